@@ -28,7 +28,9 @@ int main()
     TFunction f("x1","x2","x3","(cos(x3);sin(x3);sin(0.4*t))"); //function to be integrated
     IntervalVector a0(3,Interval(0.,0.)); // inintial condition for reference tube
     double timestep = 0.1;
-    TubeVector a = TubeVectorODE(domain,f,a0,timestep,CAPD_MODE);
+    // the integration is run once for these dynamics, other calls use the cache
+    TubeVector a = *ReferenceTubeCache::global().reference(f,a0,domain,timestep,"capd",
+                     [&]() { return TubeVectorODE(domain,f,a0,timestep,CAPD_MODE); });
     // ----- Generate derivative of [a](.) -----
     // function for the derivative tube
     TubeVector va= f.eval_vector(a);
@@ -46,11 +48,12 @@ int main()
 
 
     // ----- Contractors initialisation -----
-    Function phi("x1","x2","x3","z1","z2","z3",
-                 "(x1 + cos(x3-z3)*(-z1) - sin(x3-z3)*(-z2); \
-                    x2 + sin(x3-z3)*(-z1) + cos(x3-z3)*(-z2); \
-                    x3  - z3)");
-    CtcFunction ctc_phi(phi,x0);
+    // group action: state from the reference state (a1,a2,a3) and the initial condition (z1,z2,z3)
+    Function phi("a1","a2","a3","z1","z2","z3",
+                 "(z1 + cos(z3)*a1 - sin(z3)*a2; \
+                    z2 + sin(z3)*a1 + cos(z3)*a2; \
+                    z3 + a3)");
+    CtcLieSymmetry ctc_lie(phi);
     CtcDeriv ctc_deriv;
     CtcEval ctc_eval;
 
@@ -75,7 +78,7 @@ int main()
     ContractorNetwork cn;
     cn.add(ctc_deriv,{a,va});
     cn.add(ctc_deriv,{x,vx});
-    cn.add(ctc_phi,{x,a});
+    cn.add(ctc_lie,{x,x0,a});
     cn.contract();
     fig.show();
 
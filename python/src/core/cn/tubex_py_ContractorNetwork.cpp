@@ -175,16 +175,22 @@ void export_ContractorNetwork(py::module& m)
 
     .def("contract", &ContractorNetwork::contract,
       CONTRACTORNETWORK_DOUBLE_CONTRACT_BOOL,
-      "verbose"_a=false)
+      "verbose"_a=false,
+      py::call_guard<py::gil_scoped_release>())
 
     .def("contract_during", &ContractorNetwork::contract_during,
       CONTRACTORNETWORK_DOUBLE_CONTRACT_DURING_DOUBLE_BOOL,
-      "dt"_a, "verbose"_a=false)
+      "dt"_a, "verbose"_a=false,
+      py::call_guard<py::gil_scoped_release>())
 
-    .def("set_fixedpoint_ratio", &ContractorNetwork::set_fixedpoint_ratio,
+    .def("set_fixedpoint_ratio", (void (ContractorNetwork::*)(float))&ContractorNetwork::set_fixedpoint_ratio,
       CONTRACTORNETWORK_VOID_SET_FIXEDPOINT_RATIO_FLOAT,
       "r"_a)
 
+    .def("set_time_windows", &ContractorNetwork::set_time_windows,
+      CONTRACTORNETWORK_VOID_SET_TIME_WINDOWS_INT,
+      "nb_windows"_a)
+
     .def("trigger_all_contractors", &ContractorNetwork::trigger_all_contractors,
       CONTRACTORNETWORK_VOID_TRIGGER_ALL_CONTRACTORS)
 
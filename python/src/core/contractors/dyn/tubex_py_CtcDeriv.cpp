@@ -37,14 +37,17 @@ void export_CtcDeriv(py::module& m, py::class_<DynCtc, pyDynCtc>& dyn_ctc)
 
     .def("contract", (void (CtcDeriv::*)(Tube&,const Tube&,TimePropag))&CtcDeriv::contract,
       CTCDERIV_VOID_CONTRACT_TUBE_TUBE_TIMEPROPAG,
-      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD)
+      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD,
+      py::call_guard<py::gil_scoped_release>())
 
     .def("contract", (void (CtcDeriv::*)(TubeVector&,const TubeVector&,TimePropag))&CtcDeriv::contract,
       CTCDERIV_VOID_CONTRACT_TUBEVECTOR_TUBEVECTOR_TIMEPROPAG,
-      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD)
+      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD,
+      py::call_guard<py::gil_scoped_release>())
 
     .def("contract", (void (CtcDeriv::*)(Slice&,const Slice&,TimePropag))&CtcDeriv::contract,
       CTCDERIV_VOID_CONTRACT_SLICE_SLICE_TIMEPROPAG,
-      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD)
+      "x"_a.noconvert(), "v"_a.noconvert(), "t_propa"_a=TimePropag::FORWARD|TimePropag::BACKWARD,
+      py::call_guard<py::gil_scoped_release>())
   ;
 }
\ No newline at end of file
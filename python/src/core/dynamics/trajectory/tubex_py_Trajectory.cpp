@@ -14,6 +14,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "pyIbex_type_caster.h"
 
 #include "tubex_Trajectory.h"
@@ -26,6 +27,46 @@ using namespace tubex;
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+typedef py::array_t<double,py::array::c_style|py::array::forcecast> py_array;
+
+// NumPy conversions of sampled trajectories
+
+py::tuple trajectory_sampled_arrays(const Trajectory& x)
+{
+  if(x.definition_type() != TrajDefnType::MAP_OF_VALUES)
+    throw invalid_argument("the trajectory is not defined from a map of values");
+
+  const map<double,double>& m = x.sampled_map();
+  py_array t(m.size()), y(m.size());
+  auto t_ = t.mutable_unchecked<1>();
+  auto y_ = y.mutable_unchecked<1>();
+
+  py::ssize_t i = 0;
+  for(map<double,double>::const_iterator it = m.begin() ; it != m.end() ; it++, i++)
+  {
+    t_(i) = it->first;
+    y_(i) = it->second;
+  }
+
+  return py::make_tuple(t, y);
+}
+
+Trajectory* create_trajectory_from_arrays(const py_array& t, const py_array& y)
+{
+  if(t.ndim() != 1 || y.ndim() != 1 || t.shape(0) != y.shape(0))
+    throw invalid_argument("expected two 1d arrays of same length");
+
+  auto t_ = t.unchecked<1>();
+  auto y_ = y.unchecked<1>();
+
+  // Sorted inputs are inserted in amortized constant time
+  map<double,double> m;
+  for(py::ssize_t i = 0 ; i < t_.shape(0) ; i++)
+    m.emplace_hint(m.end(), t_(i), y_(i));
+
+  return new Trajectory(m);
+}
+
 
 void export_Trajectory(py::module& m)
 {
@@ -49,6 +90,10 @@ void export_Trajectory(py::module& m)
       TRAJECTORY_TRAJECTORY_MAPDOUBLEDOUBLE,
       "m_map_values"_a)
 
+    .def(py::init(&create_trajectory_from_arrays),
+      "Creates a trajectory from two NumPy arrays of same length: the times t and the values y(t)",
+      "t"_a, "y"_a)
+
     .def(py::init<const Trajectory&>(),
       TRAJECTORY_TRAJECTORY_TRAJECTORY,
       "traj"_a)
@@ -68,6 +113,9 @@ void export_Trajectory(py::module& m)
     .def("sampled_map", &Trajectory::sampled_map,
       TRAJECTORY_CONSTMAPDOUBLEDOUBLE_SAMPLED_MAP)
 
+    .def("sampled_arrays", &trajectory_sampled_arrays,
+      "Returns the sampled values as a tuple (t,y) of NumPy arrays")
+
     .def("tfunction", &Trajectory::tfunction,
       TRAJECTORY_CONSTTFUNCTION_TFUNCTION,
       py::return_value_policy::reference_internal)
@@ -9,14 +9,17 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
 #include <sstream>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "pyIbex_type_caster.h"
 
 #include "tubex_Tube.h"
+#include "tubex_py_Tube.h"
 // Generated file from Doxygen XML (doxygen2docstring.py):
 #include "tubex_py_Tube_docs.h"
 
@@ -26,6 +29,110 @@ using namespace tubex;
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+// NumPy conversions: the slices are stored as a linked list, so the arrays
+// are filled in one pass over the slices, without intermediate Python objects
+
+py_array tube_tdomains_array(const Tube& x)
+{
+  py_array a(vector<size_t>({(size_t)x.nb_slices(), 2}));
+  auto a_ = a.mutable_unchecked<2>();
+
+  py::ssize_t i = 0;
+  for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice(), i++)
+  {
+    a_(i,0) = s->tdomain().lb();
+    a_(i,1) = s->tdomain().ub();
+  }
+
+  return a;
+}
+
+py_array tube_codomains_array(const Tube& x)
+{
+  py_array a(vector<size_t>({(size_t)x.nb_slices(), 2}));
+  auto a_ = a.mutable_unchecked<2>();
+
+  py::ssize_t i = 0;
+  for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice(), i++)
+  {
+    a_(i,0) = s->codomain().lb();
+    a_(i,1) = s->codomain().ub();
+  }
+
+  return a;
+}
+
+py_array tube_gates_array(const Tube& x)
+{
+  py_array a(vector<size_t>({(size_t)x.nb_slices() + 1, 2}));
+  auto a_ = a.mutable_unchecked<2>();
+
+  py::ssize_t i = 0;
+  for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice(), i++)
+  {
+    a_(i,0) = s->input_gate().lb();
+    a_(i,1) = s->input_gate().ub();
+  }
+
+  a_(i,0) = x.last_slice()->output_gate().lb();
+  a_(i,1) = x.last_slice()->output_gate().ub();
+  return a;
+}
+
+void check_tdomains_array(const py_array& tdomains)
+{
+  if(tdomains.ndim() != 2 || tdomains.shape(1) != 2)
+    throw invalid_argument("tdomains: expected an array of shape (n,2)");
+
+  if(tdomains.shape(0) == 0)
+    throw invalid_argument("tdomains: expected at least one temporal domain");
+
+  auto t_ = tdomains.unchecked<2>();
+  for(py::ssize_t i = 0 ; i < t_.shape(0) ; i++)
+  {
+    // Negated comparisons, so that NaN values are rejected
+    if(!(std::isfinite(t_(i,0)) && std::isfinite(t_(i,1)) && t_(i,0) < t_(i,1)))
+      throw invalid_argument("tdomains: expected finite and non-degenerated temporal domains, with lb < ub");
+
+    if(i > 0 && !(t_(i,0) == t_(i-1,1)))
+      throw invalid_argument("tdomains: expected contiguous temporal domains, each one starting at the end of the previous one");
+  }
+}
+
+const Interval codomain_from_bounds(double lb, double ub)
+{
+  if(lb == POS_INFINITY && ub == NEG_INFINITY)
+    return Interval::EMPTY_SET;
+
+  if(!(lb <= ub))
+    throw invalid_argument("codomains: expected lb <= ub, or (inf,-inf) for an empty codomain");
+
+  return Interval(lb, ub);
+}
+
+Tube* create_tube_from_arrays(const py_array& tdomains, const py_array& codomains)
+{
+  check_tdomains_array(tdomains);
+
+  if(codomains.ndim() != 2 || codomains.shape(1) != 2 || codomains.shape(0) != tdomains.shape(0))
+    throw invalid_argument("codomains: expected an array of shape (n,2), n being the number of tdomains");
+
+  auto t_ = tdomains.unchecked<2>();
+  auto y_ = codomains.unchecked<2>();
+
+  vector<Interval> v_tdomains, v_codomains;
+  v_tdomains.reserve(t_.shape(0));
+  v_codomains.reserve(t_.shape(0));
+
+  for(py::ssize_t i = 0 ; i < t_.shape(0) ; i++)
+  {
+    v_tdomains.push_back(Interval(t_(i,0), t_(i,1)));
+    v_codomains.push_back(codomain_from_bounds(y_(i,0), y_(i,1)));
+  }
+
+  return new Tube(v_tdomains, v_codomains);
+}
+
 
 void export_Tube(py::module& m)
 {
@@ -54,6 +161,10 @@ void export_Tube(py::module& m)
       TUBE_TUBE_VECTORINTERVAL_VECTORINTERVAL,
       "v_tdomains"_a, "v_codomains"_a)
 
+    .def(py::init(&create_tube_from_arrays),
+      "Creates a tube from NumPy arrays of shape (n,2): the bounds of the n slices tdomains and codomains",
+      "tdomains"_a, "codomains"_a)
+
     .def(py::init<const Tube &>(),
       TUBE_TUBE_TUBE,
       "x"_a)
@@ -156,6 +267,15 @@ void export_Tube(py::module& m)
 
   // Accessing values
 
+    .def("tdomains_array", &tube_tdomains_array,
+      "Returns the tdomains of the slices as a NumPy array of shape (n,2)")
+
+    .def("codomains_array", &tube_codomains_array,
+      "Returns the codomains of the slices as a NumPy array of shape (n,2) (empty sets are made of NaN bounds)")
+
+    .def("gates_array", &tube_gates_array,
+      "Returns the n+1 gates of the tube as a NumPy array of shape (n+1,2) (empty sets are made of NaN bounds)")
+
     .def("codomain", &Tube::codomain,
       TUBE_CONSTINTERVAL_CODOMAIN)
 
@@ -372,6 +492,12 @@ void export_Tube(py::module& m)
       TUBE_VOID_ENABLE_SYNTHESIS_BOOL,
       "enable"_a=true)
 
+    .def("freeze", &Tube::freeze,
+      TUBE_VOID_FREEZE)
+
+    .def("is_frozen", &Tube::is_frozen,
+      TUBE_BOOL_IS_FROZEN)
+
   // Integration
 
     .def("integral", (const Interval (Tube::*)(double) const)&Tube::integral,
@@ -0,0 +1,30 @@
+/** 
+ *  \file
+ *  Tube Python binding
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou, Benoît Desrochers
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_PY_TUBE_H__
+#define __TUBEX_PY_TUBE_H__
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include "ibex_Interval.h"
+
+typedef pybind11::array_t<double,pybind11::array::c_style|pybind11::array::forcecast> py_array;
+
+// Checks temporal domains given as an array of shape (n,2): at least one slice,
+// finite and non-degenerated domains, each one starting at the end of the previous one.
+// Tube constructors only assert these conditions, invalid_argument is thrown here.
+void check_tdomains_array(const py_array& tdomains);
+
+// Builds a codomain from its bounds, (inf,-inf) being the empty set
+// (as returned by codomains_array()), invalid_argument is thrown for other lb > ub
+const ibex::Interval codomain_from_bounds(double lb, double ub);
+
+#endif
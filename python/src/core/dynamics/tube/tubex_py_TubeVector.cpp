@@ -14,9 +14,11 @@
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "pyIbex_type_caster.h"
 
 #include "tubex_TubeVector.h"
+#include "tubex_py_Tube.h"
 // Generated file from Doxygen XML (doxygen2docstring.py):
 #include "tubex_py_TubeVector_docs.h"
 
@@ -26,6 +28,99 @@ using namespace tubex;
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+// NumPy conversions: the components are expected to share the same slicing,
+// their slices are browsed in one pass to fill (n,dim,2) arrays
+
+void check_same_slicing(const TubeVector& x)
+{
+  for(int j = 1 ; j < x.size() ; j++)
+    if(!Tube::same_slicing(x[0], x[j]))
+      throw invalid_argument("the components of the tube vector do not share the same slicing");
+}
+
+py_array tubevector_tdomains_array(const TubeVector& x)
+{
+  check_same_slicing(x);
+  py_array a(vector<size_t>({(size_t)x[0].nb_slices(), 2}));
+  auto a_ = a.mutable_unchecked<2>();
+
+  py::ssize_t i = 0;
+  for(const Slice *s = x[0].first_slice() ; s != NULL ; s = s->next_slice(), i++)
+  {
+    a_(i,0) = s->tdomain().lb();
+    a_(i,1) = s->tdomain().ub();
+  }
+
+  return a;
+}
+
+py_array tubevector_codomains_array(const TubeVector& x)
+{
+  check_same_slicing(x);
+  py_array a(vector<size_t>({(size_t)x[0].nb_slices(), (size_t)x.size(), 2}));
+  auto a_ = a.mutable_unchecked<3>();
+
+  for(int j = 0 ; j < x.size() ; j++)
+  {
+    py::ssize_t i = 0;
+    for(const Slice *s = x[j].first_slice() ; s != NULL ; s = s->next_slice(), i++)
+    {
+      a_(i,j,0) = s->codomain().lb();
+      a_(i,j,1) = s->codomain().ub();
+    }
+  }
+
+  return a;
+}
+
+py_array tubevector_gates_array(const TubeVector& x)
+{
+  check_same_slicing(x);
+  py_array a(vector<size_t>({(size_t)x[0].nb_slices() + 1, (size_t)x.size(), 2}));
+  auto a_ = a.mutable_unchecked<3>();
+
+  for(int j = 0 ; j < x.size() ; j++)
+  {
+    py::ssize_t i = 0;
+    for(const Slice *s = x[j].first_slice() ; s != NULL ; s = s->next_slice(), i++)
+    {
+      a_(i,j,0) = s->input_gate().lb();
+      a_(i,j,1) = s->input_gate().ub();
+    }
+
+    a_(i,j,0) = x[j].last_slice()->output_gate().lb();
+    a_(i,j,1) = x[j].last_slice()->output_gate().ub();
+  }
+
+  return a;
+}
+
+TubeVector* create_tubevector_from_arrays(const py_array& tdomains, const py_array& codomains)
+{
+  check_tdomains_array(tdomains);
+
+  if(codomains.ndim() != 3 || codomains.shape(2) != 2 || codomains.shape(0) != tdomains.shape(0) || codomains.shape(1) == 0)
+    throw invalid_argument("codomains: expected an array of shape (n,dim,2), n being the number of tdomains");
+
+  auto t_ = tdomains.unchecked<2>();
+  auto y_ = codomains.unchecked<3>();
+
+  vector<Interval> v_tdomains;
+  vector<IntervalVector> v_codomains;
+  v_tdomains.reserve(t_.shape(0));
+  v_codomains.reserve(t_.shape(0));
+
+  for(py::ssize_t i = 0 ; i < t_.shape(0) ; i++)
+  {
+    v_tdomains.push_back(Interval(t_(i,0), t_(i,1)));
+    v_codomains.push_back(IntervalVector(y_.shape(1)));
+    for(py::ssize_t j = 0 ; j < y_.shape(1) ; j++)
+      v_codomains.back()[j] = codomain_from_bounds(y_(i,j,0), y_(i,j,1));
+  }
+
+  return new TubeVector(v_tdomains, v_codomains);
+}
+
 
 void export_TubeVector(py::module& m)
 {
@@ -58,6 +153,10 @@ void export_TubeVector(py::module& m)
       TUBEVECTOR_TUBEVECTOR_VECTORINTERVAL_VECTORINTERVALVECTOR,
       "v_tdomains"_a, "v_codomains"_a)
 
+    .def(py::init(&create_tubevector_from_arrays),
+      "Creates a tube vector from NumPy arrays: the bounds of the n slices tdomains, of shape (n,2), and of their codomains, of shape (n,dim,2)",
+      "tdomains"_a, "codomains"_a)
+
     .def(py::init<initializer_list<Tube>>(),
       TUBEVECTOR_TUBEVECTOR_INITIALIZERLISTTUBE,
       "list"_a)
@@ -142,6 +241,15 @@ void export_TubeVector(py::module& m)
 
   // Accessing values
 
+    .def("tdomains_array", &tubevector_tdomains_array,
+      "Returns the tdomains of the slices as a NumPy array of shape (n,2)")
+
+    .def("codomains_array", &tubevector_codomains_array,
+      "Returns the codomains of the slices as a NumPy array of shape (n,dim,2) (empty sets are made of NaN bounds)")
+
+    .def("gates_array", &tubevector_gates_array,
+      "Returns the n+1 gates of the tube vector as a NumPy array of shape (n+1,dim,2) (empty sets are made of NaN bounds)")
+
     .def("codomain", &TubeVector::codomain,
       TUBEVECTOR_CONSTINTERVALVECTOR_CODOMAIN)
 
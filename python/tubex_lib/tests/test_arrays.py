@@ -0,0 +1,197 @@
+#!/usr/bin/env python
+
+import time
+import threading
+import unittest
+import numpy as np
+from pyibex import Interval, IntervalVector
+from tubex_lib import *
+
+class TestArrays(unittest.TestCase):
+
+  def test_tube_arrays(self):
+
+    x = Tube(Interval(0.,4.), 1., Interval(-1.,1.))
+    x.set(Interval(2.,3.), 2)
+    x.set(Interval(0.5), 2.)
+
+    t = x.tdomains_array()
+    self.assertEqual(t.shape, (4,2))
+    self.assertTrue(np.array_equal(t, [[0.,1.],[1.,2.],[2.,3.],[3.,4.]]))
+
+    y = x.codomains_array()
+    self.assertEqual(y.shape, (4,2))
+    self.assertTrue(np.array_equal(y[2], [2.,3.]))
+    for i in range(4):
+      self.assertEqual(Interval(y[i][0], y[i][1]), x(i))
+
+    g = x.gates_array()
+    self.assertEqual(g.shape, (5,2))
+    self.assertTrue(np.array_equal(g[2], [0.5,0.5]))
+    self.assertEqual(Interval(g[4][0], g[4][1]), x(4.))
+
+  def test_tube_from_arrays(self):
+
+    t = np.array([[0.,1.],[1.,3.],[3.,3.5]])
+    y = np.array([[-1.,1.],[0.,2.],[1.,1.5]])
+    x = Tube(t, y)
+    self.assertEqual(x.nb_slices(), 3)
+    self.assertEqual(x.tdomain(), Interval(0.,3.5))
+    self.assertEqual(x(1), Interval(0.,2.))
+    self.assertTrue(np.array_equal(x.tdomains_array(), t))
+    self.assertTrue(np.array_equal(x.codomains_array(), y))
+
+    with self.assertRaises(ValueError):
+      Tube(t, y[:2])
+    with self.assertRaises(ValueError):
+      Tube(t, np.zeros((3,3)))
+
+  def test_tube_from_invalid_arrays(self):
+
+    y = np.array([[-1.,1.],[0.,2.]])
+
+    # Empty arrays
+    with self.assertRaises(ValueError):
+      Tube(np.zeros((0,2)), np.zeros((0,2)))
+
+    # Degenerated, reversed or unbounded temporal domains
+    for t in ([[0.,1.],[1.,1.]], [[1.,0.],[0.,2.]], [[0.,1.],[1.,np.inf]], [[0.,1.],[1.,np.nan]]):
+      with self.assertRaises(ValueError):
+        Tube(np.array(t), y)
+
+    # Non-contiguous or overlapping temporal domains
+    for t in ([[0.,1.],[1.5,2.]], [[0.,1.],[0.5,2.]]):
+      with self.assertRaises(ValueError):
+        Tube(np.array(t), y)
+
+    # Reversed codomains
+    t = np.array([[0.,1.],[1.,2.]])
+    with self.assertRaises(ValueError):
+      Tube(t, np.array([[-1.,1.],[2.,0.]]))
+    with self.assertRaises(ValueError):
+      Tube(t, np.array([[-1.,1.],[np.nan,0.]]))
+
+    # Empty codomains, as returned by codomains_array()
+    x = Tube(t, np.array([[-1.,1.],[np.inf,-np.inf]]))
+    self.assertTrue(x(1).is_empty())
+    x2 = Tube(x.tdomains_array(), x.codomains_array())
+    self.assertEqual(x2(0), Interval(-1.,1.))
+    self.assertTrue(x2(1).is_empty())
+
+  def test_tubevector_arrays(self):
+
+    x = TubeVector(Interval(0.,3.), 1., IntervalVector([[-1.,1.],[2.,3.]]))
+    x.set(IntervalVector([[0.,0.5],[2.5,2.5]]), 1)
+
+    t = x.tdomains_array()
+    self.assertEqual(t.shape, (3,2))
+    self.assertTrue(np.array_equal(t, [[0.,1.],[1.,2.],[2.,3.]]))
+
+    y = x.codomains_array()
+    self.assertEqual(y.shape, (3,2,2))
+    self.assertTrue(np.array_equal(y[1], [[0.,0.5],[2.5,2.5]]))
+    self.assertTrue(np.array_equal(y[2], [[-1.,1.],[2.,3.]]))
+
+    g = x.gates_array()
+    self.assertEqual(g.shape, (4,2,2))
+    for i in range(4):
+      for j in range(2):
+        self.assertEqual(Interval(g[i][j][0], g[i][j][1]), x[j](float(i)))
+
+  def test_tubevector_from_arrays(self):
+
+    t = np.array([[0.,1.],[1.,2.5]])
+    y = np.array([[[-1.,1.],[0.,1.]],[[2.,3.],[4.,5.]]])
+    x = TubeVector(t, y)
+    self.assertEqual(x.size(), 2)
+    self.assertEqual(x.nb_slices(), 2)
+    self.assertEqual(x[1](1), Interval(4.,5.))
+    self.assertTrue(np.array_equal(x.tdomains_array(), t))
+    self.assertTrue(np.array_equal(x.codomains_array(), y))
+
+    with self.assertRaises(ValueError):
+      TubeVector(t, y[:,:,0])
+    with self.assertRaises(ValueError):
+      TubeVector(t, y[:1])
+
+  def test_tubevector_from_invalid_arrays(self):
+
+    y = np.array([[[-1.,1.],[0.,1.]],[[2.,3.],[4.,5.]]])
+
+    with self.assertRaises(ValueError):
+      TubeVector(np.zeros((0,2)), np.zeros((0,2,2)))
+    with self.assertRaises(ValueError):
+      TubeVector(np.array([[0.,1.],[1.,2.]]), np.zeros((2,0,2)))
+
+    for t in ([[0.,1.],[1.,1.]], [[1.,0.],[0.,2.]], [[0.,1.],[1.5,2.]], [[0.,1.],[0.5,2.]]):
+      with self.assertRaises(ValueError):
+        TubeVector(np.array(t), y)
+
+    y[1][1] = [5.,4.]
+    with self.assertRaises(ValueError):
+      TubeVector(np.array([[0.,1.],[1.,2.]]), y)
+
+  def test_tubevector_different_slicings(self):
+
+    # Same number of slices, but different slicings
+    x = TubeVector(Interval(0.,3.), 1., 2)
+    x[0].sample(0.5)
+    x[1].sample(2.5)
+    self.assertEqual(x[0].nb_slices(), x[1].nb_slices())
+
+    with self.assertRaises(ValueError):
+      x.tdomains_array()
+    with self.assertRaises(ValueError):
+      x.codomains_array()
+    with self.assertRaises(ValueError):
+      x.gates_array()
+
+  def test_trajectory_arrays(self):
+
+    t = np.array([0.,0.5,2.])
+    y = np.array([1.,-1.,3.])
+    traj = Trajectory(t, y)
+    self.assertEqual(traj.tdomain(), Interval(0.,2.))
+    self.assertEqual(traj(0.5), -1.)
+
+    t2, y2 = traj.sampled_arrays()
+    self.assertTrue(np.array_equal(t2, t))
+    self.assertTrue(np.array_equal(y2, y))
+
+    with self.assertRaises(ValueError):
+      Trajectory(t, y[:2])
+
+  def test_gil_release(self):
+
+    # While CtcDeriv contracts a large tube in another thread,
+    # the GIL is released and this thread keeps running
+
+    x = Tube(Interval(0.,100.), 0.0005)
+    x.set(Interval(0.), 0.)
+    v = Tube(Interval(0.,100.), 0.0005, Interval(-1.,1.))
+    ctc_deriv = CtcDeriv()
+    duration = []
+
+    def contract():
+      t0 = time.perf_counter()
+      ctc_deriv.contract(x, v)
+      duration.append(time.perf_counter() - t0)
+
+    thread = threading.Thread(target=contract)
+    max_gap = 0.
+    t_prev = time.perf_counter()
+    thread.start()
+    while thread.is_alive():
+      t = time.perf_counter()
+      max_gap = max(max_gap, t - t_prev)
+      t_prev = t
+    thread.join()
+
+    self.assertEqual(x(100.), Interval(-100.,100.))
+    if duration[0] < 0.05:
+      self.skipTest("contraction too fast to be measured")
+    self.assertLess(max_gap, duration[0] / 2.)
+
+
+if __name__ ==  '__main__':
+  unittest.main()
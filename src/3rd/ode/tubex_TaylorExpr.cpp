@@ -0,0 +1,611 @@
+/**
+ *  TaylorExpr class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Tubex
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+#include "tubex_TaylorExpr.h"
+#include "tubex_Exception.h"
+#include "tubex_Tools.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // TaylorDual
+
+  TaylorDual::TaylorDual(const Interval& v)
+    : v(v)
+  {
+
+  }
+
+  TaylorDual::TaylorDual(const Interval& v, int n, int i)
+    : v(v), d(n, Interval(0.))
+  {
+    assert(i >= 0 && i < n);
+    d[i] = Interval(1.);
+  }
+
+  // Returns a*da + b*db, empty gradients being zero
+  static const vector<Interval> combine(const Interval& a, const vector<Interval>& da,
+                                        const Interval& b, const vector<Interval>& db)
+  {
+    vector<Interval> d(max(da.size(), db.size()), Interval(0.));
+    for(size_t i = 0 ; i < da.size() ; i++)
+      d[i] += a * da[i];
+    for(size_t i = 0 ; i < db.size() ; i++)
+      d[i] += b * db[i];
+    return d;
+  }
+
+  // Returns a*dx
+  static const TaylorDual chain(const Interval& v, const Interval& a, const TaylorDual& x)
+  {
+    TaylorDual y(v);
+    y.d = combine(a, x.d, Interval(0.), vector<Interval>());
+    return y;
+  }
+
+  const TaylorDual operator+(const TaylorDual& x, const TaylorDual& y)
+  {
+    TaylorDual z(x.v + y.v);
+    z.d = combine(Interval(1.), x.d, Interval(1.), y.d);
+    return z;
+  }
+
+  const TaylorDual operator-(const TaylorDual& x, const TaylorDual& y)
+  {
+    TaylorDual z(x.v - y.v);
+    z.d = combine(Interval(1.), x.d, Interval(-1.), y.d);
+    return z;
+  }
+
+  const TaylorDual operator-(const TaylorDual& x)
+  {
+    return chain(-x.v, Interval(-1.), x);
+  }
+
+  const TaylorDual operator*(const TaylorDual& x, const TaylorDual& y)
+  {
+    TaylorDual z(x.v * y.v);
+    z.d = combine(y.v, x.d, x.v, y.d);
+    return z;
+  }
+
+  const TaylorDual operator*(const TaylorDual& x, const Interval& y)
+  {
+    return chain(x.v * y, y, x);
+  }
+
+  const TaylorDual operator/(const TaylorDual& x, const TaylorDual& y)
+  {
+    TaylorDual z(x.v / y.v);
+    z.d = combine(1. / y.v, x.d, -z.v / y.v, y.d);
+    return z;
+  }
+
+  const TaylorDual operator/(const TaylorDual& x, const Interval& y)
+  {
+    return chain(x.v / y, 1. / y, x);
+  }
+
+  const TaylorDual sqr(const TaylorDual& x)
+  {
+    return chain(sqr(x.v), 2. * x.v, x);
+  }
+
+  const TaylorDual sqrt(const TaylorDual& x)
+  {
+    Interval v = sqrt(x.v);
+    return chain(v, 1. / (2. * v), x);
+  }
+
+  const TaylorDual exp(const TaylorDual& x)
+  {
+    Interval v = exp(x.v);
+    return chain(v, v, x);
+  }
+
+  const TaylorDual log(const TaylorDual& x)
+  {
+    return chain(log(x.v), 1. / x.v, x);
+  }
+
+  const TaylorDual sin(const TaylorDual& x)
+  {
+    return chain(sin(x.v), cos(x.v), x);
+  }
+
+  const TaylorDual cos(const TaylorDual& x)
+  {
+    return chain(cos(x.v), -sin(x.v), x);
+  }
+
+  const TaylorDual pow(const TaylorDual& x, const Interval& p)
+  {
+    return chain(pow(x.v, p), p * pow(x.v, p - 1.), x);
+  }
+
+  // TaylorExpr
+
+  TaylorExpr::TaylorExpr(const TFunction& f)
+    : m_n(f.nb_vars()), m_str(f.expr()), m_pos(0)
+  {
+    if(f.image_dim() != f.nb_vars())
+      throw Exception("TaylorExpr::TaylorExpr", "the dimension of f must be the dimension of the state");
+
+    m_v_var_names.push_back("t");
+    for(int i = 0 ; i < f.nb_vars() ; i++)
+      m_v_var_names.push_back(f.arg_name(i));
+
+    parse_list(m_v_outputs);
+
+    if((int)m_v_outputs.size() != m_n)
+      throw Exception("TaylorExpr::TaylorExpr", "unable to read the components of f");
+  }
+
+  int TaylorExpr::nb_vars() const
+  {
+    return m_n;
+  }
+
+  template<typename T>
+  void TaylorExpr::ode_coefficients(const Interval& t, const vector<T>& x, int order,
+                                    vector<vector<T> >& v_coeffs) const
+  {
+    assert((int)x.size() == m_n);
+    assert(order >= 0);
+
+    vector<vector<T> > c(m_v_nodes.size(), vector<T>(order + 1));
+    vector<vector<T> > aux(m_v_nodes.size(), vector<T>(order + 1));
+
+    v_coeffs = vector<vector<T> >(m_n, vector<T>(order + 1));
+    for(int j = 0 ; j < m_n ; j++)
+      v_coeffs[j][0] = x[j];
+
+    // The k-th coefficient of f(t,x(t)) provides the (k+1)-th one of x(t)
+    for(int k = 0 ; k < order ; k++)
+    {
+      for(size_t i = 0 ; i < m_v_nodes.size() ; i++)
+      {
+        const Node& node = m_v_nodes[i];
+
+        if(node.type == VAR)
+        {
+          if(node.a != 0)
+            c[i][k] = v_coeffs[node.a - 1][k];
+
+          else // time
+            c[i][k] = T(k == 0 ? t : Interval(k == 1 ? 1. : 0.));
+        }
+
+        else
+          eval_node(i, k, c, aux);
+      }
+
+      for(int j = 0 ; j < m_n ; j++)
+        v_coeffs[j][k + 1] = c[m_v_outputs[j]][k] / Interval(k + 1.);
+    }
+  }
+
+  template<typename T>
+  void TaylorExpr::eval_node(int i, int k, vector<vector<T> >& c, vector<vector<T> >& aux) const
+  {
+    const Node& node = m_v_nodes[i];
+    const vector<T>& a = node.a != -1 ? c[node.a] : c[i];
+    const vector<T>& b = node.b != -1 ? c[node.b] : c[i];
+    T& y = c[i][k];
+
+    switch(node.type)
+    {
+      case CST:
+        y = T(k == 0 ? node.cst : Interval(0.));
+        break;
+
+      case ADD:
+        y = a[k] + b[k];
+        break;
+
+      case SUB:
+        y = a[k] - b[k];
+        break;
+
+      case NEG:
+        y = -a[k];
+        break;
+
+      case MUL:
+        y = a[0] * b[k];
+        for(int j = 1 ; j <= k ; j++)
+          y = y + a[j] * b[k - j];
+        break;
+
+      case DIV:
+        y = a[k];
+        for(int j = 1 ; j <= k ; j++)
+          y = y - b[j] * c[i][k - j];
+        y = y / b[0];
+        break;
+
+      case SQR:
+        if(k == 0)
+          y = sqr(a[0]);
+
+        else
+        {
+          // Symmetric terms are counted twice
+          y = a[0] * a[k];
+          for(int j = 1 ; j < (k + 1) / 2 ; j++)
+            y = y + a[j] * a[k - j];
+          y = y * Interval(2.);
+          if(k % 2 == 0)
+            y = y + sqr(a[k / 2]);
+        }
+        break;
+
+      case SQRT:
+        if(k == 0)
+          y = sqrt(a[0]);
+
+        else
+        {
+          y = a[k];
+          for(int j = 1 ; j < k ; j++)
+            y = y - c[i][j] * c[i][k - j];
+          y = y / (c[i][0] * Interval(2.));
+        }
+        break;
+
+      case EXP:
+        if(k == 0)
+          y = exp(a[0]);
+
+        else
+        {
+          y = a[1] * c[i][k - 1];
+          for(int j = 2 ; j <= k ; j++)
+            y = y + a[j] * c[i][k - j] * Interval(j);
+          y = y / Interval(k);
+        }
+        break;
+
+      case LOG:
+        if(k == 0)
+          y = log(a[0]);
+
+        else
+        {
+          T s = T(Interval(0.));
+          for(int j = 1 ; j < k ; j++)
+            s = s + c[i][j] * a[k - j] * Interval(j);
+          y = (a[k] - s / Interval(k)) / a[0];
+        }
+        break;
+
+      case SIN:
+      case COS:
+      {
+        // Sine and cosine are computed together, the other function is stored in aux
+        vector<T>& s = node.type == SIN ? c[i] : aux[i];
+        vector<T>& co = node.type == SIN ? aux[i] : c[i];
+
+        if(k == 0)
+        {
+          s[0] = sin(a[0]);
+          co[0] = cos(a[0]);
+        }
+
+        else
+        {
+          T ds = a[1] * co[k - 1], dc = a[1] * s[k - 1];
+          for(int j = 2 ; j <= k ; j++)
+          {
+            ds = ds + a[j] * co[k - j] * Interval(j);
+            dc = dc + a[j] * s[k - j] * Interval(j);
+          }
+          s[k] = ds / Interval(k);
+          co[k] = -dc / Interval(k);
+        }
+        break;
+      }
+
+      case POW:
+        if(k == 0)
+          y = pow(a[0], node.cst);
+
+        else
+        {
+          y = a[1] * c[i][k - 1] * ((node.cst + 1.) - k);
+          for(int j = 2 ; j <= k ; j++)
+            y = y + a[j] * c[i][k - j] * ((node.cst + 1.) * j - k);
+          y = y / (a[0] * Interval(k));
+        }
+        break;
+
+      default:
+        assert(false && "unhandled node");
+    }
+  }
+
+  int TaylorExpr::add_node(NodeType type, int a, int b, const Interval& cst)
+  {
+    // Constant folding
+    if(type != CST && type != VAR
+      && (a == -1 || m_v_nodes[a].type == CST) && (b == -1 || m_v_nodes[b].type == CST))
+    {
+      const Interval& x = m_v_nodes[a].cst;
+      const Interval& y = b != -1 ? m_v_nodes[b].cst : x;
+      Interval z;
+
+      switch(type)
+      {
+        case ADD: z = x + y; break;
+        case SUB: z = x - y; break;
+        case NEG: z = -x; break;
+        case MUL: z = x * y; break;
+        case DIV: z = x / y; break;
+        case SQR: z = sqr(x); break;
+        case SQRT: z = sqrt(x); break;
+        case EXP: z = exp(x); break;
+        case LOG: z = log(x); break;
+        case SIN: z = sin(x); break;
+        case COS: z = cos(x); break;
+        case POW: z = pow(x, cst); break;
+        default: assert(false && "unhandled node");
+      }
+
+      return add_node(CST, -1, -1, z);
+    }
+
+    Node node;
+    node.type = type;
+    node.a = a;
+    node.b = b;
+    node.cst = cst;
+    m_v_nodes.push_back(node);
+    return m_v_nodes.size() - 1;
+  }
+
+  int TaylorExpr::add_power(int a, const Interval& p)
+  {
+    // Integer powers are expanded into products, that remain
+    // defined when the base contains zero
+    if(p.is_degenerated() && p.lb() == (int)p.lb() && fabs(p.lb()) <= 64.)
+    {
+      int n = (int)p.lb();
+
+      if(n == 0)
+        return add_node(CST, -1, -1, Interval(1.));
+
+      if(n < 0)
+        return add_node(DIV, add_node(CST, -1, -1, Interval(1.)), add_power(a, Interval(-n)));
+
+      int y = -1;
+      for(int x = a ; n > 0 ; n /= 2)
+      {
+        if(n % 2 == 1)
+          y = (y == -1) ? x : add_node(MUL, y, x);
+        if(n > 1)
+          x = add_node(SQR, x);
+      }
+
+      return y;
+    }
+
+    return add_node(POW, a, -1, p);
+  }
+
+  void TaylorExpr::parse_list(vector<int>& v_nodes)
+  {
+    // Vector expression: (f1;f2;...)
+    m_pos = 0;
+    if(accept('('))
+    {
+      v_nodes.push_back(parse_expr());
+
+      if(accept(';') || accept(','))
+      {
+        do
+        {
+          v_nodes.push_back(parse_expr());
+        } while(accept(';') || accept(','));
+
+        expect(')');
+        skip_spaces();
+        if(m_pos != m_str.size())
+          throw Exception("TaylorExpr::parse", "unexpected characters after the expression");
+        return;
+      }
+    }
+
+    // Scalar expression
+    v_nodes.clear();
+    m_v_nodes.clear();
+    m_pos = 0;
+    v_nodes.push_back(parse_expr());
+    skip_spaces();
+    if(m_pos != m_str.size())
+      throw Exception("TaylorExpr::parse", "unexpected characters after the expression");
+  }
+
+  int TaylorExpr::parse_expr()
+  {
+    int x = parse_term();
+
+    while(true)
+    {
+      if(accept('+'))
+        x = add_node(ADD, x, parse_term());
+
+      else if(accept('-'))
+        x = add_node(SUB, x, parse_term());
+
+      else
+        return x;
+    }
+  }
+
+  int TaylorExpr::parse_term()
+  {
+    int x = parse_unary();
+
+    while(true)
+    {
+      if(accept('*'))
+        x = add_node(MUL, x, parse_unary());
+
+      else if(accept('/'))
+        x = add_node(DIV, x, parse_unary());
+
+      else
+        return x;
+    }
+  }
+
+  int TaylorExpr::parse_unary()
+  {
+    if(accept('-'))
+      return add_node(NEG, parse_unary());
+
+    if(accept('+'))
+      return parse_unary();
+
+    return parse_power();
+  }
+
+  int TaylorExpr::parse_power()
+  {
+    int x = parse_primary();
+
+    if(accept('^'))
+    {
+      int p = parse_unary();
+      if(m_v_nodes[p].type != CST)
+        throw Exception("TaylorExpr::parse", "only constant exponents are supported");
+      return add_power(x, m_v_nodes[p].cst);
+    }
+
+    return x;
+  }
+
+  int TaylorExpr::parse_primary()
+  {
+    skip_spaces();
+
+    if(accept('('))
+    {
+      int x = parse_expr();
+      expect(')');
+      return x;
+    }
+
+    if(accept('['))
+    {
+      Interval lb = parse_number();
+      expect(',');
+      Interval ub = parse_number();
+      expect(']');
+      return add_node(CST, -1, -1, Interval(lb.lb(), ub.ub()));
+    }
+
+    if(m_pos < m_str.size() && (isdigit(m_str[m_pos]) || m_str[m_pos] == '.'))
+      return add_node(CST, -1, -1, parse_number());
+
+    size_t begin = m_pos;
+    while(m_pos < m_str.size() && (isalnum(m_str[m_pos]) || m_str[m_pos] == '_'))
+      m_pos++;
+    string name = m_str.substr(begin, m_pos - begin);
+
+    if(name.empty())
+      throw Exception("TaylorExpr::parse", "unexpected character in \"" + m_str + "\"");
+
+    if(accept('('))
+    {
+      int x = parse_expr();
+      expect(')');
+
+      if(name == "sqr") return add_node(SQR, x);
+      if(name == "sqrt") return add_node(SQRT, x);
+      if(name == "exp") return add_node(EXP, x);
+      if(name == "log") return add_node(LOG, x);
+      if(name == "sin") return add_node(SIN, x);
+      if(name == "cos") return add_node(COS, x);
+      if(name == "tan") return add_node(DIV, add_node(SIN, x), add_node(COS, x));
+
+      throw Exception("TaylorExpr::parse", "unsupported function \"" + name + "\"");
+    }
+
+    for(size_t i = 0 ; i < m_v_var_names.size() ; i++)
+      if(name == m_v_var_names[i])
+        return add_node(VAR, i);
+
+    throw Exception("TaylorExpr::parse", "unknown symbol \"" + name + "\"");
+  }
+
+  void TaylorExpr::skip_spaces()
+  {
+    while(m_pos < m_str.size() && isspace(m_str[m_pos]))
+      m_pos++;
+  }
+
+  bool TaylorExpr::accept(char c)
+  {
+    skip_spaces();
+    if(m_pos < m_str.size() && m_str[m_pos] == c)
+    {
+      m_pos++;
+      return true;
+    }
+    return false;
+  }
+
+  void TaylorExpr::expect(char c)
+  {
+    if(!accept(c))
+      throw Exception("TaylorExpr::parse", string("missing '") + c + "' in \"" + m_str + "\"");
+  }
+
+  const Interval TaylorExpr::parse_number()
+  {
+    skip_spaces();
+    const char *begin = m_str.c_str() + m_pos;
+    double x;
+    const char *end = Tools::parse_double(begin, m_str.c_str() + m_str.size(), x);
+    if(end == begin)
+      throw Exception("TaylorExpr::parse", "unable to read a number in \"" + m_str + "\"");
+    m_pos += end - begin;
+
+    // The literal is exactly represented if it is an integer (possibly
+    // followed by zero decimals) lower than 2^53 in magnitude
+    bool exact = fabs(x) < 9007199254740992.;
+    bool decimals = false;
+    for(const char *c = begin ; c != end && exact ; c++)
+    {
+      if(*c == '.')
+        decimals = true;
+      else if(isdigit(*c))
+        exact = !decimals || *c == '0';
+      else
+        exact = (c == begin && (*c == '+' || *c == '-'));
+    }
+
+    if(exact)
+      return Interval(x);
+
+    // Otherwise, the parsed value is the nearest double: the decimal
+    // value is enclosed by the neighbouring doubles
+    return Interval(nextafter(x, NEG_INFINITY), nextafter(x, POS_INFINITY));
+  }
+
+  template void TaylorExpr::ode_coefficients<Interval>(const Interval&, const vector<Interval>&, int, vector<vector<Interval> >&) const;
+  template void TaylorExpr::ode_coefficients<TaylorDual>(const Interval&, const vector<TaylorDual>&, int, vector<vector<TaylorDual> >&) const;
+}
@@ -0,0 +1,137 @@
+/**
+ *  \file
+ *  TaylorExpr class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Tubex
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TAYLOREXPR_H__
+#define __TUBEX_TAYLOREXPR_H__
+
+#include <vector>
+#include <string>
+#include "ibex_Interval.h"
+#include "tubex_TFunction.h"
+
+namespace tubex
+{
+  /**
+   * \class TaylorDual
+   * \brief Interval value together with an enclosure of its gradient
+   *        with respect to the initial condition of an ODE
+   *
+   * An empty gradient stands for a zero gradient (constants).
+   */
+  class TaylorDual
+  {
+    public:
+
+      TaylorDual(const ibex::Interval& v = ibex::Interval(0.));
+      TaylorDual(const ibex::Interval& v, int n, int i);
+
+      ibex::Interval v; //!< value
+      std::vector<ibex::Interval> d; //!< gradient, possibly empty
+  };
+
+  const TaylorDual operator+(const TaylorDual& x, const TaylorDual& y);
+  const TaylorDual operator-(const TaylorDual& x, const TaylorDual& y);
+  const TaylorDual operator-(const TaylorDual& x);
+  const TaylorDual operator*(const TaylorDual& x, const TaylorDual& y);
+  const TaylorDual operator*(const TaylorDual& x, const ibex::Interval& y);
+  const TaylorDual operator/(const TaylorDual& x, const TaylorDual& y);
+  const TaylorDual operator/(const TaylorDual& x, const ibex::Interval& y);
+  const TaylorDual sqr(const TaylorDual& x);
+  const TaylorDual sqrt(const TaylorDual& x);
+  const TaylorDual exp(const TaylorDual& x);
+  const TaylorDual log(const TaylorDual& x);
+  const TaylorDual sin(const TaylorDual& x);
+  const TaylorDual cos(const TaylorDual& x);
+  const TaylorDual pow(const TaylorDual& x, const ibex::Interval& p);
+
+  /**
+   * \class TaylorExpr
+   * \brief Computational graph of a TFunction, for the automatic
+   *        computation of Taylor coefficients of ODE solutions
+   *
+   * The expression of the function is parsed into a list of elementary
+   * operations, in topological order. Taylor coefficients are then propagated
+   * through the list with the classical recurrences of automatic differentiation.
+   *
+   * Supported operators: `+`, `-`, `*`, `/`, `^` (constant exponent),
+   * `sqr`, `sqrt`, `exp`, `log`, `sin`, `cos`, `tan`, constants and intervals.
+   */
+  class TaylorExpr
+  {
+    public:
+
+      /**
+       * \brief Creates the computational graph of \f$\mathbf{f}(t,\mathbf{x})\f$
+       *
+       * An exception is thrown if the expression contains an unsupported operator.
+       *
+       * \param f TFunction object
+       */
+      TaylorExpr(const TFunction& f);
+
+      /**
+       * \brief Returns the dimension of the state
+       *
+       * \return n
+       */
+      int nb_vars() const;
+
+      /**
+       * \brief Computes the Taylor coefficients of the solution of \f$\dot{\mathbf{x}}=\mathbf{f}(t,\mathbf{x})\f$
+       *
+       * \param t time of the expansion (may be an interval)
+       * \param x state at \f$t\f$
+       * \param order highest computed order
+       * \param v_coeffs coefficients: `v_coeffs[i][k]` is the \f$k\f$-th coefficient of \f$x_i\f$
+       */
+      template<typename T>
+      void ode_coefficients(const ibex::Interval& t, const std::vector<T>& x, int order,
+                            std::vector<std::vector<T> >& v_coeffs) const;
+
+    protected:
+
+      enum NodeType { CST, VAR, ADD, SUB, NEG, MUL, DIV, SQR, SQRT, EXP, LOG, SIN, COS, POW };
+
+      struct Node
+      {
+        NodeType type;
+        int a, b; //!< ids of the operands, or id of the variable (0 for t)
+        ibex::Interval cst; //!< constant value, or exponent of POW
+      };
+
+      int add_node(NodeType type, int a = -1, int b = -1, const ibex::Interval& cst = ibex::Interval(0.));
+      int add_power(int a, const ibex::Interval& p);
+
+      void parse_list(std::vector<int>& v_nodes);
+      int parse_expr();
+      int parse_term();
+      int parse_unary();
+      int parse_power();
+      int parse_primary();
+      void skip_spaces();
+      bool accept(char c);
+      void expect(char c);
+      const ibex::Interval parse_number();
+
+      template<typename T>
+      void eval_node(int i, int k, std::vector<std::vector<T> >& c, std::vector<std::vector<T> >& aux) const;
+
+      std::vector<Node> m_v_nodes; //!< operations in topological order
+      std::vector<int> m_v_outputs; //!< nodes of the components of f
+      int m_n; //!< dimension of the state
+      std::vector<std::string> m_v_var_names; //!< t and the names of the state variables
+
+      std::string m_str; //!< parsed expression
+      size_t m_pos; //!< parsing position
+  };
+}
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ *  TaylorIntegrator class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Tubex
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "tubex_TaylorIntegrator.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TaylorIntegrator::TaylorIntegrator(const TFunction& f)
+    : m_f(f), m_expr(f)
+  {
+
+  }
+
+  void TaylorIntegrator::set_order(int order)
+  {
+    assert(order >= 1);
+    m_order = order;
+  }
+
+  void TaylorIntegrator::set_tolerance(double tolerance)
+  {
+    assert(tolerance > 0.);
+    m_tolerance = tolerance;
+  }
+
+  void TaylorIntegrator::set_max_step(double max_step)
+  {
+    assert(max_step >= 0.);
+    m_max_step = max_step;
+  }
+
+  const TubeVector TaylorIntegrator::integrate(const Interval& tdomain, const IntervalVector& x0, double timestep) const
+  {
+    assert(!tdomain.is_empty() && !tdomain.is_unbounded() && !tdomain.is_degenerated());
+    assert(x0.size() == m_expr.nb_vars());
+    assert(!x0.is_empty() && !x0.is_unbounded());
+    assert(timestep >= 0.);
+
+    int n = x0.size();
+    double t = tdomain.lb();
+
+    // The set of states is represented by c+A*[r], with A orthogonal
+    Vector c = x0.mid();
+    Matrix a = Matrix::eye(n);
+    IntervalVector r = x0 - c;
+    IntervalVector x = x0;
+
+    vector<Interval> v_tdomains;
+    vector<IntervalVector> v_codomains, v_gates(1, x0);
+
+    // Initial step, from the magnitude of the last Taylor coefficient
+    double h = timestep;
+    if(timestep == 0.)
+    {
+      vector<vector<Interval> > v_coeffs;
+      m_expr.ode_coefficients(Interval(t), vector<Interval>(&x0[0], &x0[0] + n), m_order, v_coeffs);
+
+      double mag = 0.;
+      for(int j = 0 ; j < n ; j++)
+        mag = max(mag, v_coeffs[j][m_order].mag());
+      h = mag > 0. ? std::pow(m_tolerance / mag, 1. / m_order) : tdomain.diam();
+    }
+
+    if(m_max_step > 0.)
+      h = min(h, m_max_step);
+    const double h_min = tdomain.diam() * 1e-12;
+
+    while(t < tdomain.ub())
+    {
+      // The last step is extended rather than leaving a tiny slice
+      double t1 = t + h >= tdomain.ub() - 0.01 * h ? tdomain.ub() : t + h;
+      Interval step_tdomain(t, t1);
+      Interval dt = Interval(t1) - Interval(t);
+
+      IntervalVector b(n);
+      if(!a_priori_enclosure(step_tdomain, x, b))
+      {
+        h /= 2.;
+        if(h < h_min)
+          throw Exception("TaylorIntegrator::integrate", "step size too small: the solution may not be defined over tdomain");
+        continue;
+      }
+
+      // Remainder, from the a priori enclosure over the step
+      vector<vector<Interval> > v_rem;
+      m_expr.ode_coefficients(step_tdomain, vector<Interval>(&b[0], &b[0] + n), m_order, v_rem);
+
+      // Expansion at the center of the set
+      vector<vector<Interval> > v_center;
+      m_expr.ode_coefficients(Interval(t), vector<Interval>(&c[0], &c[0] + n), m_order - 1, v_center);
+
+      // Expansion over the set, with derivatives w.r.t. the initial state
+      vector<TaylorDual> v_x;
+      for(int j = 0 ; j < n ; j++)
+        v_x.push_back(TaylorDual(x[j], n, j));
+      vector<vector<TaylorDual> > v_set;
+      m_expr.ode_coefficients(Interval(t), v_x, m_order - 1, v_set);
+
+      IntervalVector v(n, Interval(0.)), range(n, Interval(0.));
+      IntervalMatrix jac(n, n, Interval(0.));
+      Interval dt_p = pow(dt, m_order);
+      double err = 0.;
+
+      for(int j = 0 ; j < n ; j++)
+      {
+        Interval dt_i(1.), tau_i(1.); // dt^i, and [0,dt]^i
+        for(int i = 0 ; i < m_order ; i++)
+        {
+          v[j] += v_center[j][i] * dt_i;
+          range[j] += v_set[j][i].v * tau_i;
+          for(size_t l = 0 ; l < v_set[j][i].d.size() ; l++)
+            jac[j][l] += v_set[j][i].d[l] * dt_i;
+
+          dt_i *= dt;
+          tau_i = Interval(0., dt_i.ub());
+        }
+
+        Interval rem = v_rem[j][m_order] * dt_p;
+        v[j] += rem;
+        range[j] += v_rem[j][m_order] * Interval(0., dt_p.ub());
+        err = max(err, rem.diam());
+      }
+
+      // Lohner's method: x1 = v + (J*A)*[r]
+      IntervalMatrix m = jac * IntervalMatrix(a);
+      IntervalVector x1 = v + m * r;
+      Vector c1 = v.mid();
+
+      Matrix q = qr_orthogonal(m.mid(), r.diam());
+      IntervalMatrix q_inv(n, n);
+
+      if(orthogonal_inverse(q, q_inv))
+      {
+        r = (q_inv * m) * r + q_inv * (v - c1);
+        a = q;
+      }
+
+      else // parallelepiped method
+      {
+        r = x1 - c1;
+        a = Matrix::eye(n);
+      }
+
+      c = c1;
+      x = x1 & (c + IntervalMatrix(a) * r); // both sets enclose the states
+
+      v_tdomains.push_back(step_tdomain);
+      v_codomains.push_back(range & b);
+      v_gates.push_back(x);
+      t = t1;
+
+      // Step size control
+      if(timestep == 0.)
+        h *= err > 0. ? min(2., max(0.5, 0.9 * std::pow(m_tolerance / err, 1. / m_order))) : 2.;
+      else
+        h = timestep;
+
+      if(m_max_step > 0.)
+        h = min(h, m_max_step);
+    }
+
+    TubeVector x_tube(v_tdomains, v_codomains);
+
+    x_tube.set(v_gates[0] & x_tube(v_tdomains[0].lb()), v_tdomains[0].lb());
+    for(size_t k = 0 ; k < v_tdomains.size() ; k++)
+      x_tube.set(v_gates[k + 1] & x_tube(v_tdomains[k].ub()), v_tdomains[k].ub());
+
+    return x_tube;
+  }
+
+  bool TaylorIntegrator::a_priori_enclosure(const Interval& t, const IntervalVector& x, IntervalVector& b) const
+  {
+    int n = x.size();
+    Interval tau(0., (Interval(t.ub()) - Interval(t.lb())).ub());
+
+    IntervalVector tx(n + 1);
+    tx[0] = t;
+    tx.put(1, x);
+    b = x + tau * m_f.eval_vector(tx);
+
+    // Picard-Lindelöf operator: if x+[0,h]*f(t,[b]) is a subset of [b],
+    // then the solutions are defined over t and enclosed in this set
+    for(int k = 0 ; k < 20 && !b.is_unbounded() && !b.is_empty() ; k++)
+    {
+      IntervalVector b_inflated(b);
+      for(int j = 0 ; j < n ; j++)
+        b_inflated[j] += Interval(-1.,1.) * (0.1 * b[j].diam() + 1e-14 * (1. + fabs(b[j].mid())));
+
+      tx.put(1, b_inflated);
+      b = x + tau * m_f.eval_vector(tx);
+
+      if(b.is_subset(b_inflated))
+        return true;
+    }
+
+    return false;
+  }
+
+  bool TaylorIntegrator::orthogonal_inverse(const Matrix& q, IntervalMatrix& q_inv)
+  {
+    // With C=Q^T and E=I-C*Q, Q^{-1}=(I-E)^{-1}*C, where (I-E)^{-1}=I+D
+    // and ||D||_oo <= ||E||_oo/(1-||E||_oo)
+    int n = q.nb_rows();
+    Matrix c = q.transpose();
+    IntervalMatrix e = IntervalMatrix::eye(n) - IntervalMatrix(c) * IntervalMatrix(q);
+
+    double e_norm = 0.;
+    for(int i = 0 ; i < n ; i++)
+    {
+      Interval row_sum(0.);
+      for(int j = 0 ; j < n ; j++)
+        row_sum += Interval(e[i][j].mag());
+      e_norm = max(e_norm, row_sum.ub());
+    }
+
+    if(!(e_norm < 1.))
+      return false;
+
+    Interval d_norm = Interval(e_norm) / (1. - Interval(e_norm));
+    q_inv = IntervalMatrix(c);
+
+    for(int j = 0 ; j < n ; j++)
+    {
+      double c_max = 0.;
+      for(int i = 0 ; i < n ; i++)
+        c_max = max(c_max, fabs(c[i][j]));
+
+      Interval err = Interval(-1.,1.) * (d_norm * c_max).ub();
+      for(int i = 0 ; i < n ; i++)
+        q_inv[i][j] += err;
+    }
+
+    return true;
+  }
+
+  const Matrix TaylorIntegrator::qr_orthogonal(const Matrix& m, const Vector& w)
+  {
+    int n = m.nb_rows();
+
+    // Columns sorted by decreasing weighted norms
+    vector<double> v_norms(n, 0.);
+    for(int j = 0 ; j < n ; j++)
+    {
+      for(int i = 0 ; i < n ; i++)
+        v_norms[j] += m[i][j] * m[i][j];
+      v_norms[j] = std::sqrt(v_norms[j]) * w[j];
+    }
+
+    vector<int> v_perm(n);
+    for(int j = 0 ; j < n ; j++)
+      v_perm[j] = j;
+    stable_sort(v_perm.begin(), v_perm.end(), [&v_norms](int i, int j) { return v_norms[i] > v_norms[j]; });
+
+    vector<vector<double> > r(n, vector<double>(n)), q(n, vector<double>(n, 0.));
+    for(int i = 0 ; i < n ; i++)
+    {
+      q[i][i] = 1.;
+      for(int j = 0 ; j < n ; j++)
+        r[i][j] = m[i][v_perm[j]];
+    }
+
+    // Householder reflections H_k, with Q = H_0*H_1*...
+    for(int k = 0 ; k < n - 1 ; k++)
+    {
+      double norm = 0.;
+      for(int i = k ; i < n ; i++)
+        norm += r[i][k] * r[i][k];
+      norm = std::sqrt(norm);
+      if(norm == 0.)
+        continue;
+
+      vector<double> u(n, 0.);
+      for(int i = k ; i < n ; i++)
+        u[i] = r[i][k];
+      u[k] += r[k][k] >= 0. ? norm : -norm;
+
+      double u_norm = 0.;
+      for(int i = k ; i < n ; i++)
+        u_norm += u[i] * u[i];
+      if(u_norm == 0.)
+        continue;
+
+      for(int j = k ; j < n ; j++)
+      {
+        double s = 0.;
+        for(int i = k ; i < n ; i++)
+          s += u[i] * r[i][j];
+        for(int i = k ; i < n ; i++)
+          r[i][j] -= 2. * s / u_norm * u[i];
+      }
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        double s = 0.;
+        for(int l = k ; l < n ; l++)
+          s += q[i][l] * u[l];
+        for(int l = k ; l < n ; l++)
+          q[i][l] -= 2. * s / u_norm * u[l];
+      }
+    }
+
+    Matrix q_mat(n, n);
+    for(int i = 0 ; i < n ; i++)
+      for(int j = 0 ; j < n ; j++)
+        q_mat[i][j] = q[i][j];
+    return q_mat;
+  }
+}
@@ -0,0 +1,121 @@
+/**
+ *  \file
+ *  TaylorIntegrator class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Tubex
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TAYLORINTEGRATOR_H__
+#define __TUBEX_TAYLORINTEGRATOR_H__
+
+#include "ibex_IntervalVector.h"
+#include "ibex_IntervalMatrix.h"
+#include "tubex_TubeVector.h"
+#include "tubex_TFunction.h"
+#include "tubex_TaylorExpr.h"
+
+namespace tubex
+{
+  /**
+   * \class TaylorIntegrator
+   * \brief Validated integration of \f$\dot{\mathbf{x}}=\mathbf{f}(t,\mathbf{x})\f$
+   *        by Taylor series
+   *
+   * Each step computes an a priori enclosure of the solution (Picard-Lindelöf
+   * operator), then a Taylor expansion whose coefficients are obtained by automatic
+   * differentiation of the expression of \f$\mathbf{f}\f$. The wrapping effect is
+   * controlled by Lohner's QR method: the set of states is represented by
+   * \f$\mathbf{c}+\mathbf{A}[\mathbf{r}]\f$, where \f$\mathbf{A}\f$ is orthogonal.
+   *
+   * Each step provides one slice of the resulting tube, and a gate enclosing
+   * the state at the end of the step.
+   */
+  class TaylorIntegrator
+  {
+    public:
+
+      /**
+       * \brief Creates an integrator of \f$\dot{\mathbf{x}}=\mathbf{f}(t,\mathbf{x})\f$
+       *
+       * \param f TFunction object, with \f$n\f$ variables and an image of dimension \f$n\f$
+       */
+      TaylorIntegrator(const TFunction& f);
+
+      /**
+       * \brief Sets the order of the Taylor expansions
+       *
+       * \param order order (10 by default)
+       */
+      void set_order(int order);
+
+      /**
+       * \brief Sets the width of the Taylor remainder targeted on each step
+       *
+       * The tolerance drives the adaptive step size.
+       *
+       * \param tolerance local tolerance (\f$10^{-10}\f$ by default)
+       */
+      void set_tolerance(double tolerance);
+
+      /**
+       * \brief Bounds the step size of the adaptive integration
+       *
+       * \param max_step largest step, 0 for no bound
+       */
+      void set_max_step(double max_step);
+
+      /**
+       * \brief Computes a tube enclosing the solutions starting from a box
+       *
+       * \param tdomain temporal domain of the integration
+       * \param x0 initial condition, at \f$t_0\f$
+       * \param timestep fixed step, or 0 for an adaptive step size
+       * \return the tube enclosing the solutions
+       */
+      const TubeVector integrate(const ibex::Interval& tdomain, const ibex::IntervalVector& x0, double timestep = 0.) const;
+
+    protected:
+
+      /**
+       * \brief Computes an a priori enclosure of the solutions over a step
+       *
+       * \param t temporal domain of the step
+       * \param x enclosure of the state at \f$t^-\f$
+       * \param b the enclosure, if found
+       * \return `true` in case of success, `false` if the step is too large
+       */
+      bool a_priori_enclosure(const ibex::Interval& t, const ibex::IntervalVector& x, ibex::IntervalVector& b) const;
+
+      /**
+       * \brief Computes an enclosure of the inverse of a nearly orthogonal matrix
+       *
+       * \param q the matrix
+       * \param q_inv the enclosure of \f$\mathbf{Q}^{-1}\f$, if found
+       * \return `true` in case of success
+       */
+      static bool orthogonal_inverse(const ibex::Matrix& q, ibex::IntervalMatrix& q_inv);
+
+      /**
+       * \brief Computes the orthogonal factor of a QR decomposition
+       *
+       * Columns are sorted beforehand by decreasing norms, weighted by `w`.
+       *
+       * \param m the matrix
+       * \param w weights of the columns
+       * \return the orthogonal matrix \f$\mathbf{Q}\f$
+       */
+      static const ibex::Matrix qr_orthogonal(const ibex::Matrix& m, const ibex::Vector& w);
+
+      const TFunction m_f; //!< vector field
+      const TaylorExpr m_expr; //!< computational graph of the vector field
+      int m_order = 10; //!< order of the expansions
+      double m_tolerance = 1e-10; //!< targeted width of the remainders
+      double m_max_step = 0.; //!< bound of the step size (0 for no bound)
+  };
+}
+
+#endif
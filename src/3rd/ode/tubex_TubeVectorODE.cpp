@@ -9,8 +9,13 @@
  */
 
 #include "tubex_TubeVectorODE.h"
+#include "tubex_TaylorIntegrator.h"
 #include "tubex_Exception.h"
 
+#ifdef WITH_CAPD
+#include "tubex_capd2tubex.h"
+#endif
+
 using namespace std;
 using namespace ibex;
 using namespace tubex;
@@ -23,8 +28,13 @@ namespace tubex
   {
     switch(mode)
     {
+#ifdef WITH_CAPD
       case CAPD_MODE:
         return capd2tubex(domain, f, x0, timestep);
+#endif
+
+      case TAYLOR_MODE:
+        return TaylorIntegrator(f).integrate(domain, x0, timestep);
 
       // Additional integration tools might be added in the future
 
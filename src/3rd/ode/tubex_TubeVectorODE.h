@@ -14,15 +14,34 @@
 
 #define DEFAULT_TIMESTEP 0
 #define CAPD_MODE 0
+#define TAYLOR_MODE 1
+
+// CAPD is preferred when available, the in-tree Taylor integrator otherwise
+#ifdef WITH_CAPD
+  #define DEFAULT_ODE_MODE CAPD_MODE
+#else
+  #define DEFAULT_ODE_MODE TAYLOR_MODE
+#endif
 
 #include "tubex_TubeVector.h"
 #include "ibex_IntervalVector.h"
-#include "tubex_capd2tubex.h"
 
 namespace tubex
 {
+  /**
+   * \brief Computes a tube enclosing the solutions of \f$\dot{\mathbf{x}}=\mathbf{f}(t,\mathbf{x})\f$
+   *
+   * \param domain temporal domain of the integration
+   * \param f function to be integrated
+   * \param x0 initial condition
+   * \param timestep fixed time step, or 0 for letting the integrator adapt it
+   * \param mode integration tool: `CAPD_MODE` (only if Tubex has been built with CAPD)
+   *        or `TAYLOR_MODE` (in-tree Taylor integrator, see TaylorIntegrator),
+   *        `DEFAULT_ODE_MODE` by default
+   * \return the tube enclosing the solutions
+   */
   TubeVector TubeVectorODE(const ibex::Interval& domain, const TFunction& f, const ibex::IntervalVector& x0,
-                           double timestep=DEFAULT_TIMESTEP, int mode=CAPD_MODE);
+                           double timestep=DEFAULT_TIMESTEP, int mode=DEFAULT_ODE_MODE);
 
 }
 
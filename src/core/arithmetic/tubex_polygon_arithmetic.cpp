@@ -40,10 +40,10 @@ namespace tubex
 
   const ConvexPolygon operator-(const ConvexPolygon& x)
   {
-    vector<Vector> v_result_pts = x.vertices();
-    for(auto& pt : v_result_pts)
-      pt *= -1.;
-    return ConvexPolygon(v_result_pts, true);
+    VertexArray result_pts(x.vertex_array());
+    for(size_t i = 0 ; i < result_pts.size() ; i++)
+      result_pts.set(i, -result_pts.x(i), -result_pts.y(i));
+    return ConvexPolygon(result_pts, true);
   }
 
   const ConvexPolygon operator-(const ConvexPolygon& x, const IntervalVector& v)
@@ -67,7 +67,180 @@ namespace tubex
     return ConvexPolygon(v_result_thick_pts);
   }
   
-  const ConvexPolygon operator&(const ConvexPolygon& p1, const ConvexPolygon& p2)
+  // Intersection of convex polygons
+
+  // Sign of an interval computed with outward rounding:
+  // -1, 0, 1, or SIGN_UNDEFINED if it cannot be decided
+  static const int SIGN_UNDEFINED = 2;
+
+  static int certain_sign(const Interval& x)
+  {
+    if(x.lb() > 0.)
+      return 1;
+    else if(x.ub() < 0.)
+      return -1;
+    else if(x.lb() == 0. && x.ub() == 0.)
+      return 0;
+    else
+      return SIGN_UNDEFINED;
+  }
+
+  // Twice the signed area of the triangle (a,b,c), positive if c is on the left of (a,b)
+  static const Interval area2(double ax, double ay, double bx, double by, double cx, double cy)
+  {
+    return (Interval(bx) - ax) * (Interval(cy) - ay) - (Interval(by) - ay) * (Interval(cx) - ax);
+  }
+
+  // 1 if the point is inside the convex polygon (counterclockwise),
+  // -1 if it is outside, SIGN_UNDEFINED in case of uncertainty
+  static int inside(const VertexArray& p, double x, double y)
+  {
+    bool uncertain = false;
+    for(size_t i = 0, n = p.size() ; i < n ; i++)
+    {
+      int s = certain_sign(area2(p.x(i), p.y(i), p.x((i+1)%n), p.y((i+1)%n), x, y));
+      if(s == -1)
+        return -1;
+      uncertain |= (s != 1);
+    }
+
+    return uncertain ? SIGN_UNDEFINED : 1;
+  }
+
+  // Crossing of the edges [a1,a] of p and [b1,b] of q: 1 if they properly
+  // cross, 0 if they do not, SIGN_UNDEFINED in case of uncertainty
+  static int crossing(const VertexArray& p, size_t a1, size_t a, const VertexArray& q, size_t b1, size_t b)
+  {
+    const Interval ax = Interval(p.x(a)) - p.x(a1), ay = Interval(p.y(a)) - p.y(a1);
+    const Interval bx = Interval(q.x(b)) - q.x(b1), by = Interval(q.y(b)) - q.y(b1);
+
+    const Interval denom = ax * by - ay * bx;
+    int s_denom = certain_sign(denom);
+    if(s_denom != 1 && s_denom != -1)
+      return s_denom == 0 ? 0 : SIGN_UNDEFINED; // parallel edges, not collinear (checked before)
+
+    // Parameters of the crossing point along each edge
+    const Interval dx = Interval(q.x(b1)) - p.x(a1), dy = Interval(q.y(b1)) - p.y(a1);
+    const Interval s = (dx * by - dy * bx) / denom;
+    const Interval t = (dx * ay - dy * ax) / denom;
+
+    if(s.ub() < 0. || s.lb() > 1. || t.ub() < 0. || t.lb() > 1.)
+      return 0;
+
+    else if(s.lb() > 0. && s.ub() < 1. && t.lb() > 0. && t.ub() < 1.)
+      return 1;
+
+    else
+      return SIGN_UNDEFINED;
+  }
+
+  // Linear-time intersection (J. O'Rourke et al., 1982): the boundaries of the
+  // polygons are traversed together, by advancing on the edge that 'aims' at
+  // the other one. The points of the intersection (vertices inside the other
+  // polygon, crossings of edges) are the same as the ones of the generic method.
+  // Returns false when the configuration is degenerated or when a predicate
+  // cannot be decided: the generic method is then used.
+  static bool linear_intersection(const VertexArray& p, const VertexArray& q, vector<Point>& v_pts)
+  {
+    size_t n = p.size(), m = q.size();
+    if(n < 3 || m < 3)
+      return false;
+
+    // The polygons are expected in counterclockwise order
+    if(certain_sign(area2(p.x(0), p.y(0), p.x(1), p.y(1), p.x(2), p.y(2))) != 1
+      || certain_sign(area2(q.x(0), q.y(0), q.x(1), q.y(1), q.x(2), q.y(2))) != 1)
+      return false;
+
+    enum { UNKNOWN, P_IN, Q_IN } inflag = UNKNOWN;
+    size_t a = 0, b = 0; // current edges: [a-1,a] of p, [b-1,b] of q
+    size_t aa = 0, ba = 0; // number of advances on each polygon
+    bool first_crossing = true;
+
+    do
+    {
+      size_t a1 = (a + n - 1) % n, b1 = (b + m - 1) % m;
+
+      const Interval cross_ab =
+        (Interval(p.x(a)) - p.x(a1)) * (Interval(q.y(b)) - q.y(b1))
+        - (Interval(p.y(a)) - p.y(a1)) * (Interval(q.x(b)) - q.x(b1));
+      int cross = certain_sign(cross_ab);
+      int a_hb = certain_sign(area2(q.x(b1), q.y(b1), q.x(b), q.y(b), p.x(a), p.y(a))); // a in the half-plane of [b1,b]
+      int b_ha = certain_sign(area2(p.x(a1), p.y(a1), p.x(a), p.y(a), q.x(b), q.y(b))); // b in the half-plane of [a1,a]
+
+      if(cross == SIGN_UNDEFINED || a_hb == SIGN_UNDEFINED || a_hb == 0 || b_ha == SIGN_UNDEFINED || b_ha == 0)
+        return false; // degenerated or uncertain configuration
+
+      int code = crossing(p, a1, a, q, b1, b);
+      if(code == SIGN_UNDEFINED)
+        return false;
+
+      if(code == 1)
+      {
+        const Point pt = Edge(Point(p[a1]), Point(p[a])) & Edge(Point(q[b1]), Point(q[b]));
+        if(pt.does_not_exist())
+          return false;
+        v_pts.push_back(pt);
+
+        if(first_crossing)
+        {
+          aa = 0; ba = 0;
+          first_crossing = false;
+        }
+
+        if(a_hb > 0)
+          inflag = P_IN;
+        else if(b_ha > 0)
+          inflag = Q_IN;
+      }
+
+      if(cross == 0 && a_hb < 0 && b_ha < 0)
+      {
+        v_pts.clear();
+        return true; // separated by parallel edges: empty intersection
+      }
+
+      // Advancing on one of the polygons
+      if((cross >= 0 && b_ha > 0) || (cross < 0 && a_hb < 0))
+      {
+        if(inflag == P_IN)
+          v_pts.push_back(Point(p[a]));
+        a = (a + 1) % n; aa++;
+      }
+
+      else
+      {
+        if(inflag == Q_IN)
+          v_pts.push_back(Point(q[b]));
+        b = (b + 1) % m; ba++;
+      }
+
+    } while((aa < n || ba < m) && aa < 2*n && ba < 2*m);
+
+    if(inflag == UNKNOWN) // the boundaries do not cross
+    {
+      int p_in_q = inside(q, p.x(0), p.y(0));
+      int q_in_p = inside(p, q.x(0), q.y(0));
+
+      if(p_in_q == SIGN_UNDEFINED || q_in_p == SIGN_UNDEFINED)
+        return false;
+
+      v_pts.clear();
+
+      if(p_in_q == 1)
+        for(size_t i = 0 ; i < n ; i++)
+          v_pts.push_back(Point(p[i]));
+
+      else if(q_in_p == 1)
+        for(size_t i = 0 ; i < m ; i++)
+          v_pts.push_back(Point(q[i]));
+    }
+
+    return true;
+  }
+
+  // Generic intersection, in O(n*m): vertices enclosed in the other polygon,
+  // and all the intersections of edges, also in degenerated configurations
+  static const ConvexPolygon generic_intersection(const ConvexPolygon& p1, const ConvexPolygon& p2)
   {
     vector<Point> v_pts;
 
@@ -119,6 +292,19 @@ namespace tubex
     return ConvexPolygon(v_pts);
   }
 
+  const ConvexPolygon operator&(const ConvexPolygon& p1, const ConvexPolygon& p2)
+  {
+    vector<Point> v_pts;
+
+    if(!linear_intersection(p1.vertex_array(), p2.vertex_array(), v_pts))
+      return generic_intersection(p1, p2);
+
+    if(v_pts.empty())
+      return ConvexPolygon();
+
+    return ConvexPolygon(v_pts);
+  }
+
   const ConvexPolygon operator&(const IntervalVector& p1, const ConvexPolygon& p2)
   {
     assert(p1.size() == 2 && "other dimensions not supported");
@@ -53,6 +53,7 @@ namespace tubex
 
     m_name = ac.m_name;
     m_ctc_id = ac.m_ctc_id;
+    m_fixedpoint_ratio = ac.m_fixedpoint_ratio;
 
     switch(ac.m_type)
     {
@@ -111,6 +112,49 @@ namespace tubex
     m_active = active;
   }
 
+  float Contractor::fixedpoint_ratio() const
+  {
+    return m_fixedpoint_ratio;
+  }
+
+  void Contractor::set_fixedpoint_ratio(float r)
+  {
+    m_fixedpoint_ratio = r;
+  }
+
+  double Contractor::priority() const
+  {
+    return m_priority;
+  }
+
+  uint64_t Contractor::queue_order() const
+  {
+    return m_queue_order;
+  }
+
+  void Contractor::set_priority(double priority, uint64_t queue_order)
+  {
+    m_priority = priority;
+    m_queue_order = queue_order;
+  }
+
+  double Contractor::yield() const
+  {
+    return m_yield;
+  }
+
+  double Contractor::cost() const
+  {
+    return m_cost;
+  }
+
+  void Contractor::update_stats(double yield, double cost)
+  {
+    // Exponential moving averages: recent contractions prevail
+    m_yield = 0.5 * m_yield + 0.5 * yield;
+    m_cost = m_cost == 0. ? cost : 0.5 * m_cost + 0.5 * cost;
+  }
+
   vector<Domain*>& Contractor::domains()
   {
     return const_cast<vector<Domain*>&>(static_cast<const Contractor&>(*this).domains());
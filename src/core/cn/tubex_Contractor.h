@@ -13,6 +13,7 @@
 #define __TUBEX_CONTRACTOR_H__
 
 #include <vector>
+#include <cstdint>
 #include <functional>
 #include "ibex_Ctc.h"
 #include "tubex_DynCtc.h"
@@ -51,6 +52,17 @@ namespace tubex
       bool is_active() const;
       void set_active(bool active);
 
+      float fixedpoint_ratio() const;
+      void set_fixedpoint_ratio(float r);
+
+      double priority() const;
+      uint64_t queue_order() const;
+      void set_priority(double priority, uint64_t queue_order);
+
+      double yield() const;
+      double cost() const;
+      void update_stats(double yield, double cost);
+
       std::vector<Domain*>& domains();
       const std::vector<Domain*>& domains() const;
 
@@ -68,6 +80,11 @@ namespace tubex
 
       const Type m_type;
       double m_active = true;
+      float m_fixedpoint_ratio = -1.; // negative if the ratio of the CN is used
+      double m_priority = 0.; // scheduling priority, computed when the contractor is queued
+      uint64_t m_queue_order = 0; // insertion order in the queue, FIFO among equal priorities
+      double m_yield = 1.; // recent relative contraction of the domains (optimistic at first)
+      double m_cost = 0.; // recent computation time, in seconds
 
       union
       {
@@ -8,6 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+#include <unordered_map>
 #include "tubex_ContractorNetwork.h"
 #include "tubex_CtcEval.h"
 
@@ -16,11 +20,37 @@ using namespace ibex;
 
 namespace tubex
 {
+  // Returns the first tube involved in a list of domains (or NULL)
+  static const Tube* first_tube(const vector<Domain*>& v_domains)
+  {
+    for(const auto& dom : v_domains)
+    {
+      if(dom->type() == Domain::Type::T_TUBE)
+        return &dom->tube();
+
+      else if(dom->type() == Domain::Type::T_TUBE_VECTOR)
+        return &dom->tube_vector()[0];
+    }
+
+    return NULL;
+  }
+
+  // Returns the contractor linking a tube domain to its slices
+  static Contractor* tube_component_ctc(Domain *dom)
+  {
+    for(auto& ctc : dom->contractors())
+      if(ctc->type() == Contractor::Type::T_COMPONENT && ctc->domains()[0] == dom)
+        return ctc;
+
+    return NULL;
+  }
+
   // Public methods
 
     // Definition
 
     ContractorNetwork::ContractorNetwork()
+      : m_queue_counter(0)
     {
 
     }
@@ -150,91 +180,17 @@ namespace tubex
       // so dynamic variables must share the same slicing
       assert(Domain::dyn_same_slicing(v_domains));
 
-      int n = Domain::total_size(v_domains);
-      if(n % static_ctc.nb_var != 0)
-        cout << "n=" << n << ", static_ctc.nb_var=" << static_ctc.nb_var << endl;
-      assert((n % static_ctc.nb_var == 0) && "invalid total dimension of domains");
-
       // Adding domains to the CN
+      vector<Domain*> v_dom_ptr;
       for(auto& dom : v_domains)
-        add_dom(dom);
-
-      for(int i = 0 ; i < n/static_ctc.nb_var ; i++) // in case we are dealing with array data
-      {
-        int k = 0; // k-th slice
-        int slices_nb = -1; // will be determined during the dowhile loop, if one dyn domain is present
-
-        do
-        {
-          // Creating a vector of pointers to domains
-          vector<Domain*> v_dom_ptr;
-          for(auto& dom : v_domains)
-          {
-            switch(dom.type())
-            {
-              case Domain::Type::T_INTERVAL:
-                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
-              case Domain::Type::T_SLICE:
-                v_dom_ptr.push_back(add_dom(dom));
-                break;
-
-              case Domain::Type::T_INTERVAL_VECTOR:
-                if(n/static_ctc.nb_var == 1) // heterogeneous case
-                {
-                  // todo: ? add the vector itself, or each component as it is now:
-                  for(int j = 0 ; j < dom.interval_vector().size() ; j++)
-                    v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), j)));
-                }
-
-                else // array data case
-                {
-                  assert((dom.interval_vector().size() == n/static_ctc.nb_var) && "wrong vector dimension");
-                  v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), i)));
-                }
-                break;
-
-              case Domain::Type::T_TUBE:
-                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
-                v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube().slice(k)))));
-                slices_nb = dom.tube().nb_slices();
-                break;
-
-              case Domain::Type::T_TUBE_VECTOR:
-                if(n/static_ctc.nb_var == 1) // heterogeneous case
-                {
-                  for(int j = 0 ; j < dom.tube_vector().size() ; j++)
-                    v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[j].slice(k)))));
-                }
-
-                else // array data case
-                {
-                  assert((dom.tube_vector().size() == n/static_ctc.nb_var) && "wrong vector dimension");
-                  v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[i].slice(k)))));
-                }
-
-                slices_nb = dom.tube_vector().nb_slices();
-                break;
-
-              default:
-                assert(false && "unhandled case");
-            }
-          }
-
-          assert((int)v_dom_ptr.size() == static_ctc.nb_var);
-
-          // Creating what would be this new contractor (defined with domains)
-          Contractor ctc(static_ctc, v_dom_ptr);
+        v_dom_ptr.push_back(add_dom(dom));
 
-          // Getting the actual contractor (maybe the same if not already added)
-          Contractor *ctc_ptr = add_ctc(ctc);
-
-          // Linking to the related domains
-          for(auto& dom : v_dom_ptr)
-            dom->add_ctc(ctc_ptr);
+      add_sliced(static_ctc, v_domains, 0);
 
-          k++;
-        } while(k < slices_nb);
-      }
+      // The constraint will be applied on the slices of growing tubes
+      const Tube *x = first_tube(v_dom_ptr);
+      if(x != NULL)
+        m_v_sliced_ctc.push_back({ &static_ctc, NULL, v_dom_ptr, x->tdomain().ub() });
     }
 
     void ContractorNetwork::add(DynCtc& dyn_ctc, const vector<Domain>& v_domains)
@@ -290,54 +246,14 @@ namespace tubex
         assert(Domain::all_dyn(v_domains)); // all domains are slices or tubes or tube vectors
         assert(Domain::dyn_same_slicing(v_domains)); // all domains share same slicing
 
-        vector<const Slice*> v_slices;
-
-        // Vector initialization with first slices of each tube
-        int nb_slices = -1;
+        vector<Domain*> v_dom_ptr;
         for(const auto& dom : v_domains)
-        {
-          add_dom(dom);
-
-          switch(dom.type())
-          {
-            case Domain::Type::T_TUBE:
-            {
-              if(nb_slices == -1)
-                nb_slices = dom.tube().nb_slices();
-
-              v_slices.push_back(dom.tube().first_slice());
-            }
-            break;
-
-            case Domain::Type::T_TUBE_VECTOR:
-            {            
-              for(int j = 0 ; j < dom.tube_vector().size() ; j++)
-              {
-                if(nb_slices == -1)
-                  nb_slices = dom.tube_vector()[j].nb_slices();
-
-                v_slices.push_back(dom.tube_vector()[j].first_slice());
-              }
-            }
-            break;
-
-            default:
-              assert(false && "domain is not a tube or a tube vector");
-          }
-        }
-
-        // Adding each row of slices
-        for(int k = 0 ; k < nb_slices ; k++)
-        {
-          vector<Domain> v_slices_domains;
-          for(size_t i = 0 ; i < v_slices.size() ; i++)
-            v_slices_domains.push_back(Domain(const_cast<Slice&>(*v_slices[i])));
+          v_dom_ptr.push_back(add_dom(dom));
 
-          add(dyn_ctc, v_slices_domains); 
+        add_sliced(dyn_ctc, v_domains, 0);
 
-          for(auto& s : v_slices)
-            s = s->next_slice();
-        }
+        // The constraint will be applied on the slices of growing tubes
+        m_v_sliced_ctc.push_back({ NULL, &dyn_ctc, v_dom_ptr, first_tube(v_dom_ptr)->tdomain().ub() });
       }
 
       else // otherwise, dealing with the inter-temporal constraint as it is
@@ -373,6 +289,314 @@ namespace tubex
       ad->add_data(t, y, *this);
     }
 
+    void ContractorNetwork::register_new_slices()
+    {
+      // New slices of the tube domains
+
+        size_t nb_doms = m_v_domains.size(); // new domains are not browsed
+        for(size_t i = 0 ; i < nb_doms ; i++)
+        {
+          Domain *dom = m_v_domains[i];
+          if(dom->type() != Domain::Type::T_TUBE)
+            continue;
+
+          // Contractor linking the tube to its slices
+          Contractor *ac_component = tube_component_ctc(dom);
+          assert(ac_component != NULL);
+          Domain *last_registered_dom = ac_component->domains().back();
+          const Slice *last_registered = &last_registered_dom->slice();
+
+          Slice *s = dom->tube().last_slice();
+          if(s == last_registered)
+            continue; // no new slice
+
+          while(s->prev_slice() != last_registered)
+          {
+            s = s->prev_slice();
+            assert(s != NULL && "new slices must be appended at the end of the tube");
+          }
+
+          Domain *prev_dom = last_registered_dom;
+          for( ; s != NULL ; s = s->next_slice())
+          {
+            // Dependencies tube <-> slice
+            Domain *dom_s = add_dom(Domain(*s));
+            ac_component->domains().push_back(dom_s);
+            dom_s->add_ctc(ac_component);
+
+            // Dependencies slice <-> slice
+            Contractor *ac_component_slices = add_ctc(Contractor(Contractor::Type::T_COMPONENT, {prev_dom, dom_s}));
+            prev_dom->add_ctc(ac_component_slices);
+            dom_s->add_ctc(ac_component_slices);
+            prev_dom = dom_s;
+          }
+
+          // The output gate of the previous last slice is now shared
+          for(auto& ctc : last_registered_dom->contractors())
+            if(!ctc->is_active())
+            {
+              ctc->set_active(true);
+              add_ctc_to_queue(ctc, m_deque);
+            }
+        }
+
+      // Constraints broken down to the slices level
+
+        for(size_t i = 0 ; i < m_v_sliced_ctc.size() ; i++)
+        {
+          const Tube *x = first_tube(m_v_sliced_ctc[i].v_domains);
+
+          int nb_new_slices = 0;
+          for(const Slice *s = x->last_slice() ; s != NULL && s->tdomain().lb() >= m_v_sliced_ctc[i].t_end ; s = s->prev_slice())
+            nb_new_slices++;
+
+          if(nb_new_slices == 0)
+            continue;
+
+          vector<Domain> v_domains;
+          for(const auto& dom : m_v_sliced_ctc[i].v_domains)
+            v_domains.push_back(*dom);
+
+          int first_slice_id = x->nb_slices() - nb_new_slices;
+          if(m_v_sliced_ctc[i].static_ctc != NULL)
+            add_sliced(*m_v_sliced_ctc[i].static_ctc, v_domains, first_slice_id);
+          else
+            add_sliced(*m_v_sliced_ctc[i].dyn_ctc, v_domains, first_slice_id);
+
+          m_v_sliced_ctc[i].t_end = x->tdomain().ub();
+        }
+    }
+
+    void ContractorNetwork::drop_front_slices(double t)
+    {
+      // Slices to be removed
+
+        unordered_set<const Slice*> set_slices;
+        vector<Tube*> v_tubes;
+
+        for(auto& dom : m_v_domains)
+          if(dom->type() == Domain::Type::T_TUBE)
+          {
+            assert(t < dom->tube().tdomain().ub() && "at least one slice must remain");
+            v_tubes.push_back(&dom->tube());
+            for(const Slice *s = dom->tube().first_slice() ; s->tdomain().ub() <= t ; s = s->next_slice())
+              set_slices.insert(s);
+          }
+
+        if(set_slices.empty())
+          return;
+
+      // Removing the related domains and contractors from the graph
+
+        remove_slices(set_slices);
+
+      // Then, removing the slices from the tubes
+
+        for(auto& x : v_tubes)
+          x->drop_front_slices(t);
+    }
+
+    int ContractorNetwork::adapt_slicing(const SlicingController& ctrl)
+    {
+      // Tube domains, and their derivatives if known by the graph
+
+        vector<Domain*> v_tube_doms;
+        for(auto& dom : m_v_domains)
+          if(dom->type() == Domain::Type::T_TUBE)
+            v_tube_doms.push_back(dom);
+
+        map<const Tube*,const Tube*> map_deriv;
+        for(const auto& p : m_domains_related_to_ctcderiv)
+        {
+          if(p.first->type() == Domain::Type::T_TUBE)
+            map_deriv[&p.first->tube()] = &p.second->tube();
+
+          else if(p.first->type() == Domain::Type::T_TUBE_VECTOR)
+            for(int i = 0 ; i < p.first->tube_vector().size() ; i++)
+              map_deriv[&p.first->tube_vector()[i]] = &p.second->tube_vector()[i];
+        }
+
+      // Tubes sharing the same slicing are adapted together
+
+        vector<vector<Tube*> > v_groups;
+        for(auto& dom : v_tube_doms)
+        {
+          Tube *x = &dom->tube();
+          auto it = find_if(v_groups.begin(), v_groups.end(),
+            [x](const vector<Tube*>& v_x) { return Tube::same_slicing(*v_x[0], *x); });
+
+          if(it == v_groups.end())
+            v_groups.push_back(vector<Tube*>(1, x));
+          else
+            it->push_back(x);
+        }
+
+        int nb_changes = 0;
+        unordered_set<const Tube*> set_changed_tubes;
+        unordered_set<const Slice*> set_modified; // split slices, or enlarged by a merge
+
+        for(auto& v_x : v_groups)
+        {
+          vector<const Tube*> v_cx(v_x.begin(), v_x.end()), v_cv;
+          for(const auto& x : v_cx)
+            v_cv.push_back(map_deriv.find(x) != map_deriv.end() ? map_deriv[x] : NULL);
+
+          vector<double> v_split_t, v_merge_t;
+          ctrl.plan(v_cx, v_cv, v_split_t, v_merge_t);
+          if(v_split_t.empty() && v_merge_t.empty())
+            continue;
+
+          // The slices removed by merges are first removed from the graph
+          unordered_set<const Slice*> set_removed;
+          for(const auto& x : v_cx)
+          {
+            size_t i_split = 0, i_merge = 0;
+            for(const Slice *s = x->first_slice() ; s != NULL ; s = s->next_slice())
+            {
+              if(i_merge < v_merge_t.size() && s->tdomain().lb() == v_merge_t[i_merge])
+              {
+                set_removed.insert(s);
+                set_modified.insert(s->prev_slice());
+                i_merge++;
+              }
+
+              else if(i_split < v_split_t.size() && s->tdomain().interior_contains(v_split_t[i_split]))
+              {
+                set_modified.insert(s);
+                i_split++;
+              }
+            }
+
+            set_changed_tubes.insert(x);
+          }
+
+          for(const auto& s : set_removed)
+            set_modified.erase(s);
+
+          remove_slices(set_removed);
+          SlicingController::apply(v_x, v_split_t, v_merge_t);
+          nb_changes += v_split_t.size() + v_merge_t.size();
+        }
+
+        if(nb_changes == 0)
+          return 0;
+
+      // Links tube <-> slices and slice <-> slice
+
+        unordered_map<const Slice*,Domain*> map_slice_doms;
+        for(auto& dom : m_v_domains)
+          if(dom->type() == Domain::Type::T_SLICE)
+            map_slice_doms[&dom->slice()] = dom;
+
+        auto is_new = [&](const Slice *s) -> bool { return map_slice_doms.find(s) == map_slice_doms.end(); };
+
+        vector<Domain*> v_triggered_doms;
+        unordered_set<const Slice*> set_new;
+
+        for(auto& dom : v_tube_doms)
+        {
+          if(set_changed_tubes.find(&dom->tube()) == set_changed_tubes.end())
+            continue;
+
+          Contractor *ac_component = tube_component_ctc(dom);
+          assert(ac_component != NULL);
+          vector<Domain*>& v_doms = ac_component->domains();
+          v_doms.resize(1); // the tube itself, then its slices
+
+          Domain *prev_dom = NULL;
+          bool prev_changed = false;
+
+          for(Slice *s = dom->tube().first_slice() ; s != NULL ; s = s->next_slice())
+          {
+            Domain *dom_s;
+            bool changed = true;
+
+            if(is_new(s))
+            {
+              // Dependencies tube <-> slice
+              dom_s = add_dom(Domain(*s));
+              dom_s->add_ctc(ac_component);
+              set_new.insert(s);
+            }
+
+            else
+            {
+              dom_s = map_slice_doms[s];
+              changed = set_modified.find(s) != set_modified.end();
+            }
+
+            v_doms.push_back(dom_s);
+            if(changed)
+              v_triggered_doms.push_back(dom_s);
+
+            // Dependencies slice <-> slice, for the new gates
+            if(prev_dom != NULL && (changed || prev_changed))
+            {
+              Contractor *ac_component_slices = add_ctc(Contractor(Contractor::Type::T_COMPONENT, {prev_dom, dom_s}));
+
+              for(auto& dom_i : { prev_dom, dom_s })
+                if(find(dom_i->contractors().begin(), dom_i->contractors().end(), ac_component_slices)
+                  == dom_i->contractors().end())
+                  dom_i->add_ctc(ac_component_slices);
+            }
+
+            prev_dom = dom_s;
+            prev_changed = changed;
+          }
+        }
+
+      // Constraints broken down to the slices level, applied on the new slices
+
+        for(auto& sliced_ctc : m_v_sliced_ctc)
+        {
+          const Tube *x = first_tube(sliced_ctc.v_domains);
+          if(set_changed_tubes.find(x) == set_changed_tubes.end())
+            continue;
+
+          vector<Domain> v_domains;
+          for(const auto& dom : sliced_ctc.v_domains)
+            v_domains.push_back(*dom);
+
+          // Each sequence of consecutive new slices
+          int k = 0, first_new_id = -1;
+          for(const Slice *s = x->first_slice() ; ; s = s->next_slice(), k++)
+          {
+            bool new_slice = s != NULL && set_new.find(s) != set_new.end();
+
+            if(new_slice && first_new_id == -1)
+              first_new_id = k;
+
+            else if(!new_slice && first_new_id != -1)
+            {
+              if(sliced_ctc.static_ctc != NULL)
+                add_sliced(*sliced_ctc.static_ctc, v_domains, first_new_id, k-1);
+              else
+                add_sliced(*sliced_ctc.dyn_ctc, v_domains, first_new_id, k-1);
+              first_new_id = -1;
+            }
+
+            if(s == NULL)
+              break;
+          }
+        }
+
+      // Only the contractors related to new or modified slices are activated
+
+        for(auto& dom : v_triggered_doms)
+        {
+          for(auto& ctc : dom->contractors())
+            if(!ctc->is_active())
+            {
+              ctc->set_active(true);
+              add_ctc_to_queue(ctc, m_deque);
+            }
+
+          dom->set_volume(dom->compute_volume());
+        }
+
+      return nb_changes;
+    }
+
   // Protected methods
 
     Domain* ContractorNetwork::add_dom(const Domain& ad)
@@ -388,6 +612,10 @@ namespace tubex
         Domain *dom = new Domain(ad);
         m_v_domains.push_back(dom);
 
+        // The saved volume is the reference of the next contractions,
+        // so that the first one of this domain is propagated
+        dom->set_volume(dom->compute_volume());
+
       // And add possible dependencies
 
         switch(dom->type())
@@ -475,4 +703,190 @@ namespace tubex
       add_ctc_to_queue(ctc, m_deque);
       return ctc;
     }
+
+    void ContractorNetwork::remove_slices(const unordered_set<const Slice*>& set_slices)
+    {
+      if(set_slices.empty())
+        return;
+
+      // Related domains and contractors
+
+        unordered_set<Domain*> set_doms;
+        for(auto& dom : m_v_domains)
+          if(dom->type() == Domain::Type::T_SLICE && set_slices.find(&dom->slice()) != set_slices.end())
+            set_doms.insert(dom);
+
+        auto removed_dom = [&](Domain *dom) -> bool { return set_doms.find(dom) != set_doms.end(); };
+
+        unordered_set<Contractor*> set_ctc;
+        for(auto& ctc : m_v_ctc)
+        {
+          vector<Domain*>& v_ctc_doms = ctc->domains();
+
+          // The contractors linking tubes to their slices are kept
+          if(ctc->type() == Contractor::Type::T_COMPONENT && v_ctc_doms[0]->type() == Domain::Type::T_TUBE)
+            v_ctc_doms.erase(remove_if(v_ctc_doms.begin(), v_ctc_doms.end(), removed_dom), v_ctc_doms.end());
+
+          else if(any_of(v_ctc_doms.begin(), v_ctc_doms.end(), removed_dom))
+            set_ctc.insert(ctc);
+        }
+
+        auto removed_ctc = [&](Contractor *ctc) -> bool { return set_ctc.find(ctc) != set_ctc.end(); };
+
+      // Removing them from the graph
+
+        for(auto& dom : m_v_domains)
+          if(!removed_dom(dom))
+            dom->contractors().erase(remove_if(dom->contractors().begin(), dom->contractors().end(), removed_ctc),
+                                     dom->contractors().end());
+
+        m_deque.erase(remove_if(m_deque.begin(), m_deque.end(), removed_ctc), m_deque.end());
+        if(m_scheduling != Scheduling::STACK)
+          make_heap(m_deque.begin(), m_deque.end(), lower_priority);
+        m_v_ctc.erase(remove_if(m_v_ctc.begin(), m_v_ctc.end(), removed_ctc), m_v_ctc.end());
+        m_v_domains.erase(remove_if(m_v_domains.begin(), m_v_domains.end(), removed_dom), m_v_domains.end());
+
+        for(auto& ctc : set_ctc)
+          delete ctc;
+        for(auto& dom : set_doms)
+          delete dom;
+    }
+
+    void ContractorNetwork::add_sliced(Ctc& static_ctc, const vector<Domain>& v_domains, int first_slice_id, int last_slice_id)
+    {
+      int n = Domain::total_size(v_domains);
+      if(n % static_ctc.nb_var != 0)
+        cout << "n=" << n << ", static_ctc.nb_var=" << static_ctc.nb_var << endl;
+      assert((n % static_ctc.nb_var == 0) && "invalid total dimension of domains");
+
+      for(int i = 0 ; i < n/static_ctc.nb_var ; i++) // in case we are dealing with array data
+      {
+        int k = first_slice_id; // k-th slice
+        int slices_nb = -1; // will be determined during the dowhile loop, if one dyn domain is present
+
+        do
+        {
+          // Creating a vector of pointers to domains
+          vector<Domain*> v_dom_ptr;
+          for(auto& dom : v_domains)
+          {
+            switch(dom.type())
+            {
+              case Domain::Type::T_INTERVAL:
+                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
+              case Domain::Type::T_SLICE:
+                v_dom_ptr.push_back(add_dom(dom));
+                break;
+
+              case Domain::Type::T_INTERVAL_VECTOR:
+                if(n/static_ctc.nb_var == 1) // heterogeneous case
+                {
+                  // todo: ? add the vector itself, or each component as it is now:
+                  for(int j = 0 ; j < dom.interval_vector().size() ; j++)
+                    v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), j)));
+                }
+
+                else // array data case
+                {
+                  assert((dom.interval_vector().size() == n/static_ctc.nb_var) && "wrong vector dimension");
+                  v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), i)));
+                }
+                break;
+
+              case Domain::Type::T_TUBE:
+                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
+                v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube().slice(k)))));
+                slices_nb = dom.tube().nb_slices();
+                break;
+
+              case Domain::Type::T_TUBE_VECTOR:
+                if(n/static_ctc.nb_var == 1) // heterogeneous case
+                {
+                  for(int j = 0 ; j < dom.tube_vector().size() ; j++)
+                    v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[j].slice(k)))));
+                }
+
+                else // array data case
+                {
+                  assert((dom.tube_vector().size() == n/static_ctc.nb_var) && "wrong vector dimension");
+                  v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[i].slice(k)))));
+                }
+
+                slices_nb = dom.tube_vector().nb_slices();
+                break;
+
+              default:
+                assert(false && "unhandled case");
+            }
+          }
+
+          assert((int)v_dom_ptr.size() == static_ctc.nb_var);
+
+          // Creating what would be this new contractor (defined with domains)
+          Contractor ctc(static_ctc, v_dom_ptr);
+
+          // Getting the actual contractor (maybe the same if not already added)
+          Contractor *ctc_ptr = add_ctc(ctc);
+
+          // Linking to the related domains
+          for(auto& dom : v_dom_ptr)
+            dom->add_ctc(ctc_ptr);
+
+          k++;
+        } while(k < slices_nb && (last_slice_id == -1 || k <= last_slice_id));
+      }
+    }
+
+    void ContractorNetwork::add_sliced(DynCtc& dyn_ctc, const vector<Domain>& v_domains, int first_slice_id, int last_slice_id)
+    {
+      vector<const Slice*> v_slices;
+
+      // Vector initialization with the first slices of the rows
+      int nb_slices = -1;
+      for(const auto& dom : v_domains)
+      {
+        switch(dom.type())
+        {
+          case Domain::Type::T_TUBE:
+          {
+            if(nb_slices == -1)
+              nb_slices = dom.tube().nb_slices();
+
+            v_slices.push_back(dom.tube().slice(first_slice_id));
+          }
+          break;
+
+          case Domain::Type::T_TUBE_VECTOR:
+          {            
+            for(int j = 0 ; j < dom.tube_vector().size() ; j++)
+            {
+              if(nb_slices == -1)
+                nb_slices = dom.tube_vector()[j].nb_slices();
+
+              v_slices.push_back(dom.tube_vector()[j].slice(first_slice_id));
+            }
+          }
+          break;
+
+          default:
+            assert(false && "domain is not a tube or a tube vector");
+        }
+      }
+
+      // Adding each row of slices
+      if(last_slice_id != -1)
+        nb_slices = min(nb_slices, last_slice_id + 1);
+
+      for(int k = first_slice_id ; k < nb_slices ; k++)
+      {
+        vector<Domain> v_slices_domains;
+        for(size_t i = 0 ; i < v_slices.size() ; i++)
+          v_slices_domains.push_back(Domain(const_cast<Slice&>(*v_slices[i])));
+
+        add(dyn_ctc, v_slices_domains); 
+
+        for(auto& s : v_slices)
+          s = s->next_slice();
+      }
+    }
 }
\ No newline at end of file
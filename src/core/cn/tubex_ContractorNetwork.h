@@ -13,12 +13,17 @@
 #define __TUBEX_CONTRACTORNETWORK_H__
 
 #include <deque>
+#include <atomic>
+#include <functional>
 #include <initializer_list>
+#include <unordered_set>
+#include <unordered_map>
 #include "ibex_Ctc.h"
 #include "tubex_DynCtc.h"
 #include "tubex_Domain.h"
 #include "tubex_Contractor.h"
 #include "tubex_CtcDeriv.h"
+#include "tubex_SlicingController.h"
 
 namespace ibex
 {
@@ -32,6 +37,17 @@ namespace tubex
   class DynCtc;
   class CtcDeriv;
 
+  /**
+   * \enum Scheduling
+   * \brief Specifies the order in which the active contractors of a ContractorNetwork are processed
+   */
+  enum class Scheduling
+  {
+    STACK, ///< contractors are stacked, component contractors being queued last (default)
+    YIELD_PER_COST, ///< contractors of highest recent contraction per unit of computation time first
+    DOMAIN_WEIGHT ///< AC-3 with domain weights: contractors of the most contracted domains first
+  };
+
   /**
    * \class ContractorNetwork
    * \brief Graph of contractors and domains that model a problem in the constraint
@@ -220,6 +236,41 @@ namespace tubex
        */
       void add_data(TubeVector& x, double t, const ibex::IntervalVector& y);
 
+      /**
+       * \brief Registers the slices that have been appended to the tubes of the graph (growing tubes)
+       *
+       * See Tube::push_back_slice(). The new slices are added as domains, and the constraints
+       * previously added on whole tubes, that have been broken down to the slices level, are
+       * applied on them. Only the contractors related to the new slices and to the previous
+       * last slices are activated, so that the next contraction is limited to the affected
+       * time window.
+       */
+      void register_new_slices();
+
+      /**
+       * \brief Removes the first slices of the tubes of the graph, defined before \f$t\f$ (sliding horizon)
+       *
+       * The related slice domains and the contractors applied on them are removed
+       * from the graph, then the slices are removed from the tubes.
+       *
+       * \param t the temporal key (must be lower than the upper bound of the tubes tdomains)
+       */
+      void drop_front_slices(double t);
+
+      /**
+       * \brief Adapts the slicing of the tubes of the graph, between two contractions
+       *
+       * Tubes sharing the same slicing are adapted together, so that the constraints
+       * broken down to the slices level remain valid. Derivatives known by the graph
+       * (see CtcDeriv) are taken into account by the controller. The slice domains and
+       * the contractors are then updated: only the contractors related to new or
+       * modified slices are activated for the next contraction.
+       *
+       * \param ctrl the slicing controller
+       * \return the number of changes (splits and merges)
+       */
+      int adapt_slicing(const SlicingController& ctrl);
+
       /// @}
       /// \name Contraction process
       /// @{
@@ -229,6 +280,12 @@ namespace tubex
        *
        * Contractions are performed until a fixed point has been reached on the whole graph.
        *
+       * The process is incremental: only the contractors added since the last call, or
+       * related to domains contracted meanwhile, are in the queue. With a fixed point
+       * ratio of 0 (see set_fixedpoint_ratio()), the fixed point reached after adding
+       * new constraints is the one a contraction from scratch of the whole graph would
+       * reach, provided that the contractors are monotonic.
+       *
        * \param verbose verbose mode, `false` by default
        * \return the computation time in seconds
        */
@@ -264,6 +321,69 @@ namespace tubex
        */
       void set_fixedpoint_ratio(float r);
 
+      /**
+       * \brief Sets a fixed point ratio specific to a static contractor
+       *
+       * The contractor is triggered when one of its domains has been contracted
+       * by more than this ratio. This allows to call less often contractors that
+       * are expensive, or that yield poor contractions.
+       *
+       * \param ctc static contractor (inherited from Ctc), already added to the graph
+       * \param r ratio of contraction, \f$r\in[0,1]\f$
+       */
+      void set_fixedpoint_ratio(ibex::Ctc& ctc, float r);
+
+      /**
+       * \brief Sets a fixed point ratio specific to a dynamic contractor
+       *
+       * See set_fixedpoint_ratio(ibex::Ctc&, float).
+       *
+       * \param ctc dynamic contractor (inherited from DynCtc), already added to the graph
+       * \param r ratio of contraction, \f$r\in[0,1]\f$
+       */
+      void set_fixedpoint_ratio(DynCtc& ctc, float r);
+
+      /**
+       * \brief Sets the policy ordering the queue of active contractors
+       *
+       * The fixed point does not depend on the policy (provided that the contractors
+       * are monotonic and that the ratios are 0), only the time to reach it.
+       *
+       * \param policy scheduling policy (Scheduling::STACK by default)
+       */
+      void set_scheduling(Scheduling policy);
+
+      /**
+       * \brief Sets the number of threads available to the contractors of the graph
+       *
+       * Contractors that can run in parallel and that follow the global setting
+       * (see DynCtc::set_nb_threads(), with 0 threads) use the pool of the library,
+       * see Executor. This setting overrides the global one during the contractions
+       * of this graph.
+       *
+       * \param nb_threads number of threads (0 for the global setting, 1 for sequential contractions)
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Enables the contraction of the graph by time windows
+       *
+       * The temporal domain of the tubes is split into \f$K\f$ windows. The contractors
+       * that are local to a window (reentrant contractors on slices, such as CtcDeriv, see
+       * DynCtc::is_reentrant()) are processed by propagations restricted to each window,
+       * the windows being contracted in parallel. Contractions reaching the gates at the
+       * interface of two windows, and the other contractors (on whole tubes, such as CtcEval,
+       * or static ones), are then processed sequentially, before a new parallel pass, and so
+       * on until a fixed point is reached.
+       *
+       * Only the order of the contractions differs from the monolithic process: the fixed
+       * point is the same, under the conditions given in contract(). Two neighbouring windows
+       * are never contracted at the same time, since they share a gate.
+       *
+       * \param nb_windows number of windows \f$K\f$ (1 for a monolithic contraction, by default)
+       */
+      void set_time_windows(int nb_windows);
+
       /**
        * \brief Triggers on all contractors involved in the graph.
        *
@@ -272,6 +392,19 @@ namespace tubex
        */
       void trigger_all_contractors();
 
+      /**
+       * \brief Triggers on the contractors related to a domain that has been updated
+       *        externally: outside the ContractorNetwork.
+       *
+       * This is the incremental alternative to trigger_all_contractors(): earlier contractions
+       * remain valid and only the zone of influence of the update is propagated.
+       * Note that contractors and domains added to the graph are automatically queued,
+       * so that new observations do not require this call.
+       *
+       * \param dom the updated domain, that must be part of the graph
+       */
+      void trigger_contractors(Domain dom);
+
       /**
        * \brief Returns the number of contractors that are waiting for process.
        *
@@ -281,6 +414,35 @@ namespace tubex
        */
       int nb_ctc_in_stack() const;
 
+      /// @}
+      /// \name Checkpoints
+      /// @{
+
+      /**
+       * \brief Saves the state of the contraction process in a binary file
+       *
+       * The checkpoint contains the current values of the domains and their saved
+       * volumes, the activation flags of the contractors and the queue of active
+       * contractors. A long contraction can then be resumed with restore_checkpoint().
+       *
+       * \param binary_file_name name of the output file
+       */
+      void save_checkpoint(const std::string& binary_file_name) const;
+
+      /**
+       * \brief Restores the state of the contraction process from a binary file
+       *
+       * The network must have been built in the same way as the one that has been
+       * saved: same domains and contractors, added in the same order, and tubes
+       * with the same slicing. An exception is thrown otherwise, or if the file is
+       * truncated: the file is entirely read before any modification, so that the
+       * network is then left unchanged. Domains are updated in place, so that
+       * references held outside the network remain valid.
+       *
+       * \param binary_file_name name of the file created by save_checkpoint()
+       */
+      void restore_checkpoint(const std::string& binary_file_name);
+
       /// @}
       /// \name Visualization
       /// @{
@@ -361,21 +523,118 @@ namespace tubex
        */
       Contractor* add_ctc(const Contractor& ac);
 
+      /**
+       * \brief Adds a static contractor on the rows of slices of the domains, from a given slice index
+       *
+       * \param static_ctc ibex::Ctc contractor object
+       * \param v_domains a vector of abstract domains
+       * \param first_slice_id index of the first row of slices
+       * \param last_slice_id index of the last row of slices (-1 for the last slices of the tubes)
+       */
+      void add_sliced(ibex::Ctc& static_ctc, const std::vector<Domain>& v_domains, int first_slice_id, int last_slice_id = -1);
+
+      /**
+       * \brief Adds a non inter-temporal dynamic contractor on the rows of slices of the domains, from a given slice index
+       *
+       * \param dyn_ctc DynCtc contractor object
+       * \param v_domains a vector of tube domains
+       * \param first_slice_id index of the first row of slices
+       * \param last_slice_id index of the last row of slices (-1 for the last slices of the tubes)
+       */
+      void add_sliced(DynCtc& dyn_ctc, const std::vector<Domain>& v_domains, int first_slice_id, int last_slice_id = -1);
+
+      /**
+       * \brief Removes slice domains from the graph, together with the contractors applied on them
+       *
+       * The contractors linking tubes to their slices are kept. The slices themselves
+       * are not removed from the tubes.
+       *
+       * \param set_slices the slices to be removed
+       */
+      void remove_slices(const std::unordered_set<const Slice*>& set_slices);
+
       /**
        * \brief Adds a Contractor object in the queue of active contractors
        *
+       * With Scheduling::STACK, the queue is a double-ended queue. With the other
+       * policies, it is a binary heap whose top is the back of the deque (see lower_priority()).
+       * The priority of a contractor is computed when it is queued, and is not updated
+       * afterwards, even if the yields or the weights of the domains evolve in the meantime.
+       *
        * \param ac Contractor to be added
        * \param ctc_deque queue of contractors
        */
       void add_ctc_to_queue(Contractor *ac, std::deque<Contractor*>& ctc_deque);
 
+      /**
+       * \brief Removes the next Contractor object to be processed from a queue of active contractors
+       *
+       * \param ctc_deque non-empty queue of contractors, see add_ctc_to_queue()
+       * \return the contractor
+       */
+      Contractor* pop_ctc_from_queue(std::deque<Contractor*>& ctc_deque) const;
+
+      /**
+       * \brief Order of the heaps of active contractors
+       *
+       * Contractors of same priority are processed in FIFO order.
+       *
+       * \param a first Contractor object
+       * \param b second Contractor object
+       * \return `true` if `a` is processed after `b`
+       */
+      static bool lower_priority(const Contractor *a, const Contractor *b);
+
+      /**
+       * \brief Computes the scheduling priority of a contractor, according to the policy
+       *
+       * \param ac Contractor object
+       * \return the priority, the highest is processed first
+       */
+      double priority(const Contractor *ac) const;
+
       /**
        * \brief Triggers on the contractors related to the given Domain
        *
        * \param dom pointer to the Domain
        * \param ctc_to_avoid optional pointer to a Contractor to not activate
+       * \return the relative contraction of the domain since its last update, in \f$[0,1]\f$
        */
-      void trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = NULL);
+      double trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = NULL);
+
+      /**
+       * \brief Computes the time windows of the contractors of the graph
+       *
+       * \param nb_windows number of windows of equal length
+       * \return the index of the window of each local contractor, other contractors
+       *         (processed sequentially) being not in the map
+       */
+      const std::unordered_map<const Contractor*,int> time_windows(int nb_windows) const;
+
+      /**
+       * \brief Launches the contraction process by time windows, see set_time_windows()
+       *
+       * \param elapsed_time function returning the computation time since the call to contract()
+       */
+      void contract_time_windows(const std::function<double()>& elapsed_time);
+
+      /**
+       * \brief Triggers on the contractors related to the given Domain, during the contraction of a time window
+       *
+       * Contractors of the window are queued in the local queue, the others are deferred to
+       * the sequential part of the process, without modifying their state.
+       *
+       * \param dom pointer to the Domain, that belongs to the window
+       * \param ctc_to_avoid pointer to a Contractor to not activate
+       * \param window index of the window
+       * \param map_windows windows of the local contractors, see time_windows()
+       * \param ctc_deque queue of the window
+       * \param v_deferred contractors to be processed after the contraction of the windows
+       * \return the relative contraction of the domain since its last update, in \f$[0,1]\f$
+       */
+      double trigger_ctc_in_window(Domain *dom, Contractor *ctc_to_avoid, int window,
+                                 const std::unordered_map<const Contractor*,int>& map_windows,
+                                 std::deque<Contractor*>& ctc_deque, std::vector<Contractor*>& v_deferred);
 
     protected:
 
@@ -385,10 +644,27 @@ namespace tubex
 
       float m_fixedpoint_ratio = 0.0001; //!< fixed point ratio for propagation limit
       double m_contraction_duration_max = std::numeric_limits<double>::infinity(); //!< computation time limit
+      int m_nb_threads = 0; //!< number of threads available to the contractors (0 for the global setting)
+      Scheduling m_scheduling = Scheduling::STACK; //!< policy ordering the queue of active contractors
+      std::atomic<uint64_t> m_queue_counter; //!< number of insertions in the heaps of active contractors
+      int m_nb_time_windows = 1; //!< number of time windows contracted in parallel (1 for a monolithic process)
 
       CtcDeriv *m_ctc_deriv = NULL; //!< optional pointer to a CtcDeriv object that can be automatically added in the graph
       std::list<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv;
 
+      /**
+       * \brief Constraint applied on each row of slices, to be extended on growing tubes
+       */
+      struct SlicedCtc
+      {
+        ibex::Ctc *static_ctc; //!< static contractor, or NULL
+        DynCtc *dyn_ctc; //!< dynamic contractor, or NULL
+        std::vector<Domain*> v_domains; //!< pointers to the domains of the graph, as given when adding the constraint
+        double t_end; //!< upper bound of the last row of slices on which the constraint has been applied
+      };
+
+      std::vector<SlicedCtc> m_v_sliced_ctc; //!< constraints broken down to the slices level
+
       friend class Domain;
   };
 }
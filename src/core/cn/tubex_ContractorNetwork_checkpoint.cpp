@@ -0,0 +1,291 @@
+/**
+ *  ContractorNetwork class : checkpoints
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+#include "tubex_ContractorNetwork.h"
+#include "tubex_serialize_intervals.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Version number of the checkpoint files, for compliance purposes
+  static const short int CHECKPOINT_VERSION = 2;
+
+  static void throw_checkpoint_error(const string& msg)
+  {
+    throw Exception("ContractorNetwork::restore_checkpoint()", msg);
+  }
+
+  // Slices of the domains of the network, in a deterministic order: a slice
+  // shared by several domains (its tube, its tube vector, itself) is listed once
+  static vector<Slice*> network_slices(const vector<Domain*>& v_domains)
+  {
+    vector<Slice*> v_slices;
+    unordered_set<const Slice*> set_slices;
+
+    auto add_slice = [&](Slice *s)
+    {
+      if(set_slices.insert(s).second)
+        v_slices.push_back(s);
+    };
+
+    for(Domain *dom : v_domains)
+      switch(dom->type())
+      {
+        case Domain::Type::T_SLICE:
+          add_slice(&dom->slice());
+          break;
+
+        case Domain::Type::T_TUBE:
+          for(Slice *s = dom->tube().first_slice() ; s != NULL ; s = s->next_slice())
+            add_slice(s);
+          break;
+
+        case Domain::Type::T_TUBE_VECTOR:
+          for(int i = 0 ; i < dom->tube_vector().size() ; i++)
+            for(Slice *s = dom->tube_vector()[i].first_slice() ; s != NULL ; s = s->next_slice())
+              add_slice(s);
+          break;
+
+        default:
+          break;
+      }
+
+    return v_slices;
+  }
+
+  // Size of a domain, checked at restoration: number of components
+  // of vectors, number of slices of tubes
+  static int domain_size(const Domain *dom)
+  {
+    switch(dom->type())
+    {
+      case Domain::Type::T_INTERVAL_VECTOR:
+        return dom->interval_vector().size();
+
+      case Domain::Type::T_TUBE:
+        return dom->tube().nb_slices();
+
+      case Domain::Type::T_TUBE_VECTOR:
+        return dom->tube_vector().size();
+
+      default:
+        return 1;
+    }
+  }
+
+  // Public methods
+
+    // Checkpoints
+
+    void ContractorNetwork::save_checkpoint(const string& binary_file_name) const
+    {
+      ofstream bin_file(binary_file_name.c_str(), ios::out | ios::binary);
+
+      if(!bin_file.is_open())
+        throw Exception("ContractorNetwork::save_checkpoint()", "error while writing file \"" + binary_file_name + "\"");
+
+      bin_file.write((const char*)&CHECKPOINT_VERSION, sizeof(short int));
+
+      // Shape of the network
+      vector<Slice*> v_slices = network_slices(m_v_domains);
+      int nb_dom = m_v_domains.size(), nb_ctc = m_v_ctc.size(), nb_slices = v_slices.size();
+      bin_file.write((const char*)&nb_dom, sizeof(int));
+      bin_file.write((const char*)&nb_ctc, sizeof(int));
+      bin_file.write((const char*)&nb_slices, sizeof(int));
+
+      // Domains: static values and saved volumes, the values
+      // of the slices being written once, afterwards
+      for(const Domain *dom : m_v_domains)
+      {
+        char type = (char)dom->type();
+        bin_file.write((const char*)&type, sizeof(char));
+
+        int size = domain_size(dom);
+        bin_file.write((const char*)&size, sizeof(int));
+
+        double volume = dom->get_saved_volume();
+        bin_file.write((const char*)&volume, sizeof(double));
+
+        if(dom->type() == Domain::Type::T_INTERVAL)
+          serialize_Interval(bin_file, dom->interval());
+
+        else if(dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+          for(int i = 0 ; i < size ; i++)
+            serialize_Interval(bin_file, dom->interval_vector()[i]);
+      }
+
+      // Slices
+      for(const Slice *s : v_slices)
+      {
+        serialize_Interval(bin_file, s->tdomain());
+        serialize_Interval(bin_file, s->input_gate());
+        serialize_Interval(bin_file, s->codomain());
+        serialize_Interval(bin_file, s->output_gate());
+      }
+
+      // Activation flags
+      unordered_map<const Contractor*,int> map_ctc_id;
+      for(int i = 0 ; i < nb_ctc ; i++)
+      {
+        map_ctc_id[m_v_ctc[i]] = i;
+        char active = m_v_ctc[i]->is_active() ? 1 : 0;
+        bin_file.write((const char*)&active, sizeof(char));
+      }
+
+      // Queue of active contractors, in their order of processing
+      deque<Contractor*> ctc_deque(m_deque);
+      int deque_size = ctc_deque.size();
+      bin_file.write((const char*)&deque_size, sizeof(int));
+      while(!ctc_deque.empty())
+      {
+        int id = map_ctc_id[pop_ctc_from_queue(ctc_deque)];
+        bin_file.write((const char*)&id, sizeof(int));
+      }
+
+      bin_file.close();
+    }
+
+    void ContractorNetwork::restore_checkpoint(const string& binary_file_name)
+    {
+      ifstream bin_file(binary_file_name.c_str(), ios::in | ios::binary);
+
+      if(!bin_file.is_open())
+        throw_checkpoint_error("error while reading file \"" + binary_file_name + "\"");
+
+      short int version_number;
+      bin_file.read((char*)&version_number, sizeof(short int));
+      if(!bin_file || version_number != CHECKPOINT_VERSION)
+        throw_checkpoint_error("checkpoint version number not supported");
+
+      // The whole file is read and checked before any modification
+      // of the network, that is left unchanged in case of error
+
+      // Shape of the network
+
+        vector<Slice*> v_slices = network_slices(m_v_domains);
+        int nb_dom, nb_ctc, nb_slices;
+        bin_file.read((char*)&nb_dom, sizeof(int));
+        bin_file.read((char*)&nb_ctc, sizeof(int));
+        bin_file.read((char*)&nb_slices, sizeof(int));
+
+        if(!bin_file || nb_dom != (int)m_v_domains.size() || nb_ctc != (int)m_v_ctc.size()
+          || nb_slices != (int)v_slices.size())
+          throw_checkpoint_error("the network differs from the checkpoint");
+
+      // Domains
+
+        vector<double> v_volumes(nb_dom);
+        vector<vector<Interval> > v_values(nb_dom); // static values
+
+        for(int k = 0 ; k < nb_dom ; k++)
+        {
+          const Domain *dom = m_v_domains[k];
+
+          char type;
+          int size;
+          bin_file.read((char*)&type, sizeof(char));
+          bin_file.read((char*)&size, sizeof(int));
+          bin_file.read((char*)&v_volumes[k], sizeof(double));
+          if(!bin_file)
+            throw_checkpoint_error("unexpected end of file");
+          if(type != (char)dom->type() || size != domain_size(dom))
+            throw_checkpoint_error("the network differs from the checkpoint");
+
+          if(dom->type() == Domain::Type::T_INTERVAL || dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+          {
+            v_values[k].resize(size);
+            for(int i = 0 ; i < size ; i++)
+              deserialize_Interval(bin_file, v_values[k][i]);
+          }
+        }
+
+      // Slices
+
+        vector<Interval> v_slice_values(3*nb_slices); // input gate, codomain, output gate
+        for(int i = 0 ; i < nb_slices ; i++)
+        {
+          Interval tdomain;
+          deserialize_Interval(bin_file, tdomain);
+          for(int j = 0 ; j < 3 ; j++)
+            deserialize_Interval(bin_file, v_slice_values[3*i+j]);
+
+          if(!bin_file)
+            throw_checkpoint_error("unexpected end of file");
+          if(tdomain != v_slices[i]->tdomain())
+            throw_checkpoint_error("the slicing of a tube differs from the checkpoint");
+        }
+
+      // Activation flags
+
+        vector<char> v_active(nb_ctc);
+        if(nb_ctc > 0)
+          bin_file.read(v_active.data(), nb_ctc * sizeof(char));
+
+      // Queue of active contractors
+
+        int deque_size;
+        bin_file.read((char*)&deque_size, sizeof(int));
+        if(!bin_file || deque_size < 0 || deque_size > nb_ctc)
+          throw_checkpoint_error("unexpected end of file");
+
+        vector<int> v_deque_ids(deque_size);
+        for(int& id : v_deque_ids)
+        {
+          bin_file.read((char*)&id, sizeof(int));
+          if(!bin_file || id < 0 || id >= nb_ctc)
+            throw_checkpoint_error("unexpected end of file");
+        }
+
+      bin_file.close();
+
+      // Updating the network, in place: references to
+      // the domains held outside the network remain valid
+
+        for(int k = 0 ; k < nb_dom ; k++)
+        {
+          Domain *dom = m_v_domains[k];
+
+          if(dom->type() == Domain::Type::T_INTERVAL)
+            dom->interval() = v_values[k][0];
+
+          else if(dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+            for(size_t i = 0 ; i < v_values[k].size() ; i++)
+              dom->interval_vector()[i] = v_values[k][i];
+
+          dom->set_volume(v_volumes[k]);
+        }
+
+        for(int i = 0 ; i < nb_slices ; i++)
+        {
+          v_slices[i]->set_envelope(v_slice_values[3*i+1], false);
+          v_slices[i]->set_input_gate(v_slice_values[3*i], false);
+          v_slices[i]->set_output_gate(v_slice_values[3*i+2], false);
+        }
+
+        for(int i = 0 ; i < nb_ctc ; i++)
+          m_v_ctc[i]->set_active(v_active[i] != 0);
+
+        m_deque.clear();
+        for(int id : v_deque_ids)
+        {
+          // Priorities are not saved: they are computed again
+          if(m_scheduling == Scheduling::STACK)
+            m_deque.push_back(m_v_ctc[id]);
+          else
+            add_ctc_to_queue(m_v_ctc[id], m_deque);
+        }
+    }
+}
@@ -8,8 +8,11 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
+#include <chrono>
+#include <algorithm>
 #include "tubex_ContractorNetwork.h"
+#include "tubex_Executor.h"
+#include "tubex_Exception.h"
 
 using namespace std;
 using namespace ibex;
@@ -22,7 +25,12 @@ namespace tubex
 
     double ContractorNetwork::contract(bool verbose)
     {
-      clock_t t_start = clock();
+      // Elapsed time, rather than processor time that also counts the threads of the contractors
+      chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+      auto elapsed_time = [&t_start]() -> double
+        { return chrono::duration<double>(chrono::steady_clock::now() - t_start).count(); };
+
+      Executor::ScopedNbThreads scope(m_nb_threads);
 
       if(verbose)
       {
@@ -34,25 +42,42 @@ namespace tubex
         cout << endl;
       }
 
-      while(!m_deque.empty()
-        && (double)(clock() - t_start)/CLOCKS_PER_SEC < m_contraction_duration_max)
+      if(m_nb_time_windows > 1)
+        contract_time_windows(elapsed_time);
+
+      else while(!m_deque.empty() && elapsed_time() < m_contraction_duration_max)
       {
-        Contractor *ctc = m_deque.front();
-        m_deque.pop_front();
+        Contractor *ctc = pop_ctc_from_queue(m_deque);
 
-        ctc->contract();
-        ctc->set_active(false);
+        if(m_scheduling == Scheduling::YIELD_PER_COST)
+        {
+          chrono::steady_clock::time_point t_ctc = chrono::steady_clock::now();
+          ctc->contract();
+          double cost = chrono::duration<double>(chrono::steady_clock::now() - t_ctc).count();
+          ctc->set_active(false);
+
+          double yield = 0.;
+          for(auto& ctc_dom : ctc->domains())
+            yield += trigger_ctc_related_to_dom(ctc_dom, ctc);
+          ctc->update_stats(yield / ctc->domains().size(), cost);
+        }
 
-        for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
+        else
         {
-          // If the domain has "changed" after the contraction
-          trigger_ctc_related_to_dom(ctc_dom, ctc);
+          ctc->contract();
+          ctc->set_active(false);
+
+          for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
+          {
+            // If the domain has "changed" after the contraction
+            trigger_ctc_related_to_dom(ctc_dom, ctc);
+          }
         }
       }
 
       if(verbose)
         cout << endl
-             << "  computation time: " << (double)(clock() - t_start)/CLOCKS_PER_SEC << "s" << endl;
+             << "  computation time: " << elapsed_time() << "s" << endl;
 
       // Emptiness test
       // todo: test only contracted domains?
@@ -64,7 +89,7 @@ namespace tubex
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return elapsed_time();
     }
 
     double ContractorNetwork::contract_during(double dt, bool verbose)
@@ -82,6 +107,65 @@ namespace tubex
       m_fixedpoint_ratio = r;
     }
 
+    void ContractorNetwork::set_fixedpoint_ratio(Ctc& ctc, float r)
+    {
+      assert(Interval(0.,1).contains(r) && "invalid ratio");
+
+      #ifndef NDEBUG
+        bool contractor_found = false;
+      #endif
+
+      for(const auto& added_ctc: m_v_ctc)
+        if(added_ctc->type() == Contractor::Type::T_IBEX && &added_ctc->ibex_ctc() == &ctc)
+        {
+          added_ctc->set_fixedpoint_ratio(r);
+          #ifndef NDEBUG
+            contractor_found = true;
+          #endif
+        }
+
+      assert(contractor_found);
+    }
+
+    void ContractorNetwork::set_fixedpoint_ratio(DynCtc& ctc, float r)
+    {
+      assert(Interval(0.,1).contains(r) && "invalid ratio");
+
+      #ifndef NDEBUG
+        bool contractor_found = false;
+      #endif
+
+      for(const auto& added_ctc: m_v_ctc)
+        if(added_ctc->type() == Contractor::Type::T_TUBEX && &added_ctc->tubex_ctc() == &ctc)
+        {
+          added_ctc->set_fixedpoint_ratio(r);
+          #ifndef NDEBUG
+            contractor_found = true;
+          #endif
+        }
+
+      assert(contractor_found);
+    }
+
+    void ContractorNetwork::set_scheduling(Scheduling policy)
+    {
+      // The current queue is ordered according to the new policy,
+      // from its current order of processing
+      vector<Contractor*> v_ctc;
+      while(!m_deque.empty())
+        v_ctc.push_back(pop_ctc_from_queue(m_deque));
+
+      m_scheduling = policy;
+      for(auto& ctc : v_ctc)
+        add_ctc_to_queue(ctc, m_deque);
+    }
+
+    void ContractorNetwork::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0);
+      m_nb_threads = nb_threads;
+    }
+
     void ContractorNetwork::trigger_all_contractors()
     {
       m_deque.clear();
@@ -93,6 +177,30 @@ namespace tubex
       }
     }
 
+    void ContractorNetwork::trigger_contractors(Domain dom)
+    {
+      for(auto& dom_ptr : m_v_domains)
+        if(*dom_ptr == dom)
+        {
+          deque<Contractor*> ctc_deque;
+
+          for(auto& ctc : dom_ptr->contractors())
+            if(!ctc->is_active())
+            {
+              ctc->set_active(true);
+              add_ctc_to_queue(ctc, m_scheduling == Scheduling::STACK ? ctc_deque : m_deque);
+            }
+
+          for(auto& c : ctc_deque)
+            m_deque.push_front(c);
+
+          dom_ptr->set_volume(dom_ptr->compute_volume());
+          return;
+        }
+
+      throw Exception("ContractorNetwork::trigger_contractors()", "the domain is not part of the graph");
+    }
+
     int ContractorNetwork::nb_ctc_in_stack() const
     {
       return m_deque.size();
@@ -104,30 +212,99 @@ namespace tubex
     {
       // todo: propagate for EQUALITY contractors even in case of poor contractions?
 
-      if(ac->type() == Contractor::Type::T_COMPONENT)
-        ctc_deque.push_back(ac);
+      switch(m_scheduling)
+      {
+        case Scheduling::STACK:
+          if(ac->type() == Contractor::Type::T_COMPONENT)
+            ctc_deque.push_back(ac);
+
+          else
+            ctc_deque.push_front(ac); // priority
+          break;
+
+        default:
+          // Binary heap: O(log n) per activation
+          ac->set_priority(priority(ac), m_queue_counter++);
+          ctc_deque.push_back(ac);
+          push_heap(ctc_deque.begin(), ctc_deque.end(), lower_priority);
+      }
+    }
+
+    Contractor* ContractorNetwork::pop_ctc_from_queue(deque<Contractor*>& ctc_deque) const
+    {
+      assert(!ctc_deque.empty());
+      Contractor *ctc;
+
+      if(m_scheduling == Scheduling::STACK)
+      {
+        ctc = ctc_deque.front();
+        ctc_deque.pop_front();
+      }
 
       else
-        ctc_deque.push_front(ac); // priority
+      {
+        pop_heap(ctc_deque.begin(), ctc_deque.end(), lower_priority); // top moved to the back
+        ctc = ctc_deque.back();
+        ctc_deque.pop_back();
+      }
+
+      return ctc;
+    }
+
+    bool ContractorNetwork::lower_priority(const Contractor *a, const Contractor *b)
+    {
+      return a->priority() < b->priority()
+        || (a->priority() == b->priority() && a->queue_order() > b->queue_order());
+    }
+
+    double ContractorNetwork::priority(const Contractor *ac) const
+    {
+      switch(m_scheduling)
+      {
+        case Scheduling::YIELD_PER_COST:
+          // New contractors (optimistic yield, no cost yet) are processed first
+          return ac->yield() / (ac->cost() + 1e-7);
+
+        case Scheduling::DOMAIN_WEIGHT:
+        {
+          double w = 0.;
+          for(const auto& dom : ac->domains())
+            w += dom->weight();
+          return w / ac->domains().size();
+        }
+
+        default:
+          return 0.;
+      }
     }
 
-    void ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
+    double ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
     {
       double current_volume = dom->compute_volume(); // new volume after contraction
+      double ratio = current_volume/dom->get_saved_volume();
+
+      // NaN ratios (unbounded or degenerated domains) are not considered as contractions
+      double contraction = ratio < 1. ? 1. - ratio : 0.;
 
-      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio)
+      if(contraction > 0.)
       {
+        dom->add_weight(contraction);
+
         // We activate each contractor related to these domains, according to graph orientation
 
         // Local deque, for specific order related to this domain
         deque<Contractor*> ctc_deque;
 
-        for(auto& ctc_of_dom : dom->contractors()) 
-          if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
+        for(auto& ctc_of_dom : dom->contractors())
+        {
+          float r = ctc_of_dom->fixedpoint_ratio() < 0. ? m_fixedpoint_ratio : ctc_of_dom->fixedpoint_ratio();
+
+          if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active() && ratio < 1.-r)
           {
             ctc_of_dom->set_active(true);
-            add_ctc_to_queue(ctc_of_dom, ctc_deque);
+            add_ctc_to_queue(ctc_of_dom, m_scheduling == Scheduling::STACK ? ctc_deque : m_deque);
           }
+        }
 
         // Merging this local deque in the CN one
         for(auto& c : ctc_deque)
@@ -135,5 +312,6 @@ namespace tubex
       }
       
       dom->set_volume(current_volume); // updating old volume
+      return contraction;
     }
-}
\ No newline at end of file
+}
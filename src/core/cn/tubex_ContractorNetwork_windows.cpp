@@ -0,0 +1,254 @@
+/**
+ *  ContractorNetwork class : contraction by time windows
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <algorithm>
+#include "tubex_ContractorNetwork.h"
+#include "tubex_Executor.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Public methods
+
+    // Contraction process
+
+    void ContractorNetwork::set_time_windows(int nb_windows)
+    {
+      assert(nb_windows > 0);
+      m_nb_time_windows = nb_windows;
+    }
+
+  // Protected methods
+
+    const unordered_map<const Contractor*,int> ContractorNetwork::time_windows(int nb_windows) const
+    {
+      assert(nb_windows > 0);
+      unordered_map<const Contractor*,int> map_windows;
+
+      // Temporal domain covered by the slices of the graph
+
+        Interval tdomain = Interval::EMPTY_SET;
+        for(const auto& dom : m_v_domains)
+          if(dom->type() == Domain::Type::T_SLICE)
+            tdomain |= dom->slice().tdomain();
+
+        if(tdomain.is_empty() || tdomain.is_degenerated())
+          return map_windows;
+
+        auto window = [&](const Domain *dom) -> int
+        {
+          int w = (int)(nb_windows * (dom->slice().tdomain().lb() - tdomain.lb()) / tdomain.diam());
+          return min(max(w, 0), nb_windows - 1);
+        };
+
+      // Contractors that may be local: reentrant ones on slices,
+      // and the components linking two consecutive slices
+
+        vector<pair<const Contractor*,pair<int,int> > > v_candidates; // contractor, first and last windows
+
+        for(const auto& ctc : m_v_ctc)
+        {
+          if(ctc->type() == Contractor::Type::T_TUBEX && !ctc->tubex_ctc().is_reentrant())
+            continue;
+
+          if(ctc->type() != Contractor::Type::T_TUBEX && ctc->type() != Contractor::Type::T_COMPONENT)
+            continue;
+
+          int w_min = nb_windows, w_max = -1;
+          bool slices_only = true;
+
+          for(const auto& dom : ctc->domains())
+          {
+            if(dom->type() != Domain::Type::T_SLICE)
+            {
+              slices_only = false;
+              break;
+            }
+
+            w_min = min(w_min, window(dom));
+            w_max = max(w_max, window(dom));
+          }
+
+          if(slices_only)
+            v_candidates.push_back(make_pair(ctc, make_pair(w_min, w_max)));
+        }
+
+      // Two windows sharing data must be consecutive: windows linked by a
+      // contractor over more than two windows (e.g. large slices) are merged
+
+        vector<bool> v_first(nb_windows, true); // if true, the window starts a new group
+        for(const auto& c : v_candidates)
+          if(c.second.second - c.second.first > 1)
+            for(int w = c.second.first + 1 ; w <= c.second.second ; w++)
+              v_first[w] = false;
+
+        vector<int> v_group(nb_windows);
+        for(int w = 0, g = -1 ; w < nb_windows ; w++)
+        {
+          if(v_first[w])
+            g++;
+          v_group[w] = g;
+        }
+
+      // Local contractors: the ones inside a group of windows,
+      // contractors at the interface of two groups are processed sequentially
+
+        for(const auto& c : v_candidates)
+          if(v_group[c.second.first] == v_group[c.second.second])
+            map_windows[c.first] = v_group[c.second.first];
+
+      return map_windows;
+    }
+
+    void ContractorNetwork::contract_time_windows(const function<double()>& elapsed_time)
+    {
+      const unordered_map<const Contractor*,int> map_windows = time_windows(m_nb_time_windows);
+
+      int nb_windows = 0;
+      for(const auto& it : map_windows)
+        nb_windows = max(nb_windows, it.second + 1);
+
+      vector<deque<Contractor*> > v_deques(nb_windows); // active contractors of each window
+      vector<vector<Contractor*> > v_deferred(nb_windows); // contractors triggered from each window
+
+      bool pending = true;
+      while(pending && elapsed_time() < m_contraction_duration_max)
+      {
+        // Sequential part: contractors that are not local to a window,
+        // the local ones being dispatched in the queues of their windows
+
+          while(!m_deque.empty() && elapsed_time() < m_contraction_duration_max)
+          {
+            Contractor *ctc = pop_ctc_from_queue(m_deque);
+
+            auto it = map_windows.find(ctc);
+            if(it != map_windows.end())
+            {
+              add_ctc_to_queue(ctc, v_deques[it->second]); // remains active
+              continue;
+            }
+
+            chrono::steady_clock::time_point t_ctc = chrono::steady_clock::now();
+            ctc->contract();
+            ctc->set_active(false);
+
+            double yield = 0.;
+            for(auto& ctc_dom : ctc->domains())
+              yield += trigger_ctc_related_to_dom(ctc_dom, ctc);
+
+            if(m_scheduling == Scheduling::YIELD_PER_COST)
+              ctc->update_stats(yield / ctc->domains().size(),
+                chrono::duration<double>(chrono::steady_clock::now() - t_ctc).count());
+          }
+
+        // Parallel part: windows of even indexes, then the odd ones,
+        // so that two neighbouring windows (that share gates) are not
+        // contracted at the same time
+
+          for(int parity = 0 ; parity < 2 ; parity++)
+            Executor::global().parallel_for(0, (nb_windows + 1 - parity) / 2,
+              [&](size_t i, int)
+              {
+                int w = 2 * i + parity;
+                deque<Contractor*>& ctc_deque = v_deques[w];
+
+                while(!ctc_deque.empty() && elapsed_time() < m_contraction_duration_max)
+                {
+                  Contractor *ctc = pop_ctc_from_queue(ctc_deque);
+
+                  chrono::steady_clock::time_point t_ctc = chrono::steady_clock::now();
+                  ctc->contract();
+                  ctc->set_active(false);
+
+                  double yield = 0.;
+                  for(auto& ctc_dom : ctc->domains())
+                    yield += trigger_ctc_in_window(ctc_dom, ctc, w, map_windows, ctc_deque, v_deferred[w]);
+
+                  if(m_scheduling == Scheduling::YIELD_PER_COST)
+                    ctc->update_stats(yield / ctc->domains().size(),
+                      chrono::duration<double>(chrono::steady_clock::now() - t_ctc).count());
+                }
+              },
+              m_nb_threads);
+
+        // Contractors triggered from the windows, in a deterministic order
+
+          pending = false;
+          for(int w = 0 ; w < nb_windows ; w++)
+          {
+            for(auto& ctc : v_deferred[w])
+              if(!ctc->is_active())
+              {
+                ctc->set_active(true);
+                add_ctc_to_queue(ctc, m_deque);
+              }
+
+            v_deferred[w].clear();
+            pending |= !v_deques[w].empty();
+          }
+
+          pending |= !m_deque.empty();
+      }
+
+      // Contractors still active (time limit reached) are kept in the
+      // queue of the graph, for next calls
+
+        for(int w = 0 ; w < nb_windows ; w++)
+          while(!v_deques[w].empty())
+            add_ctc_to_queue(pop_ctc_from_queue(v_deques[w]), m_deque);
+    }
+
+    double ContractorNetwork::trigger_ctc_in_window(Domain *dom, Contractor *ctc_to_avoid, int window,
+                                                    const unordered_map<const Contractor*,int>& map_windows,
+                                                    deque<Contractor*>& ctc_deque, vector<Contractor*>& v_deferred)
+    {
+      // Same propagation as in trigger_ctc_related_to_dom(), the state of the
+      // contractors outside the window being left unchanged
+
+      double current_volume = dom->compute_volume(); // new volume after contraction
+      double ratio = current_volume/dom->get_saved_volume();
+      double contraction = ratio < 1. ? 1. - ratio : 0.;
+
+      if(contraction > 0.)
+      {
+        dom->add_weight(contraction);
+        deque<Contractor*> local_deque;
+
+        for(auto& ctc_of_dom : dom->contractors())
+        {
+          float r = ctc_of_dom->fixedpoint_ratio() < 0. ? m_fixedpoint_ratio : ctc_of_dom->fixedpoint_ratio();
+          if(ctc_of_dom == ctc_to_avoid || !(ratio < 1.-r))
+            continue;
+
+          auto it = map_windows.find(ctc_of_dom);
+          if(it != map_windows.end() && it->second == window)
+          {
+            if(!ctc_of_dom->is_active())
+            {
+              ctc_of_dom->set_active(true);
+              add_ctc_to_queue(ctc_of_dom, m_scheduling == Scheduling::STACK ? local_deque : ctc_deque);
+            }
+          }
+
+          else if(v_deferred.empty() || v_deferred.back() != ctc_of_dom)
+            v_deferred.push_back(ctc_of_dom);
+        }
+
+        for(auto& c : local_deque)
+          ctc_deque.push_front(c);
+      }
+
+      dom->set_volume(current_volume);
+      return contraction;
+    }
+}
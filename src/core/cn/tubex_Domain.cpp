@@ -215,6 +215,7 @@ namespace tubex
   const Domain& Domain::operator=(const Domain& ad)
   {
     m_volume = ad.m_volume;
+    m_weight = ad.m_weight;
     m_v_ctc = ad.m_v_ctc;
     m_name = ad.m_name;
     m_dom_id = ad.m_dom_id;
@@ -480,6 +481,16 @@ namespace tubex
     m_volume = vol;
   }
 
+  double Domain::weight() const
+  {
+    return m_weight;
+  }
+
+  void Domain::add_weight(double w)
+  {
+    m_weight += w;
+  }
+
   bool Domain::is_empty() const
   {
     switch(m_type)
@@ -78,6 +78,8 @@ namespace tubex
       double compute_volume() const;
       double get_saved_volume() const;
       void set_volume(double vol);
+      double weight() const;
+      void add_weight(double w);
 
       bool is_empty() const;
       
@@ -155,6 +157,7 @@ namespace tubex
 
       std::vector<Contractor*> m_v_ctc;
       double m_volume = 0.;
+      double m_weight = 0.; // accumulated relative contractions, for scheduling
 
       std::string m_name;
       int m_dom_id;
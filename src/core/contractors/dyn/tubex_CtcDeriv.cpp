@@ -11,6 +11,8 @@
 #include "tubex_CtcDeriv.h"
 #include "tubex_ConvexPolygon.h"
 #include "tubex_Domain.h"
+#include "tubex_Executor.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
@@ -20,7 +22,7 @@ namespace tubex
   CtcDeriv::CtcDeriv()
     : DynCtc(false)
   {
-
+    m_reentrant = true; // slices are contracted without side effects on the object
   }
   
   void CtcDeriv::contract(vector<Domain*>& v_domains)
@@ -100,12 +102,14 @@ namespace tubex
     assert(x.tdomain() == v.tdomain());
     assert(TubeVector::same_slicing(x, v));
 
-    for(int i = 0 ; i < x.size() ; i++)
-      contract(x[i], v[i], t_propa);
+    // The components are independent: they are contracted in parallel
+    Executor::global().parallel_for(0, x.size(),
+      [&](size_t i, int) { contract(x[i], v[i], t_propa); }, m_nb_threads);
   }
 
   void CtcDeriv::contract(Slice& x, const Slice& v, TimePropag t_propa)
   {
+    TUBEX_PERF_KERNEL(CTC_DERIV_SLICE);
     assert(x.tdomain() == v.tdomain());
     #ifndef NDEBUG
       double volume = x.volume() + v.volume(); // for last assert
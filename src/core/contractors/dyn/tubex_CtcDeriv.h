@@ -63,6 +63,8 @@ namespace tubex
        *
        * \pre \f$[\mathbf{x}](\cdot)\f$ and \f$[\mathbf{v}](\cdot)\f$ must share the same dimension, slicing and tdomain.
        *
+       * \note The components can be contracted in parallel, see DynCtc::set_nb_threads().
+       *
        * \param x the n-dimensional tube \f$[\mathbf{x}](\cdot)\f$
        * \param v the n-dimensional derivative tube \f$[\mathbf{v}](\cdot)\f$
        * \param t_propa an optional temporal way of propagation
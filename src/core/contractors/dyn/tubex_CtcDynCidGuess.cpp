@@ -5,7 +5,10 @@
  *  \authors  	Victor Reyes
  */
 #include "tubex_CtcDynCidGuess.h"
+#include "tubex_TFunction.h"
+#include "tubex_Executor.h"
 #include <deque>
+#include <exception>
 
 using namespace std;
 using namespace ibex;
@@ -125,7 +128,12 @@ namespace tubex
 			v.set_envelope(fnc.eval_vector(envelope)[pos]);
 	}
 
-	void CtcDynCidGuess::ctc_fwd(Slice &x, Slice &v, std::vector<Slice> x_slice, std::vector<Slice> v_slice, int pos)
+	void CtcDynCidGuess::ctc_fwd(Slice &x, Slice &v, const std::vector<Slice>& x_slice, const std::vector<Slice>& v_slice, int pos)
+	{
+		ctc_fwd(fnc, x, v, x_slice, pos);
+	}
+
+	void CtcDynCidGuess::ctc_fwd(const TFnc& f, Slice &x, Slice &v, const std::vector<Slice>& x_slice, int pos)
 	{
 		/*envelope*/
 		IntervalVector envelope(x_slice.size()+1);
@@ -138,7 +146,7 @@ namespace tubex
 				envelope[i+1] = x_slice[i].codomain();
 		}
 
-		v.set_envelope(fnc.eval_vector(envelope)[pos]);
+		v.set_envelope(f.eval_vector(envelope)[pos]);
 	}
 
 	double CtcDynCidGuess::get_prec()
@@ -182,6 +190,29 @@ namespace tubex
 	void CtcDynCidGuess::set_dpolicy(int d_policy){
 				this->d_policy = d_policy;
 	}
+
+	void CtcDynCidGuess::set_max_corners(int max_corners){
+		assert(max_corners > 0);
+		this->max_corners = max_corners;
+	}
+
+	int CtcDynCidGuess::get_max_corners(){
+		return this->max_corners;
+	}
+
+	void CtcDynCidGuess::set_corners_sampling(int sampling){
+		assert(sampling == 0 || sampling == 1);
+		this->corners_sampling = sampling;
+	}
+
+	int CtcDynCidGuess::get_corners_sampling(){
+		return this->corners_sampling;
+	}
+
+	int CtcDynCidGuess::get_nb_threads(){
+		return m_nb_threads;
+	}
+
 	void CtcDynCidGuess::set_variant(int variant){
 		if (variant==0){
 			this->set_propagation_engine(0);
@@ -219,47 +250,6 @@ namespace tubex
 		}
 	}
 
-	std::vector<std::vector<double>> CtcDynCidGuess::cart_product (const std::vector<std::vector<double>>& v) {
-		std::vector<std::vector<double>> s = {{}};
-	    for (const auto& u : v) {
-	        vector<vector<double>> r;
-	        for (const auto& x : s) {
-	            for (const auto y : u) {
-	                r.push_back(x);
-	                r.back().push_back(y);
-	            }
-	        }
-	        s = move(r);
-	    }
-	    return s;
-	}
-
-	void CtcDynCidGuess::create_corners(std::vector<Slice> x_slices, std::vector< std::vector<double> > & points, TimePropag t_propa){
-
-		std::vector< std::vector<double> > aux_points;
-		//for each dimension, obtain the corresponding corners
-		if (t_propa & TimePropag::FORWARD){
-			for (int i=0 ; i < x_slices.size() ; i++){
-				vector<double> aux;
-				aux.clear();
-				aux.push_back(x_slices[i].input_gate().lb());
-				aux.push_back(x_slices[i].input_gate().ub());
-				aux_points.push_back(aux);
-			}
-		}
-		else if(t_propa & TimePropag::BACKWARD){
-			for (int i=0 ; i < x_slices.size() ; i++){
-				vector<double> aux;
-				aux.clear();
-				aux.push_back(x_slices[i].output_gate().lb());
-				aux.push_back(x_slices[i].output_gate().ub());
-				aux_points.push_back(aux);
-			}
-		}
-		//create the 2n corners
-		points = cart_product(aux_points);
-	}
-
 	void CtcDynCidGuess::var3Bcheck(ibex::Interval remove_bound ,int bound, int pos ,std::vector<Slice*> & x_slice, std::vector<Slice*> v_slice, TimePropag t_propa)
 	{
 
@@ -462,145 +452,245 @@ namespace tubex
 		}
 	}
 
-  void CtcDynCidGuess::FullPropagationEngine(std::vector<Slice> & x_slice, std::vector<Slice> & v_slice, TimePropag t_propa){
+	void CtcDynCidGuess::FullPropagationEngine(std::vector<Slice> & x_slice, std::vector<Slice> & v_slice, TimePropag t_propa){
 
-			/*create the contractor queue: format contraint - variable, 0: for ctc_deriv, 1 for fwd*/
-			std::deque< vector<int> > contractorQ;
+		if (get_s_corn() == 1){
+			CornersPropagationEngine(x_slice, v_slice, t_propa);
+			return;
+		}
 
-			vector<int> ctr_var;
-			for (int i = 0 ; i < 2 ; i++) ctr_var.push_back(-1);
+		/*Initialization contractor array - bool*/
+		vector<bool> isPresent(x_slice.size(), false);
 
-			/*Initialization contractor array - bool*/
-			vector<bool > isPresent;
+		/*going throw all the variables*/
+		for (int i = 0 ; i < x_slice.size() ; i++){
 
-			for (int i = 0 ; i < x_slice.size() ; i++){
-				isPresent.push_back(false);
-			}
+			std::vector<ibex::Interval> x_subslices;
+			/*create the sub-slices*/
+			create_slices(x_slice[i],x_subslices, t_propa);
 
-			std::vector< std::vector<double> >  points;
-			if (get_s_corn() == 1)
-				create_corners(x_slice, points, t_propa);
+			/*Hull for each dimension on x and v*/
+			vector<Interval> hull_input_x(x_slice.size(), Interval::EMPTY_SET), hull_input_v(x_slice.size(), Interval::EMPTY_SET);
+			vector<Interval> hull_output_x(x_slice.size(), Interval::EMPTY_SET), hull_output_v(x_slice.size(), Interval::EMPTY_SET);
+			vector<Interval> hull_codomain_x(x_slice.size(), Interval::EMPTY_SET), hull_codomain_v(x_slice.size(), Interval::EMPTY_SET);
 
-			/*going throw all the variables*/
-			for (int i = 0 ; i < x_slice.size() ; i++){
+			for (int k = 0 ; k < x_subslices.size() ; k++){
 
-				std::vector<ibex::Interval> x_subslices;
-				x_subslices.clear();
-				/*create the sub-slices*/
-				if (get_s_corn() == 0)
-					create_slices(x_slice[i],x_subslices, t_propa);
+				/*restore with the current domains*/
+				vector<Slice> aux_slice_x(x_slice);
+				vector<Slice> aux_slice_v(v_slice);
 
-				/*Hull for each dimension on x and v*/
-				vector<Interval> hull_input_x; vector<Interval> hull_input_v;
-				vector<Interval> hull_output_x; vector<Interval> hull_output_v;
-				vector<Interval> hull_codomain_x; vector<Interval> hull_codomain_v;
+				/*Set the gate depending on the direction of the contraction*/
+				if (t_propa & TimePropag::FORWARD)
+					aux_slice_x[i].set_input_gate(x_subslices[k]);
+				else if (t_propa & TimePropag::BACKWARD)
+					aux_slice_x[i].set_output_gate(x_subslices[k]);
+
+				propagate_trial(fnc, ctc_deriv, aux_slice_x, aux_slice_v, isPresent, i, t_propa);
 
-				/*Initiliazation*/
+				/*The union of the current Slice is made*/
 				for (int j = 0 ; j < x_slice.size() ; j++){
-					hull_input_x.push_back(Interval::EMPTY_SET); hull_input_v.push_back(Interval::EMPTY_SET);
-					hull_output_x.push_back(Interval::EMPTY_SET); hull_output_v.push_back(Interval::EMPTY_SET);
-					hull_codomain_x.push_back(Interval::EMPTY_SET); hull_codomain_v.push_back(Interval::EMPTY_SET);
+					hull_input_x[j] |= aux_slice_x[j].input_gate(); hull_input_v[j] |= aux_slice_v[j].input_gate();
+					hull_output_x[j] |= aux_slice_x[j].output_gate(); hull_output_v[j] |= aux_slice_v[j].output_gate();
+					hull_codomain_x[j] |= aux_slice_x[j].codomain(); hull_codomain_v[j] |= aux_slice_v[j].codomain();
 				}
+			}
+			/*replacing the old domains*/
+			for (int j = 0 ; j < x_slice.size() ; j++){
+				x_slice[j].set_envelope(x_slice[j].codomain() & hull_codomain_x[j]); v_slice[j].set_envelope(v_slice[j].codomain() & hull_codomain_v[j]);
+				x_slice[j].set_input_gate(x_slice[j].input_gate() & hull_input_x[j]); v_slice[j].set_input_gate(v_slice[j].input_gate() & hull_input_v[j]);
+				x_slice[j].set_output_gate(x_slice[j].output_gate() & hull_output_x[j]); v_slice[j].set_output_gate(v_slice[j].output_gate() & hull_output_v[j]);
+			}
+		}
+	}
 
-				int nb_iterations;
-				if (get_s_corn() == 0)
-					nb_iterations = x_subslices.size();
-				else if (get_s_corn() == 1)
-					nb_iterations = points.size();
-				for (int k = 0 ; k < nb_iterations ; k++){
+	void CtcDynCidGuess::propagate_trial(const TFnc& f, CtcDeriv& ctc, std::vector<Slice> & aux_slice_x, std::vector<Slice> & aux_slice_v,
+	                                     std::vector<bool> & isPresent, int first_variable, TimePropag t_propa){
 
-					/*restore with the current domains*/
-					vector<Slice> aux_slice_x; aux_slice_x.clear();
-					vector<Slice> aux_slice_v; aux_slice_v.clear();
+		/*create the contractor queue: format contraint - variable, 0: for ctc_deriv, 1 for fwd*/
+		std::deque< vector<int> > contractorQ;
+		vector<int> ctr_var(2);
 
-					for (int j = 0 ; j < x_slice.size() ; j++){
-						aux_slice_x.push_back(x_slice[j]);
-						aux_slice_v.push_back(v_slice[j]);
-					}
+		/*push the first element to the contractor queue*/
+		ctr_var[0] = 0; ctr_var[1] = first_variable;
+		contractorQ.push_back(ctr_var);
 
-					/*Set the gate depending on the direction of the contraction*/
-					if (get_s_corn() == 0){
-						if (t_propa & TimePropag::FORWARD)
-							aux_slice_x[i].set_input_gate(x_subslices[k]);
-						else if (t_propa & TimePropag::BACKWARD)
-							aux_slice_x[i].set_output_gate(x_subslices[k]);
-					}
-					else if (get_s_corn() == 1){
-						if (t_propa & TimePropag::FORWARD)
-							for (int tt = 0 ; tt < points[k].size() ; tt++)
-								aux_slice_x[tt].set_input_gate(points[k][tt]);
-
-						else if (t_propa & TimePropag::BACKWARD)
-							for (int tt = 0 ; tt < points[k].size() ; tt++)
-								aux_slice_x[tt].set_output_gate(points[k][tt]);
+		/*FIFO queue*/
+		do{
+			/*get what contractor should be called*/
+			int contractor = contractorQ.front()[0];
+			/*get the variable that is going to be contracted*/
+			int variable = contractorQ.front()[1];
+			isPresent[variable] = false;
+			/*pop the first element*/
+			contractorQ.pop_front();
+			/*contract*/
+			if (contractor == 0 ){ //call ctc_deriv
+				/*save the corresponding domain*/
+				double size_x = aux_slice_x[variable].codomain().diam();
+				ctc.contract(aux_slice_x[variable],aux_slice_v[variable],t_propa);
+
+				if ((1-(aux_slice_x[variable].codomain().diam()/size_x)) > this->get_prec()){
+					ctr_var[0] = 1; ctr_var[1] = variable;
+					contractorQ.push_front(ctr_var);
+				}
+			}
+			else if (contractor == 1){ //call ctc_fwd
+				/*save the corresponding domain*/
+				double size_v = aux_slice_v[variable].codomain().diam();
+				ctc_fwd(f, aux_slice_x[variable], aux_slice_v[variable], aux_slice_x, variable);
+
+				/*add the contraints not included in isPresent*/
+				if ((1-(aux_slice_v[variable].codomain().diam()/size_v)) > this->get_prec()){
+					for (int j = 0 ; j < aux_slice_x.size() ; j++ ){
+						if ((!isPresent[j]) && (j!=variable)){
+							ctr_var[0] = 1; ctr_var[1] = j;
+							contractorQ.push_front(ctr_var);
+							isPresent[j] = true;
+						}
 					}
+					ctr_var[0] = 0; ctr_var[1] = variable;
+					contractorQ.push_front(ctr_var);
+				}
+			}
 
-					/*push the first element to the contractor queue*/
-					if (get_s_corn() == 0){
-						ctr_var[0] = 0; ctr_var[1] = i;
-					}
-					else if (get_s_corn() == 1){
-						ctr_var[0] = 0; ctr_var[1] = 0;
-					}
-					contractorQ.push_back(ctr_var);
-
-					/*FIFO queue*/
-					do{
-						/*get what contractor should be called*/
-						int contractor = contractorQ.front()[0];
-						/*get the variable that is going to be contracted*/
-						int variable = contractorQ.front()[1];
-						isPresent[variable] = false;
-						/*pop the first element*/
-						contractorQ.pop_front();
-						/*contract*/
-						if (contractor == 0 ){ //call ctc_deriv
-							/*save the corresponding domain*/
-							double size_x = aux_slice_x[variable].codomain().diam();
-							ctc_deriv.contract(aux_slice_x[variable],aux_slice_v[variable],t_propa);
-
-							if ((1-(aux_slice_x[variable].codomain().diam()/size_x)) > this->get_prec()){
-								ctr_var[0] = 1; ctr_var[1] = variable;
-								contractorQ.push_front(ctr_var);
-							}
-						}
-						else if (contractor == 1){ //call ctc_fwd
-							/*save the corresponding domain*/
-							double size_v = aux_slice_v[variable].codomain().diam();
-							ctc_fwd(aux_slice_x[variable], aux_slice_v[variable], aux_slice_x, aux_slice_v, variable);
-
-							/*add the contraints not included in isPresent*/
-							if ((1-(aux_slice_v[variable].codomain().diam()/size_v)) > this->get_prec()){
-								for (int j = 0 ; j < x_slice.size() ; j++ ){
-									if ((!isPresent[j]) && (j!=variable)){
-										ctr_var[0] = 1; ctr_var[1] = j;
-										contractorQ.push_front(ctr_var);
-										isPresent[j] = true;
-									}
-								}
-								ctr_var[0] = 0; ctr_var[1] = variable;
-								contractorQ.push_front(ctr_var);
-							}
-						}
+		} while (contractorQ.size() > 0);
+	}
 
-					} while (contractorQ.size() > 0);
+	static uint64_t splitmix64(uint64_t x)
+	{
+		x += 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
 
-					/*The union of the current Slice is made*/
-					for (int j = 0 ; j < x_slice.size() ; j++){
-						hull_input_x[j] |= aux_slice_x[j].input_gate(); hull_input_v[j] |= aux_slice_v[j].input_gate();
-						hull_output_x[j] |= aux_slice_x[j].output_gate(); hull_output_v[j] |= aux_slice_v[j].output_gate();
-						hull_codomain_x[j] |= aux_slice_x[j].codomain(); hull_codomain_v[j] |= aux_slice_v[j].codomain();
-					}
+	void CtcDynCidGuess::corner(uint64_t k, std::vector<bool> & corner, const std::vector<int> & primes){
+
+		/*sampled corners: the first ones are the lower and upper corners of the gates*/
+		if (k < 2){
+			corner.assign(corner.size(), k == 1);
+			return;
+		}
+
+		for (int j = 0 ; j < corner.size() ; j++){
+			if (get_corners_sampling() == 0){ // random, reproducible
+				corner[j] = (splitmix64(k * 0x100000001B3ull + (j/64)) >> (j%64)) & 1;
+			}
+			else{ // Halton sequence, shifted in each dimension
+				double r = 0., f = 1.;
+				for (uint64_t i = k ; i > 0 ; i /= primes[j]){
+					f /= primes[j];
+					r += f * (i % primes[j]);
 				}
-				/*replacing the old domains*/
-				for (int j = 0 ; j < x_slice.size() ; j++){
-					x_slice[j].set_envelope(x_slice[j].codomain() & hull_codomain_x[j]); v_slice[j].set_envelope(v_slice[j].codomain() & hull_codomain_v[j]);
-					x_slice[j].set_input_gate(x_slice[j].input_gate() & hull_input_x[j]); v_slice[j].set_input_gate(v_slice[j].input_gate() & hull_input_v[j]);
-					x_slice[j].set_output_gate(x_slice[j].output_gate() & hull_output_x[j]); v_slice[j].set_output_gate(v_slice[j].output_gate() & hull_output_v[j]);
+				r += 0.6180339887498949 * (j+1);
+				corner[j] = (r - floor(r)) >= 0.5;
+			}
+		}
+	}
+
+	void CtcDynCidGuess::CornersPropagationEngine(std::vector<Slice> & x_slice, std::vector<Slice> & v_slice, TimePropag t_propa){
+
+		const int n = x_slice.size();
+
+		/*the gates whose corners are tried*/
+		vector<Interval> gates(n);
+		for (int j = 0 ; j < n ; j++)
+			gates[j] = (t_propa & TimePropag::FORWARD) ? x_slice[j].input_gate() : x_slice[j].output_gate();
+
+		/*exhaustive enumeration or sampling*/
+		bool exhaustive = n < 63 && ((uint64_t)1 << n) <= (uint64_t)get_max_corners();
+		uint64_t nb_corners = exhaustive ? ((uint64_t)1 << n) : (uint64_t)get_max_corners();
+
+		vector<int> primes; // bases of the Halton sequence
+		for (int p = 2 ; !exhaustive && primes.size() < n ; p++){
+			bool is_prime = true;
+			for (int i = 0 ; i < primes.size() && primes[i]*primes[i] <= p ; i++)
+				if (p % primes[i] == 0) is_prime = false;
+			if (is_prime) primes.push_back(p);
+		}
+
+		/*IBEX functions are not reentrant: the trials are run in parallel on copies*/
+		int threads = Executor::nb_threads(get_nb_threads());
+		const TFunction *tfunction = dynamic_cast<const TFunction*>(&fnc);
+		if (tfunction == NULL) threads = 1;
+		threads = (int)min((uint64_t)threads, nb_corners);
+
+		/*Hull for each dimension on x and v, for each thread*/
+		vector< vector<Interval> > hull_input_x(threads, vector<Interval>(n, Interval::EMPTY_SET)), hull_input_v(hull_input_x);
+		vector< vector<Interval> > hull_output_x(hull_input_x), hull_output_v(hull_input_x);
+		vector< vector<Interval> > hull_codomain_x(hull_input_x), hull_codomain_v(hull_input_x);
+
+		vector<TFunction*> v_f(threads, NULL);
+		for (int t = 1 ; t < threads ; t++)
+			v_f[t] = new TFunction(*tfunction);
+
+		/*trials of the corners k0 to k1-1*/
+		auto run_trials = [&](int thread_id, uint64_t k0, uint64_t k1){
+
+			const TFnc& f = (thread_id == 0) ? fnc : *v_f[thread_id];
+			CtcDeriv ctc(ctc_deriv);
+			vector<Slice> aux_slice_x(x_slice), aux_slice_v(v_slice);
+			vector<bool> isPresent(n, false), c(n, false);
+
+			for (uint64_t k = k0 ; k < k1 ; k++){
+
+				/*the kth corner: bits of k, or sampled*/
+				if (exhaustive)
+					for (int j = 0 ; j < n ; j++)
+						c[j] = (k >> j) & 1;
+				else
+					corner(k, c, primes);
+
+				/*restore with the current domains: each trial contracts all the components*/
+				for (int j = 0 ; j < n ; j++){
+					aux_slice_x[j] = x_slice[j];
+					aux_slice_v[j] = v_slice[j];
+					Interval point(c[j] ? gates[j].ub() : gates[j].lb());
+					if (t_propa & TimePropag::FORWARD)
+						aux_slice_x[j].set_input_gate(point);
+					else if (t_propa & TimePropag::BACKWARD)
+						aux_slice_x[j].set_output_gate(point);
+				}
+
+				propagate_trial(f, ctc, aux_slice_x, aux_slice_v, isPresent, 0, t_propa);
+
+				/*The union of the current Slice is made*/
+				for (int j = 0 ; j < n ; j++){
+					hull_input_x[thread_id][j] |= aux_slice_x[j].input_gate(); hull_input_v[thread_id][j] |= aux_slice_v[j].input_gate();
+					hull_output_x[thread_id][j] |= aux_slice_x[j].output_gate(); hull_output_v[thread_id][j] |= aux_slice_v[j].output_gate();
+					hull_codomain_x[thread_id][j] |= aux_slice_x[j].codomain(); hull_codomain_v[thread_id][j] |= aux_slice_v[j].codomain();
 				}
-				if (get_s_corn() == 1)
-					i=x_slice.size()+1;
 			}
+		};
+
+		/*the trials are run on the pool of the library*/
+		exception_ptr first_exception;
+		try{
+			Executor::global().run(threads, [&](int thread_id){
+				run_trials(thread_id, nb_corners * thread_id / threads, nb_corners * (thread_id+1) / threads);
+			});
+		}
+		catch(...){
+			first_exception = current_exception();
+		}
 
+		for (int t = 1 ; t < threads ; t++)
+			delete v_f[t];
+
+		if (first_exception)
+			rethrow_exception(first_exception);
+
+		/*hull reduction and replacing the old domains*/
+		for (int j = 0 ; j < n ; j++){
+			for (int t = 1 ; t < threads ; t++){
+				hull_input_x[0][j] |= hull_input_x[t][j]; hull_input_v[0][j] |= hull_input_v[t][j];
+				hull_output_x[0][j] |= hull_output_x[t][j]; hull_output_v[0][j] |= hull_output_v[t][j];
+				hull_codomain_x[0][j] |= hull_codomain_x[t][j]; hull_codomain_v[0][j] |= hull_codomain_v[t][j];
+			}
+			x_slice[j].set_envelope(x_slice[j].codomain() & hull_codomain_x[0][j]); v_slice[j].set_envelope(v_slice[j].codomain() & hull_codomain_v[0][j]);
+			x_slice[j].set_input_gate(x_slice[j].input_gate() & hull_input_x[0][j]); v_slice[j].set_input_gate(v_slice[j].input_gate() & hull_input_v[0][j]);
+			x_slice[j].set_output_gate(x_slice[j].output_gate() & hull_output_x[0][j]); v_slice[j].set_output_gate(v_slice[j].output_gate() & hull_output_v[0][j]);
 		}
+	}
 }
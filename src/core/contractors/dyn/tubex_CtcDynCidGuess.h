@@ -13,6 +13,7 @@
 #include "ibex_Function.h"
 #include "tubex_CtcDeriv.h"
 #include <vector>
+#include <cstdint>
 #include <cmath>
 #include <ctime>
 
@@ -39,7 +40,7 @@ namespace tubex
 		/*
 		 * todo: add comments
 		 */
-		void ctc_fwd(Slice &x, Slice &v, std::vector<Slice> x_slice, std::vector<Slice> v_slice, int pos);
+		void ctc_fwd(Slice &x, Slice &v, const std::vector<Slice>& x_slice, const std::vector<Slice>& v_slice, int pos);
 		/*
 		 * todo: add comments
 		 */
@@ -75,9 +76,6 @@ namespace tubex
 		*/
 		void AtomicPropagationEngine(std::vector<Slice> & x_slice, std::vector<Slice> & v_slice, TimePropag t_propa);
 
-		void create_corners(std::vector<Slice> x_slices, std::vector< std::vector<double> > & points, TimePropag t_propa);
-		std::vector<std::vector<double>> cart_product (const std::vector<std::vector<double>>& v);
-
 		void set_s_corn(int s_strategy);
 		int get_s_corn();
 
@@ -86,6 +84,35 @@ namespace tubex
 
 		void set_variant(int variation);
 
+		/*
+		 * Corners strategy (s_corn = 1): the 2^n corners of the gates are
+		 * all tried if they are not more than max_corners,
+		 * otherwise max_corners corners are sampled (0: random, 1: low-discrepancy).
+		 * Both sampled corners include the lower and upper corners of the gates.
+		 */
+		void set_max_corners(int max_corners);
+		int get_max_corners();
+		void set_corners_sampling(int sampling);
+		int get_corners_sampling();
+
+		/*
+		 * Number of threads evaluating the corners, see DynCtc::set_nb_threads()
+		 * (1 by default). The result does not depend on it.
+		 */
+		int get_nb_threads();
+
+	protected:
+		/*
+		 * Propagation on the corners of the gates, with hull of the trials
+		 */
+		void CornersPropagationEngine(std::vector<Slice> & x_slice, std::vector<Slice> & v_slice, TimePropag t_propa);
+		/*
+		 * Fixpoint of one trial, from the contractor queue initialized with ctc_deriv on the given variable
+		 */
+		void propagate_trial(const TFnc& f, CtcDeriv& ctc, std::vector<Slice> & aux_slice_x, std::vector<Slice> & aux_slice_v, std::vector<bool> & isPresent, int first_variable, TimePropag t_propa);
+		static void ctc_fwd(const TFnc& f, Slice &x, Slice &v, const std::vector<Slice>& x_slice, int pos);
+		void corner(uint64_t k, std::vector<bool> & corner, const std::vector<int> & primes);
+
 	private:
 		double prec;
 		const TFnc& fnc;
@@ -94,6 +121,8 @@ namespace tubex
 		int s_strategy = 0 ;
 		bool max_it = false;
 		int d_policy = 0; // 0: nothing , 1: small , 2:big
+		int max_corners = 1024; // exhaustive enumeration up to 10 dimensions
+		int corners_sampling = 1; // 0: random, 1: low-discrepancy
 	};
 }
 
@@ -9,6 +9,7 @@
 #include "tubex_CtcDynBasic.h"
 #include "tubex_CtcDynCid.h"
 #include "tubex_CtcDynCidGuess.h"
+#include "tubex_TubeSnapshot.h"
 
 using namespace std;
 using namespace ibex;
@@ -235,7 +236,7 @@ namespace tubex
 		this->m_slice_picard_mode = slice_picard_mode;
 	}
 
-	std::pair<int,std::pair<double,double>> CtcIntegration::bisection_guess(TubeVector x, TubeVector v, DynCtc* slice_ctr, TFunction& fnc, int variant){
+	std::pair<int,std::pair<double,double>> CtcIntegration::bisection_guess(TubeVector& x, TubeVector& v, DynCtc* slice_ctr, TFunction& fnc, int variant){
 
 		//variant 0 -> return immediately as soon as we find a potential gate
 		//variant 1 -> return the largest gate in a slice
@@ -258,9 +259,9 @@ namespace tubex
 		/*init all the tubes*/
 		vector<Slice*> x_slice;
 		vector<Slice*> v_slice;
-		/*auxiliar tubes*/
-		vector<Slice*> aux_x_slice; TubeVector aux_x = x;
-		vector<Slice*> aux_v_slice; TubeVector aux_v = v;
+		/*snapshots of the tubes: the values modified by a trial are restored afterwards*/
+		TubeSnapshot x_snapshot(x);
+		TubeSnapshot v_snapshot(v);
 
 
 		double max_diameter = -1;
@@ -268,78 +269,74 @@ namespace tubex
 		for (int it = 0 ; it < 2 ; it++){
 			//clean
 			x_slice.clear(); v_slice.clear();
-			aux_x_slice.clear(); aux_v_slice.clear();
 			/*push slices for forward phase*/
 			//for forward
 			TimePropag t_propa;
 			if (it == 0){
 			  t_propa = TimePropag::FORWARD;
 				for (int i = 0 ; i < x.size() ; i++){
-					x_slice.push_back(x[i].first_slice()); aux_x_slice.push_back(aux_x[i].first_slice());
-					v_slice.push_back(v[i].first_slice()); aux_v_slice.push_back(aux_v[i].first_slice());
+					x_slice.push_back(x[i].first_slice());
+					v_slice.push_back(v[i].first_slice());
 				}
 			}
 			//for backward
 			else{
 			  t_propa = TimePropag::BACKWARD;
 				for (int i = 0 ; i < x.size() ; i++){
-					x_slice.push_back(x[i].last_slice()); aux_x_slice.push_back(aux_x[i].last_slice());
-					v_slice.push_back(v[i].last_slice()); aux_v_slice.push_back(aux_v[i].last_slice());
+					x_slice.push_back(x[i].last_slice());
+					v_slice.push_back(v[i].last_slice());
 				}
 			}
 
 			while (x_slice[0] != NULL){
 				for (int i = 0 ; i < x.size() ; i++){
 				  if (t_propa & TimePropag::FORWARD){
-						x_bisection = aux_x_slice[i]->output_gate().mid();
-						t_bisection = aux_x_slice[i]->tdomain().ub();
-						gate_diam = aux_x_slice[i]->output_gate().diam();
-						aux_x_slice[i]->set_output_gate(x_bisection);
+						x_bisection = x_slice[i]->output_gate().mid();
+						t_bisection = x_slice[i]->tdomain().ub();
+						gate_diam = x_slice[i]->output_gate().diam();
+						x_slice[i]->set_output_gate(x_bisection);
 					}
 					else if (t_propa & TimePropag::BACKWARD){
-						x_bisection = aux_x_slice[i]->input_gate().mid();
-						t_bisection = aux_x_slice[i]->tdomain().lb();
-						gate_diam = aux_x_slice[i]->input_gate().diam();
-						aux_x_slice[i]->set_input_gate(x_bisection);
+						x_bisection = x_slice[i]->input_gate().mid();
+						t_bisection = x_slice[i]->tdomain().lb();
+						gate_diam = x_slice[i]->input_gate().diam();
+						x_slice[i]->set_input_gate(x_bisection);
 					}
 					if(dynamic_cast <CtcDynCid*> (slice_ctr)){
 						CtcDynCid * cid = dynamic_cast <CtcDynCid*> (slice_ctr);
-						cid->contract(aux_x_slice,aux_v_slice,t_propa);
+						cid->contract(x_slice,v_slice,t_propa);
 					}
 
 					else if(dynamic_cast <CtcDynCidGuess*> (slice_ctr)){
 						CtcDynCidGuess * cidguess = dynamic_cast <CtcDynCidGuess*> (slice_ctr);
-						cidguess->contract(aux_x_slice,aux_v_slice,t_propa);
+						cidguess->contract(x_slice,v_slice,t_propa);
 					}
 					else if(dynamic_cast <CtcDynBasic*> (slice_ctr)){
 						CtcDynBasic * basic = dynamic_cast <CtcDynBasic*> (slice_ctr);
-						basic->contract(aux_x_slice,aux_v_slice,t_propa);
+						basic->contract(x_slice,v_slice,t_propa);
 					}
 
-					for (int k = 0 ; k < aux_x_slice.size() ; k++){
-						if (aux_x_slice[k]->is_empty()){
-							if (variant == 0){
-								bisection.first = i;
-								bisection.second.first = t_bisection;
-								bisection.second.second = x_bisection;
-								return bisection;
-							}
-							else {
-								if (gate_diam > max_diameter){
-									bisection.first = i;
-									bisection.second.first = t_bisection;
-									bisection.second.second = x_bisection;
-									max_diameter = gate_diam;
-									break;
-								}
-							}
-						}
-					}
+					bool empty = false;
+					for (int k = 0 ; k < x_slice.size() ; k++)
+						empty |= x_slice[k]->is_empty();
+
 					//restore values for x and v
-					for (int k = 0 ; k < aux_x_slice.size() ; k++){
-						aux_x_slice[k]->set_envelope(x_slice[k]->codomain()); aux_v_slice[k]->set_envelope(v_slice[k]->codomain());
-						aux_x_slice[k]->set_input_gate(x_slice[k]->input_gate()); aux_v_slice[k]->set_input_gate(v_slice[k]->input_gate());
-						aux_x_slice[k]->set_output_gate(x_slice[k]->output_gate()); aux_v_slice[k]->set_output_gate(v_slice[k]->output_gate());
+					x_snapshot.restore();
+					v_snapshot.restore();
+
+					if (empty){
+						if (variant == 0){
+							bisection.first = i;
+							bisection.second.first = t_bisection;
+							bisection.second.second = x_bisection;
+							return bisection;
+						}
+						else if (gate_diam > max_diameter){
+							bisection.first = i;
+							bisection.second.first = t_bisection;
+							bisection.second.second = x_bisection;
+							max_diameter = gate_diam;
+						}
 					}
 				}
 
@@ -350,14 +347,14 @@ namespace tubex
 
 				if (t_propa & TimePropag::FORWARD){
 					for (int i = 0 ; i < x.size() ; i++){
-						x_slice[i] = x_slice[i]->next_slice(); aux_x_slice[i] = aux_x_slice[i]->next_slice();
-						v_slice[i] = v_slice[i]->next_slice(); aux_v_slice[i] = aux_v_slice[i]->next_slice();
+						x_slice[i] = x_slice[i]->next_slice();
+						v_slice[i] = v_slice[i]->next_slice();
 					}
 				}
 				else if (t_propa & TimePropag::BACKWARD){
 					for (int i = 0 ; i < x.size() ; i++){
-						x_slice[i] = x_slice[i]->prev_slice(); aux_x_slice[i] = aux_x_slice[i]->prev_slice();
-						v_slice[i] = v_slice[i]->prev_slice(); aux_v_slice[i] = aux_v_slice[i]->prev_slice();
+						x_slice[i] = x_slice[i]->prev_slice();
+						v_slice[i] = v_slice[i]->prev_slice();
 					}
 				}
 			}
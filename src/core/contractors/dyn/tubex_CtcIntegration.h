@@ -66,7 +66,8 @@ namespace tubex
 		void set_incremental_mode(bool incremental_mode = true);
 
 		/*temporal function*/
-		std::pair<int,std::pair<double,double>> bisection_guess(TubeVector x, TubeVector v, DynCtc* slice_ctr, TFunction& fnc, int variant);
+		/*x and v are contracted by the trials, and restored before returning*/
+		std::pair<int,std::pair<double,double>> bisection_guess(TubeVector& x, TubeVector& v, DynCtc* slice_ctr, TFunction& fnc, int variant);
 
 	private:
 		bool m_incremental_mode = true;
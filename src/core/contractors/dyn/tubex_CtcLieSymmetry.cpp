@@ -0,0 +1,205 @@
+/**
+ *  CtcLieSymmetry class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Julien Damers, Simon Rohou
+ *  \copyright  Copyright 2020 Tubex Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_CtcLieSymmetry.h"
+#include "tubex_Domain.h"
+#include "tubex_Executor.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Number of consecutive boxes contracted by a thread
+  static const size_t boxes_grain = 32;
+
+  CtcLieSymmetry::CtcLieSymmetry(const Function& phi)
+    : DynCtc(true), m_phi(new Function(phi, Function::COPY))
+  {
+    assert(phi.nb_var() == 2 * phi.image_dim());
+  }
+
+  CtcLieSymmetry::~CtcLieSymmetry()
+  {
+    for(auto& phi : m_v_thread_phi)
+      delete phi;
+    delete m_phi;
+  }
+
+  void CtcLieSymmetry::contract(vector<Domain*>& v_domains)
+  {
+    assert(v_domains.size() == 3);
+
+    if(v_domains[0]->type() == Domain::Type::T_TUBE_VECTOR
+      && v_domains[1]->type() == Domain::Type::T_INTERVAL_VECTOR
+      && v_domains[2]->type() == Domain::Type::T_TUBE_VECTOR)
+      contract(v_domains[0]->tube_vector(), v_domains[1]->interval_vector(), v_domains[2]->tube_vector());
+
+    else
+      assert(false && "vector of domains not consistent with the contractor definition");
+  }
+
+  void CtcLieSymmetry::contract(TubeVector& x, IntervalVector& x0, const TubeVector& a)
+  {
+    assert(x.size() == a.size() && x0.size() == x.size());
+    assert(x.size() == m_phi->image_dim());
+    assert(TubeVector::same_slicing(x, a));
+
+    if(x.is_empty() || x0.is_empty())
+    {
+      x.set_empty();
+      x0.set_empty();
+      return;
+    }
+
+    int n = x.size();
+
+    // Rows of slices impacted by the contractor, in row-major arrays
+
+      vector<Slice*> v_x;
+      vector<const Slice*> v_a;
+      vector<Slice*> v_row_x(n);
+      vector<const Slice*> v_row_a(n);
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        v_row_x[i] = x[i].first_slice();
+        v_row_a[i] = a[i].first_slice();
+      }
+
+      while(v_row_x[0] != NULL)
+      {
+        if(v_row_x[0]->tdomain().intersects(m_restricted_tdomain))
+        {
+          v_x.insert(v_x.end(), v_row_x.begin(), v_row_x.end());
+          v_a.insert(v_a.end(), v_row_a.begin(), v_row_a.end());
+        }
+
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_row_x[i] = v_row_x[i]->next_slice();
+          v_row_a[i] = v_row_a[i]->next_slice();
+        }
+      }
+
+      size_t nb_rows = v_x.size() / n;
+      if(nb_rows == 0)
+        return;
+
+    // Boxes of the envelopes, of the input gates, and of the last output gate
+
+      size_t nb_boxes = 2 * nb_rows + 1;
+      vector<IntervalVector> v_x_boxes(nb_boxes, IntervalVector(n));
+      vector<IntervalVector> v_a_boxes(nb_boxes, IntervalVector(n));
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_x_boxes[k][i] = v_x[k*n+i]->codomain();
+          v_a_boxes[k][i] = v_a[k*n+i]->codomain();
+          v_x_boxes[nb_rows+k][i] = v_x[k*n+i]->input_gate();
+          v_a_boxes[nb_rows+k][i] = v_a[k*n+i]->input_gate();
+        }
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        v_x_boxes[2*nb_rows][i] = v_x[(nb_rows-1)*n+i]->output_gate();
+        v_a_boxes[2*nb_rows][i] = v_a[(nb_rows-1)*n+i]->output_gate();
+      }
+
+    // Single pass over the boxes, in parallel. Each box is contracted from
+    // the same initial condition, and the contractions of [x0] are intersected
+    // afterwards, so that the result does not depend on the number of threads.
+
+      // IBEX functions are not reentrant: one copy of the group action per thread
+      // (created once, under a lock: the pointers are then read from a local list)
+      int nb_lanes = Executor::nb_lanes(nb_boxes, m_nb_threads, boxes_grain);
+      vector<const Function*> v_thread_phi;
+      {
+        lock_guard<mutex> lock(m_thread_phi_mutex);
+        while((int)m_v_thread_phi.size() < nb_lanes - 1)
+          m_v_thread_phi.push_back(new Function(*m_phi, Function::COPY));
+        v_thread_phi.assign(m_v_thread_phi.begin(), m_v_thread_phi.begin() + (nb_lanes - 1));
+      }
+
+      vector<IntervalVector> v_x0(nb_lanes, x0);
+
+      Executor::global().parallel_for(0, nb_boxes,
+        [&](size_t k, int lane)
+        {
+          IntervalVector x0_k(x0);
+          contract_box(lane == 0 ? *m_phi : *v_thread_phi[lane-1], v_x_boxes[k], x0_k, v_a_boxes[k]);
+          v_x0[lane] &= x0_k;
+        },
+        m_nb_threads, boxes_grain);
+
+      for(const auto& x0_lane : v_x0)
+        x0 &= x0_lane;
+
+      if(x0.is_empty())
+      {
+        x.set_empty();
+        return;
+      }
+
+    // Envelopes, then gates
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
+        for(int i = 0 ; i < n ; i++)
+          v_x[k*n+i]->set_envelope(v_x_boxes[k][i]);
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
+        for(int i = 0 ; i < n ; i++)
+          v_x[k*n+i]->set_input_gate(v_x[k*n+i]->input_gate() & v_x_boxes[nb_rows+k][i]);
+
+      for(int i = 0 ; i < n ; i++)
+        v_x[(nb_rows-1)*n+i]->set_output_gate(v_x[(nb_rows-1)*n+i]->output_gate() & v_x_boxes[2*nb_rows][i]);
+  }
+
+  const TubeVector CtcLieSymmetry::transport(const TubeVector& a, const IntervalVector& x0)
+  {
+    assert(a.size() == x0.size());
+
+    TubeVector x(a);
+    x.set(IntervalVector(a.size()));
+
+    IntervalVector x0_(x0);
+    contract(x, x0_, a);
+    return x;
+  }
+
+  void CtcLieSymmetry::contract_box(const Function& phi, IntervalVector& x, IntervalVector& x0, const IntervalVector& a)
+  {
+    int n = x.size();
+    IntervalVector ax0(2*n);
+    for(int i = 0 ; i < n ; i++)
+    {
+      ax0[i] = a[i];
+      ax0[n+i] = x0[i];
+    }
+
+    // Forward: [x] = [x] & phi([a],[x0])
+    x &= phi.eval_vector(ax0);
+
+    // Backward: [x0] such that phi([a],[x0]) is in [x]
+    if(!x.is_empty())
+      phi.backward(x, ax0);
+
+    if(x.is_empty() || ax0.is_empty())
+    {
+      x.set_empty();
+      x0.set_empty();
+      return;
+    }
+
+    for(int i = 0 ; i < n ; i++)
+      x0[i] = ax0[n+i];
+  }
+}
@@ -0,0 +1,107 @@
+/**
+ *  \file
+ *  CtcLieSymmetry class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Julien Damers, Simon Rohou
+ *  \copyright  Copyright 2020 Tubex Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_CTCLIESYMMETRY_H__
+#define __TUBEX_CTCLIESYMMETRY_H__
+
+#include <vector>
+#include <mutex>
+#include "ibex_Function.h"
+#include "tubex_DynCtc.h"
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * \class CtcLieSymmetry
+   * \brief \f$\mathcal{C}_{\varphi}\f$ that relates a tube \f$[\mathbf{x}](\cdot)\f$ to a
+   *        reference tube \f$[\mathbf{a}](\cdot)\f$ through a symmetry of the dynamics
+   *
+   * If the differential equation \f$\dot{\mathbf{x}}=\mathbf{f}(\mathbf{x},t)\f$ is invariant
+   * under the action \f$\varphi\f$ of a Lie group, any solution can be obtained from a reference
+   * solution \f$\mathbf{a}(\cdot)\f$: \f$\mathbf{x}(t)=\varphi(\mathbf{a}(t),\mathbf{x}_0)\f$,
+   * where \f$\mathbf{x}_0\f$ is the initial condition of \f$\mathbf{x}(\cdot)\f$.
+   * Once the reference tube \f$[\mathbf{a}](\cdot)\f$ has been integrated (see ReferenceTubeCache),
+   * the tube of a new initial condition is then obtained by a single pass over the slices,
+   * without any integration.
+   *
+   * The reference tube is not contracted, so that it can be shared between several problems.
+   * The slices of \f$[\mathbf{x}](\cdot)\f$ and \f$[\mathbf{a}](\cdot)\f$ can be processed in
+   * parallel (see set_nb_threads()).
+   */
+  class CtcLieSymmetry : public DynCtc
+  {
+    public:
+
+      /**
+       * \brief Creates a contractor from the action of a symmetry group
+       *
+       * \param phi the group action \f$\varphi(\mathbf{a},\mathbf{x}_0)\f$, with \f$2n\f$ variables
+       *        (the state of the reference, then the initial condition) and \f$n\f$ outputs:
+       *        the state at the same time of the solution starting from \f$\mathbf{x}_0\f$
+       */
+      CtcLieSymmetry(const ibex::Function& phi);
+
+      /**
+       * \brief CtcLieSymmetry destructor
+       */
+      ~CtcLieSymmetry();
+
+      /*
+       * \brief Contracts a set of abstract domains
+       *
+       * This method makes the contractor available in the CN framework.
+       * The domains are expected in the order \f$([\mathbf{x}](\cdot),[\mathbf{x}_0],[\mathbf{a}](\cdot))\f$.
+       *
+       * \param v_domains vector of Domain pointers
+       */
+      void contract(std::vector<Domain*>& v_domains);
+
+      /**
+       * \brief \f$\mathcal{C}_{\varphi}\big([\mathbf{x}](\cdot),[\mathbf{x}_0],[\mathbf{a}](\cdot)\big)\f$
+       *
+       * \note The tubes \f$[\mathbf{x}](\cdot)\f$ and \f$[\mathbf{a}](\cdot)\f$ must share the same slicing.
+       *
+       * \param x the n-dimensional tube \f$[\mathbf{x}](\cdot)\f$ to be contracted
+       * \param x0 the initial condition \f$[\mathbf{x}_0]\f$ of \f$[\mathbf{x}](\cdot)\f$, to be contracted
+       * \param a the n-dimensional reference tube \f$[\mathbf{a}](\cdot)\f$
+       */
+      void contract(TubeVector& x, ibex::IntervalVector& x0, const TubeVector& a);
+
+      /**
+       * \brief Transports the reference tube to a new initial condition
+       *
+       * \param a the n-dimensional reference tube \f$[\mathbf{a}](\cdot)\f$
+       * \param x0 the initial condition \f$[\mathbf{x}_0]\f$
+       * \return the tube \f$\varphi([\mathbf{a}](\cdot),[\mathbf{x}_0])\f$, with the slicing of \f$[\mathbf{a}](\cdot)\f$
+       */
+      const TubeVector transport(const TubeVector& a, const ibex::IntervalVector& x0);
+
+    protected:
+
+      /**
+       * \brief Contracts the box \f$[\mathbf{x}]\f$ of a slice or a gate, together with \f$[\mathbf{x}_0]\f$
+       *
+       * \param phi the (thread-local) copy of the group action
+       * \param x the box \f$[\mathbf{x}]\f$ to be contracted
+       * \param x0 the initial condition \f$[\mathbf{x}_0]\f$ to be contracted
+       * \param a the related box \f$[\mathbf{a}]\f$ of the reference
+       */
+      static void contract_box(const ibex::Function& phi,
+                               ibex::IntervalVector& x, ibex::IntervalVector& x0, const ibex::IntervalVector& a);
+
+      const ibex::Function *m_phi; //!< group action
+      std::vector<const ibex::Function*> m_v_thread_phi; //!< copies of the group action, used by the other threads
+      std::mutex m_thread_phi_mutex; //!< guards the creation of the copies
+  };
+}
+
+#endif
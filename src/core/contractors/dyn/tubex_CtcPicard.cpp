@@ -46,91 +46,100 @@ namespace tubex
     m_picard_subslices=nsubslices;
   }
 
-  void CtcPicard::contract_picard_tubeslice(const TFnc& f, TubeVector& x, int & k, TimePropag t_propa )
+  bool CtcPicard::contract_picard_tubeslice(const TFnc& f, TubeVector& x, vector<Slice*>& v_x, int& k, TimePropag t_propa)
   {
-    /*
-          if(!x(k).is_unbounded())
-            continue;
-    */
+    contract_slices(f, x, v_x, k, t_propa);
+
+    // NB: all tube components share the same slicing
+    // If the slice stays unbounded after the contraction step,
+    // then it is sampled and contracted again.
+    Interval t = v_x[0]->tdomain();
+    if(slices_codomain(v_x).is_unbounded() && t.diam() > x.tdomain().diam() / m_picard_subslices
+      && t.interior_contains(t.mid()))
+    {
+      sample_slices(x, v_x, t.mid()); // all the components of the tube are sampled
 
+      // Forward: the first subslice, still pointed by v_x, will be computed
+      // Backward: the second subslice will be computed
+      if(t_propa & TimePropag::BACKWARD)
+      {
+        k++;
+        for(size_t i = 0 ; i < v_x.size() ; i++)
+          v_x[i] = v_x[i]->next_slice();
+      }
 
+      return true;
+    }
 
-          contract_kth_slices(f, x, k, t_propa);
-          // NB: all tube components share the same slicing
-          // If the slice stays unbounded after the contraction step,
-          // then it is sampled and contracted again.
-          if(x(k).is_unbounded() && x[0].slice_tdomain(k).diam() > x.tdomain().diam() / m_picard_subslices)
-          {
+    return false;
+  }
 
-            x.sample(x[0].slice_tdomain(k).mid()); // all the components of the tube are sampled,
-            // and sampling time is selected according to the first slice of one of the components,
-            // for instance the first one x[0]
+  void CtcPicard::contract_picard_slice(const TFnc& f, TubeVector& x, int k, TimePropag t_propa)
+  {
+    assert(t_propa == TimePropag::FORWARD || t_propa == TimePropag::BACKWARD);
 
-            if (t_propa &  TimePropag::FORWARD) k--; // the first subslice will be computed
-	    else k+=2;  // the second subslice will be computed
-          }
+    vector<Slice*> v_x(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      v_x[i] = x[i].slice(k);
+
+      if((t_propa == TimePropag::FORWARD && v_x[i]->input_gate().is_unbounded())
+        || (t_propa == TimePropag::BACKWARD && v_x[i]->output_gate().is_unbounded()))
+        return;
+    }
+
+    contract_picard_slice(f, x, v_x, k, t_propa);
   }
 
-  void CtcPicard::contract_picard_slice(const TFnc& f, TubeVector& x, int  k, TimePropag t_propa )
+  void CtcPicard::contract_picard_slice(const TFnc& f, TubeVector& x, vector<Slice*>& v_x, int k, TimePropag t_propa)
   {
-    assert (t_propa ==   TimePropag::FORWARD || t_propa == TimePropag::BACKWARD);
-
-    for (int i=0 ;i< x.size() ; i++)
-      if ((t_propa == TimePropag::FORWARD && x[i].slice(k)->input_gate().is_unbounded())
-	  ||
-	  (t_propa == TimePropag::BACKWARD && x[i].slice(k)->output_gate().is_unbounded())
-	  )
-	return;
-
-    TubeVector * first_slicing;
-    if (m_preserve_slicing)
-      first_slicing= new TubeVector(x);
-
-    Interval initdomain=x[0].slice_tdomain(k) ;
-    //    Interval initdomain=x[0].domain() ;
-    int kfinished;
-    if (t_propa == TimePropag::FORWARD) kfinished=k+1;
-    else kfinished=k-1;
-
-    while (k!= kfinished){
-          contract_kth_slices(f, x, k, t_propa);
-          // NB: all tube components share the same slicing
-          // If the slice stays unbounded after the contraction step,
-          // then it is sampled and contracted again.
-          if(x(k).is_unbounded())
-	     {
-	       //	       cout << " k " << k << "  nb_slices " <<  x[0].nb_slices() << "  " << x[0].slice_tdomain(k) << " initdomain " <<  initdomain.diam() << " " << initdomain.diam() / m_picard_subslices << endl;
-	       if (x[0].slice_tdomain(k).diam() > initdomain.diam() / m_picard_subslices
-		 && x[0].slice_tdomain(k).mid() < x[0].slice_tdomain(k).ub()
-		   && x[0].slice_tdomain(k).mid() > x[0].slice_tdomain(k).lb())
-		{
-
-		  x.sample(x[0].slice_tdomain(k).mid()); // all the components of the tube are sampled,
-            // and sampling time is selected according to the first slice of one of the components,
-            // for instance the first one x[0]
-
-		  if (t_propa == TimePropag::FORWARD) {kfinished++;} // the first subslice will be computed; the final index incremented
-		  else {k+=1;}  // the second subslice will be computed
-		}
-	      else break;  // fail to bound the current slice : stop the algorithm
-	     }
-	  else if  (t_propa == TimePropag::FORWARD) k++;
-	  else k--;
-    }
-    if(m_preserve_slicing)
-    
-      {	first_slicing->set_empty();
-	*first_slicing |= x;
-	x=*first_slicing;
-	delete first_slicing;
+    assert(t_propa == TimePropag::FORWARD || t_propa == TimePropag::BACKWARD);
+
+    Interval initdomain = v_x[0]->tdomain();
+
+    // When sampled, the slice keeps the first subdomain: the first
+    // subslice is always the initial Slice object
+    vector<Slice*> v_first(v_x);
+
+    while(v_x[0] != NULL
+      && ((t_propa == TimePropag::FORWARD && v_x[0]->tdomain().lb() < initdomain.ub())
+        || (t_propa == TimePropag::BACKWARD && v_x[0]->tdomain().ub() > initdomain.lb())))
+    {
+      contract_slices(f, x, v_x, k, t_propa);
+
+      // NB: all tube components share the same slicing
+      // If the slice stays unbounded after the contraction step,
+      // then it is sampled and contracted again.
+      Interval t = v_x[0]->tdomain();
+      if(slices_codomain(v_x).is_unbounded())
+      {
+        if(t.diam() > initdomain.diam() / m_picard_subslices && t.interior_contains(t.mid()))
+        {
+          sample_slices(x, v_x, t.mid());
+
+          if(t_propa == TimePropag::BACKWARD) // the second subslice will be computed
+          {
+            k++;
+            for(size_t i = 0 ; i < v_x.size() ; i++)
+              v_x[i] = v_x[i]->next_slice();
+          }
+        }
+
+        else
+          break; // fail to bound the current slice: stop the algorithm
       }
-    
-  }
 
+      else
+        move_slices(v_x, k, t_propa);
+    }
 
+    if(m_preserve_slicing) // subslices are merged in place
+      for(int i = 0 ; i < x.size() ; i++)
+        while(v_first[i]->tdomain().ub() < initdomain.ub())
+          x[i].remove_gate(v_first[i]->next_slice());
+  }
 
   void CtcPicard::contract(const TFnc& f, TubeVector& x, TimePropag t_propa)
-
   {
     assert(f.nb_vars() == f.image_dim());
     assert(f.nb_vars() == x.size());
@@ -147,44 +156,52 @@ namespace tubex
 
     else
     {
-      TubeVector *first_slicing = NULL;
-      if(m_preserve_slicing)
-        first_slicing = new TubeVector(x);
+      // The slices are walked through with a cursor (one slice per
+      // component), sampled and merged locally: no index accesses
 
+      vector<Slice*> v_x(x.size());
+      int k;
 
       if(t_propa & TimePropag::FORWARD)
-
       {
+        k = 0;
+        for(int i = 0 ; i < x.size() ; i++)
+          v_x[i] = x[i].first_slice();
+      }
 
-        for(int k = 0 ; k < x.nb_slices() ; k++)
-        {
-
-	  contract_picard_tubeslice(f,x,k, TimePropag::FORWARD);
-
-        
-      
-        }
+      else
+      {
+        k = x.nb_slices() - 1;
+        for(int i = 0 ; i < x.size() ; i++)
+          v_x[i] = x[i].last_slice();
       }
 
-      if(t_propa & TimePropag::BACKWARD)
+      while(v_x[0] != NULL)
       {
-        for(int k = x.nb_slices() - 1 ; k >= 0 ; k--)
-        {
+        // Initial Slice objects, kept as first subslices when sampled
+        vector<Slice*> v_first(v_x);
+        Interval initdomain = v_x[0]->tdomain();
+        int k_first = k;
 
+        do
+        {
+          if(!contract_picard_tubeslice(f, x, v_x, k, t_propa))
+            move_slices(v_x, k, t_propa);
 
-	  contract_picard_tubeslice(f,x,k, TimePropag::BACKWARD);
+        } while(v_x[0] != NULL
+          && ((t_propa & TimePropag::FORWARD) ? v_x[0]->tdomain().lb() < initdomain.ub()
+                                              : v_x[0]->tdomain().ub() > initdomain.lb()));
 
+        if(m_preserve_slicing) // subslices are merged back in place
+        {
+          for(int i = 0 ; i < x.size() ; i++)
+            while(v_first[i]->tdomain().ub() < initdomain.ub())
+              x[i].remove_gate(v_first[i]->next_slice());
 
+          if(t_propa & TimePropag::FORWARD)
+            k = k_first + 1;
         }
       }
-
-      if(first_slicing != NULL)
-      {
-        first_slicing->set_empty();
-        *first_slicing |= x;
-        x = *first_slicing;
-        delete first_slicing;
-      }
     }
   }
 
@@ -197,23 +214,50 @@ namespace tubex
                                       TubeVector& tube,
                                       int k,
                                       TimePropag t_propa)
+  {
+    assert(k >= 0 && k < tube.nb_slices());
+
+    vector<Slice*> v_x(tube.size());
+    for(int i = 0 ; i < tube.size() ; i++)
+      v_x[i] = tube[i].slice(k);
+
+    contract_slices(f, tube, v_x, k, t_propa);
+  }
+
+  void CtcPicard::guess_kth_slices_envelope(const TFnc& f,
+                                            TubeVector& tube,
+                                            int k,
+                                            TimePropag t_propa)
+  {
+    assert(k >= 0 && k < tube.nb_slices());
+
+    vector<Slice*> v_x(tube.size());
+    for(int i = 0 ; i < tube.size() ; i++)
+      v_x[i] = tube[i].slice(k);
+
+    guess_slices_envelope(f, tube, v_x, k, t_propa);
+  }
+
+  void CtcPicard::contract_slices(const TFnc& f,
+                                  TubeVector& tube,
+                                  const vector<Slice*>& v_x,
+                                  int k,
+                                  TimePropag t_propa)
   {
     assert(!((t_propa & TimePropag::FORWARD) && (t_propa & TimePropag::BACKWARD)) && "forward/backward case not implemented yet");
     assert(f.nb_vars() == f.image_dim());
     assert(f.nb_vars() == tube.size());
-    assert(k >= 0 && k < tube.nb_slices());
+    assert((int)v_x.size() == tube.size());
     if(tube.is_empty())
       return;
 
-    guess_kth_slices_envelope(f, tube, k, t_propa);
-    IntervalVector f_eval = f.eval_vector(k, tube); // computed only once
-
+    guess_slices_envelope(f, tube, v_x, k, t_propa);
+    IntervalVector f_eval = eval_slices(f, tube, v_x, k); // computed only once
 
     if(t_propa & TimePropag::FORWARD)
-
       for(int i = 0 ; i < tube.size() ; i++)
       {
-        Slice *s = tube[i].slice(k);
+        Slice *s = v_x[i];
         s->set_output_gate(s->output_gate()
           & (s->input_gate() + s->tdomain().diam() * f_eval[i]));
       }
@@ -221,42 +265,50 @@ namespace tubex
     else if(t_propa & TimePropag::BACKWARD)
       for(int i = 0 ; i < tube.size() ; i++)
       {
-        Slice *s = tube[i].slice(k);
+        Slice *s = v_x[i];
         s->set_input_gate(s->input_gate()
           & (s->output_gate() - s->tdomain().diam() * f_eval[i]));
       }
   }
 
-  void CtcPicard::guess_kth_slices_envelope(const TFnc& f,
-                                            TubeVector& tube,
-                                            int k,
-                                            TimePropag t_propa)
+  void CtcPicard::guess_slices_envelope(const TFnc& f,
+                                        TubeVector& tube,
+                                        const vector<Slice*>& v_x,
+                                        int k,
+                                        TimePropag t_propa)
   {
     assert(!((t_propa & TimePropag::FORWARD) && (t_propa & TimePropag::BACKWARD)) && "forward/backward case not implemented yet");
     assert(f.nb_vars() == f.image_dim());
     assert(f.nb_vars() == tube.size());
-    assert(k >= 0 && k < tube.nb_slices());
+    assert((int)v_x.size() == tube.size());
 
     if(tube.is_empty())
       return;
     
     float delta = m_delta;
-    Interval h, t = tube[0].slice_tdomain(k);
-    IntervalVector initial_x = tube(k), x0(tube.size()), xf(x0);
+    Interval h, t = v_x[0]->tdomain();
+    IntervalVector initial_x = slices_codomain(v_x), x0(tube.size()), xf(x0);
 
-    if(t_propa & TimePropag::FORWARD)
+    for(int i = 0 ; i < tube.size() ; i++)
     {
-      x0 = tube(t.lb());
-      xf = tube(t.ub());
-      h = Interval(0., t.diam());
+      if(t_propa & TimePropag::FORWARD)
+      {
+        x0[i] = v_x[i]->input_gate();
+        xf[i] = v_x[i]->output_gate();
+      }
+
+      else if(t_propa & TimePropag::BACKWARD)
+      {
+        x0[i] = v_x[i]->output_gate();
+        xf[i] = v_x[i]->input_gate();
+      }
     }
 
+    if(t_propa & TimePropag::FORWARD)
+      h = Interval(0., t.diam());
+
     else if(t_propa & TimePropag::BACKWARD)
-    {
-      x0 = tube(t.ub());
-      xf = tube(t.lb());
       h = Interval(-t.diam(), 0.);
-    }
 
     IntervalVector x_guess(tube.size()), x_enclosure = x0;
     m_picard_iterations = 0;
@@ -276,7 +328,7 @@ namespace tubex
         // Update needed for further computations
         // that may be related to this slice k
         for(int i = 0 ; i < tube.size() ; i++)
-          tube[i].slice(k)->set_envelope(x_guess[i] & initial_x[i]);
+          v_x[i]->set_envelope(x_guess[i] & initial_x[i]);
         x_enclosure = x0 + h * f.eval_vector(k, tube);
       }
 
@@ -292,7 +344,7 @@ namespace tubex
       {
         if(f.is_intertemporal())
           for(int i = 0 ; i < tube.size() ; i++)
-            tube[i].slice(k)->set_envelope(initial_x[i]); // coming back to the initial state
+            v_x[i]->set_envelope(initial_x[i]); // coming back to the initial state
         break;
       }
     } while(!x_enclosure.is_interior_subset(x_guess));
@@ -300,18 +352,57 @@ namespace tubex
     // Setting tube's values
     if(!(x_enclosure.is_unbounded() || x_enclosure.is_empty() || x_guess.is_empty()))
       for(int i = 0 ; i < tube.size() ; i++)
-        tube[i].slice(k)->set_envelope(initial_x[i] & x_enclosure[i]);
+        v_x[i]->set_envelope(initial_x[i] & x_enclosure[i]);
 
     if(f.is_intertemporal())
     {
       // Restoring ending gate, contracted by setting the envelope
       for(int i = 0 ; i < tube.size() ; i++)
       {
-        Slice *s = tube[i].slice(k);
+        Slice *s = v_x[i];
         if(t_propa & TimePropag::FORWARD)  s->set_output_gate(xf[i]);
         if(t_propa & TimePropag::BACKWARD) s->set_input_gate(xf[i]);
         // todo: ^ check this ^
       }
     }
   }
+
+  const IntervalVector CtcPicard::slices_codomain(const vector<Slice*>& v_x)
+  {
+    IntervalVector codomain(v_x.size());
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+      codomain[i] = v_x[i]->codomain();
+    return codomain;
+  }
+
+  const IntervalVector CtcPicard::eval_slices(const TFnc& f, const TubeVector& tube, const vector<Slice*>& v_x, int k)
+  {
+    if(f.is_intertemporal()) // the whole tube may be involved
+      return f.eval_vector(k, tube);
+
+    IntervalVector x = slices_codomain(v_x);
+    if(x.is_empty())
+      return IntervalVector(f.image_dim(), Interval::EMPTY_SET);
+
+    IntervalVector box(f.nb_vars() + 1); // +1 for system variable (t)
+    box[0] = v_x[0]->tdomain();
+    box.put(1, x);
+    return f.eval_vector(box);
+  }
+
+  void CtcPicard::sample_slices(TubeVector& x, const vector<Slice*>& v_x, double t)
+  {
+    // All the components are sampled locally, without slice lookup
+    for(int i = 0 ; i < x.size() ; i++)
+      x[i].sample(t, v_x[i]);
+  }
+
+  void CtcPicard::move_slices(vector<Slice*>& v_x, int& k, TimePropag t_propa)
+  {
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+      v_x[i] = (t_propa & TimePropag::FORWARD) ? v_x[i]->next_slice() : v_x[i]->prev_slice();
+
+    if(t_propa & TimePropag::FORWARD) k++;
+    else k--;
+  }
 }
@@ -47,11 +47,22 @@ namespace tubex
 
 
     protected:
-      void contract_picard_tubeslice(const TFnc& f,
+
+      /* the Picard algorithm for the slices v_x (one per component) of index k,
+         subslices are merged back if the slicing is preserved */
+      void contract_picard_slice(const TFnc& f,
                                TubeVector& tube,
-                               int & k,
-			       TimePropag t_propa);
-      
+                               std::vector<Slice*>& v_x,
+                               int k,
+                               TimePropag t_propa);
+
+      /* contracts the slices v_x of index k, that are sampled if they remain unbounded;
+         returns true if sampled: v_x and k then point to the subslice to be computed */
+      bool contract_picard_tubeslice(const TFnc& f,
+                               TubeVector& tube,
+                               std::vector<Slice*>& v_x,
+                               int& k,
+                               TimePropag t_propa);
 
       void contract_kth_slices(const TFnc& f,
                                TubeVector& tube,
@@ -62,6 +73,23 @@ namespace tubex
                                int k,
                                TimePropag t_propa);
 
+      // Cursor-based versions: v_x contains the kth slice of each component
+      void contract_slices(const TFnc& f,
+                               TubeVector& tube,
+                               const std::vector<Slice*>& v_x,
+                               int k,
+                               TimePropag t_propa);
+      void guess_slices_envelope(const TFnc& f,
+                               TubeVector& tube,
+                               const std::vector<Slice*>& v_x,
+                               int k,
+                               TimePropag t_propa);
+
+      static const ibex::IntervalVector slices_codomain(const std::vector<Slice*>& v_x);
+      static const ibex::IntervalVector eval_slices(const TFnc& f, const TubeVector& tube, const std::vector<Slice*>& v_x, int k);
+      static void sample_slices(TubeVector& tube, const std::vector<Slice*>& v_x, double t);
+      static void move_slices(std::vector<Slice*>& v_x, int& k, TimePropag t_propa);
+
       float m_delta;
       int m_picard_iterations = 0;
       int m_picard_subslices=500;
@@ -9,6 +9,8 @@
  */
 
 #include "tubex_CtcStatic.h"
+#include "tubex_CtcFunction.h"
+#include "tubex_Executor.h"
 
 using namespace std;
 using namespace ibex;
@@ -163,66 +165,97 @@ namespace tubex
 
   void CtcStatic::contract(Slice **v_x_slices, int n)
   {
-    IntervalVector envelope(n + m_dynamic_ctc);
-    IntervalVector ingate(n + m_dynamic_ctc);
+    // Rows of slices impacted by the contractor, in a row-major array
 
-    while(v_x_slices[0] != NULL)
-    {
-      // If these slices should not be impacted by the contractor
-      if(!v_x_slices[0]->tdomain().intersects(m_restricted_tdomain))
-      {
-        for(int i = 0 ; i < n ; i++)
-          v_x_slices[i] = v_x_slices[i]->next_slice();
+      vector<Slice*> v_s;
+      vector<Slice*> v_row(v_x_slices, v_x_slices + n);
+      bool last_row = false;
 
+      while(v_row[0] != NULL)
+      {
         // todo: Thin contraction with respect to tube's slicing:
         // the contraction should not be optimal on purpose if the
         // restricted tdomain does not cover the slice's tdomain
-        
-        continue; // moving to next slice
-      }
+        last_row = v_row[0]->tdomain().intersects(m_restricted_tdomain);
+        if(last_row)
+          v_s.insert(v_s.end(), v_row.begin(), v_row.end());
 
-      if(m_dynamic_ctc)
-      {
-        envelope[0] = v_x_slices[0]->tdomain();
-        ingate[0] = v_x_slices[0]->tdomain().lb();
+        for(int i = 0 ; i < n ; i++)
+          v_row[i] = v_row[i]->next_slice();
       }
 
-      for(int i = 0 ; i < n ; i++)
-      {
-        envelope[i+m_dynamic_ctc] = v_x_slices[i]->codomain();
-        ingate[i+m_dynamic_ctc] = v_x_slices[i]->input_gate();
-      }
+      size_t nb_rows = v_s.size() / n;
+      if(nb_rows == 0)
+        return;
 
-      m_static_ctc.contract(envelope);
-      m_static_ctc.contract(ingate);
+    // The boxes are contracted in parallel if the IBEX contractor
+    // allows it (see CtcFunction), sequentially otherwise
 
-      for(int i = 0 ; i < n ; i++)
+      CtcFunction *ctc_f = dynamic_cast<CtcFunction*>(&m_static_ctc);
+      auto contract_boxes = [&](vector<IntervalVector>& v_boxes)
       {
-        v_x_slices[i]->set_envelope(envelope[i+m_dynamic_ctc]);
-        v_x_slices[i]->set_input_gate(ingate[i+m_dynamic_ctc]);
-      }
-
-      if(v_x_slices[0]->next_slice() == NULL) // output gate
+        if(ctc_f != NULL)
+        {
+          Executor::ScopedNbThreads scope(m_nb_threads);
+          ctc_f->contract(v_boxes);
+        }
+
+        else
+          for(auto& box : v_boxes)
+            m_static_ctc.contract(box);
+      };
+
+    // Envelopes: they do not depend on each other
+    // (input gates are read before any envelope is set)
+
+      vector<IntervalVector> v_boxes(nb_rows, IntervalVector(n + m_dynamic_ctc));
+      vector<IntervalVector> v_gates(nb_rows, IntervalVector(n + m_dynamic_ctc));
+      for(size_t k = 0 ; k < nb_rows ; k++)
       {
-        IntervalVector outgate(n + m_dynamic_ctc);
-
         if(m_dynamic_ctc)
-          outgate[0] = v_x_slices[0]->tdomain().ub();
+        {
+          v_boxes[k][0] = v_s[k*n]->tdomain();
+          v_gates[k][0] = v_s[k*n]->tdomain().lb();
+        }
 
         for(int i = 0 ; i < n ; i++)
-          outgate[i+m_dynamic_ctc] = v_x_slices[i]->output_gate();
+        {
+          v_boxes[k][i+m_dynamic_ctc] = v_s[k*n+i]->codomain();
+          v_gates[k][i+m_dynamic_ctc] = v_s[k*n+i]->input_gate();
+        }
+      }
+
+      contract_boxes(v_boxes);
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
+        for(int i = 0 ; i < n ; i++)
+          v_s[k*n+i]->set_envelope(v_boxes[k][i+m_dynamic_ctc]);
 
-        m_static_ctc.contract(outgate);
+    // Gates: in a propagation through the slices, the input gate of a slice
+    // is contracted once the envelope of the previous slice has been set,
+    // but before its own envelope is set (same values as the sequential run)
 
+      for(size_t k = 1 ; k < nb_rows ; k++)
         for(int i = 0 ; i < n ; i++)
-          v_x_slices[i]->set_output_gate(outgate[i+m_dynamic_ctc]);
+          v_gates[k][i+m_dynamic_ctc] &= v_boxes[k-1][i+m_dynamic_ctc];
 
-        break; // end of contractions
+      if(last_row) // output gate of the tubes
+      {
+        v_gates.push_back(IntervalVector(n + m_dynamic_ctc));
+        if(m_dynamic_ctc)
+          v_gates[nb_rows][0] = v_s[(nb_rows-1)*n]->tdomain().ub();
+        for(int i = 0 ; i < n ; i++)
+          v_gates[nb_rows][i+m_dynamic_ctc] = v_s[(nb_rows-1)*n+i]->output_gate();
       }
-      
-      else
+
+      contract_boxes(v_gates);
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
         for(int i = 0 ; i < n ; i++)
-          v_x_slices[i] = v_x_slices[i]->next_slice();
-    }
+          v_s[k*n+i]->set_input_gate(v_gates[k][i+m_dynamic_ctc]);
+
+      if(last_row)
+        for(int i = 0 ; i < n ; i++)
+          v_s[(nb_rows-1)*n+i]->set_output_gate(v_gates[nb_rows][i+m_dynamic_ctc]);
   }
-}
\ No newline at end of file
+}
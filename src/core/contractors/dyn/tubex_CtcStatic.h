@@ -113,7 +113,9 @@ namespace tubex
       /**
        * \brief Contracts an array of slices (representing a slice vector)
        *
-       * Propagates the contractions to the next slices
+       * Propagates the contractions to the next slices. If the IBEX contractor is a
+       * CtcFunction, the slices can be contracted in parallel (see DynCtc::set_nb_threads()),
+       * with the same result as a sequential run.
        *
        * \param v_x_slices the slices to be contracted
        * \param n the dimension of the array
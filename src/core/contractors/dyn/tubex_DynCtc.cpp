@@ -41,10 +41,22 @@ namespace tubex
     m_restricted_tdomain = tdomain;
   }
 
+  void DynCtc::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = nb_threads;
+  }
+
   bool DynCtc::is_intertemporal() const
   {
     return m_intertemporal;
   }
+
+  bool DynCtc::is_reentrant() const
+  {
+    return m_reentrant;
+  }
+
   void DynCtc::contract(std::vector<Domain*>& v_domains) {;}
 
 }
@@ -107,6 +107,16 @@ namespace tubex
        */
       void restrict_tdomain(const ibex::Interval& tdomain);
 
+      /**
+       * \brief Sets the number of threads of the contractions, for contractors that can run in parallel
+       *
+       * \note Threads are provided by the pool of the library, see Executor.
+       * \note Contractions are sequential by default, parallelism has to be enabled explicitly.
+       *
+       * \param nb_threads number of threads (1 for a sequential run, 0 for the global setting)
+       */
+      void set_nb_threads(int nb_threads);
+
       /**
        * \brief Tests if the related constraint is inter-temporal or not
        *
@@ -114,12 +124,24 @@ namespace tubex
        */
       bool is_intertemporal() const;
 
+      /**
+       * \brief Tests if the contractor can be called concurrently on different domains
+       *
+       * This allows the ContractorNetwork to contract several time windows in parallel,
+       * see ContractorNetwork::set_time_windows().
+       *
+       * \return `true` if the contractions do not modify the state of the contractor
+       */
+      bool is_reentrant() const;
+
     protected:
 
       bool m_preserve_slicing = true; //!< if `true`, tube's slicing will not be affected by the contractor
       bool m_fast_mode = false; //!< some contractors may propose more pessimistic but faster execution modes
       ibex::Interval m_restricted_tdomain; //!< limits the contractions to the specified temporal domain
+      int m_nb_threads = 1; //!< number of threads of the contractions (0 for the global setting)
       const bool m_intertemporal = true; //!< defines if the related constraint is inter-temporal or not (true by default)
+      bool m_reentrant = false; //!< if `true`, concurrent contractions on different domains are allowed
   };
 }
 
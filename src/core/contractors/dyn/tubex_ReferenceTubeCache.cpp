@@ -0,0 +1,140 @@
+/**
+ *  ReferenceTubeCache class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_ReferenceTubeCache.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  ReferenceTubeCache::ReferenceTubeCache(int max_size)
+    : m_max_size(max_size)
+  {
+    assert(max_size > 0);
+  }
+
+  ReferenceTubeCache::~ReferenceTubeCache()
+  {
+
+  }
+
+  ReferenceTubeCache& ReferenceTubeCache::global()
+  {
+    static ReferenceTubeCache cache;
+    return cache;
+  }
+
+  shared_ptr<const TubeVector> ReferenceTubeCache::reference(const TFunction& f, const IntervalVector& a0,
+                                                             const Interval& tdomain, double timestep,
+                                                             const string& integrator,
+                                                             const function<TubeVector()>& integrate)
+  {
+    assert(f.nb_vars() == a0.size());
+    assert(timestep > 0.);
+    const Key k = key(f, a0, tdomain, timestep, integrator);
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      auto it = m_map.find(k);
+      if(it != m_map.end())
+      {
+        it->second.last_use = ++m_use_counter;
+        return it->second.tube;
+      }
+    }
+
+    // The integration is run without lock, other tubes remaining available
+    shared_ptr<const TubeVector> a = make_shared<const TubeVector>(integrate());
+    assert(a->size() == a0.size() && a->tdomain() == tdomain);
+
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_map.find(k);
+    if(it != m_map.end()) // integrated meanwhile by another thread
+    {
+      it->second.last_use = ++m_use_counter;
+      return it->second.tube;
+    }
+
+    evict(m_max_size - 1);
+    Entry& e = m_map[k];
+    e.tube = a;
+    e.last_use = ++m_use_counter;
+    return a;
+  }
+
+  bool ReferenceTubeCache::contains(const TFunction& f, const IntervalVector& a0,
+                                    const Interval& tdomain, double timestep,
+                                    const string& integrator) const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_map.find(key(f, a0, tdomain, timestep, integrator)) != m_map.end();
+  }
+
+  int ReferenceTubeCache::size() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_map.size();
+  }
+
+  int ReferenceTubeCache::max_size() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_max_size;
+  }
+
+  void ReferenceTubeCache::set_max_size(int max_size)
+  {
+    assert(max_size > 0);
+    lock_guard<mutex> lock(m_mutex);
+    m_max_size = max_size;
+    evict(m_max_size);
+  }
+
+  void ReferenceTubeCache::clear()
+  {
+    // Tubes still used outside the cache are released by their last owner
+    lock_guard<mutex> lock(m_mutex);
+    m_map.clear();
+  }
+
+  void ReferenceTubeCache::evict(int max_size)
+  {
+    while((int)m_map.size() > max_size)
+    {
+      auto lru = m_map.begin();
+      for(auto it = m_map.begin() ; it != m_map.end() ; it++)
+        if(it->second.last_use < lru->second.last_use)
+          lru = it;
+      m_map.erase(lru);
+    }
+  }
+
+  const ReferenceTubeCache::Key ReferenceTubeCache::key(const TFunction& f, const IntervalVector& a0,
+                                                        const Interval& tdomain, double timestep,
+                                                        const string& integrator)
+  {
+    // Integration method, expression of the dynamics with the names of its arguments
+    string expr = integrator + ";";
+    for(int i = 0 ; i < f.nb_vars() ; i++)
+      expr += f.arg_name(i) + ",";
+    expr += f.expr();
+
+    // Time grid and initial condition
+    vector<double> v_values = { tdomain.lb(), tdomain.ub(), timestep };
+    for(int i = 0 ; i < a0.size() ; i++)
+    {
+      v_values.push_back(a0[i].lb());
+      v_values.push_back(a0[i].ub());
+    }
+
+    return make_pair(expr, v_values);
+  }
+}
@@ -0,0 +1,168 @@
+/**
+ *  \file
+ *  ReferenceTubeCache class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_REFERENCETUBECACHE_H__
+#define __TUBEX_REFERENCETUBECACHE_H__
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include "tubex_TubeVector.h"
+#include "tubex_TFunction.h"
+
+namespace tubex
+{
+  /**
+   * \class ReferenceTubeCache
+   * \brief Storage of reference tubes, integrated once for given dynamics
+   *
+   * Reference tubes are used with CtcLieSymmetry: for fleets of similar
+   * systems or many initial conditions, the dynamics are integrated once,
+   * other tubes being obtained by transport of the reference.
+   *
+   * The tubes are identified by the expression of the dynamics, the initial
+   * condition of the reference, the time grid (temporal domain and timestep)
+   * and a description of the integration method with its settings. The
+   * integration itself is left to the user (for instance TubeVectorODE).
+   *
+   * The number of stored tubes is bounded: when the bound is reached, the least
+   * recently used tube is removed from the cache. The tubes are shared, so that
+   * the ones returned before an eviction or a call to clear() remain valid.
+   * The methods of this class can be called concurrently.
+   */
+  class ReferenceTubeCache
+  {
+    public:
+
+      /**
+       * \brief Creates an empty cache
+       *
+       * \param max_size maximal number of stored reference tubes
+       */
+      ReferenceTubeCache(int max_size = 32);
+
+      /**
+       * \brief ReferenceTubeCache destructor
+       */
+      ~ReferenceTubeCache();
+
+      /**
+       * \brief Returns the cache shared by the library
+       *
+       * \return a reference to the global cache
+       */
+      static ReferenceTubeCache& global();
+
+      /**
+       * \brief Returns the reference tube of some dynamics, integrated at the first call
+       *
+       * \param f the dynamics \f$\mathbf{f}(\mathbf{a},t)\f$
+       * \param a0 the initial condition \f$[\mathbf{a}_0]\f$ of the reference
+       * \param tdomain the temporal domain of the reference tube
+       * \param timestep the timestep of the reference tube
+       * \param integrator description of the integration method and its settings
+       *        (for instance `"capd"` or `"taylor,order=20"`)
+       * \param integrate function computing the reference tube, called if not in the cache
+       * \return a shared pointer to the cached tube
+       */
+      std::shared_ptr<const TubeVector> reference(const TFunction& f, const ibex::IntervalVector& a0,
+                                                  const ibex::Interval& tdomain, double timestep,
+                                                  const std::string& integrator,
+                                                  const std::function<TubeVector()>& integrate);
+
+      /**
+       * \brief Tests if a reference tube is already stored
+       *
+       * \param f the dynamics \f$\mathbf{f}(\mathbf{a},t)\f$
+       * \param a0 the initial condition \f$[\mathbf{a}_0]\f$ of the reference
+       * \param tdomain the temporal domain of the reference tube
+       * \param timestep the timestep of the reference tube
+       * \param integrator description of the integration method and its settings
+       * \return `true` in case of a stored tube
+       */
+      bool contains(const TFunction& f, const ibex::IntervalVector& a0,
+                    const ibex::Interval& tdomain, double timestep,
+                    const std::string& integrator) const;
+
+      /**
+       * \brief Returns the number of stored reference tubes
+       *
+       * \return an integer
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the maximal number of stored reference tubes
+       *
+       * \return an integer
+       */
+      int max_size() const;
+
+      /**
+       * \brief Sets the maximal number of stored reference tubes
+       *
+       * \note The least recently used tubes are removed if needed.
+       *
+       * \param max_size the new bound, at least 1
+       */
+      void set_max_size(int max_size);
+
+      /**
+       * \brief Removes all the reference tubes
+       */
+      void clear();
+
+    protected:
+
+      typedef std::pair<std::string,std::vector<double> > Key;
+
+      /**
+       * \brief Stored reference tube, with the date of its last use
+       */
+      struct Entry
+      {
+        std::shared_ptr<const TubeVector> tube; //!< reference tube
+        unsigned long last_use; //!< value of the use counter at the last access
+      };
+      /**
+       * \brief Identifies a reference tube
+       *
+       * \param f the dynamics \f$\mathbf{f}(\mathbf{a},t)\f$
+       * \param a0 the initial condition \f$[\mathbf{a}_0]\f$ of the reference
+       * \param tdomain the temporal domain of the reference tube
+       * \param timestep the timestep of the reference tube
+       * \param integrator description of the integration method and its settings
+       * \return the key of the tube in the map
+       */
+      static const Key key(const TFunction& f, const ibex::IntervalVector& a0,
+                           const ibex::Interval& tdomain, double timestep,
+                           const std::string& integrator);
+
+      /**
+       * \brief Removes the least recently used tubes until the bound is respected
+       *
+       * \note The mutex must be locked by the caller.
+       *
+       * \param max_size the number of tubes to keep at most
+       */
+      void evict(int max_size);
+
+      std::map<Key,Entry> m_map; //!< stored reference tubes
+      int m_max_size; //!< maximal number of stored tubes
+      unsigned long m_use_counter = 0; //!< incremented at each access to the cache
+      mutable std::mutex m_mutex; //!< protects the map
+  };
+}
+
+#endif
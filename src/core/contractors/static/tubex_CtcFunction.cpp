@@ -10,12 +10,16 @@
 
 #include "tubex_CtcFunction.h"
 #include "ibex_CtcFwdBwd.h"
+#include "tubex_Executor.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace tubex
 {
+  // Number of consecutive boxes contracted by a thread
+  static const size_t boxes_grain = 32;
+
   CtcFunction::CtcFunction(const Function& f)
     : CtcFwdBwd(*new Function(f))
   {
@@ -40,12 +44,53 @@ namespace tubex
     // todo: clean delete
   }
 
+  CtcFunction::~CtcFunction()
+  {
+    for(auto& ctc : m_v_thread_ctc)
+    {
+      const Function *f_copy = &ctc->f;
+      delete ctc;
+      delete f_copy;
+    }
+  }
+
+  void CtcFunction::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = nb_threads;
+  }
+
   void CtcFunction::contract(IntervalVector& x)
   {
     assert(x.size() == nb_var);
     CtcFwdBwd::contract(x);
   }
 
+  void CtcFunction::contract(vector<IntervalVector>& v_boxes)
+  {
+    // IBEX functions are not reentrant: one copy of the contractor per thread
+    // (created once, under a lock: the pointers are then read from a local list)
+    int nb_lanes = Executor::nb_lanes(v_boxes.size(), m_nb_threads, boxes_grain);
+    vector<CtcFwdBwd*> v_thread_ctc;
+    {
+      lock_guard<mutex> lock(m_thread_ctc_mutex);
+      while((int)m_v_thread_ctc.size() < nb_lanes - 1)
+        m_v_thread_ctc.push_back(new CtcFwdBwd(*new Function(f, Function::COPY), d));
+      v_thread_ctc.assign(m_v_thread_ctc.begin(), m_v_thread_ctc.begin() + (nb_lanes - 1));
+    }
+
+    Executor::global().parallel_for(0, v_boxes.size(),
+      [&](size_t k, int lane)
+      {
+        assert(v_boxes[k].size() == nb_var);
+        if(lane == 0)
+          CtcFwdBwd::contract(v_boxes[k]);
+        else
+          v_thread_ctc[lane-1]->contract(v_boxes[k]);
+      },
+      m_nb_threads, boxes_grain);
+  }
+
   void CtcFunction::contract(TubeVector& x)
   {
     assert(x.size() == nb_var);
@@ -141,44 +186,54 @@ namespace tubex
 
   void CtcFunction::contract(Slice **v_x_slices)
   {
-    IntervalVector envelope(nb_var);
-    IntervalVector ingate(nb_var);
+    // Rows of slices, in a row-major array
 
-    while(v_x_slices[0] != NULL)
-    {
-      for(int i = 0 ; i < nb_var ; i++)
+      vector<Slice*> v_s;
+      vector<Slice*> v_row(v_x_slices, v_x_slices + nb_var);
+
+      while(v_row[0] != NULL)
       {
-        envelope[i] = v_x_slices[i]->codomain();
-        ingate[i] = v_x_slices[i]->input_gate();
+        v_s.insert(v_s.end(), v_row.begin(), v_row.end());
+        for(int i = 0 ; i < nb_var ; i++)
+          v_row[i] = v_row[i]->next_slice();
       }
 
-      CtcFwdBwd::contract(envelope);
-      CtcFwdBwd::contract(ingate);
+      size_t nb_rows = v_s.size() / nb_var;
 
-      for(int i = 0 ; i < nb_var ; i++)
-      {
-        v_x_slices[i]->set_envelope(envelope[i]);
-        v_x_slices[i]->set_input_gate(ingate[i]);
-      }
+    // Envelopes: they do not depend on each other
+    // (input gates are read before any envelope is set)
 
-      if(v_x_slices[0]->next_slice() == NULL) // output gate
-      {
-        IntervalVector outgate(nb_var);
+      vector<IntervalVector> v_boxes(nb_rows, IntervalVector(nb_var));
+      vector<IntervalVector> v_gates(nb_rows + 1, IntervalVector(nb_var));
+      for(size_t k = 0 ; k < nb_rows ; k++)
+        for(int i = 0 ; i < nb_var ; i++)
+        {
+          v_boxes[k][i] = v_s[k*nb_var+i]->codomain();
+          v_gates[k][i] = v_s[k*nb_var+i]->input_gate();
+        }
+
+      contract(v_boxes);
 
+      for(size_t k = 0 ; k < nb_rows ; k++)
         for(int i = 0 ; i < nb_var ; i++)
-          outgate[i] = v_x_slices[i]->output_gate();
+          v_s[k*nb_var+i]->set_envelope(v_boxes[k][i]);
 
-        CtcFwdBwd::contract(outgate);
+    // Gates: in a propagation through the slices, the input gate of a slice
+    // is contracted once the envelope of the previous slice has been set,
+    // but before its own envelope is set (same values as the sequential run)
 
+      for(size_t k = 1 ; k < nb_rows ; k++)
         for(int i = 0 ; i < nb_var ; i++)
-          v_x_slices[i]->set_output_gate(outgate[i]);
+          v_gates[k][i] &= v_boxes[k-1][i];
+      for(int i = 0 ; i < nb_var ; i++)
+        v_gates[nb_rows][i] = v_s[(nb_rows-1)*nb_var+i]->output_gate();
 
-        break; // end of contractions
-      }
-      
-      else
+      contract(v_gates);
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
         for(int i = 0 ; i < nb_var ; i++)
-          v_x_slices[i] = v_x_slices[i]->next_slice();
-    }
+          v_s[k*nb_var+i]->set_input_gate(v_gates[k][i]);
+      for(int i = 0 ; i < nb_var ; i++)
+        v_s[(nb_rows-1)*nb_var+i]->set_output_gate(v_gates[nb_rows][i]);
   }
-}
\ No newline at end of file
+}
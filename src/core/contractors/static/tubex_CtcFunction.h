@@ -13,6 +13,8 @@
 #define __TUBEX_CTCFUNCTION_H__
 
 #include <string>
+#include <vector>
+#include <mutex>
 #include "ibex_Function.h"
 #include "ibex_CtcFwdBwd.h"
 #include "ibex_Domain.h"
@@ -63,6 +65,20 @@ namespace tubex
        * \param y the IntervalVector \f$[\mathbf{y}]\f$
        */
       CtcFunction(const ibex::Function& f, const ibex::IntervalVector& y);
+
+      /**
+       * \brief CtcFunction destructor
+       */
+      ~CtcFunction();
+
+      /**
+       * \brief Sets the number of threads used for contracting the slices of tubes
+       *
+       * \note Threads are provided by the pool of the library, see Executor.
+       *
+       * \param nb_threads number of threads (0 for the global setting, 1 for a sequential run)
+       */
+      void set_nb_threads(int nb_threads);
       
       /**
        * \brief \f$\mathcal{C}\big([\mathbf{x}]\big)\f$
@@ -71,6 +87,15 @@ namespace tubex
        */
       void contract(ibex::IntervalVector& x);
       
+      /**
+       * \brief \f$\mathcal{C}\big([\mathbf{x}_k]\big)\f$ for a set of boxes, contracted in parallel
+       *
+       * \note IBEX functions are not reentrant: each thread uses its own copy of the contractor.
+       *
+       * \param v_boxes the n-dimensional boxes \f$[\mathbf{x}_k]\f$ to be contracted
+       */
+      void contract(std::vector<ibex::IntervalVector>& v_boxes);
+      
       /**
        * \brief \f$\mathcal{C}\big([\mathbf{x}](\cdot)\big)\f$
        *
@@ -138,11 +163,18 @@ namespace tubex
       /**
        * \brief Contracts an array of slices (representing a slice vector)
        *
-       * Propagates the contractions to the next slices
+       * Propagates the contractions to the next slices. The slices are contracted in
+       * parallel, with the same result as a sequential run.
        *
        * \param v_x_slices the slices to be contracted
        */
       void contract(Slice **v_x_slices);
+
+    protected:
+
+      int m_nb_threads = 0; //!< number of threads (0 for the global setting)
+      std::vector<ibex::CtcFwdBwd*> m_v_thread_ctc; //!< copies of the contractor, used by the other threads
+      std::mutex m_thread_ctc_mutex; //!< guards the creation of the copies
   };
 }
 
@@ -11,6 +11,10 @@
 #include <iomanip>
 #include "tubex_Slice.h"
 #include "tubex_CtcDeriv.h"
+#include "tubex_TubeIntegralCache.h"
+#include "tubex_TubeSnapshot.h"
+#include "tubex_TubeVectorGrid.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
@@ -27,6 +31,8 @@ namespace tubex
       assert(valid_tdomain(tdomain));
       m_input_gate = new Interval(codomain);
       m_output_gate = new Interval(codomain);
+      TUBEX_PERF_ALLOC(SLICE, 1);
+      TUBEX_PERF_ALLOC(GATE, 2);
     }
 
     Slice::Slice(const Slice& x)
@@ -53,6 +59,12 @@ namespace tubex
 
     const Slice& Slice::operator=(const Slice& x)
     {
+      if(m_snapshot != NULL)
+        m_snapshot->record(this);
+
+      if(m_grid != NULL)
+        m_grid->invalidate(m_grid_id);
+
       m_tdomain = x.m_tdomain;
       m_codomain = x.m_codomain;
       *m_input_gate = *x.m_input_gate;
@@ -63,6 +75,9 @@ namespace tubex
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
+
+      if(m_integral_cache != NULL)
+        m_integral_cache->invalidate(m_integral_cache_id);
       
       return *this;
     }
@@ -225,8 +240,26 @@ namespace tubex
 
     const Interval Slice::invert(const Interval& y, const Interval& search_tdomain) const
     {
-      Slice v(tdomain(), Interval::ALL_REALS); // todo: optimize this
-      return invert(y, v, search_tdomain);
+      // Same cases as the inversion with an unbounded derivative,
+      // without allocating the derivative slice
+
+      if(!m_tdomain.intersects(search_tdomain))
+        return Interval::EMPTY_SET;
+
+      else if((m_tdomain & search_tdomain) == m_tdomain && m_codomain.is_subset(y))
+        return m_tdomain;
+
+      else if(search_tdomain == m_tdomain.lb())
+        return y.intersects(input_gate()) ? Interval(m_tdomain.lb()) : Interval::EMPTY_SET;
+
+      else if(search_tdomain == m_tdomain.ub())
+        return y.intersects(output_gate()) ? Interval(m_tdomain.ub()) : Interval::EMPTY_SET;
+
+      else if(y.intersects(m_codomain))
+        return search_tdomain & m_tdomain;
+
+      else
+        return Interval::EMPTY_SET;
     }
 
     const Interval Slice::invert(const Interval& y, const Slice& v, const Interval& search_tdomain) const
@@ -234,7 +267,10 @@ namespace tubex
       assert(tdomain() == v.tdomain());
       // todo: use enclosed bounds also? in order to speed up computations
 
-      if(!m_tdomain.intersects(search_tdomain))
+      if(v.codomain() == Interval::all_reals())
+        return invert(y, search_tdomain);
+
+      else if(!m_tdomain.intersects(search_tdomain))
         return Interval::EMPTY_SET;
 
       else if((m_tdomain & search_tdomain) == m_tdomain && m_codomain.is_subset(y))
@@ -256,14 +292,6 @@ namespace tubex
           return Interval::EMPTY_SET;
       }
 
-      else if(v.codomain() == Interval::all_reals())
-      {
-        if(y.intersects(m_codomain))
-          return search_tdomain & m_tdomain;
-        else
-          return Interval::EMPTY_SET;
-      }
-
       else
       {
         ConvexPolygon p = polygon(v);
@@ -394,6 +422,12 @@ namespace tubex
 
     void Slice::set(const Interval& y)
     {
+      if(m_snapshot != NULL)
+        m_snapshot->record(this);
+
+      if(m_grid != NULL)
+        m_grid->invalidate(m_grid_id);
+
       m_codomain = y;
 
       *m_input_gate = y;
@@ -409,6 +443,9 @@ namespace tubex
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
+
+      if(m_integral_cache != NULL)
+        m_integral_cache->invalidate(m_integral_cache_id);
     }
     
     void Slice::set_empty()
@@ -418,6 +455,12 @@ namespace tubex
 
     void Slice::set_envelope(const Interval& envelope, bool slice_consistency)
     {
+      if(m_snapshot != NULL)
+        m_snapshot->record(this);
+
+      if(m_grid != NULL)
+        m_grid->invalidate(m_grid_id);
+
       m_codomain = envelope;
 
       if(slice_consistency)
@@ -431,10 +474,19 @@ namespace tubex
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
+
+      if(m_integral_cache != NULL)
+        m_integral_cache->invalidate(m_integral_cache_id);
     }
 
     void Slice::set_input_gate(const Interval& input_gate, bool slice_consistency)
     {
+      if(m_snapshot != NULL)
+        m_snapshot->record(this);
+
+      if(m_grid != NULL)
+        m_grid->invalidate(m_grid_id);
+
       *m_input_gate = input_gate;
 
       if(slice_consistency)
@@ -453,6 +505,12 @@ namespace tubex
 
     void Slice::set_output_gate(const Interval& output_gate, bool slice_consistency)
     {
+      if(m_snapshot != NULL)
+        m_snapshot->record(this);
+
+      if(m_grid != NULL)
+        m_grid->invalidate(m_grid_id);
+
       *m_output_gate = output_gate;
 
       if(slice_consistency)
@@ -543,6 +601,7 @@ namespace tubex
 
       // Deleting objects after fusion
       first_slice->m_output_gate = new Interval(second_slice->output_gate());
+      TUBEX_PERF_ALLOC(GATE, 1);
 
       second_slice->m_prev_slice = NULL;
       second_slice->m_next_slice = NULL;
@@ -12,6 +12,7 @@
 #ifndef __TUBEX_SLICE_H__
 #define __TUBEX_SLICE_H__
 
+#include <cstdint>
 #include "tubex_Tube.h"
 #include "tubex_Trajectory.h"
 #include "tubex_DynamicalItem.h"
@@ -24,6 +25,9 @@ namespace tubex
   #define EPSILON_CONTAINS ibex::next_float(0.) * 1000. //!< epsilon limit of the contains() algorithm
 
   class Tube;
+  class TubeIntegralCache;
+  class TubeSnapshot;
+  class TubeVectorGrid;
   class Trajectory;
 
   /**
@@ -669,9 +673,18 @@ namespace tubex
         ibex::Interval *m_input_gate = NULL, *m_output_gate = NULL; //!< input and output gates
         Slice *m_prev_slice = NULL, *m_next_slice = NULL; //!< pointers to previous and next slices of the related tube
         mutable TubeTreeSynthesis *m_synthesis_reference = NULL; //!< pointer to a leaf of the optional synthesis tree of the related tube
+        mutable TubeIntegralCache *m_integral_cache = NULL; //!< pointer to the optional integral cache of the related tube
+        mutable int m_integral_cache_id = 0; //!< index of the slice in the integral cache
+        TubeSnapshot *m_snapshot = NULL; //!< pointer to the optional snapshot recording the previous values of the slice
+        uint64_t m_snapshot_epoch = 0; //!< epoch of the snapshot at which the slice has been recorded
+        mutable TubeVectorGrid *m_grid = NULL; //!< pointer to the optional shared grid of the related tube vector
+        mutable int m_grid_id = 0; //!< index of the slice in the shared grid
 
       friend class Tube;
       friend class TubeTreeSynthesis;
+      friend class TubeIntegralCache;
+      friend class TubeSnapshot;
+      friend class TubeVectorGrid;
       friend class CtcEval;
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
   };
@@ -9,6 +9,7 @@
  */
 
 #include "tubex_Slice.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
@@ -85,6 +86,7 @@ namespace tubex
 
   const ConvexPolygon Slice::polygon(const Slice& v) const
   {
+    TUBEX_PERF_KERNEL(POLYGON_BUILD);
     assert(tdomain() == v.tdomain());
 
     Interval t = tdomain();
@@ -103,8 +105,8 @@ namespace tubex
 
     else
     {
-      vector<Vector> v_pts;
-      v_pts.push_back(Vector({t.lb(), input_gate().lb()}));
+      VertexArray v_pts; // no heap allocation for these few points
+      v_pts.push_back(t.lb(), input_gate().lb());
 
       // Lower bounds
 
@@ -128,33 +130,33 @@ namespace tubex
             if(y_inter_lb.ub() >= codomain().lb())
             {
               if(t_inter_lb.is_degenerated())
-                v_pts.push_back(Vector({t_inter_lb.ub(), y_inter_lb.lb()}));
+                v_pts.push_back(t_inter_lb.ub(), y_inter_lb.lb());
 
               else
               {
                 // The following transforms the line intersection result into
                 // two floating 2d vectors. This creates an additional point,
                 // but maintains reliability.
-                v_pts.push_back(Vector({t_inter_lb.lb(), y_inter_lb.lb()}));
-                v_pts.push_back(Vector({t_inter_lb.ub(), y_inter_lb.lb()}));
+                v_pts.push_back(t_inter_lb.lb(), y_inter_lb.lb());
+                v_pts.push_back(t_inter_lb.ub(), y_inter_lb.lb());
               }
             }
 
             else
             {
               Interval t_a = yilb_inv(codomain().lb(), *this, v);
-              v_pts.push_back(Vector({t_a.lb(), codomain().lb()}));
+              v_pts.push_back(t_a.lb(), codomain().lb());
               Interval t_b = yolb_inv(codomain().lb(), *this, v);
-              v_pts.push_back(Vector({t_b.ub(), codomain().lb()}));
+              v_pts.push_back(t_b.ub(), codomain().lb());
             }
           }
         }
 
-        v_pts.push_back(Vector({t.ub(), output_gate().lb()}));
+        v_pts.push_back(t.ub(), output_gate().lb());
 
       // Upper bounds
 
-        v_pts.push_back(Vector({t.ub(), output_gate().ub()}));
+        v_pts.push_back(t.ub(), output_gate().ub());
 
         if(!v.codomain().is_degenerated())
         {
@@ -176,30 +178,30 @@ namespace tubex
             if(y_inter_ub.lb() <= codomain().ub())
             {
               if(t_inter_ub.is_degenerated())
-                v_pts.push_back(Vector({t_inter_ub.ub(), y_inter_ub.ub()}));
+                v_pts.push_back(t_inter_ub.ub(), y_inter_ub.ub());
 
               else
               {
                 // The following transforms the line intersection result into
                 // two floating 2d vectors. This creates an additional point,
                 // but maintains reliability.
-                v_pts.push_back(Vector({t_inter_ub.ub(), y_inter_ub.ub()}));
-                v_pts.push_back(Vector({t_inter_ub.lb(), y_inter_ub.ub()}));
+                v_pts.push_back(t_inter_ub.ub(), y_inter_ub.ub());
+                v_pts.push_back(t_inter_ub.lb(), y_inter_ub.ub());
               }
             }
 
             else
             {
               Interval t_b = youb_inv(codomain().ub(), *this, v);
-              v_pts.push_back(Vector({t_b.ub(), codomain().ub()}));
+              v_pts.push_back(t_b.ub(), codomain().ub());
               Interval t_a = yiub_inv(codomain().ub(), *this, v);
-              v_pts.push_back(Vector({t_a.lb(), codomain().ub()}));
+              v_pts.push_back(t_a.lb(), codomain().ub());
             }
           }
         }
       
-      v_pts.push_back(Vector({t.lb(), input_gate().ub()}));
-      v_pts = Point::remove_identical_pts(v_pts);
+      v_pts.push_back(t.lb(), input_gate().ub());
+      v_pts.remove_identical_pts();
       return ConvexPolygon(v_pts, true);
     }
   }
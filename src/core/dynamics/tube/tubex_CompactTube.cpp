@@ -0,0 +1,195 @@
+/**
+ *  CompactTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "tubex_CompactTube.h"
+#include "tubex_Tube.h"
+#include "tubex_Slice.h"
+#include "tubex_serialize_tubes.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Outward rounding of bounds to single precision.
+  // An empty set is stored as a pair of NaN.
+
+  static float round_down(double x)
+  {
+    if(std::isnan(x)) return NAN;
+    if(x < -FLT_MAX) return -INFINITY;
+    if(x > FLT_MAX) return FLT_MAX;
+    float f = (float)x;
+    return (double)f > x ? nextafterf(f, -INFINITY) : f;
+  }
+
+  static float round_up(double x)
+  {
+    if(std::isnan(x)) return NAN;
+    if(x > FLT_MAX) return INFINITY;
+    if(x < -FLT_MAX) return -FLT_MAX;
+    float f = (float)x;
+    return (double)f < x ? nextafterf(f, INFINITY) : f;
+  }
+
+  static void push_interval(vector<float>& v, const Interval& x)
+  {
+    if(x.is_empty())
+    {
+      v.push_back(NAN);
+      v.push_back(NAN);
+    }
+
+    else
+    {
+      v.push_back(round_down(x.lb()));
+      v.push_back(round_up(x.ub()));
+    }
+  }
+
+  static const Interval make_interval(float lb, float ub)
+  {
+    if(std::isnan(lb) || std::isnan(ub))
+      return Interval::EMPTY_SET;
+    return Interval(lb, ub);
+  }
+
+  // Public methods
+
+    // Definition
+
+    CompactTube::CompactTube()
+    {
+
+    }
+
+    CompactTube::CompactTube(const Tube& x)
+    {
+      int n = x.nb_slices();
+      m_v_t.reserve(n + 1);
+      m_v_codomains.reserve(2 * n);
+      m_v_gates.reserve(2 * (n + 1));
+
+      push_interval(m_v_gates, x.first_slice()->input_gate());
+
+      for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        m_v_t.push_back(s->tdomain().lb());
+        push_interval(m_v_codomains, s->codomain());
+        push_interval(m_v_gates, s->output_gate());
+      }
+
+      m_v_t.push_back(x.tdomain().ub());
+    }
+
+    CompactTube::CompactTube(const string& binary_file_name)
+    {
+      ifstream bin_file(binary_file_name.c_str(), ios::in | ios::binary);
+
+      if(!bin_file.is_open())
+        throw Exception("CompactTube::CompactTube()", "error while opening file \"" + binary_file_name + "\"");
+
+      CompactTube *ptr;
+      deserialize_CompactTube(bin_file, ptr);
+      *this = *ptr;
+      delete ptr;
+      bin_file.close();
+    }
+
+    int CompactTube::nb_slices() const
+    {
+      return m_v_t.size() - 1;
+    }
+
+    const Interval CompactTube::tdomain() const
+    {
+      return Interval(m_v_t.front(), m_v_t.back());
+    }
+
+    const Interval CompactTube::slice_tdomain(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return Interval(m_v_t[slice_id], m_v_t[slice_id+1]);
+    }
+
+    size_t CompactTube::memory_size() const
+    {
+      return m_v_t.size() * sizeof(double)
+           + (m_v_codomains.size() + m_v_gates.size()) * sizeof(float);
+    }
+
+    const Tube CompactTube::tube() const
+    {
+      int n = nb_slices();
+      vector<Interval> v_tdomains(n), v_codomains(n);
+      for(int k = 0 ; k < n ; k++)
+      {
+        v_tdomains[k] = slice_tdomain(k);
+        v_codomains[k] = (*this)(k);
+      }
+
+      Tube x(v_tdomains, v_codomains);
+
+      // The gates are intersected with the enclosing codomains, that
+      // contain the original gates: the enclosure property is preserved
+      x.first_slice()->set_input_gate(gate(0));
+      int k = 1;
+      for(Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+        s->set_output_gate(gate(k++));
+
+      return x;
+    }
+
+    // Accessing values
+
+    const Interval CompactTube::operator()(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return make_interval(m_v_codomains[2*slice_id], m_v_codomains[2*slice_id+1]);
+    }
+
+    const Interval CompactTube::operator()(double t) const
+    {
+      assert(tdomain().contains(t));
+
+      // First bound strictly greater than t
+      int k = upper_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+
+      if(m_v_t[k-1] == t) // gate
+        return gate(k-1);
+
+      return (*this)(k-1);
+    }
+
+    // Serialization
+
+    void CompactTube::serialize(const string& binary_file_name) const
+    {
+      ofstream bin_file(binary_file_name.c_str(), ios::out | ios::binary);
+
+      if(!bin_file.is_open())
+        throw Exception("CompactTube::serialize()", "error while writing file \"" + binary_file_name + "\"");
+
+      serialize_CompactTube(bin_file, *this);
+      bin_file.close();
+    }
+
+  // Protected methods
+
+    const Interval CompactTube::gate(int gate_id) const
+    {
+      assert(gate_id >= 0 && gate_id <= nb_slices());
+      return make_interval(m_v_gates[2*gate_id], m_v_gates[2*gate_id+1]);
+    }
+}
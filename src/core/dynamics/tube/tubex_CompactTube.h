@@ -0,0 +1,160 @@
+/**
+ *  \file
+ *  CompactTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_COMPACTTUBE_H__
+#define __TUBEX_COMPACTTUBE_H__
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include "ibex_Interval.h"
+
+namespace tubex
+{
+  class Tube;
+
+  /**
+   * \class CompactTube
+   * \brief Compact storage of a one dimensional tube \f$[x](\cdot)\f$, for archiving purposes
+   *
+   * The codomains and the gates are stored with single precision bounds, rounded
+   * outward: the lower bounds downward, the upper bounds upward. The compact tube
+   * is then a sound enclosure of the original one: \f$[x](\cdot)\subseteq[x_c](\cdot)\f$.
+   * The bounds of the slices are kept in double precision, so that the slicing
+   * is unchanged.
+   *
+   * The memory footprint is about 24 bytes per slice, while a Tube allocates its
+   * slices and gates separately. The related binary format is the version 3 of
+   * the serialization of tubes, see serialize_Tube().
+   *
+   * \note A compact tube cannot be contracted: convert it into a Tube beforehand, see tube().
+   */
+  class CompactTube
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates the compact enclosure of a tube
+       *
+       * \param x Tube to be stored
+       */
+      explicit CompactTube(const Tube& x);
+
+      /**
+       * \brief Restores a compact tube from a binary file
+       *
+       * \note The file may have been written by serialize(), or by Tube::serialize()
+       *       with any supported version number.
+       *
+       * \param binary_file_name path to the binary file
+       */
+      explicit CompactTube(const std::string& binary_file_name);
+
+      /**
+       * \brief Returns the number of slices of this tube
+       *
+       * \return an integer
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal domain of this tube
+       *
+       * \return an Interval object \f$[t_0,t_f]\f$
+       */
+      const ibex::Interval tdomain() const;
+
+      /**
+       * \brief Returns the temporal domain of a slice
+       *
+       * \param slice_id the index of the slice
+       * \return an Interval object
+       */
+      const ibex::Interval slice_tdomain(int slice_id) const;
+
+      /**
+       * \brief Returns the number of bytes used by the values of this tube
+       *
+       * \return the size, in bytes
+       */
+      size_t memory_size() const;
+
+      /**
+       * \brief Converts this compact tube into a Tube object
+       *
+       * \return the Tube \f$[x_c](\cdot)\f$, that encloses the original tube
+       */
+      const Tube tube() const;
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the value of the ith slice
+       *
+       * \param slice_id the index of the ith slice
+       * \return Interval value of \f$[x_c](i)\f$
+       */
+      const ibex::Interval operator()(int slice_id) const;
+
+      /**
+       * \brief Returns the evaluation of this tube at \f$t\f$
+       *
+       * \note The value of a gate is returned if \f$t\f$ is a bound of a slice.
+       *
+       * \param t the temporal key (double, must belong to the tube's tdomain)
+       * \return Interval value of \f$[x_c](t)\f$
+       */
+      const ibex::Interval operator()(double t) const;
+
+      /// @}
+      /// \name Serialization
+      /// @{
+
+      /**
+       * \brief Serializes this compact tube (version 3 of the serialization of tubes)
+       *
+       * \param binary_file_name name of the output file (default value: "x.tube")
+       */
+      void serialize(const std::string& binary_file_name = "x.tube") const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Creates an empty compact tube, to be deserialized
+       */
+      CompactTube();
+
+      /**
+       * \brief Returns the value of the ith gate
+       *
+       * \param gate_id the index of the gate, from 0 (\f$t_0\f$) to nb_slices() (\f$t_f\f$)
+       * \return Interval value of the gate
+       */
+      const ibex::Interval gate(int gate_id) const;
+
+      std::vector<double> m_v_t; //!< bounds of the slices, from \f$t_0\f$ to \f$t_f\f$
+      std::vector<float> m_v_codomains; //!< outward rounded bounds of the codomains of the slices
+      std::vector<float> m_v_gates; //!< outward rounded bounds of the gates
+
+      friend void serialize_CompactTube(std::ofstream& bin_file, const CompactTube& tube);
+      friend void deserialize_CompactTube(std::ifstream& bin_file, CompactTube *&tube);
+      friend class CompactTubeVector;
+  };
+}
+
+#endif
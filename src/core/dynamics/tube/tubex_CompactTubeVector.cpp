@@ -0,0 +1,99 @@
+/**
+ *  CompactTubeVector class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <fstream>
+#include "tubex_CompactTubeVector.h"
+#include "tubex_TubeVector.h"
+#include "tubex_serialize_tubes.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Public methods
+
+    // Definition
+
+    CompactTubeVector::CompactTubeVector(const TubeVector& x)
+    {
+      m_v_tubes.reserve(x.size());
+      for(int i = 0 ; i < x.size() ; i++)
+        m_v_tubes.push_back(CompactTube(x[i]));
+    }
+
+    CompactTubeVector::CompactTubeVector(const string& binary_file_name)
+    {
+      ifstream bin_file(binary_file_name.c_str(), ios::in | ios::binary);
+
+      if(!bin_file.is_open())
+        throw Exception("CompactTubeVector::CompactTubeVector()", "error while opening file \"" + binary_file_name + "\"");
+
+      // Same structure as for TubeVector objects
+      short int size;
+      bin_file.read((char*)&size, sizeof(short int));
+
+      for(int i = 0 ; i < size ; i++)
+      {
+        CompactTube *ptr;
+        deserialize_CompactTube(bin_file, ptr);
+        m_v_tubes.push_back(*ptr);
+        delete ptr;
+      }
+
+      bin_file.close();
+    }
+
+    int CompactTubeVector::size() const
+    {
+      return m_v_tubes.size();
+    }
+
+    size_t CompactTubeVector::memory_size() const
+    {
+      size_t memory = 0;
+      for(const auto& x : m_v_tubes)
+        memory += x.memory_size();
+      return memory;
+    }
+
+    const TubeVector CompactTubeVector::tube_vector() const
+    {
+      assert(size() > 0);
+      TubeVector x(size(), m_v_tubes[0].tube());
+      for(int i = 1 ; i < size() ; i++)
+        x[i] = m_v_tubes[i].tube();
+      return x;
+    }
+
+    const CompactTube& CompactTubeVector::operator[](int index) const
+    {
+      assert(index >= 0 && index < size());
+      return m_v_tubes[index];
+    }
+
+    // Serialization
+
+    void CompactTubeVector::serialize(const string& binary_file_name) const
+    {
+      ofstream bin_file(binary_file_name.c_str(), ios::out | ios::binary);
+
+      if(!bin_file.is_open())
+        throw Exception("CompactTubeVector::serialize()", "error while writing file \"" + binary_file_name + "\"");
+
+      short int size = m_v_tubes.size();
+      bin_file.write((const char*)&size, sizeof(short int));
+      for(const auto& x : m_v_tubes)
+        serialize_CompactTube(bin_file, x);
+
+      bin_file.close();
+    }
+}
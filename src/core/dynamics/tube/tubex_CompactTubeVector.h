@@ -0,0 +1,102 @@
+/**
+ *  \file
+ *  CompactTubeVector class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_COMPACTTUBEVECTOR_H__
+#define __TUBEX_COMPACTTUBEVECTOR_H__
+
+#include <vector>
+#include <string>
+#include "tubex_CompactTube.h"
+
+namespace tubex
+{
+  class TubeVector;
+
+  /**
+   * \class CompactTubeVector
+   * \brief Compact storage of a n-dimensional tube \f$[\mathbf{x}](\cdot)\f$, for archiving purposes
+   *
+   * Each component is stored as a CompactTube: the values are rounded outward to
+   * single precision, and the resulting tube encloses the original one.
+   */
+  class CompactTubeVector
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates the compact enclosure of a n-dimensional tube
+       *
+       * \param x TubeVector to be stored
+       */
+      explicit CompactTubeVector(const TubeVector& x);
+
+      /**
+       * \brief Restores a compact tube from a binary file
+       *
+       * \note The file may have been written by serialize(), or by TubeVector::serialize()
+       *       with any supported version number.
+       *
+       * \param binary_file_name path to the binary file
+       */
+      explicit CompactTubeVector(const std::string& binary_file_name);
+
+      /**
+       * \brief Returns the dimension of the tube
+       *
+       * \return n
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the number of bytes used by the values of this tube
+       *
+       * \return the size, in bytes
+       */
+      size_t memory_size() const;
+
+      /**
+       * \brief Converts this compact tube into a TubeVector object
+       *
+       * \return the TubeVector \f$[\mathbf{x}_c](\cdot)\f$, that encloses the original tube
+       */
+      const TubeVector tube_vector() const;
+
+      /**
+       * \brief Returns a const reference to the ith component of this tube
+       *
+       * \param index the index of this ith component
+       * \return a const reference to the ith component
+       */
+      const CompactTube& operator[](int index) const;
+
+      /// @}
+      /// \name Serialization
+      /// @{
+
+      /**
+       * \brief Serializes this compact tube (version 3 of the serialization of tubes)
+       *
+       * \param binary_file_name name of the output file (default value: "x.tube")
+       */
+      void serialize(const std::string& binary_file_name = "x.tube") const;
+
+      /// @}
+
+    protected:
+
+      std::vector<CompactTube> m_v_tubes; //!< components
+  };
+}
+
+#endif
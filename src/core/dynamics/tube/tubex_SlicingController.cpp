@@ -0,0 +1,286 @@
+/** 
+ *  SlicingController class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "tubex_SlicingController.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Public methods
+
+    // Definition
+
+    SlicingController::SlicingController(int max_nb_slices, double split_threshold, double merge_threshold)
+      : m_max_nb_slices(max_nb_slices), m_split_threshold(split_threshold), m_merge_threshold(merge_threshold)
+    {
+      assert(max_nb_slices > 0);
+      assert(split_threshold >= 0.);
+      assert(merge_threshold >= 0.);
+    }
+
+    void SlicingController::set_min_dt(double min_dt)
+    {
+      assert(min_dt >= 0.);
+      m_min_dt = min_dt;
+    }
+
+    int SlicingController::max_nb_slices() const
+    {
+      return m_max_nb_slices;
+    }
+
+    // Adapting the slicing
+
+    int SlicingController::adapt(Tube& x) const
+    {
+      return adapt(vector<Tube*>(1, &x), vector<Tube*>());
+    }
+
+    int SlicingController::adapt(Tube& x, Tube& v) const
+    {
+      assert(Tube::same_slicing(x, v));
+      return adapt(vector<Tube*>(1, &x), vector<Tube*>(1, &v));
+    }
+
+    int SlicingController::adapt(TubeVector& x) const
+    {
+      vector<Tube*> v_x;
+      for(int i = 0 ; i < x.size() ; i++)
+        v_x.push_back(&x[i]);
+      return adapt(v_x, vector<Tube*>());
+    }
+
+    int SlicingController::adapt(TubeVector& x, TubeVector& v) const
+    {
+      assert(x.size() == v.size());
+      assert(TubeVector::same_slicing(x, v));
+
+      vector<Tube*> v_x, v_v;
+      for(int i = 0 ; i < x.size() ; i++)
+      {
+        v_x.push_back(&x[i]);
+        v_v.push_back(&v[i]);
+      }
+      return adapt(v_x, v_v);
+    }
+
+    void SlicingController::plan(const vector<const Tube*>& v_x, const vector<const Tube*>& v_v,
+                                 vector<double>& v_split_t, vector<double>& v_merge_t) const
+    {
+      assert(!v_x.empty());
+      assert(v_v.empty() || v_v.size() == v_x.size());
+
+      v_split_t.clear();
+      v_merge_t.clear();
+
+      int n = v_x[0]->nb_slices();
+
+      // Scores of the slices (split) and of the gates between them (merge)
+
+        vector<const Slice*> v_sx, v_sv(v_x.size(), NULL);
+        for(size_t i = 0 ; i < v_x.size() ; i++)
+        {
+          assert(v_x[i]->nb_slices() == n && "tubes must share the same slicing");
+          v_sx.push_back(v_x[i]->first_slice());
+          if(!v_v.empty() && v_v[i] != NULL)
+            v_sv[i] = v_v[i]->first_slice();
+        }
+
+        vector<Interval> v_tdomains(n);
+        vector<double> v_split_score(n, -1.), v_merge_score(max(0, n - 1), POS_INFINITY);
+
+        for(int k = 0 ; k < n ; k++)
+        {
+          v_tdomains[k] = v_sx[0]->tdomain();
+          double split = 0., merge = 0.;
+
+          for(size_t i = 0 ; i < v_x.size() ; i++)
+          {
+            split = max(split, split_score(v_sx[i], v_sv[i]));
+
+            if(k < n - 1)
+            {
+              merge = max(merge, merge_score(v_sx[i], v_sx[i]->next_slice()));
+              if(v_sv[i] != NULL)
+                merge = max(merge, merge_score(v_sv[i], v_sv[i]->next_slice()));
+            }
+
+            v_sx[i] = v_sx[i]->next_slice();
+            if(v_sv[i] != NULL)
+              v_sv[i] = v_sv[i]->next_slice();
+          }
+
+          if(split > m_split_threshold && v_tdomains[k].diam() / 2. >= m_min_dt
+            && v_tdomains[k].interior_contains(v_tdomains[k].mid()))
+            v_split_score[k] = split;
+
+          if(k < n - 1)
+            v_merge_score[k] = merge;
+        }
+
+      // Splits, and merges of nearly identical slices (not chained,
+      // so that the differences do not accumulate)
+
+        vector<bool> v_split(n, false), v_merge(max(0, n - 1), false);
+        int nb_slices = n;
+
+        for(int k = 0 ; k < n ; k++)
+          if(v_split_score[k] >= 0.)
+          {
+            v_split[k] = true;
+            nb_slices++;
+          }
+
+        for(int k = 0 ; k < n - 1 ; k++)
+          if(v_merge_score[k] <= m_merge_threshold && !v_split[k] && !v_split[k+1] && (k == 0 || !v_merge[k-1]))
+          {
+            v_merge[k] = true;
+            nb_slices--;
+          }
+
+      // Budget: the splits of lower interest are dropped first,
+      // then the most similar neighbours are merged
+
+        if(nb_slices > m_max_nb_slices)
+        {
+          vector<int> v_ids;
+          for(int k = 0 ; k < n ; k++)
+            if(v_split[k])
+              v_ids.push_back(k);
+
+          stable_sort(v_ids.begin(), v_ids.end(),
+            [&v_split_score](int i, int j) { return v_split_score[i] < v_split_score[j]; });
+
+          for(size_t j = 0 ; j < v_ids.size() && nb_slices > m_max_nb_slices ; j++)
+          {
+            v_split[v_ids[j]] = false;
+            nb_slices--;
+          }
+        }
+
+        if(nb_slices > m_max_nb_slices)
+        {
+          vector<int> v_ids;
+          for(int k = 0 ; k < n - 1 ; k++)
+            if(!v_merge[k] && !v_split[k] && !v_split[k+1])
+              v_ids.push_back(k);
+
+          stable_sort(v_ids.begin(), v_ids.end(),
+            [&v_merge_score](int i, int j) { return v_merge_score[i] < v_merge_score[j]; });
+
+          for(size_t j = 0 ; j < v_ids.size() && nb_slices > m_max_nb_slices ; j++)
+          {
+            v_merge[v_ids[j]] = true;
+            nb_slices--;
+          }
+        }
+
+      // Resulting times
+
+        for(int k = 0 ; k < n ; k++)
+        {
+          if(v_split[k])
+            v_split_t.push_back(v_tdomains[k].mid());
+          if(k < n - 1 && v_merge[k])
+            v_merge_t.push_back(v_tdomains[k].ub());
+        }
+    }
+
+    void SlicingController::apply(const vector<Tube*>& v_tubes,
+                                  const vector<double>& v_split_t, const vector<double>& v_merge_t)
+    {
+      for(auto& x : v_tubes)
+      {
+        size_t i_split = 0, i_merge = 0;
+
+        for(Slice *s = x->first_slice() ; s != NULL ; )
+        {
+          Slice *next_s = s->next_slice();
+
+          if(i_merge < v_merge_t.size() && s->tdomain().lb() == v_merge_t[i_merge])
+          {
+            x->remove_gate(s); // s is deleted
+            i_merge++;
+          }
+
+          else if(i_split < v_split_t.size() && s->tdomain().interior_contains(v_split_t[i_split]))
+          {
+            x->sample(v_split_t[i_split], s);
+            i_split++;
+          }
+
+          s = next_s;
+        }
+
+        assert(i_split == v_split_t.size() && i_merge == v_merge_t.size() && "unexpected slicing");
+      }
+    }
+
+  // Protected methods
+
+    int SlicingController::adapt(const vector<Tube*>& v_x, const vector<Tube*>& v_v) const
+    {
+      vector<double> v_split_t, v_merge_t;
+      plan(vector<const Tube*>(v_x.begin(), v_x.end()), vector<const Tube*>(v_v.begin(), v_v.end()),
+           v_split_t, v_merge_t);
+
+      vector<Tube*> v_tubes(v_x);
+      v_tubes.insert(v_tubes.end(), v_v.begin(), v_v.end());
+      apply(v_tubes, v_split_t, v_merge_t);
+
+      return v_split_t.size() + v_merge_t.size();
+    }
+
+    double SlicingController::split_score(const Slice *x, const Slice *v)
+    {
+      const Interval& y = x->codomain();
+      if(y.is_empty())
+        return 0.;
+
+      // Width of the codomain that is not explained by the gates
+      Interval gates = x->input_gate() | x->output_gate();
+      double score;
+
+      if(y.is_unbounded())
+        score = gates.is_unbounded() ? 0. : POS_INFINITY;
+      else
+        score = y.diam() - (gates.is_empty() ? 0. : gates.diam());
+
+      // Bounded by the possible variation of the trajectories over the slice
+      if(v != NULL && !v->codomain().is_empty())
+        score = min(score, v->codomain().mag() * x->tdomain().diam());
+
+      return score;
+    }
+
+    double SlicingController::merge_score(const Slice *s1, const Slice *s2)
+    {
+      const Interval& y1 = s1->codomain();
+      const Interval& y2 = s2->codomain();
+
+      if(y1.is_empty() || y2.is_empty())
+        return y1 == y2 ? 0. : POS_INFINITY;
+
+      double score = max(y1.lb() == y2.lb() ? 0. : fabs(y1.lb() - y2.lb()),
+                         y1.ub() == y2.ub() ? 0. : fabs(y1.ub() - y2.ub()));
+
+      // Information provided by the gate that would be removed
+      const Interval& gate = s1->output_gate();
+      Interval hull = y1 | y2;
+      if(!hull.is_unbounded() && !gate.is_empty())
+        score = max(score, hull.diam() - gate.diam());
+
+      return score;
+    }
+}
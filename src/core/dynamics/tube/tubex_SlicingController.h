@@ -0,0 +1,165 @@
+/**
+ *  \file
+ *  SlicingController class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SLICINGCONTROLLER_H__
+#define __TUBEX_SLICINGCONTROLLER_H__
+
+#include <vector>
+#include "tubex_Tube.h"
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * \class SlicingController
+   * \brief Adaptive slicing of tubes, driven by the precision that
+   *        slices could gain from a finer sampling
+   *
+   * A slice is split in two halves when its codomain is significantly wider
+   * than its gates, that is when a finer slicing could help contractors
+   * (if a derivative is known, the width is also bounded by the possible
+   * variation over the slice). Two neighbouring slices are merged when their
+   * codomains are nearly identical. A budget bounds the number of slices:
+   * the splits of lower interest are then dropped, and the most similar
+   * neighbours are merged first.
+   *
+   * Tubes given together are assumed to share the same slicing, which is
+   * preserved. The controller can be used between two contraction rounds
+   * of a ContractorNetwork, see ContractorNetwork::adapt_slicing().
+   */
+  class SlicingController
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a controller
+       *
+       * \param max_nb_slices maximal number of slices of each tube
+       * \param split_threshold width above which a slice is split
+       * \param merge_threshold maximal difference between the bounds of two merged slices
+       */
+      SlicingController(int max_nb_slices, double split_threshold, double merge_threshold = 0.);
+
+      /**
+       * \brief Sets the smallest temporal width of the slices created by a split
+       *
+       * \param min_dt minimal width (0 by default)
+       */
+      void set_min_dt(double min_dt);
+
+      /**
+       * \brief Returns the maximal number of slices
+       *
+       * \return the budget
+       */
+      int max_nb_slices() const;
+
+      /// @}
+      /// \name Adapting the slicing
+      /// @{
+
+      /**
+       * \brief Adapts the slicing of a tube
+       *
+       * \param x the tube
+       * \return the number of changes (splits and merges)
+       */
+      int adapt(Tube& x) const;
+
+      /**
+       * \brief Adapts the slicing of a tube and of its derivative
+       *
+       * \param x the tube
+       * \param v the derivative of \f$x(\cdot)\f$, with the same slicing
+       * \return the number of changes (splits and merges)
+       */
+      int adapt(Tube& x, Tube& v) const;
+
+      /**
+       * \brief Adapts the slicing of a tube vector
+       *
+       * \param x the tube vector
+       * \return the number of changes (splits and merges)
+       */
+      int adapt(TubeVector& x) const;
+
+      /**
+       * \brief Adapts the slicing of a tube vector and of its derivative
+       *
+       * \param x the tube vector
+       * \param v the derivative of \f$\mathbf{x}(\cdot)\f$, with the same slicing
+       * \return the number of changes (splits and merges)
+       */
+      int adapt(TubeVector& x, TubeVector& v) const;
+
+      /**
+       * \brief Computes the changes of slicing of a set of tubes sharing the same slicing
+       *
+       * \param v_x tubes
+       * \param v_v derivatives of the tubes (`NULL` if unknown), or empty
+       * \param v_split_t times of the sampling to be added, in increasing order
+       * \param v_merge_t times of the gates to be removed, in increasing order
+       */
+      void plan(const std::vector<const Tube*>& v_x, const std::vector<const Tube*>& v_v,
+                std::vector<double>& v_split_t, std::vector<double>& v_merge_t) const;
+
+      /**
+       * \brief Applies changes of slicing computed by plan()
+       *
+       * \param v_tubes tubes sharing the same slicing
+       * \param v_split_t times of the sampling to be added, in increasing order
+       * \param v_merge_t times of the gates to be removed, in increasing order
+       */
+      static void apply(const std::vector<Tube*>& v_tubes,
+                        const std::vector<double>& v_split_t, const std::vector<double>& v_merge_t);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Adapts the slicing of tubes and of their derivatives
+       *
+       * \param v_x tubes sharing the same slicing
+       * \param v_v derivatives of the tubes, or empty
+       * \return the number of changes (splits and merges)
+       */
+      int adapt(const std::vector<Tube*>& v_x, const std::vector<Tube*>& v_v) const;
+
+      /**
+       * \brief Evaluates the interest of splitting a slice
+       *
+       * \param x slice
+       * \param v slice of the derivative, or `NULL`
+       * \return width of the codomain not explained by the gates
+       */
+      static double split_score(const Slice *x, const Slice *v);
+
+      /**
+       * \brief Evaluates the difference between two neighbouring slices
+       *
+       * \param s1 first slice
+       * \param s2 next slice
+       * \return largest difference between their bounds
+       */
+      static double merge_score(const Slice *s1, const Slice *s2);
+
+      int m_max_nb_slices; //!< budget
+      double m_split_threshold; //!< width above which a slice is split
+      double m_merge_threshold; //!< difference below which slices are merged
+      double m_min_dt = 0.; //!< smallest width of split slices
+  };
+}
+
+#endif
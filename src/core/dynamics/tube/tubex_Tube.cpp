@@ -8,7 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "tubex_Tube.h"
+#include "tubex_TubeVectorGrid.h"
+#include "tubex_perf.h"
 #include "tubex_Exception.h"
 #include "tubex_CtcDeriv.h"
 #include "tubex_CtcEval.h"
@@ -207,6 +210,9 @@ namespace tubex
     {
       // Destroying already existing structure
 
+        delete_synthesis_tree(); // before the slices, that are referenced by the tree
+        m_last_slice = NULL;
+
         Slice *prev_slice, *slice = first_slice();
         while(slice != NULL)
         {
@@ -214,8 +220,6 @@ namespace tubex
           delete slice;
           slice = next_slice;
         }
-
-        delete_synthesis_tree();
       
       // Creating new structure
 
@@ -257,7 +261,7 @@ namespace tubex
     const Interval Tube::tdomain() const
     {
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->tdomain();
+        return m_synthesis_tree.load()->tdomain();
       
       else
       {
@@ -303,7 +307,7 @@ namespace tubex
     int Tube::nb_slices() const
     {
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->nb_slices();
+        return m_synthesis_tree.load()->nb_slices();
       
       else
       {
@@ -325,7 +329,7 @@ namespace tubex
       assert(slice_id >= 0 && slice_id < nb_slices());
 
       if(m_synthesis_tree != NULL) // fast access
-        return m_synthesis_tree->slice(slice_id);
+        return m_synthesis_tree.load()->slice(slice_id);
       
       else
       {
@@ -353,7 +357,7 @@ namespace tubex
       assert(tdomain().contains(t));
 
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->slice(m_synthesis_tree->time_to_index(t));
+        return m_synthesis_tree.load()->slice(m_synthesis_tree.load()->time_to_index(t));
       
       else
       {
@@ -388,14 +392,18 @@ namespace tubex
     const Slice* Tube::last_slice() const
     {
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->slice(nb_slices() - 1);
+        return m_synthesis_tree.load()->slice(nb_slices() - 1);
       
       else
       {
-        for(const Slice *s = first_slice() ; true ; s = s->next_slice())
-          if(s->next_slice() == NULL)
-            return s;
-        return NULL;
+        Slice *last_slice = m_last_slice;
+        if(last_slice == NULL)
+        {
+          for(Slice *s = m_first_slice ; s != NULL ; s = s->next_slice())
+            last_slice = s;
+          m_last_slice = last_slice; // same value for concurrent queries
+        }
+        return last_slice;
       }
     }
 
@@ -481,7 +489,7 @@ namespace tubex
       assert(tdomain().contains(t));
 
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->time_to_index(t);
+        return m_synthesis_tree.load()->time_to_index(t);
       
       else
       {
@@ -547,6 +555,9 @@ namespace tubex
         Slice::chain_slices(new_slice, next_slice);
         Slice::chain_slices(slice_to_be_sampled, new_slice);
         new_slice->set_input_gate(new_slice->codomain());
+
+        if(m_last_slice == slice_to_be_sampled)
+          m_last_slice = new_slice;
       }
     }
 
@@ -572,6 +583,48 @@ namespace tubex
         sample(s->tdomain().ub());
     }
 
+    void Tube::push_back_slice(double dt, const Interval& codomain)
+    {
+      assert(dt > 0.);
+      assert(m_first_slice != NULL);
+
+      delete_synthesis_tree();
+
+      Slice *last = last_slice();
+      Slice *new_slice = new Slice(Interval(last->tdomain().ub(), last->tdomain().ub() + dt), codomain);
+
+      // The input gate is shared with the previous slice
+      delete new_slice->m_input_gate;
+      new_slice->m_input_gate = NULL;
+      Slice::chain_slices(last, new_slice);
+      *new_slice->m_input_gate &= codomain;
+
+      m_last_slice = new_slice;
+      m_tdomain = Interval(m_tdomain.lb(), new_slice->tdomain().ub());
+    }
+
+    int Tube::drop_front_slices(double t)
+    {
+      assert(t < tdomain().ub() && "at least one slice must remain");
+
+      int nb_removed = 0;
+      if(m_first_slice->tdomain().ub() > t)
+        return nb_removed;
+
+      delete_synthesis_tree();
+
+      while(m_first_slice->tdomain().ub() <= t)
+      {
+        Slice *next_slice = m_first_slice->next_slice();
+        delete m_first_slice; // the shared output gate remains as the input gate of the next slice
+        m_first_slice = next_slice;
+        nb_removed++;
+      }
+
+      m_tdomain = Interval(m_first_slice->tdomain().lb(), m_tdomain.ub());
+      return nb_removed;
+    }
+
     bool Tube::gate_exists(double t) const
     {
       return slice(t)->tdomain().lb() == t || t == tdomain().ub();
@@ -620,7 +673,7 @@ namespace tubex
         return operator()(t.lb());
 
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->operator()(t);
+        return m_synthesis_tree.load()->operator()(t);
       
       else
       {
@@ -640,7 +693,7 @@ namespace tubex
     const pair<Interval,Interval> Tube::eval(const Interval& t) const
     {
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->eval(t);
+        return m_synthesis_tree.load()->eval(t);
       
       else
       {
@@ -701,18 +754,100 @@ namespace tubex
     const Interval Tube::invert(const Interval& y, const Interval& search_tdomain) const
     {
       if(m_synthesis_tree != NULL) // fast inversion
-        return m_synthesis_tree->invert(y, search_tdomain);
+        return m_synthesis_tree.load()->invert(y, search_tdomain);
+
+      Interval invert = Interval::EMPTY_SET;
+      Interval intersection = search_tdomain & tdomain();
+      if(intersection.is_empty())
+        return Interval::EMPTY_SET;
+
+      for(const Slice *s = slice(intersection.lb()) ; s != NULL && s->tdomain().lb() < intersection.ub() ; s = s->next_slice())
+        invert |= s->invert(y, intersection);
 
-      Tube v(*this, Interval::ALL_REALS); // todo: optimize this
-      return invert(y, v, search_tdomain);
+      return invert;
     }
 
     void Tube::invert(const Interval& y, vector<Interval> &v_t, const Interval& search_tdomain) const
     {
-      // todo: fast inversion with binary tree considering derivative information
-      Tube v(*this, Interval::ALL_REALS); // todo: optimize this
+      if(m_synthesis_tree != NULL) // subtrees that cannot reach y are not explored
+      {
+        m_synthesis_tree.load()->invert(y, v_t, search_tdomain);
+        return;
+      }
+
       v_t.clear();
-      invert(y, v_t, v, search_tdomain);
+
+      Interval invert = Interval::EMPTY_SET;
+      Interval intersection = search_tdomain & tdomain();
+      if(intersection.is_empty())
+        return;
+
+      for(const Slice *s = slice(intersection.lb()) ; s != NULL && s->tdomain().lb() <= intersection.ub() ; s = s->next_slice())
+      {
+        Interval local_invert = s->invert(y, intersection);
+        if(local_invert.is_empty() && !invert.is_empty())
+        {
+          v_t.push_back(invert);
+          invert.set_empty();
+        }
+
+        else
+          invert |= local_invert;
+      }
+
+      if(!invert.is_empty())
+        v_t.push_back(invert);
+    }
+
+    void Tube::invert(const vector<Interval>& v_y, vector<Interval> &v_t, const Interval& search_tdomain) const
+    {
+      v_t = vector<Interval>(v_y.size(), Interval::EMPTY_SET);
+
+      if(m_synthesis_tree != NULL) // fast inversion
+      {
+        for(size_t i = 0 ; i < v_y.size() ; i++)
+          v_t[i] = m_synthesis_tree.load()->invert(v_y[i], search_tdomain);
+        return;
+      }
+
+      Interval intersection = search_tdomain & tdomain();
+      if(intersection.is_empty())
+        return;
+
+      // Codomains sorted by lower bounds: for a given slice, only
+      // a prefix of them can intersect the codomain of the slice
+
+      vector<size_t> v_ids;
+      for(size_t i = 0 ; i < v_y.size() ; i++)
+      {
+        if(v_y[i].is_empty()) // particular case, not sorted
+          v_t[i] = invert(v_y[i], search_tdomain);
+        else
+          v_ids.push_back(i);
+      }
+
+      sort(v_ids.begin(), v_ids.end(),
+        [&v_y](size_t a, size_t b) { return v_y[a].lb() < v_y[b].lb(); });
+
+      for(const Slice *s = slice(intersection.lb()) ; s != NULL && s->tdomain().lb() < intersection.ub() ; s = s->next_slice())
+      {
+        Interval codomain = s->codomain() | s->input_gate() | s->output_gate();
+
+        for(size_t j = 0 ; j < v_ids.size() ; j++)
+        {
+          size_t i = v_ids[j];
+
+          if(!codomain.is_empty())
+          {
+            if(v_y[i].lb() > codomain.ub())
+              break; // next codomains are above the slice
+            if(v_y[i].ub() < codomain.lb())
+              continue;
+          }
+
+          v_t[i] |= s->invert(v_y[i], intersection);
+        }
+      }
     }
 
     const Interval Tube::invert(const Interval& y, const Tube& v, const Interval& search_tdomain) const
@@ -855,9 +990,10 @@ namespace tubex
       while(s_x != NULL)
       {
         ConvexPolygon p = s_x->polygon(*s_v);
+        const VertexArray& pts = p.vertex_array();
 
-        for(size_t i = 0 ; i < p.vertices().size() ; i++)
-          thicknesses.set(Slice::diam(s_x->interpol(p[i][0], *s_v)), p[i][1]);
+        for(int i = 0 ; i < p.nb_vertices() ; i++)
+          thicknesses.set(Slice::diam(s_x->interpol(pts.x(i), *s_v)), pts.y(i));
 
         s_x = s_x->next_slice();
         s_v = s_v->next_slice();
@@ -1123,9 +1259,20 @@ namespace tubex
 
       Slice *s2 = slice(t);
       assert(s2->tdomain().lb() == t && "the gate must already exist");
-      Slice *s1 = s2->prev_slice();
+      remove_gate(s2);
+    }
+
+    void Tube::remove_gate(Slice *slice_after_gate)
+    {
+      assert(slice_after_gate != NULL);
+      assert(slice_after_gate->prev_slice() != NULL && "cannot remove initial gate");
+
+      delete_synthesis_tree(); // todo: update tree if created, instead of delete
 
-      Slice::merge_slices(s1, s2);
+      Slice *s1 = slice_after_gate->prev_slice();
+      if(m_last_slice == slice_after_gate)
+        m_last_slice = s1;
+      Slice::merge_slices(s1, slice_after_gate);
     }
 
     // Bisection
@@ -1167,9 +1314,9 @@ namespace tubex
     // Synthesis tree
     
     #ifdef USE_TUBE_TREE
-    bool Tube::s_enable_syntheses = true;
+    atomic<bool> Tube::s_enable_syntheses(true);
     #else
-    bool Tube::s_enable_syntheses = false;
+    atomic<bool> Tube::s_enable_syntheses(false);
     #endif
     
     void Tube::enable_syntheses(bool enable)
@@ -1233,56 +1380,24 @@ namespace tubex
       assert(tdomain().is_superset(t));
 
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->partial_integral(t);
-      
-      else
-      {
-        Interval intv_t;
-        const Slice *slice = first_slice();
-        pair<Interval,Interval> p_integ
-          = make_pair(0., 0.), p_integ_uncertain(p_integ);
+        return m_synthesis_tree.load()->partial_integral(t);
 
-        while(slice != NULL && slice->tdomain().lb() < t.ub())
+      else // prefix sums, lazily computed
+      {
+        TubeIntegralCache *cache = m_integral_cache;
+        if(cache == NULL)
         {
-          if(slice->codomain().is_empty())
-            return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
-
-          if(slice->codomain().is_unbounded())
-            return make_pair(Interval::ALL_REALS, Interval::ALL_REALS);
-
-          // From t0 to tlb
-
-            intv_t = slice->tdomain() & Interval(tdomain().lb(), t.lb());
-            if(!intv_t.is_empty())
-            {
-              p_integ.first += intv_t.diam() * slice->codomain().lb();
-              p_integ.second += intv_t.diam() * slice->codomain().ub();
-              p_integ_uncertain = p_integ;
-
-              if(intv_t.ub() == t.ub())
-                return p_integ; // end of the integral evaluation
-            }
-
-          // From tlb to tub
-
-            intv_t = slice->tdomain() & t;
-            if(!intv_t.is_empty())
-            {
-              pair<Interval,Interval> p_integ_temp(p_integ_uncertain);
-              p_integ_uncertain.first += Interval(0., intv_t.diam()) * slice->codomain().lb();
-              p_integ_uncertain.second += Interval(0., intv_t.diam()) * slice->codomain().ub();
-            
-              p_integ.first |= p_integ_uncertain.first;
-              p_integ.second |= p_integ_uncertain.second;
-
-              p_integ_uncertain.first = p_integ_temp.first + intv_t.diam() * slice->codomain().lb();
-              p_integ_uncertain.second = p_integ_temp.second + intv_t.diam() * slice->codomain().ub();
-            }
-
-          slice = slice->next_slice();
+          // The cache is created once, and published when complete
+          lock_guard<mutex> lock(m_cache_mutex);
+          cache = m_integral_cache;
+          if(cache == NULL)
+          {
+            cache = new TubeIntegralCache(this);
+            m_integral_cache = cache;
+          }
         }
 
-        return p_integ;
+        return cache->partial_integral(t);
       }
     }
 
@@ -1340,9 +1455,45 @@ namespace tubex
 
     void Tube::enable_synthesis(bool enable) const
     {
+      // The tree is built once, and published when complete:
+      // concurrent queries use it as soon as it is available
+      lock_guard<mutex> lock(m_cache_mutex);
       m_enable_synthesis = enable;
-      if(enable)
-        create_synthesis_tree();
+
+      if(enable && m_synthesis_tree == NULL)
+      {
+        vector<const Slice*> v_slices;
+        for(const Slice* s = first_slice() ; s != NULL ; s = s->next_slice())
+          v_slices.push_back(s);
+        m_synthesis_tree = new TubeTreeSynthesis(this, 0, v_slices.size() - 1, v_slices);
+      }
+    }
+
+    void Tube::freeze() const
+    {
+      TubeTreeSynthesis *tree = m_synthesis_tree;
+
+      if(tree != NULL)
+      {
+        tree->update_values();
+        tree->update_integrals();
+      }
+
+      else
+      {
+        last_slice();
+        partial_integral(tdomain()); // prefix sums over all the slices
+      }
+    }
+
+    bool Tube::is_frozen() const
+    {
+      TubeTreeSynthesis *tree = m_synthesis_tree;
+      if(tree != NULL)
+        return tree->is_up_to_date();
+
+      TubeIntegralCache *cache = m_integral_cache;
+      return m_last_slice != NULL && cache != NULL && cache->is_up_to_date(cache->nb_slices() - 1);
     }
 
     const Tube Tube::hull(const list<Tube>& l_tubes)
@@ -1362,7 +1513,7 @@ namespace tubex
     const IntervalVector Tube::codomain_box() const
     {
       if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->codomain();
+        return m_synthesis_tree.load()->codomain();
       
       else
       {
@@ -1404,6 +1555,7 @@ namespace tubex
     
     void Tube::create_synthesis_tree() const
     {
+      TUBEX_PERF_KERNEL(SYNTHESIS_BUILD);
       m_enable_synthesis = true;
       delete_synthesis_tree();
 
@@ -1418,8 +1570,17 @@ namespace tubex
     {
       if(m_synthesis_tree != NULL)
       {
-        delete m_synthesis_tree;
+        delete m_synthesis_tree.load();
         m_synthesis_tree = NULL;
       }
+
+      if(m_integral_cache != NULL)
+      {
+        delete m_integral_cache.load();
+        m_integral_cache = NULL;
+      }
+
+      if(m_grid != NULL)
+        m_grid->invalidate_structure();
     }
 }
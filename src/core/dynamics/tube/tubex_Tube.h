@@ -15,12 +15,15 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <mutex>
+#include <atomic>
 #include "tubex_TFnc.h"
 #include "tubex_Slice.h"
 #include "tubex_Trajectory.h"
 #include "tubex_serialize_tubes.h"
 #include "tubex_tube_arithmetic.h"
 #include "tubex_TubeTreeSynthesis.h"
+#include "tubex_TubeIntegralCache.h"
 #include "tubex_Polygon.h"
 #include "ibex_BoolInterval.h"
 
@@ -34,12 +37,23 @@ namespace tubex
   class Slice;
   class Trajectory;
   class TubeTreeSynthesis;
+  class TubeVectorGrid;
 
   /**
    * \class Tube
    * \brief One dimensional tube \f$[x](\cdot)\f$, defined as an interval of scalar trajectories
    *
    * \note Use TubeVector for the multi-dimensional case
+   *
+   * \note Concurrency: const methods can be called by several threads
+   *       on the same tube, provided that no thread modifies it meanwhile.
+   *       Lazily computed data (synthesis tree values and integrals,
+   *       prefix sums of integrals, last slice) are updated under a lock
+   *       and published atomically: queries on up-to-date data do not lock.
+   *       A call to freeze() precomputes all these data, so that the const
+   *       methods are lock-free until the next modification of the tube.
+   *       Enabling the synthesis tree is safe during concurrent queries,
+   *       but not its deletion, which occurs on structural changes.
    */
   class Tube : public DynamicalItem
   {
@@ -406,6 +420,32 @@ namespace tubex
        */
       void sample(const Tube& x);
 
+      /**
+       * \brief Appends a new Slice at the end of this tube (growing tube)
+       *
+       * The tdomain of the tube is extended to \f$[t_0,t_f+dt]\f$.
+       * The input gate of the new slice is the output gate of the previous one.
+       *
+       * \note The last slice is cached, so that successive appends are performed in constant time.
+       *       The synthesis tree, if any, is deleted.
+       *
+       * \param dt the width of the tdomain of the new slice
+       * \param codomain the codomain of the new slice (all reals by default)
+       */
+      void push_back_slice(double dt, const ibex::Interval& codomain = ibex::Interval::ALL_REALS);
+
+      /**
+       * \brief Removes the first slices of this tube that are defined before \f$t\f$ (sliding horizon)
+       *
+       * The slices whose tdomain upper bound is lower or equal to \f$t\f$ are deleted.
+       *
+       * \note The synthesis tree, if any, is deleted.
+       *
+       * \param t the temporal key (double, must be lower than the upper bound of the tube's tdomain)
+       * \return the number of removed slices
+       */
+      int drop_front_slices(double t);
+
       /**
        * \brief Tests if a gate exists at time \f$t\f$
        *
@@ -513,6 +553,18 @@ namespace tubex
        */
       void invert(const ibex::Interval& y, std::vector<ibex::Interval> &v_t, const ibex::Interval& search_tdomain = ibex::Interval::ALL_REALS) const;
 
+      /**
+       * \brief Computes the interval inversions \f$[x]^{-1}([y_i])\f$ of several codomains
+       *
+       * \note The slices are swept once for all the codomains. The result is
+       *       the same as calling invert(y, search_tdomain) for each \f$[y_i]\f$.
+       *
+       * \param v_y the interval codomains \f$[y_i]\f$
+       * \param v_t the hulls of \f$[x]^{-1}([y_i])\f$, in the order of `v_y`
+       * \param search_tdomain the optional temporal domain on which the inversions will be performed
+       */
+      void invert(const std::vector<ibex::Interval>& v_y, std::vector<ibex::Interval> &v_t, const ibex::Interval& search_tdomain = ibex::Interval::ALL_REALS) const;
+
       /**
        * \brief Returns the optimal interval inversion \f$[x]^{-1}([y])\f$
        *
@@ -796,6 +848,13 @@ namespace tubex
        */
       void remove_gate(double t);
 
+      /**
+       * \brief Removes the input gate of a slice and merges it with the previous one
+       *
+       * \param slice_after_gate a pointer to a Slice of this tube, that is not the first one
+       */
+      void remove_gate(Slice *slice_after_gate);
+
       /// @}
       /// \name Bisection
       /// @{
@@ -994,6 +1053,24 @@ namespace tubex
        */
       void enable_synthesis(bool enable = true) const;
 
+      /**
+       * \brief Precomputes the lazily computed data of this tube
+       *
+       * \note After this call and until the next modification of the tube,
+       *       the const methods do not write any data and do not lock:
+       *       concurrent queries are then lock-free
+       */
+      void freeze() const;
+
+      /**
+       * \brief Tests whether the lazily computed data of this tube are up-to-date
+       *
+       * \note True after a call to freeze() and until the next modification of the tube
+       *
+       * \return true if the const methods are lock-free
+       */
+      bool is_frozen() const;
+
       /// @}
       /// \name Integration
       /// @{
@@ -1155,22 +1232,32 @@ namespace tubex
 
       /**
        * \brief Deletes the synthesis tree of this tube
+       *
+       * \note Called before any structural change of the tube: the
+       *       integral cache, that relies on the slicing, is also deleted,
+       *       and the shared grid of the related tube vector is invalidated.
        */
       void delete_synthesis_tree() const;
 
       // Class variables:
 
         Slice *m_first_slice = NULL; //!< pointer to the first Slice object of this tube
-        mutable TubeTreeSynthesis *m_synthesis_tree = NULL; //!< pointer to the optional synthesis tree
+        mutable std::atomic<Slice*> m_last_slice{NULL}; //!< cached pointer to the last Slice object of this tube (lazily computed)
+        mutable std::atomic<TubeTreeSynthesis*> m_synthesis_tree{NULL}; //!< pointer to the optional synthesis tree
+        mutable std::atomic<TubeIntegralCache*> m_integral_cache{NULL}; //!< pointer to the prefix sums of integrals, used without synthesis tree
+        mutable std::mutex m_cache_mutex; //!< guards the creation and the updates of the lazily computed data
         mutable bool m_enable_synthesis = Tube::s_enable_syntheses; //!< enables of the use of a synthesis tree
         ibex::Interval m_tdomain; //!< redundant information for fast evaluations
+        TubeVectorGrid *m_grid = NULL; //!< pointer to the optional shared grid of the related tube vector
 
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
       friend class TubeVector;
       friend class CtcEval;
+      friend class TubeTreeSynthesis;
+      friend class TubeVectorGrid;
 
-      static bool s_enable_syntheses;
+      static std::atomic<bool> s_enable_syntheses;
   };
 }
 
@@ -0,0 +1,152 @@
+/**
+ *  TubeIntegralCache class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include "tubex_TubeIntegralCache.h"
+#include "tubex_Tube.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TubeIntegralCache::TubeIntegralCache(const Tube *tube)
+  {
+    assert(tube != NULL);
+
+    for(const Slice *s = tube->first_slice() ; s != NULL ; s = s->next_slice())
+    {
+      assert(s->m_integral_cache == NULL);
+      s->m_integral_cache = this;
+      s->m_integral_cache_id = m_v_slices.size();
+      m_v_slices.push_back(s);
+      m_v_t.push_back(s->tdomain().lb());
+    }
+
+    m_v_sum_lb = vector<Interval>(m_v_slices.size() + 1, Interval(0.));
+    m_v_sum_ub = vector<Interval>(m_v_slices.size() + 1, Interval(0.));
+  }
+
+  TubeIntegralCache::~TubeIntegralCache()
+  {
+    for(size_t i = 0 ; i < m_v_slices.size() ; i++)
+      m_v_slices[i]->m_integral_cache = NULL; // removing reference from slice's part
+  }
+
+  int TubeIntegralCache::nb_slices() const
+  {
+    return m_v_slices.size();
+  }
+
+  bool TubeIntegralCache::is_up_to_date(int slice_id) const
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+    return m_special_slice_id != -1 || m_nb_valid_sums > slice_id + 1;
+  }
+
+  void TubeIntegralCache::invalidate(int slice_id)
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+
+    // Sums up to the slice remain valid (slices may be invalidated concurrently)
+    int nb_valid_sums = m_nb_valid_sums.load();
+    while(nb_valid_sums > slice_id + 1
+      && !m_nb_valid_sums.compare_exchange_weak(nb_valid_sums, slice_id + 1));
+
+    if(m_special_slice_id >= slice_id)
+      m_special_slice_id = -1;
+  }
+
+  const pair<Interval,Interval> TubeIntegralCache::partial_integral(const Interval& t)
+  {
+    assert(!t.is_empty());
+
+    // Slices involved in the integral: the ones starting before t.ub()
+    int k_ub = nb_slices_before(t.ub()) - 1;
+    if(k_ub < 0)
+      return make_pair(Interval(0.), Interval(0.)); // t = t0
+
+    if(!is_up_to_date(k_ub))
+    {
+      lock_guard<mutex> lock(m_update_mutex);
+      update(k_ub);
+    }
+
+    int special_slice_id = m_special_slice_id;
+    if(special_slice_id != -1 && special_slice_id <= k_ub)
+    {
+      if(m_v_slices[special_slice_id]->codomain().is_empty())
+        return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
+      else
+        return make_pair(Interval::ALL_REALS, Interval::ALL_REALS);
+    }
+
+    // Integral from t0 to t.lb()
+    int k_lb = max(0, min(k_ub, nb_slices_before(t.lb()) - 1));
+    pair<Interval,Interval> p_integ = primitive_value(k_lb, t.lb());
+
+    // The primitives are linear on each slice: their hull over [t]
+    // is reached at the bounds of [t] or at the slices boundaries
+    if(t.lb() < t.ub())
+    {
+      for(int k = k_lb + 1 ; k <= k_ub ; k++)
+      {
+        p_integ.first |= m_v_sum_lb[k];
+        p_integ.second |= m_v_sum_ub[k];
+      }
+
+      pair<Interval,Interval> p_integ_ub = primitive_value(k_ub, t.ub());
+      p_integ.first |= p_integ_ub.first;
+      p_integ.second |= p_integ_ub.second;
+    }
+
+    return p_integ;
+  }
+
+  int TubeIntegralCache::nb_slices_before(double t) const
+  {
+    // Number of slices whose temporal domain starts strictly before t
+    return lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+  }
+
+  void TubeIntegralCache::update(int slice_id)
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+
+    // The sums are computed until the slice, or until an empty or unbounded slice
+    while(m_special_slice_id == -1 && m_nb_valid_sums <= slice_id + 1)
+    {
+      int k = m_nb_valid_sums - 1;
+      const Slice *s = m_v_slices[k];
+
+      if(s->codomain().is_empty() || s->codomain().is_unbounded())
+      {
+        m_special_slice_id = k;
+        break;
+      }
+
+      double dt = s->tdomain().diam();
+      m_v_sum_lb[k + 1] = m_v_sum_lb[k] + dt * s->codomain().lb();
+      m_v_sum_ub[k + 1] = m_v_sum_ub[k] + dt * s->codomain().ub();
+      m_nb_valid_sums++; // published once the sums are written
+    }
+  }
+
+  const pair<Interval,Interval> TubeIntegralCache::primitive_value(int slice_id, double t) const
+  {
+    assert(slice_id >= 0 && slice_id < m_nb_valid_sums);
+    const Slice *s = m_v_slices[slice_id];
+    assert(s->tdomain().contains(t));
+
+    double dt = Interval(s->tdomain().lb(), t).diam();
+    return make_pair(m_v_sum_lb[slice_id] + dt * s->codomain().lb(),
+                     m_v_sum_ub[slice_id] + dt * s->codomain().ub());
+  }
+}
@@ -0,0 +1,72 @@
+/**
+ *  TubeIntegralCache class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBEINTEGRALCACHE_H__
+#define __TUBEX_TUBEINTEGRALCACHE_H__
+
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <atomic>
+#include "ibex_Interval.h"
+
+namespace tubex
+{
+  class Tube;
+  class Slice;
+
+  /**
+   * \class TubeIntegralCache
+   * \brief Prefix sums of the lower and upper integrals of the slices of a tube
+   *
+   * Lighter than the TubeTreeSynthesis, the cache is used for integral
+   * computations when no synthesis tree is available. Sums are computed
+   * lazily, up to the last slice required by a query. A modification of
+   * the codomain of a slice invalidates the sums from this slice onward.
+   *
+   * \note The cache relies on the slicing of the tube: it has to be
+   *       deleted before any structural change (sampling, slices removal).
+   *
+   * \note Concurrent queries are allowed: the sums are computed under a
+   *       lock, and the number of valid sums is published once they are
+   *       written. Queries on already computed sums do not lock.
+   */
+  class TubeIntegralCache
+  {
+    public:
+
+      TubeIntegralCache(const Tube *tube);
+      ~TubeIntegralCache();
+
+      int nb_slices() const;
+      bool is_up_to_date(int slice_id) const;
+      void invalidate(int slice_id);
+      const std::pair<ibex::Interval,ibex::Interval> partial_integral(const ibex::Interval& t);
+
+    protected:
+
+      TubeIntegralCache(const TubeIntegralCache&) = delete;
+      TubeIntegralCache& operator=(const TubeIntegralCache&) = delete;
+
+      int nb_slices_before(double t) const;
+      void update(int slice_id);
+      const std::pair<ibex::Interval,ibex::Interval> primitive_value(int slice_id, double t) const;
+
+      std::vector<const Slice*> m_v_slices; //!< slices of the tube, in temporal order
+      std::vector<double> m_v_t; //!< lower bounds of the temporal domains of the slices
+      std::vector<ibex::Interval> m_v_sum_lb; //!< m_v_sum_lb[k]: integral of the lower bounds over the k first slices
+      std::vector<ibex::Interval> m_v_sum_ub; //!< m_v_sum_ub[k]: integral of the upper bounds over the k first slices
+      std::atomic<int> m_nb_valid_sums{1}; //!< number of up-to-date sums
+      std::atomic<int> m_special_slice_id{-1}; //!< first summed slice with an empty or unbounded codomain, -1 if none
+      std::mutex m_update_mutex; //!< guards the lazy computation of the sums
+  };
+}
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ *  TubeSnapshot class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_TubeSnapshot.h"
+#include "tubex_TubeVector.h"
+#include "tubex_Slice.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Epochs are unique among all the snapshots: a slice stamped
+  // by a previous snapshot is recorded again by a new one
+  static atomic<uint64_t> next_epoch(1);
+
+  TubeSnapshot::TubeSnapshot(Tube& x)
+    : m_nb_records(0), m_epoch(next_epoch++)
+  {
+    attach(x);
+  }
+
+  TubeSnapshot::TubeSnapshot(TubeVector& x)
+    : m_nb_records(0), m_epoch(next_epoch++)
+  {
+    try
+    {
+      for(int i = 0 ; i < x.size() ; i++)
+        attach(x[i]);
+    }
+
+    catch(Exception&)
+    {
+      detach();
+      throw;
+    }
+  }
+
+  TubeSnapshot::~TubeSnapshot()
+  {
+    detach();
+  }
+
+  void TubeSnapshot::restore()
+  {
+    for(size_t i = 0 ; i < m_v_tubes.size() ; i++)
+      if(m_v_tubes[i]->nb_slices() != m_v_nb_slices[i])
+        throw Exception("TubeSnapshot::restore()", "the slicing of the tube has been modified");
+
+    // The records are restored from the last one: gates shared by two
+    // slices finally get the value recorded before their first modification
+
+    m_restoring = true;
+    for(size_t i = m_nb_records ; i > 0 ; i--)
+    {
+      const SliceRecord& r = m_v_records[i-1];
+      r.slice->set_envelope(r.codomain, false);
+      r.slice->set_input_gate(r.input_gate, false);
+      r.slice->set_output_gate(r.output_gate, false);
+    }
+    m_restoring = false;
+
+    m_nb_records = 0;
+    m_epoch = next_epoch++; // the slices will be recorded again
+  }
+
+  size_t TubeSnapshot::nb_records() const
+  {
+    return m_nb_records;
+  }
+
+  void TubeSnapshot::attach(Tube& x)
+  {
+    for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+      if(s->m_snapshot != NULL)
+        throw Exception("TubeSnapshot::TubeSnapshot()", "a snapshot is already attached to this tube");
+
+    for(Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+      s->m_snapshot = this;
+
+    m_v_tubes.push_back(&x);
+    m_v_nb_slices.push_back(x.nb_slices());
+    m_v_records.resize(m_v_records.size() + x.nb_slices());
+  }
+
+  void TubeSnapshot::detach()
+  {
+    for(auto& x : m_v_tubes)
+      for(Slice *s = x->first_slice() ; s != NULL ; s = s->next_slice())
+        s->m_snapshot = NULL;
+    m_v_tubes.clear();
+  }
+
+  void TubeSnapshot::record(Slice *s)
+  {
+    // A slice is modified by one thread at a time: its stamp is not shared
+    if(m_restoring || s->m_snapshot_epoch == m_epoch)
+      return;
+
+    s->m_snapshot_epoch = m_epoch;
+    size_t i = m_nb_records.fetch_add(1);
+    assert(i < m_v_records.size() && "each slice is recorded once per epoch");
+    m_v_records[i] = { s, s->codomain(), s->input_gate(), s->output_gate() };
+  }
+}
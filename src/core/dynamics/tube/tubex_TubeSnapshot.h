@@ -0,0 +1,129 @@
+/**
+ *  \file
+ *  TubeSnapshot class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBESNAPSHOT_H__
+#define __TUBEX_TUBESNAPSHOT_H__
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "ibex_Interval.h"
+
+namespace tubex
+{
+  class Tube;
+  class TubeVector;
+  class Slice;
+
+  /**
+   * \class TubeSnapshot
+   * \brief Snapshot of the values of a tube, that can be restored after
+   *        trial contractions or for backtracking purposes
+   *
+   * Instead of a copy of the tube, the snapshot records the previous values
+   * of a slice (codomain and gates) the first time the slice is modified after
+   * the snapshot or the last restoration. Further modifications of the slice
+   * only compare an epoch stamp. Restoring the tube then costs O(modified slices),
+   * and no slice is allocated.
+   *
+   * \note The slicing of the tube must not be changed while a snapshot is
+   *       attached to it, and the tube must outlive the snapshot.
+   * \note Only one snapshot can be attached to a tube at a time.
+   */
+  class TubeSnapshot
+  {
+    public:
+
+      /**
+       * \brief Takes a snapshot of a tube
+       *
+       * \param x the Tube to be recorded
+       */
+      explicit TubeSnapshot(Tube& x);
+
+      /**
+       * \brief Takes a snapshot of a n-dimensional tube
+       *
+       * \param x the TubeVector to be recorded
+       */
+      explicit TubeSnapshot(TubeVector& x);
+
+      /**
+       * \brief TubeSnapshot destructor
+       *
+       * The recording is stopped, the current values of the tube are kept.
+       */
+      ~TubeSnapshot();
+
+      /**
+       * \brief Restores the values of the tube at the time of the snapshot
+       *
+       * The snapshot remains attached to the tube, and can be restored again.
+       */
+      void restore();
+
+      /**
+       * \brief Returns the number of slices modified since the snapshot or the last restoration
+       *
+       * \return an integer
+       */
+      size_t nb_records() const;
+
+    protected:
+
+      /**
+       * \brief Values of a slice before its first modification
+       */
+      struct SliceRecord
+      {
+        Slice *slice; //!< modified slice
+        ibex::Interval codomain; //!< previous envelope
+        ibex::Interval input_gate; //!< previous input gate
+        ibex::Interval output_gate; //!< previous output gate
+      };
+
+      TubeSnapshot(const TubeSnapshot&) = delete;
+      TubeSnapshot& operator=(const TubeSnapshot&) = delete;
+
+      /**
+       * \brief Starts the recording of the slices of a tube
+       *
+       * \param x the Tube to be recorded
+       */
+      void attach(Tube& x);
+
+      /**
+       * \brief Stops the recording of the slices of the tubes
+       */
+      void detach();
+
+      /**
+       * \brief Records the values of a slice, before its first modification
+       *
+       * Slices may be modified concurrently: the records are preallocated
+       * (one per recorded slice) and reserved without lock.
+       *
+       * \param s the slice about to be modified
+       */
+      void record(Slice *s);
+
+      std::vector<Tube*> m_v_tubes; //!< recorded tubes
+      std::vector<int> m_v_nb_slices; //!< number of slices of the recorded tubes
+      std::vector<SliceRecord> m_v_records; //!< previous values, in order of first modification
+      std::atomic<size_t> m_nb_records; //!< number of reserved records
+      uint64_t m_epoch; //!< stamp of the slices already recorded since the snapshot or the last restoration
+      bool m_restoring = false; //!< no recording during a restoration
+
+      friend class Slice;
+  };
+}
+
+#endif
@@ -9,6 +9,8 @@
  */
 
 #include "tubex_TubeTreeSynthesis.h"
+#include "tubex_Tube.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
@@ -18,6 +20,7 @@ namespace tubex
   TubeTreeSynthesis::TubeTreeSynthesis(const Tube* tube, int k0, int kf, const vector<const Slice*>& v_tube_slices)
     : m_tube_ref(tube), m_parent(NULL)
   {
+    TUBEX_PERF_ALLOC(SYNTHESIS_NODE, 1);
     assert(tube != NULL);
     assert(k0 >= 0 && k0 < (int)v_tube_slices.size()); // todo: use size_t
     assert(kf >= 0 && kf < (int)v_tube_slices.size()); // todo: use size_t
@@ -133,17 +136,78 @@ namespace tubex
     }
   }
   
+  void TubeTreeSynthesis::invert(const Interval& y, vector<Interval>& v_t, const Interval& search_tdomain)
+  {
+    assert(is_root());
+    v_t.clear();
+
+    Interval intersection = m_tdomain & search_tdomain;
+    if(intersection.is_empty())
+      return;
+
+    // Same slices as the ones swept by Tube::invert
+    int k0 = time_to_index(intersection.lb());
+    int kf = time_to_index(intersection.ub());
+
+    Interval current = Interval::EMPTY_SET;
+    invert(y, v_t, current, intersection, k0, kf, 0);
+
+    if(!current.is_empty())
+      v_t.push_back(current);
+  }
+
+  void TubeTreeSynthesis::invert(const Interval& y, vector<Interval>& v_t, Interval& current,
+                                 const Interval& search_tdomain, int k0, int kf, int offset)
+  {
+    if(offset > kf || offset + m_nb_slices - 1 < k0)
+      return; // outside the swept slices
+
+    if(!codomain().intersects(y))
+    {
+      // No pre-image in this subtree: the current connected subset ends
+      if(!current.is_empty())
+      {
+        v_t.push_back(current);
+        current.set_empty();
+      }
+    }
+
+    else if(offset >= k0 && offset + m_nb_slices - 1 <= kf
+      && codomain_bounds().first.ub() < y.lb() && codomain_bounds().second.lb() > y.ub())
+      current |= m_tdomain & search_tdomain; // each slice (and gate) is a superset of y
+
+    else if(is_leaf())
+    {
+      Interval local_invert = m_slice_ref->invert(y, search_tdomain);
+
+      if(local_invert.is_empty() && !current.is_empty())
+      {
+        v_t.push_back(current);
+        current.set_empty();
+      }
+
+      else
+        current |= local_invert;
+    }
+
+    else
+    {
+      m_first_subtree->invert(y, v_t, current, search_tdomain, k0, kf, offset);
+      m_second_subtree->invert(y, v_t, current, search_tdomain, k0, kf, offset + m_first_subtree->nb_slices());
+    }
+  }
+  
   const Interval TubeTreeSynthesis::codomain()
   {
     if(m_values_update_needed)
-      root()->update_values();
+      update_values();
     return m_codomain;
   }
   
   const pair<Interval,Interval> TubeTreeSynthesis::codomain_bounds()
   {
     if(m_values_update_needed)
-      root()->update_values();
+      update_values();
     return m_codomain_bounds;
   }
 
@@ -284,7 +348,26 @@ namespace tubex
       return m_parent->root();
   }
 
+  bool TubeTreeSynthesis::is_up_to_date() const
+  {
+    return !m_values_update_needed && !m_integrals_update_needed;
+  }
+
   void TubeTreeSynthesis::update_values()
+  {
+    // Lazy update, possibly requested by concurrent const queries on the tube:
+    // the flags are cleared once the values below are computed
+    lock_guard<mutex> lock(m_tube_ref->m_cache_mutex);
+    root()->update_subtree_values();
+  }
+
+  void TubeTreeSynthesis::update_integrals()
+  {
+    lock_guard<mutex> lock(m_tube_ref->m_cache_mutex);
+    root()->update_subtree_integrals();
+  }
+
+  void TubeTreeSynthesis::update_subtree_values()
   {
     if(m_values_update_needed)
     {
@@ -301,8 +384,8 @@ namespace tubex
 
       else
       {
-        m_first_subtree->update_values();
-        m_second_subtree->update_values();
+        m_first_subtree->update_subtree_values();
+        m_second_subtree->update_subtree_values();
 
         m_codomain = m_first_subtree->m_codomain | m_second_subtree->m_codomain;
         pair<Interval,Interval> p_first = m_first_subtree->m_codomain_bounds;
@@ -314,9 +397,9 @@ namespace tubex
     }
   }
 
-  void TubeTreeSynthesis::update_integrals()
+  void TubeTreeSynthesis::update_subtree_integrals()
   {
-    if(m_values_update_needed)
+    if(m_integrals_update_needed)
     {
       // 1. Updating leafs values (leaf nodes)
 
@@ -344,8 +427,8 @@ namespace tubex
 
       if(!is_leaf()) // flag already set to false in step 1
       {
-        m_first_subtree->update_integrals();
-        m_second_subtree->update_integrals();
+        m_first_subtree->update_subtree_integrals();
+        m_second_subtree->update_subtree_integrals();
 
         m_partial_primitive = m_first_subtree->m_partial_primitive;
         m_partial_primitive.first |= m_second_subtree->m_partial_primitive.first;
@@ -361,7 +444,7 @@ namespace tubex
     assert(is_root());
 
     if(m_integrals_update_needed)
-      root()->update_integrals();
+      update_integrals();
 
     int index_lb = m_tube_ref->time_to_index(t.lb());
     int index_ub = m_tube_ref->time_to_index(t.ub());
@@ -477,7 +560,7 @@ namespace tubex
   const pair<Interval,Interval> TubeTreeSynthesis::partial_primitive_bounds(const Interval& t)
   {
     if(m_integrals_update_needed)
-      root()->update_integrals();
+      update_integrals();
 
     if(t == Interval::ALL_REALS)
       return m_partial_primitive; // pre-computed values
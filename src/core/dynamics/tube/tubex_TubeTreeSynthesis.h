@@ -11,6 +11,7 @@
 #ifndef __TUBEX_TUBETREESYNTHESIS_H__
 #define __TUBEX_TUBETREESYNTHESIS_H__
 
+#include <atomic>
 #include "tubex_Slice.h"
 
 namespace tubex
@@ -26,6 +27,7 @@ namespace tubex
       int nb_slices() const;
       const ibex::Interval operator()(const ibex::Interval& t);
       const ibex::Interval invert(const ibex::Interval& y, const ibex::Interval& search_tdomain);
+      void invert(const ibex::Interval& y, std::vector<ibex::Interval>& v_t, const ibex::Interval& search_tdomain);
       const ibex::Interval codomain();
       const std::pair<ibex::Interval,ibex::Interval> codomain_bounds();
       const std::pair<ibex::Interval,ibex::Interval> eval(const ibex::Interval& t = ibex::Interval::ALL_REALS);
@@ -40,6 +42,7 @@ namespace tubex
 
       void request_values_update();
       void request_integrals_update(bool propagate_to_other_slices = true);
+      bool is_up_to_date() const;
       void update_values();
       void update_integrals();
       std::pair<ibex::Interval,ibex::Interval> partial_integral(const ibex::Interval& t);
@@ -47,6 +50,11 @@ namespace tubex
 
     protected:
 
+      void update_subtree_values();
+      void update_subtree_integrals();
+      void invert(const ibex::Interval& y, std::vector<ibex::Interval>& v_t, ibex::Interval& current,
+                  const ibex::Interval& search_tdomain, int k0, int kf, int offset);
+
       // Slices connections
       const Slice *m_slice_ref = NULL;
       const Tube *m_tube_ref = NULL;
@@ -60,8 +68,9 @@ namespace tubex
       std::pair<ibex::Interval,ibex::Interval> m_codomain_bounds;
       std::pair<ibex::Interval,ibex::Interval> m_partial_primitive;
 
-      bool m_integrals_update_needed = true;
-      bool m_values_update_needed = true;
+      // Flags cleared once the values are computed: read without lock by concurrent queries
+      std::atomic<bool> m_integrals_update_needed{true};
+      std::atomic<bool> m_values_update_needed{true};
   };
 }
 
@@ -10,6 +10,7 @@
 
 #include "tubex_TubeVector.h"
 #include "tubex_Exception.h"
+#include "tubex_perf.h"
 #include "tubex_CtcDeriv.h"
 #include "tubex_CtcEval.h"
 #include "ibex_LargestFirst.h"
@@ -156,6 +157,7 @@ namespace tubex
     
     TubeVector::~TubeVector()
     {
+      delete m_grid; // before the components, that are referenced by the grid
       delete[] m_v_tubes;
     }
 
@@ -176,7 +178,10 @@ namespace tubex
 
     const TubeVector& TubeVector::operator=(const TubeVector& x)
     {
+      bool shared_grid = m_grid != NULL;
+
       { // Destroying already existing components
+        enable_shared_grid(false);
         if(m_v_tubes != NULL)
           delete[] m_v_tubes;
       }
@@ -187,6 +192,7 @@ namespace tubex
       for(int i = 0 ; i < size() ; i++)
         (*this)[i] = x[i]; // copy of each component
 
+      enable_shared_grid(shared_grid);
       return *this;
     }
 
@@ -210,6 +216,9 @@ namespace tubex
       if(n == size())
         return;
 
+      bool shared_grid = m_grid != NULL;
+      enable_shared_grid(false);
+
       Tube *new_vec = new Tube[n];
 
       int i = 0;
@@ -224,6 +233,7 @@ namespace tubex
 
       m_n = n;
       m_v_tubes = new_vec;
+      enable_shared_grid(shared_grid);
     }
     
     const TubeVector TubeVector::subvector(int start_index, int end_index) const
@@ -267,8 +277,24 @@ namespace tubex
     void TubeVector::sample(double t)
     {
       assert(tdomain().contains(t));
-      for(int i = 0 ; i < size() ; i++)
-        (*this)[i].sample(t);
+
+      const TubeVectorGrid *grid = shared_grid();
+      if(grid != NULL) // slices to be sampled are directly known
+      {
+        int k = grid->time_to_index(t);
+        if(grid->slice_tdomain(k).lb() == t)
+          return; // the gate already exists
+
+        vector<Slice*> v_slices(size());
+        for(int i = 0 ; i < size() ; i++)
+          v_slices[i] = grid->slice(k, i); // before the first sampling, that invalidates the grid
+        for(int i = 0 ; i < size() ; i++)
+          (*this)[i].sample(t, v_slices[i]);
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          (*this)[i].sample(t);
     }
 
     void TubeVector::sample(double t, const IntervalVector& gate)
@@ -294,6 +320,27 @@ namespace tubex
         (*this)[i].sample(x[i]);
     }
 
+    void TubeVector::push_back_slice(double dt, const IntervalVector& codomain)
+    {
+      assert(size() == codomain.size());
+      for(int i = 0 ; i < size() ; i++)
+        (*this)[i].push_back_slice(dt, codomain[i]);
+    }
+
+    void TubeVector::push_back_slice(double dt)
+    {
+      for(int i = 0 ; i < size() ; i++)
+        (*this)[i].push_back_slice(dt);
+    }
+
+    int TubeVector::drop_front_slices(double t)
+    {
+      int nb_removed = 0;
+      for(int i = 0 ; i < size() ; i++)
+        nb_removed = (*this)[i].drop_front_slices(t);
+      return nb_removed;
+    }
+
     // Accessing values
 
     const IntervalVector TubeVector::codomain() const
@@ -324,6 +371,12 @@ namespace tubex
     const IntervalVector TubeVector::operator()(int slice_id) const
     {
       assert(slice_id >= 0 && slice_id < nb_slices());
+      TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
+
+      const TubeVectorGrid *grid = shared_grid();
+      if(grid != NULL) // values of the slice are contiguous
+        return grid->box(slice_id);
+
       IntervalVector box(size());
       for(int i = 0 ; i < size() ; i++)
         box[i] = (*this)[i](slice_id);
@@ -333,6 +386,7 @@ namespace tubex
     const IntervalVector TubeVector::operator()(double t) const
     {
       assert(tdomain().contains(t));
+      TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
       IntervalVector box(size());
       for(int i = 0 ; i < size() ; i++)
         box[i] = (*this)[i](t);
@@ -342,6 +396,7 @@ namespace tubex
     const IntervalVector TubeVector::operator()(const Interval& t) const
     {
       assert(tdomain().is_superset(t));
+      TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
       IntervalVector box(size());
       for(int i = 0 ; i < size() ; i++)
         box[i] = (*this)[i](t);
@@ -876,6 +931,27 @@ const double TubeVector::max_gate_diam(double & t) const
         (*this)[i].enable_synthesis(enable);
     }
 
+    // Shared time grid
+
+    void TubeVector::enable_shared_grid(bool enable)
+    {
+      if(enable && m_grid == NULL)
+        m_grid = new TubeVectorGrid(this);
+
+      else if(!enable && m_grid != NULL)
+      {
+        delete m_grid;
+        m_grid = NULL;
+      }
+    }
+
+    const TubeVectorGrid* TubeVector::shared_grid() const
+    {
+      if(m_grid != NULL && m_grid->is_shared())
+        return m_grid;
+      return NULL;
+    }
+
     // Integration
 
     const IntervalVector TubeVector::integral(double t) const
@@ -972,6 +1048,11 @@ const double TubeVector::max_gate_diam(double & t) const
     bool TubeVector::same_slicing(const TubeVector& x1, const TubeVector& x2)
     {
       assert(x1.size() == x2.size());
+
+      const TubeVectorGrid *g1 = x1.shared_grid(), *g2 = x2.shared_grid();
+      if(g1 != NULL && g2 != NULL) // time bounds are stored once for all the components
+        return TubeVectorGrid::same_slicing(*g1, *g2);
+
       for(int i = 0 ; i < x1.size() ; i++)
         if(!Tube::same_slicing(x1[i], x2[i]))
           return false;
@@ -20,6 +20,7 @@
 #include "tubex_TrajectoryVector.h"
 #include "tubex_tube_arithmetic.h"
 #include "tubex_serialize_tubes.h"
+#include "tubex_TubeVectorGrid.h"
 #include "ibex_BoolInterval.h"
 
 namespace tubex
@@ -310,6 +311,29 @@ namespace tubex
        */
       void sample(const TubeVector& x);
 
+      /**
+       * \brief Appends a new Slice at the end of each component (growing tube)
+       *
+       * \param dt the width of the tdomain of the new slices
+       * \param codomain the codomain of the new slices
+       */
+      void push_back_slice(double dt, const ibex::IntervalVector& codomain);
+
+      /**
+       * \brief Appends a new Slice at the end of each component (growing tube), with unbounded codomains
+       *
+       * \param dt the width of the tdomain of the new slices
+       */
+      void push_back_slice(double dt);
+
+      /**
+       * \brief Removes the first slices of each component that are defined before \f$t\f$ (sliding horizon)
+       *
+       * \param t the temporal key (double, must be lower than the upper bound of the tube's tdomain)
+       * \return the number of removed slices in each component
+       */
+      int drop_front_slices(double t);
+
       /// @}
       /// \name Accessing values
       /// @{
@@ -1012,6 +1036,30 @@ namespace tubex
        */
       void enable_synthesis(bool enable = true) const;
 
+      /// @}
+      /// \name Shared time grid
+      /// @{
+
+      /**
+       * \brief Enables the storage of the slices in a time grid shared by the components
+       *
+       * \note When the components are sampled identically, the shared grid speeds up
+       *       the evaluations by slice index, the comparisons of slicings and the samplings.
+       *       It is not used otherwise. This setting is kept by the assignment operator,
+       *       but is not transmitted to copies.
+       *
+       * \param enable boolean
+       */
+      void enable_shared_grid(bool enable = true);
+
+      /**
+       * \brief Returns the shared time grid of this tube
+       *
+       * \return a pointer to the grid, NULL if not enabled or if the components
+       *         do not share the same slicing
+       */
+      const TubeVectorGrid* shared_grid() const;
+
       /// @}
       /// \name Integration
       /// @{
@@ -1171,8 +1219,10 @@ namespace tubex
 
         int m_n = 0; //!< dimension of this tube
         Tube *m_v_tubes = NULL; //!< array of components (scalar tubes)
+        TubeVectorGrid *m_grid = NULL; //!< optional time grid shared by the components
 
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
+      friend class TubeVectorGrid;
   };
 }
 
@@ -0,0 +1,216 @@
+/**
+ *  TubeVectorGrid class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include "tubex_TubeVectorGrid.h"
+#include "tubex_TubeVector.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TubeVectorGrid::TubeVectorGrid(TubeVector *x)
+    : m_x(x), m_n(x->size())
+  {
+    assert(x != NULL);
+
+    for(int i = 0 ; i < m_n ; i++)
+    {
+      assert(x->m_v_tubes[i].m_grid == NULL);
+      x->m_v_tubes[i].m_grid = this;
+    }
+  }
+
+  TubeVectorGrid::~TubeVectorGrid()
+  {
+    detach_slices();
+    for(int i = 0 ; i < m_n ; i++)
+      m_x->m_v_tubes[i].m_grid = NULL; // removing reference from tube's part
+  }
+
+  bool TubeVectorGrid::is_shared() const
+  {
+    update_structure();
+    return m_shared;
+  }
+
+  int TubeVectorGrid::nb_slices() const
+  {
+    assert(is_shared());
+    return m_v_t.size() - 1;
+  }
+
+  const Interval TubeVectorGrid::slice_tdomain(int slice_id) const
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+    return Interval(m_v_t[slice_id], m_v_t[slice_id + 1]);
+  }
+
+  int TubeVectorGrid::time_to_index(double t) const
+  {
+    assert(Interval(m_v_t.front(), m_v_t.back()).contains(t));
+
+    // Same convention as Tube::time_to_index(): first slice such that t < t_f
+    int k = upper_bound(m_v_t.begin() + 1, m_v_t.end(), t) - (m_v_t.begin() + 1);
+    return min(k, nb_slices() - 1);
+  }
+
+  const Interval* TubeVectorGrid::codomain(int slice_id) const
+  {
+    return row(slice_id);
+  }
+
+  const Interval* TubeVectorGrid::input_gate(int slice_id) const
+  {
+    return row(slice_id) + m_n;
+  }
+
+  const Interval* TubeVectorGrid::output_gate(int slice_id) const
+  {
+    return row(slice_id) + 2 * m_n;
+  }
+
+  const IntervalVector TubeVectorGrid::box(int slice_id) const
+  {
+    const Interval *values = codomain(slice_id);
+    IntervalVector box(m_n);
+    for(int i = 0 ; i < m_n ; i++)
+      box[i] = values[i];
+    return box;
+  }
+
+  Slice* TubeVectorGrid::slice(int slice_id, int i) const
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+    assert(i >= 0 && i < m_n);
+    return m_v_slices[slice_id * m_n + i];
+  }
+
+  void TubeVectorGrid::invalidate(int slice_id)
+  {
+    if(!m_structure_up_to_date) // the whole grid will be computed again
+      return;
+
+    // Gates are shared with the previous and next slices
+    int nb = m_v_t.size() - 1;
+    for(int k = max(0, slice_id - 1) ; k <= min(nb - 1, slice_id + 1) ; k++)
+      m_v_up_to_date[k] = false;
+  }
+
+  void TubeVectorGrid::invalidate_structure()
+  {
+    m_structure_up_to_date = false;
+  }
+
+  bool TubeVectorGrid::same_slicing(const TubeVectorGrid& g1, const TubeVectorGrid& g2)
+  {
+    assert(g1.is_shared() && g2.is_shared());
+    return g1.m_v_t == g2.m_v_t;
+  }
+
+  const Interval* TubeVectorGrid::row(int slice_id) const
+  {
+    assert(slice_id >= 0 && slice_id < nb_slices());
+
+    if(!m_v_up_to_date[slice_id])
+    {
+      lock_guard<mutex> lock(m_update_mutex);
+      update(slice_id);
+    }
+
+    return &m_v_values[3 * m_n * slice_id];
+  }
+
+  void TubeVectorGrid::update_structure() const
+  {
+    if(m_structure_up_to_date)
+      return;
+
+    lock_guard<mutex> lock(m_update_mutex);
+    if(m_structure_up_to_date) // computed in the meantime by another thread
+      return;
+
+    m_v_t.clear();
+    m_v_slices.clear();
+    m_v_values.clear();
+    m_shared = true;
+
+    // Time grid of the first component
+
+      for(const Slice *s = m_x->m_v_tubes[0].first_slice() ; s != NULL ; s = s->next_slice())
+        m_v_t.push_back(s->tdomain().lb());
+      m_v_t.push_back(m_x->m_v_tubes[0].tdomain().ub());
+
+      int nb = m_v_t.size() - 1;
+      m_v_slices.resize(nb * m_n, NULL);
+
+    // Slices of the components, that must share the grid
+
+      for(int i = 0 ; i < m_n && m_shared ; i++)
+      {
+        int k = 0;
+        for(Slice *s = m_x->m_v_tubes[i].first_slice() ; s != NULL ; s = s->next_slice(), k++)
+        {
+          if(k >= nb || s->tdomain().lb() != m_v_t[k] || s->tdomain().ub() != m_v_t[k + 1])
+          {
+            m_shared = false;
+            break;
+          }
+
+          s->m_grid = const_cast<TubeVectorGrid*>(this);
+          s->m_grid_id = k;
+          m_v_slices[k * m_n + i] = s;
+        }
+
+        m_shared &= (k == nb);
+      }
+
+      if(!m_shared)
+      {
+        detach_slices();
+        m_v_slices.clear();
+      }
+
+      else
+      {
+        m_v_values.resize(3 * m_n * nb);
+        m_v_up_to_date.reset(new atomic<bool>[nb]);
+        for(int k = 0 ; k < nb ; k++)
+          m_v_up_to_date[k] = false;
+      }
+
+    m_structure_up_to_date = true; // published once the structure is written
+  }
+
+  void TubeVectorGrid::update(int slice_id) const
+  {
+    if(m_v_up_to_date[slice_id]) // computed in the meantime by another thread
+      return;
+
+    Interval *values = &m_v_values[3 * m_n * slice_id];
+    for(int i = 0 ; i < m_n ; i++)
+    {
+      const Slice *s = m_v_slices[slice_id * m_n + i];
+      values[i] = s->codomain();
+      values[m_n + i] = s->input_gate();
+      values[2 * m_n + i] = s->output_gate();
+    }
+
+    m_v_up_to_date[slice_id] = true; // published once the values are written
+  }
+
+  void TubeVectorGrid::detach_slices() const
+  {
+    for(int i = 0 ; i < m_n ; i++)
+      for(Slice *s = m_x->m_v_tubes[i].first_slice() ; s != NULL ; s = s->next_slice())
+        s->m_grid = NULL;
+  }
+}
@@ -0,0 +1,90 @@
+/**
+ *  \file
+ *  TubeVectorGrid class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBEVECTORGRID_H__
+#define __TUBEX_TUBEVECTORGRID_H__
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "ibex_Interval.h"
+#include "ibex_IntervalVector.h"
+
+namespace tubex
+{
+  class TubeVector;
+  class Slice;
+
+  /**
+   * \class TubeVectorGrid
+   * \brief Shared time grid of the components of a TubeVector, with the
+   *        values of each slice stored contiguously
+   *
+   * When all the components of a TubeVector share the same slicing, the
+   * temporal bounds are stored once, and the values of the k-th slice of
+   * all the components are stored in a row: the n codomains, followed by the
+   * n input gates and the n output gates. The k-th box of the tube is then
+   * read in place, without walking through the slices of each component.
+   *
+   * The grid is built lazily. A structural change of a component (sampling,
+   * slices removal) invalidates the whole grid, while the modification of
+   * a slice only invalidates its row and the neighbouring ones (gates are
+   * shared between consecutive slices).
+   *
+   * \note Concurrent queries are allowed: the rows are computed under a
+   *       lock, and are published once they are written. Queries on
+   *       already computed rows do not lock.
+   */
+  class TubeVectorGrid
+  {
+    public:
+
+      TubeVectorGrid(TubeVector *x);
+      ~TubeVectorGrid();
+
+      bool is_shared() const;
+      int nb_slices() const;
+      const ibex::Interval slice_tdomain(int slice_id) const;
+      int time_to_index(double t) const;
+      const ibex::Interval* codomain(int slice_id) const;
+      const ibex::Interval* input_gate(int slice_id) const;
+      const ibex::Interval* output_gate(int slice_id) const;
+      const ibex::IntervalVector box(int slice_id) const;
+      Slice* slice(int slice_id, int i) const;
+      void invalidate(int slice_id);
+      void invalidate_structure();
+
+      static bool same_slicing(const TubeVectorGrid& g1, const TubeVectorGrid& g2);
+
+    protected:
+
+      TubeVectorGrid(const TubeVectorGrid&) = delete;
+      TubeVectorGrid& operator=(const TubeVectorGrid&) = delete;
+
+      const ibex::Interval* row(int slice_id) const;
+      void update_structure() const;
+      void update(int slice_id) const;
+      void detach_slices() const;
+
+      TubeVector *m_x; //!< related tube
+      int m_n; //!< dimension of the tube
+      mutable bool m_shared = false; //!< the components share the same slicing
+      mutable std::vector<double> m_v_t; //!< shared bounds of the temporal domains of the slices
+      mutable std::vector<Slice*> m_v_slices; //!< m_v_slices[k*n+i]: k-th slice of the i-th component
+      mutable std::vector<ibex::Interval> m_v_values; //!< rows of 3n values: codomains, input gates, output gates
+      mutable std::unique_ptr<std::atomic<bool>[]> m_v_up_to_date; //!< validity of each row
+      mutable std::atomic<bool> m_structure_up_to_date{false}; //!< validity of the slicing
+      mutable std::mutex m_update_mutex; //!< guards the lazy computation of the grid
+  };
+}
+
+#endif
@@ -11,12 +11,17 @@
 #include "tubex_TFunction.h"
 #include "tubex_Tube.h"
 #include "tubex_TubeVector.h"
+#include "tubex_Executor.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace tubex
 {
+  // Number of consecutive rows of slices evaluated by a thread
+  static const size_t rows_grain = 32;
+
   TFunction::TFunction(int n, const char** x, const char* y)
   {
     construct_from_array(n, x, y);
@@ -224,6 +229,8 @@ namespace tubex
   const IntervalVector TFunction::eval_vector(const Interval& t) const
   {
     assert(nb_vars() == 0);
+    TUBEX_PERF_KERNEL(TFUNCTION_EVAL);
+    TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
     IntervalVector box(1, t);
     return m_ibex_f->eval_vector(box);
   }
@@ -232,6 +239,7 @@ namespace tubex
   {
     assert(nb_vars() == x.size() - 1);
     assert(!is_intertemporal());
+    TUBEX_PERF_KERNEL(TFUNCTION_EVAL);
     return m_ibex_f->eval_vector(x);
   }
 
@@ -239,19 +247,36 @@ namespace tubex
   {
     assert(slice_id >= 0 && slice_id < x.nb_slices());
 
-    Interval t = x[0].slice_tdomain(slice_id);
+    const TubeVectorGrid *grid = x.shared_grid();
+    Interval t = grid != NULL ? grid->slice_tdomain(slice_id) : x[0].slice_tdomain(slice_id);
 
     if(nb_vars() == 0)
       return eval_vector(t);
 
     assert(nb_vars() == x.size());
-
-    if(x(slice_id).is_empty())
-      return IntervalVector(image_dim(), Interval::EMPTY_SET);
+    TUBEX_PERF_KERNEL(TFUNCTION_EVAL);
+    TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
 
     IntervalVector box(nb_vars() + 1); // +1 for system variable (t)
     box[0] = t;
-    box.put(1, x(slice_id));
+
+    if(grid != NULL) // values of the slice are read in place
+    {
+      const Interval *codomain = grid->codomain(slice_id);
+      for(int i = 0 ; i < x.size() ; i++)
+      {
+        if(codomain[i].is_empty())
+          return IntervalVector(image_dim(), Interval::EMPTY_SET);
+        box[i + 1] = codomain[i];
+      }
+    }
+
+    else
+    {
+      if(x(slice_id).is_empty())
+        return IntervalVector(image_dim(), Interval::EMPTY_SET);
+      box.put(1, x(slice_id));
+    }
 
     return m_ibex_f->eval_vector(box);
   }
@@ -264,10 +289,12 @@ namespace tubex
 
     assert(x.tdomain().is_superset(t));
     assert(nb_vars() == x.size());
+    TUBEX_PERF_KERNEL(TFUNCTION_EVAL);
 
     if(x(t).is_empty())
       return IntervalVector(image_dim(), Interval::EMPTY_SET);
 
+    TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 1);
     IntervalVector box(nb_vars() + 1); // +1 for system variable (t)
     box[0] = t;
     if(nb_vars() != 0)
@@ -288,6 +315,8 @@ namespace tubex
 
     if(nb_vars() != 0)
       assert(x.size() == nb_vars());
+
+    TUBEX_PERF_KERNEL(TFUNCTION_EVAL);
     
     TubeVector y(x); // keeping slicing the x
     y.resize(image_dim());
@@ -298,59 +327,73 @@ namespace tubex
       return y;
     }
 
-    IntervalVector box(x.size() + 1), result(y.size());
+    // Rows of slices, in row-major arrays
 
-    const Slice **v_sx = new const Slice*[x.size()];
-    for(int i = 0 ; i < x.size() ; i++)
-      v_sx[i] = NULL;
+      vector<const Slice*> v_sx;
+      vector<Slice*> v_sy;
 
-    Slice **v_sy = new Slice*[y.size()];
-    for(int i = 0 ; i < y.size() ; i++)
-      v_sy[i] = NULL;
+      for(int i = 0 ; i < x.size() ; i++)
+        v_sx.push_back(x[i].first_slice());
+      for(int i = 0 ; i < y.size() ; i++)
+        v_sy.push_back(y[i].first_slice());
 
-    do
-    {
-      if(v_sx[0] == NULL) // first iteration
+      size_t nb_rows = x.nb_slices();
+      for(size_t k = 1 ; k < nb_rows ; k++)
       {
         for(int i = 0 ; i < x.size() ; i++)
-          v_sx[i] = x[i].first_slice();
+          v_sx.push_back(v_sx[(k-1)*x.size()+i]->next_slice());
         for(int i = 0 ; i < y.size() ; i++)
-          v_sy[i] = y[i].first_slice();
+          v_sy.push_back(v_sy[(k-1)*y.size()+i]->next_slice());
       }
 
-      else
-      {
-        for(int i = 0 ; i < x.size() ; i++)
-          v_sx[i] = v_sx[i]->next_slice();
+    // Evaluations over the envelopes and the input gates, in parallel
+    // (IBEX functions are not reentrant: one copy per thread)
+
+      int nb_lanes = Executor::nb_lanes(nb_rows, 0, rows_grain);
+      vector<Function*> v_f(1, m_ibex_f);
+      for(int i = 1 ; i < nb_lanes ; i++)
+        v_f.push_back(new Function(*m_ibex_f, Function::COPY));
+
+      vector<IntervalVector> v_envelopes(nb_rows, IntervalVector(y.size())), v_ingates(v_envelopes);
+      TUBEX_PERF_ALLOC(INTERVAL_VECTOR, 3 * nb_rows + 1); // results and evaluated boxes
+
+      Executor::global().parallel_for(0, nb_rows,
+        [&](size_t k, int lane)
+        {
+          IntervalVector box(x.size() + 1);
+
+          box[0] = v_sx[k*x.size()]->tdomain();
+          for(int i = 0 ; i < x.size() ; i++)
+            box[i+1] = v_sx[k*x.size()+i]->codomain();
+          v_envelopes[k] = v_f[lane]->eval_vector(box);
+
+          box[0] = box[0].lb();
+          for(int i = 0 ; i < x.size() ; i++)
+            box[i+1] = v_sx[k*x.size()+i]->input_gate();
+          v_ingates[k] = v_f[lane]->eval_vector(box);
+        },
+        0, rows_grain);
+
+      for(int i = 1 ; i < nb_lanes ; i++)
+        delete v_f[i];
+
+      for(size_t k = 0 ; k < nb_rows ; k++)
         for(int i = 0 ; i < y.size() ; i++)
-          v_sy[i] = v_sy[i]->next_slice();
-      }
+        {
+          v_sy[k*y.size()+i]->set_envelope(v_envelopes[k][i], false);
+          v_sy[k*y.size()+i]->set_input_gate(v_ingates[k][i], false);
+        }
 
-      box[0] = v_sx[0]->tdomain();
-      for(int i = 0 ; i < x.size() ; i++)
-        box[i+1] = v_sx[i]->codomain();
-      result = m_ibex_f->eval_vector(box);
-      for(int i = 0 ; i < y.size() ; i++)
-        v_sy[i]->set_envelope(result[i], false);
+    // Output gate
 
-      box[0] = box[0].lb();
+      IntervalVector box(x.size() + 1);
+      box[0] = x.tdomain().ub();
       for(int i = 0 ; i < x.size() ; i++)
-        box[i+1] = v_sx[i]->input_gate();
-      result = m_ibex_f->eval_vector(box);
+        box[i+1] = x[i].last_slice()->output_gate();
+      IntervalVector result = m_ibex_f->eval_vector(box);
       for(int i = 0 ; i < y.size() ; i++)
-        v_sy[i]->set_input_gate(result[i], false);
+        y[i].last_slice()->set_output_gate(result[i], false);
 
-    } while(v_sx[0]->next_slice() != NULL);
-    
-    box[0] = v_sx[0]->tdomain().ub();
-    for(int i = 0 ; i < x.size() ; i++)
-      box[i+1] = v_sx[i]->output_gate();
-    result = m_ibex_f->eval_vector(box);
-    for(int i = 0 ; i < y.size() ; i++)
-      v_sy[i]->set_output_gate(result[i], false);
-
-    delete[] v_sx;
-    delete[] v_sy;
     return y;
   }
 
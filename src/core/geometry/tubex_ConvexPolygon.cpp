@@ -14,6 +14,7 @@
 #include "tubex_ConvexPolygon.h"
 #include "tubex_GrahamScan.h"
 #include "tubex_VIBesFig.h"
+#include "tubex_perf.h"
 
 using namespace std;
 using namespace ibex;
@@ -25,28 +26,43 @@ namespace tubex
   ConvexPolygon::ConvexPolygon()
     : Polygon()
   {
-
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
   }
 
   ConvexPolygon::ConvexPolygon(const ConvexPolygon& p)
-    : Polygon(p.m_v_floating_pts)
+    : Polygon(p.m_pts)
   {
     // Already convex
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
   }
 
   ConvexPolygon::ConvexPolygon(const IntervalVector& box)
     : Polygon()
   {
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
     assert(box.size() == 2);
     assert(!box.is_empty());
 
-    Point::push(box, m_v_floating_pts);
-    m_v_floating_pts = GrahamScan::convex_hull(m_v_floating_pts);
+    if(box[0].is_degenerated() || box[1].is_degenerated())
+    {
+      vector<Vector> v_pts;
+      Point::push(box, v_pts);
+      m_pts = VertexArray(GrahamScan::convex_hull(v_pts));
+    }
+
+    else // already convex, in counterclockwise order from the bottom-left corner
+    {
+      m_pts.push_back(box[0].lb(), box[1].lb());
+      m_pts.push_back(box[0].ub(), box[1].lb());
+      m_pts.push_back(box[0].ub(), box[1].ub());
+      m_pts.push_back(box[0].lb(), box[1].ub());
+    }
   }
 
   ConvexPolygon::ConvexPolygon(const vector<Point>& v_thick_pts)
     : Polygon()
   {
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
     for(const auto& thick_pt : v_thick_pts)
       if(thick_pt.does_not_exist())
         return; // one undefined point means undefined polygon
@@ -61,7 +77,7 @@ namespace tubex
     {
       if(thick_pt.does_not_exist()) // empty polygon
       {
-        m_v_floating_pts.clear();
+        m_pts.clear();
         return;
       }
 
@@ -81,14 +97,25 @@ namespace tubex
       }
     }
 
-    m_v_floating_pts = GrahamScan::convex_hull(v_pts);
+    m_pts = VertexArray(GrahamScan::convex_hull(v_pts));
   }
 
   ConvexPolygon::ConvexPolygon(const vector<Vector>& v_floating_pts, bool convex_and_convention_order)
-    : Polygon(v_floating_pts)
+    : Polygon()
+  {
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
+    if(!convex_and_convention_order)
+      m_pts = VertexArray(GrahamScan::convex_hull(v_floating_pts));
+    else
+      m_pts = VertexArray(v_floating_pts);
+  }
+
+  ConvexPolygon::ConvexPolygon(const VertexArray& floating_pts, bool convex_and_convention_order)
+    : Polygon(floating_pts)
   {
+    TUBEX_PERF_ALLOC(CONVEX_POLYGON, 1);
     if(!convex_and_convention_order)
-      m_v_floating_pts = GrahamScan::convex_hull(m_v_floating_pts);
+      m_pts = VertexArray(GrahamScan::convex_hull(m_pts.to_vectors()));
   }
 
 
@@ -98,9 +125,9 @@ namespace tubex
   {
     BoolInterval is_subset = YES;
 
-    for(const auto& pt : vertices())
+    for(size_t i = 0 ; i < m_pts.size() ; i++)
     {
-      is_subset = is_subset && p.encloses(Point(pt));
+      is_subset = is_subset && p.encloses(Point(Interval(m_pts.x(i)), Interval(m_pts.y(i))));
       if(is_subset == NO)
         return NO;
     }
@@ -176,9 +203,9 @@ namespace tubex
     IntervalVector box_limit = box();
     box_limit.inflate(box_limit.max_diam()*2.); // avoid wrong optimizations in case of almost parallel edges
 
-    while(m_v_floating_pts.size() > max_edges)
+    while(m_pts.size() > max_edges)
     {
-      size_t n = m_v_floating_pts.size();
+      size_t n = m_pts.size();
 
       // Finding shortest edge, to be removed
       double min_surf = 0.;
@@ -187,8 +214,8 @@ namespace tubex
 
       for(size_t i = 0 ; i < n ; i++)
       {
-        const Edge e1(Point(m_v_floating_pts[(i-1+n)%n]), Point(m_v_floating_pts[i]));
-        const Edge e2(Point(m_v_floating_pts[(i+1)%n]), Point(m_v_floating_pts[(i+2)%n]));
+        const Edge e1(Point(m_pts[(i-1+n)%n]), Point(m_pts[i]));
+        const Edge e2(Point(m_pts[(i+1)%n]), Point(m_pts[(i+2)%n]));
 
         if(Edge::parallel(e1, e2) == NO)
         {
@@ -203,10 +230,10 @@ namespace tubex
           if(!box_limit.contains(inter.mid()))
             continue;
 
-          if(GrahamScan::orientation(m_v_floating_pts[i], inter.box(), m_v_floating_pts[(i+1)%n]) == OrientationInterval::CLOCKWISE)
+          if(GrahamScan::orientation(m_pts[i], inter.box(), m_pts[(i+1)%n]) == OrientationInterval::CLOCKWISE)
             continue;
 
-          double surf = surface(m_v_floating_pts[i], inter.box(), m_v_floating_pts[(i+1)%n]).ub();
+          double surf = surface(m_pts[i], inter.box(), m_pts[(i+1)%n]).ub();
 
           if(min_i == 0 || surf < min_surf) // keeping the simplification that has less impact
           {
@@ -221,11 +248,12 @@ namespace tubex
         return *this;
 
       // Updating one of the vertices, removing the other one
-      m_v_floating_pts[min_i] = min_inter.mid(); // todo: attention: reliability is lost here
-      m_v_floating_pts.erase(m_v_floating_pts.begin() + ((min_i+1)%n));
+      Vector mid = min_inter.mid(); // todo: attention: reliability is lost here
+      m_pts.set(min_i, mid[0], mid[1]);
+      m_pts.erase((min_i+1)%n);
     }
     
-    assert(m_v_floating_pts.size() <= max_edges);
+    assert(m_pts.size() <= max_edges);
     return *this;
   }
 
@@ -246,12 +274,12 @@ namespace tubex
     rtra[1][0] = 0.; rtra[1][1] = 1.; rtra[1][2] = -center[1];
     rtra[2][0] = 0.; rtra[2][1] = 0.; rtra[2][2] = 1.;
 
-    vector<Point> v_thick_pts(m_v_floating_pts.size());
-    for(size_t i = 0 ; i < m_v_floating_pts.size() ; i++)
+    vector<Point> v_thick_pts(m_pts.size());
+    for(size_t i = 0 ; i < m_pts.size() ; i++)
     {
       IntervalVector pt(3);
-      pt[0] = m_v_floating_pts[i][0];
-      pt[1] = m_v_floating_pts[i][1];
+      pt[0] = m_pts.x(i);
+      pt[1] = m_pts.y(i);
       pt[2] = 1.;
       v_thick_pts[i] = Point((tra * rot * rtra * pt).subvector(0,1));
     }
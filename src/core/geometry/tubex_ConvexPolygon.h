@@ -29,6 +29,7 @@ namespace tubex
         explicit ConvexPolygon(const ibex::IntervalVector& box);
         ConvexPolygon(const std::vector<Point>& v_thick_pts);
         ConvexPolygon(const std::vector<ibex::Vector>& v_floating_pts, bool convex_and_convention_order = false);
+        explicit ConvexPolygon(const VertexArray& floating_pts, bool convex_and_convention_order = false);
 
       /// @}
       /// \name Tests
@@ -28,17 +28,23 @@ namespace tubex
   }
 
   Polygon::Polygon(const Polygon& p)
-    : m_v_floating_pts(p.m_v_floating_pts)
+    : m_pts(p.m_pts)
   {
 
   }
   
   Polygon::Polygon(const vector<Vector>& v_floating_pts)
-    : m_v_floating_pts(v_floating_pts)
+    : m_pts(v_floating_pts)
   {
     
   }
 
+  Polygon::Polygon(const VertexArray& floating_pts)
+    : m_pts(floating_pts)
+  {
+
+  }
+
 
   // Accessing values
 
@@ -49,48 +55,60 @@ namespace tubex
 
   int Polygon::nb_edges() const
   {
-    return m_v_floating_pts.size();
+    return m_pts.size();
   }
 
   int Polygon::nb_vertices() const
   {
-    return m_v_floating_pts.size();
+    return m_pts.size();
   }
 
   const vector<Edge> Polygon::edges() const
   {
-    size_t n = m_v_floating_pts.size();
+    size_t n = m_pts.size();
     vector<Edge> v_edges(n,Edge(Point(),Point()));
     for(size_t i = 0 ; i < n ; i++)
-      v_edges[i] = Edge(Point(m_v_floating_pts[i]), Point(m_v_floating_pts[(i+1)%n]));
+      v_edges[i] = Edge(Point(Interval(m_pts.x(i)), Interval(m_pts.y(i))),
+                        Point(Interval(m_pts.x((i+1)%n)), Interval(m_pts.y((i+1)%n))));
     return v_edges;
   }
 
-  const vector<Vector>& Polygon::vertices() const
+  const vector<Vector> Polygon::vertices() const
   {
-    return m_v_floating_pts;
+    return m_pts.to_vectors();
   }
 
-  const Vector& Polygon::operator[](size_t vertex_id) const
+  const VertexArray& Polygon::vertex_array() const
   {
-    assert(vertex_id >= 0 && vertex_id < m_v_floating_pts.size());
-    return m_v_floating_pts[vertex_id];
+    return m_pts;
+  }
+
+  const Vector Polygon::operator[](size_t vertex_id) const
+  {
+    assert(vertex_id >= 0 && vertex_id < m_pts.size());
+    return m_pts[vertex_id];
   }
 
   const IntervalVector Polygon::box() const
   {
     IntervalVector box(2, Interval::EMPTY_SET);
-    for(const auto& pt : m_v_floating_pts)
-      box |= pt;
+    for(size_t i = 0 ; i < m_pts.size() ; i++)
+    {
+      box[0] |= m_pts.x(i);
+      box[1] |= m_pts.y(i);
+    }
     return box;
   }
 
   const Point Polygon::center() const
   {
     IntervalVector center(2, 0.);
-    for(const auto& pt : m_v_floating_pts)
-      center += pt;
-    center *= (1. / m_v_floating_pts.size());
+    for(size_t i = 0 ; i < m_pts.size() ; i++)
+    {
+      center[0] += m_pts.x(i);
+      center[1] += m_pts.y(i);
+    }
+    center *= (1. / m_pts.size());
     return Point(center);;
   }
 
@@ -99,36 +117,36 @@ namespace tubex
 
   bool Polygon::is_empty() const
   {
-    return m_v_floating_pts.size() == 0;
+    return m_pts.size() == 0;
   }
 
   bool Polygon::is_point() const
   {
-    return m_v_floating_pts.size() == 1;
+    return m_pts.size() == 1;
   }
 
   bool Polygon::is_segment() const
   {
-    return m_v_floating_pts.size() == 2;
+    return m_pts.size() == 2;
   }
 
   bool Polygon::operator==(const Polygon& p) const
   {
-    size_t n = m_v_floating_pts.size();
-    if(n != p.m_v_floating_pts.size())
+    size_t n = m_pts.size();
+    if(n != p.m_pts.size())
       return false;
 
     size_t i; // looking for same reference of first value
     for(i = 0 ; i < n ; i++)
-      if(m_v_floating_pts[0] == p.m_v_floating_pts[i])
+      if(m_pts.same_pt(0, p.m_pts, i))
         break;
 
     size_t way = 1;
     if(n > 1)
-      way = (m_v_floating_pts[1] == p.m_v_floating_pts[(i+1)%n]) ? 1 : -1;
+      way = m_pts.same_pt(1, p.m_pts, (i+1)%n) ? 1 : -1;
 
     for(size_t j = 0 ; j < n ; j++)
-      if(m_v_floating_pts[j] != p.m_v_floating_pts[(i+way*j+n)%n])
+      if(!m_pts.same_pt(j, p.m_pts, (i+way*j+n)%n))
         return false;
 
     // todo: test undefined case
@@ -138,21 +156,21 @@ namespace tubex
 
   bool Polygon::operator!=(const Polygon& p) const
   {
-    size_t n = m_v_floating_pts.size();
-    if(n != p.m_v_floating_pts.size())
+    size_t n = m_pts.size();
+    if(n != p.m_pts.size())
       return true;
 
     size_t i; // looking for same reference of first value
     for(i = 0 ; i < n ; i++)
-      if(m_v_floating_pts[0] == p.m_v_floating_pts[i])
+      if(m_pts.same_pt(0, p.m_pts, i))
         break;
 
     size_t way = 1;
     if(n > 1)
-      way = (m_v_floating_pts[1] == p.m_v_floating_pts[(i+1)%n]) ? 1 : -1;
+      way = m_pts.same_pt(1, p.m_pts, (i+1)%n) ? 1 : -1;
 
     for(size_t j = 0 ; j < n ; j++)
-      if(m_v_floating_pts[j] != p.m_v_floating_pts[(i+way*j+n)%n])
+      if(!m_pts.same_pt(j, p.m_pts, (i+way*j+n)%n))
         return true;
 
     // todo: test undefined case
@@ -175,7 +193,7 @@ namespace tubex
       for(int i = 0 ; i < p.nb_vertices() ; i++)
       {
         if(i != 0) str << ",";
-        str << p.vertices()[i];
+        str << p[i];
       }
     }
 
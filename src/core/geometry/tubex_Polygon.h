@@ -16,6 +16,7 @@
 #include "ibex_IntervalVector.h"
 #include "tubex_Edge.h"
 #include "tubex_Point.h"
+#include "tubex_VertexArray.h"
 
 namespace tubex
 {
@@ -29,6 +30,7 @@ namespace tubex
         Polygon();
         Polygon(const Polygon& p);
         Polygon(const std::vector<ibex::Vector>& v_floating_pts);
+        explicit Polygon(const VertexArray& floating_pts);
 
       /// @}
       /// \name Accessing values
@@ -38,8 +40,9 @@ namespace tubex
         int nb_edges() const;
         int nb_vertices() const;
         const std::vector<Edge> edges() const;
-        const std::vector<ibex::Vector>& vertices() const;
-        const ibex::Vector& operator[](size_t vertex_id) const;
+        const std::vector<ibex::Vector> vertices() const;
+        const VertexArray& vertex_array() const;
+        const ibex::Vector operator[](size_t vertex_id) const;
         const ibex::IntervalVector box() const;
         const Point center() const;
 
@@ -64,7 +67,7 @@ namespace tubex
       
     protected:
       
-      std::vector<ibex::Vector> m_v_floating_pts;
+      VertexArray m_pts; // inline storage for small polygons
   };
 }
 
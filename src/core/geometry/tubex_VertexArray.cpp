@@ -0,0 +1,178 @@
+/**
+ *  VertexArray class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cstring>
+#include "tubex_VertexArray.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Definition
+
+  VertexArray::VertexArray()
+  {
+
+  }
+
+  VertexArray::VertexArray(const VertexArray& a)
+  {
+    *this = a;
+  }
+
+  VertexArray::VertexArray(const vector<Vector>& v_pts)
+  {
+    reserve(v_pts.size());
+    for(const auto& pt : v_pts)
+      push_back(pt);
+  }
+
+  VertexArray::~VertexArray()
+  {
+    if(m_pts != m_inline_pts)
+      delete[] m_pts;
+  }
+
+  const VertexArray& VertexArray::operator=(const VertexArray& a)
+  {
+    if(this != &a)
+    {
+      reserve(a.m_size);
+      memcpy(m_pts, a.m_pts, 2 * a.m_size * sizeof(double));
+      m_size = a.m_size;
+    }
+
+    return *this;
+  }
+
+
+  // Accessing values
+
+  size_t VertexArray::size() const
+  {
+    return m_size;
+  }
+
+  bool VertexArray::empty() const
+  {
+    return m_size == 0;
+  }
+
+  double VertexArray::x(size_t i) const
+  {
+    assert(i < m_size);
+    return m_pts[2*i];
+  }
+
+  double VertexArray::y(size_t i) const
+  {
+    assert(i < m_size);
+    return m_pts[2*i+1];
+  }
+
+  const Vector VertexArray::operator[](size_t i) const
+  {
+    assert(i < m_size);
+    return Vector({ m_pts[2*i], m_pts[2*i+1] });
+  }
+
+  const vector<Vector> VertexArray::to_vectors() const
+  {
+    vector<Vector> v_pts;
+    v_pts.reserve(m_size);
+    for(size_t i = 0 ; i < m_size ; i++)
+      v_pts.push_back((*this)[i]);
+    return v_pts;
+  }
+
+  bool VertexArray::same_pt(size_t i, const VertexArray& a, size_t j) const
+  {
+    return x(i) == a.x(j) && y(i) == a.y(j);
+  }
+
+
+  // Setting values
+
+  void VertexArray::clear()
+  {
+    m_size = 0;
+  }
+
+  void VertexArray::push_back(double x, double y)
+  {
+    if(m_size == m_capacity)
+      reserve(2 * m_capacity);
+
+    m_pts[2*m_size] = x;
+    m_pts[2*m_size+1] = y;
+    m_size++;
+  }
+
+  void VertexArray::push_back(const Vector& pt)
+  {
+    assert(pt.size() == 2 && "operation not supported for other dimensions");
+    push_back(pt[0], pt[1]);
+  }
+
+  void VertexArray::set(size_t i, double x, double y)
+  {
+    assert(i < m_size);
+    m_pts[2*i] = x;
+    m_pts[2*i+1] = y;
+  }
+
+  void VertexArray::erase(size_t i)
+  {
+    assert(i < m_size);
+    memmove(m_pts + 2*i, m_pts + 2*(i+1), 2 * (m_size - i - 1) * sizeof(double));
+    m_size--;
+  }
+
+  void VertexArray::remove_identical_pts()
+  {
+    // Keeping the first occurrence of each point, in the same order
+    size_t n = 0;
+    for(size_t i = 0 ; i < m_size ; i++)
+    {
+      bool found = false;
+      for(size_t j = 0 ; j < n && !found ; j++)
+        found = same_pt(i, *this, j);
+
+      if(!found)
+      {
+        m_pts[2*n] = m_pts[2*i];
+        m_pts[2*n+1] = m_pts[2*i+1];
+        n++;
+      }
+    }
+
+    m_size = n;
+  }
+
+
+  // Protected methods
+
+  void VertexArray::reserve(size_t capacity)
+  {
+    if(capacity <= m_capacity)
+      return;
+
+    double *pts = new double[2 * capacity];
+    memcpy(pts, m_pts, 2 * m_size * sizeof(double));
+
+    if(m_pts != m_inline_pts)
+      delete[] m_pts;
+
+    m_pts = pts;
+    m_capacity = capacity;
+  }
+}
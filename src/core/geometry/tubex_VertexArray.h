@@ -0,0 +1,78 @@
+/**
+ *  VertexArray class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_VERTEXARRAY_H__
+#define __TUBEX_VERTEXARRAY_H__
+
+#include <vector>
+#include "ibex_Vector.h"
+
+namespace tubex
+{
+  /**
+   * \class VertexArray
+   * \brief Array of 2d floating points, vertices of a polygon
+   *
+   * The coordinates of up to INLINE_CAPACITY vertices are stored in the
+   * object itself: small polygons, such as the ones of slices, do not
+   * require any heap allocation. Larger arrays are moved to the heap.
+   */
+  class VertexArray
+  {
+    public:
+
+      static const size_t INLINE_CAPACITY = 8; //!< number of vertices stored without heap allocation
+
+      /// \name Definition
+      /// @{
+
+        VertexArray();
+        VertexArray(const VertexArray& a);
+        explicit VertexArray(const std::vector<ibex::Vector>& v_pts);
+        ~VertexArray();
+        const VertexArray& operator=(const VertexArray& a);
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+        size_t size() const;
+        bool empty() const;
+        double x(size_t i) const;
+        double y(size_t i) const;
+        const ibex::Vector operator[](size_t i) const;
+        const std::vector<ibex::Vector> to_vectors() const;
+        bool same_pt(size_t i, const VertexArray& a, size_t j) const;
+
+      /// @}
+      /// \name Setting values
+      /// @{
+
+        void clear();
+        void push_back(double x, double y);
+        void push_back(const ibex::Vector& pt);
+        void set(size_t i, double x, double y);
+        void erase(size_t i);
+        void remove_identical_pts();
+
+      /// @}
+
+    protected:
+
+      void reserve(size_t capacity);
+
+      double m_inline_pts[2*INLINE_CAPACITY]; //!< inline storage of the coordinates (x0,y0,x1,y1,...)
+      double *m_pts = m_inline_pts; //!< coordinates, stored inline or on the heap
+      size_t m_size = 0; //!< number of vertices
+      size_t m_capacity = INLINE_CAPACITY; //!< number of vertices that can be stored without reallocation
+  };
+}
+
+#endif
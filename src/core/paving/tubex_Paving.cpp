@@ -9,6 +9,9 @@
  */
 
 #include <list>
+#include <new>
+#include <algorithm>
+#include <unordered_map>
 #include <iostream>
 #include "tubex_Paving.h"
 #include "ibex_LargestFirst.h"
@@ -30,9 +33,18 @@ namespace tubex
   {
     if(m_first_subpaving != NULL)
     {
-      delete m_first_subpaving;
-      delete m_second_subpaving;
+      Paving *v_sub[2] = { m_first_subpaving, m_second_subpaving };
+      for(int i = 0 ; i < 2 ; i++)
+      {
+        if(v_sub[i]->m_pooled)
+          v_sub[i]->~Paving(); // memory released by the pools of the root
+        else
+          delete v_sub[i];
+      }
     }
+
+    for(size_t i = 0 ; i < m_v_node_pools.size() ; i++)
+      delete m_v_node_pools[i];
   }
 
   // Binary tree structure
@@ -99,11 +111,45 @@ namespace tubex
     m_second_subpaving->m_root = m_root;
   }
 
+  void Paving::bisect(PavingNodePool& pool, float ratio)
+  {
+    assert(Interval(0.,1.).interior_contains(ratio));
+    assert(is_leaf() && "only leaves can be bisected");
+
+    LargestFirst bisector(0., ratio);
+    pair<IntervalVector,IntervalVector> subboxes = bisector.bisect(m_box);
+    m_first_subpaving = new (pool.allocate()) Paving(subboxes.first, m_value);
+    m_first_subpaving->m_root = m_root;
+    m_first_subpaving->m_pooled = true;
+    m_second_subpaving = new (pool.allocate()) Paving(subboxes.second, m_value);
+    m_second_subpaving->m_root = m_root;
+    m_second_subpaving->m_pooled = true;
+  }
+
   bool Paving::is_leaf() const
   {
     return m_first_subpaving == NULL;
   }
 
+  // Parallel computation
+
+  void Paving::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = nb_threads;
+  }
+
+  void Paving::set_task_depth(int task_depth)
+  {
+    assert(task_depth >= 0);
+    m_task_depth = task_depth;
+  }
+
+  const PavingEngine Paving::engine() const
+  {
+    return PavingEngine(m_nb_threads, m_task_depth);
+  }
+
   // Flags
 
   bool Paving::flag() const
@@ -151,6 +197,21 @@ namespace tubex
     }
   }
 
+  void Paving::get_leaves(SetValue val, vector<const Paving*>& v_leaves) const
+  {
+    if(is_leaf())
+    {
+      if(m_value & val)
+        v_leaves.push_back(this);
+    }
+
+    else
+    {
+      m_first_subpaving->get_leaves(val, v_leaves);
+      m_second_subpaving->get_leaves(val, v_leaves);
+    }
+  }
+
   void Paving::get_neighbours(vector<const Paving*>& v_neighbours, SetValue val, bool without_flag) const
   {
     v_neighbours.clear();
@@ -164,48 +225,88 @@ namespace tubex
     }
   }
 
-  // todo: bool compare_subset(const ConnectedSubset* x1, const ConnectedSubset* x2)
-  // todo: {
-  // todo:   return x1->get_items().size() > x2->get_items().size();
-  // todo: }
+  static bool compare_subset(const ConnectedSubset& x1, const ConnectedSubset& x2)
+  {
+    return x1.get_items().size() > x2.get_items().size();
+  }
 
-  vector<ConnectedSubset> Paving::get_connected_subsets(bool sort_by_size) const
+  static size_t find_subset_root(vector<size_t>& v_parent, size_t i)
   {
-    reset_flags();
+    while(v_parent[i] != i)
+    {
+      v_parent[i] = v_parent[v_parent[i]]; // path halving
+      i = v_parent[i];
+    }
+    return i;
+  }
 
-    const Paving *p;
+  vector<ConnectedSubset> Paving::get_connected_subsets(bool sort_by_size) const
+  {
     SetValue val = SetValue::MAYBE | SetValue::IN;
-    vector<ConnectedSubset> v_connected_subsets;
 
-    while((p = get_first_leaf(val, true)) != NULL)
-    {
-      vector<const Paving*> v_subset_items;
-      list<const Paving*> l;
-      l.push_back(p);
+    // Leaf array, enumerated once
 
-      while(!l.empty())
+      vector<const Paving*> v_leaves;
+      get_leaves(val, v_leaves);
+
+      unordered_map<const Paving*,size_t> map_ids;
+      map_ids.reserve(v_leaves.size());
+      for(size_t i = 0 ; i < v_leaves.size() ; i++)
+        map_ids[v_leaves[i]] = i;
+
+    // Union-find over the adjacency of the leaves
+
+      vector<size_t> v_parent(v_leaves.size()), v_rank(v_leaves.size(), 0);
+      for(size_t i = 0 ; i < v_leaves.size() ; i++)
+        v_parent[i] = i;
+
+      vector<const Paving*> v_neighbours;
+      for(size_t i = 0 ; i < v_leaves.size() ; i++)
       {
-        const Paving *e = l.front();
-        l.pop_front();
+        // Tree-neighbour search: only the branches intersecting the leaf are visited
+        v_neighbours.clear();
+        get_pavings_intersecting(val, v_leaves[i]->box(), v_neighbours);
+
+        for(size_t j = 0 ; j < v_neighbours.size() ; j++)
+        {
+          unordered_map<const Paving*,size_t>::const_iterator it = map_ids.find(v_neighbours[j]);
+          if(it == map_ids.end() || it->second <= i)
+            continue; // each adjacency is processed once
+
+          size_t ri = find_subset_root(v_parent, i), rj = find_subset_root(v_parent, it->second);
+          if(ri == rj)
+            continue;
 
-        v_subset_items.push_back(e);
-        e->set_flag();
+          if(v_rank[ri] < v_rank[rj]) swap(ri, rj);
+          v_parent[rj] = ri;
+          if(v_rank[ri] == v_rank[rj]) v_rank[ri]++;
+        }
+      }
 
-        vector<const Paving*> v_neighbours;
-        e->get_neighbours(v_neighbours, val, true);
+    // Gathering the items of each subset, in the order of appearance of the leaves
 
-        for(size_t i = 0 ; i < v_neighbours.size() ; i++)
+      vector<int> v_subset_id(v_leaves.size(), -1);
+      vector<vector<const Paving*> > v_subsets_items;
+
+      for(size_t i = 0 ; i < v_leaves.size() ; i++)
+      {
+        size_t r = find_subset_root(v_parent, i);
+        if(v_subset_id[r] == -1)
         {
-          v_neighbours[i]->set_flag();
-          l.push_back(v_neighbours[i]);
+          v_subset_id[r] = v_subsets_items.size();
+          v_subsets_items.push_back(vector<const Paving*>());
         }
+
+        v_subsets_items[v_subset_id[r]].push_back(v_leaves[i]);
       }
 
-      v_connected_subsets.push_back(ConnectedSubset(v_subset_items));
-    }
+    vector<ConnectedSubset> v_connected_subsets;
+    v_connected_subsets.reserve(v_subsets_items.size());
+    for(size_t i = 0 ; i < v_subsets_items.size() ; i++)
+      v_connected_subsets.push_back(ConnectedSubset(v_subsets_items[i]));
 
-    // todo: if(sort_by_size)
-    // todo:   sort(v_connected_subsets.begin(), v_connected_subsets.end(), compare_subset);
+    if(sort_by_size)
+      stable_sort(v_connected_subsets.begin(), v_connected_subsets.end(), compare_subset);
 
     return v_connected_subsets;
   }
@@ -14,6 +14,7 @@
 
 #include "tubex_Set.h"
 #include "tubex_ConnectedSubset.h"
+#include "tubex_PavingEngine.h"
 
 namespace tubex
 {
@@ -124,6 +125,29 @@ namespace tubex
        */
       bool is_leaf() const;
 
+      /// @}
+      /// \name Parallel computation
+      /// @{
+
+      /**
+       * \brief Sets the number of threads used by the computation of this paving
+       *
+       * \note The resulting paving does not depend on this number.
+       *
+       * \param nb_threads number of threads (0 for the global setting of the Executor, 1 for a sequential run)
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Sets the task-granularity cutoff of the computation of this paving
+       *
+       * Subpavings located at a depth lower than this value are spawned as
+       * independent tasks, deeper ones are computed by the thread owning their parent.
+       *
+       * \param task_depth depth in the binary tree (10 by default)
+       */
+      void set_task_depth(int task_depth);
+
       /// @}
       /// \name Flags
       /// @{
@@ -163,6 +187,16 @@ namespace tubex
           std::vector<const Paving*>& v_subpavings,
           bool no_degenerated_intersection = false) const;
 
+      /**
+       * \brief Returns the leaves of this paving having some value
+       *
+       * The leaves are appended in the depth-first order of the binary tree.
+       *
+       * \param val the value of the leaves we are looking for
+       * \param v_leaves the set of returned objects
+       */
+      void get_leaves(SetValue val, std::vector<const Paving*>& v_leaves) const;
+
       /**
        * \brief Returns the neighbors (adjacent items) of this Paving, having some value
        *
@@ -182,8 +216,12 @@ namespace tubex
        *
        * \note Note that this method is preferably called from the root Paving.
        *
+       * The leaves are enumerated once, their adjacency is computed by a single
+       * tree-neighbour search per leaf, and the subsets are obtained by union-find,
+       * which makes the extraction nearly linear in the number of leaves.
+       *
        * \param sort_by_size (optional) if `true` then the subsets will be
-       *                     sort by the number of boxes they are made of
+       *                     sorted by decreasing number of boxes they are made of
        * \return the set of connected subsets
        */
       std::vector<ConnectedSubset> get_connected_subsets(bool sort_by_size = false) const;
@@ -192,9 +230,32 @@ namespace tubex
 
     protected:
 
-      mutable bool m_flag; //!< optional flag, can be used by search algorithms
+      /**
+       * \brief Bisects this paving, the two subpavings being allocated from a node pool
+       *
+       * \note The pool must be owned by the root of this paving.
+       *
+       * \param pool the PavingNodePool providing the memory of the subpavings
+       * \param ratio the bisection ratio
+       */
+      void bisect(PavingNodePool& pool, float ratio);
+
+      /**
+       * \brief Returns an engine configured with the parallel settings of this paving
+       *
+       * \return the PavingEngine object
+       */
+      const PavingEngine engine() const;
+
+      mutable bool m_flag = false; //!< optional flag, can be used by search algorithms
       Paving *m_root = NULL; //!< pointer to the root
       Paving *m_first_subpaving = NULL, *m_second_subpaving = NULL; //!< tree structure
+      bool m_pooled = false; //!< `true` if this node has been allocated from a PavingNodePool
+      std::vector<PavingNodePool*> m_v_node_pools; //!< node pools owned by the root
+      int m_nb_threads = 0; //!< number of threads for the computation of the paving
+      int m_task_depth = 10; //!< task-granularity cutoff for the computation of the paving
+
+      friend class PavingEngine;
   };
 }
 
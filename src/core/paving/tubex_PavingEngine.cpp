@@ -0,0 +1,207 @@
+/**
+ *  PavingEngine class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include "tubex_PavingEngine.h"
+#include "tubex_Paving.h"
+#include "tubex_Executor.h"
+
+using namespace std;
+
+namespace tubex
+{
+  // PavingNodePool
+
+  PavingNodePool::PavingNodePool(size_t chunk_size)
+    : m_chunk_size(chunk_size)
+  {
+    assert(chunk_size > 0);
+  }
+
+  PavingNodePool::~PavingNodePool()
+  {
+    for(size_t i = 0 ; i < m_v_chunks.size() ; i++)
+      ::operator delete(m_v_chunks[i]);
+  }
+
+  void* PavingNodePool::allocate()
+  {
+    size_t i = m_nb_nodes % m_chunk_size;
+    if(i == 0)
+      m_v_chunks.push_back(static_cast<char*>(::operator new(m_chunk_size * sizeof(Paving))));
+    m_nb_nodes++;
+    return m_v_chunks.back() + i * sizeof(Paving);
+  }
+
+  size_t PavingNodePool::nb_nodes() const
+  {
+    return m_nb_nodes;
+  }
+
+  // PavingEngine
+
+  struct PavingTask
+  {
+    Paving *node;
+    int depth;
+  };
+
+  struct PavingTaskQueue
+  {
+    mutex mtx;
+    deque<PavingTask> tasks;
+  };
+
+  PavingEngine::PavingEngine(int nb_threads, int task_depth)
+    : m_nb_threads(nb_threads), m_task_depth(task_depth)
+  {
+    assert(nb_threads >= 0);
+    assert(task_depth >= 0);
+
+    m_nb_threads = Executor::nb_threads(nb_threads);
+  }
+
+  int PavingEngine::nb_threads() const
+  {
+    return m_nb_threads;
+  }
+
+  void PavingEngine::compute(Paving *root, const LeafTest& f, float ratio) const
+  {
+    assert(root != NULL);
+
+    // One node pool per thread, owned by the root of the paving
+
+      vector<PavingNodePool*> v_pools(m_nb_threads);
+      for(int i = 0 ; i < m_nb_threads ; i++)
+      {
+        v_pools[i] = new PavingNodePool();
+        root->get_root()->m_v_node_pools.push_back(v_pools[i]);
+      }
+
+    // Exploration of a subtree by one thread. Subpavings that are
+    // close enough to the root are returned as new tasks.
+
+      const bool parallel = m_nb_threads > 1;
+      const int task_depth = m_task_depth;
+
+      function<void(Paving*,int,int,vector<PavingTask>&)> explore =
+        [&](Paving *p, int depth, int thread_id, vector<PavingTask>& v_spawned)
+        {
+          if(p->is_leaf())
+          {
+            if(!f(p, thread_id))
+              return;
+            p->bisect(*v_pools[thread_id], ratio);
+          }
+
+          Paving *v_sub[2] = { p->m_first_subpaving, p->m_second_subpaving };
+          for(int i = 0 ; i < 2 ; i++)
+          {
+            if(parallel && depth + 1 < task_depth)
+              v_spawned.push_back({ v_sub[i], depth + 1 });
+            else
+              explore(v_sub[i], depth + 1, thread_id, v_spawned);
+          }
+        };
+
+    // Deterministic sequential fallback
+
+      if(!parallel)
+      {
+        vector<PavingTask> v_spawned;
+        explore(root, 0, 0, v_spawned);
+        assert(v_spawned.empty());
+        return;
+      }
+
+    // Work-stealing execution: each thread pops its own tasks in LIFO
+    // order (depth-first) and steals the oldest tasks of the others
+
+      vector<PavingTaskQueue> v_queues(m_nb_threads);
+      v_queues[0].tasks.push_back({ root, 0 });
+      atomic<int> nb_pending(1);
+      atomic<bool> aborted(false);
+      exception_ptr first_exception;
+      mutex exception_mtx;
+
+      auto worker = [&](int thread_id)
+      {
+        vector<PavingTask> v_spawned;
+
+        while(nb_pending.load() > 0 && !aborted.load())
+        {
+          PavingTask task = { NULL, 0 };
+
+          {
+            lock_guard<mutex> lock(v_queues[thread_id].mtx);
+            if(!v_queues[thread_id].tasks.empty())
+            {
+              task = v_queues[thread_id].tasks.back();
+              v_queues[thread_id].tasks.pop_back();
+            }
+          }
+
+          for(int i = 1 ; task.node == NULL && i < m_nb_threads ; i++)
+          {
+            PavingTaskQueue& victim = v_queues[(thread_id + i) % m_nb_threads];
+            lock_guard<mutex> lock(victim.mtx);
+            if(!victim.tasks.empty())
+            {
+              task = victim.tasks.front();
+              victim.tasks.pop_front();
+            }
+          }
+
+          if(task.node == NULL)
+          {
+            this_thread::yield();
+            continue;
+          }
+
+          try
+          {
+            v_spawned.clear();
+            explore(task.node, task.depth, thread_id, v_spawned);
+
+            if(!v_spawned.empty())
+            {
+              nb_pending += v_spawned.size();
+              lock_guard<mutex> lock(v_queues[thread_id].mtx);
+              for(size_t i = 0 ; i < v_spawned.size() ; i++)
+                v_queues[thread_id].tasks.push_back(v_spawned[i]);
+            }
+          }
+
+          catch(...)
+          {
+            lock_guard<mutex> lock(exception_mtx);
+            if(!first_exception)
+              first_exception = current_exception();
+            aborted = true;
+          }
+
+          nb_pending--;
+        }
+      };
+
+      // Workers are run by the pool of the library: a worker that starts
+      // late finds no pending task and returns immediately
+      Executor::global().run(m_nb_threads, worker);
+
+      if(first_exception)
+        rethrow_exception(first_exception);
+  }
+}
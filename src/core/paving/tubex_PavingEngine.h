@@ -0,0 +1,130 @@
+/**
+ *  \file
+ *  PavingEngine class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_PAVINGENGINE_H__
+#define __TUBEX_PAVINGENGINE_H__
+
+#include <vector>
+#include <functional>
+
+namespace tubex
+{
+  class Paving;
+
+  /**
+   * \class PavingNodePool
+   * \brief Chunk allocator of Paving nodes
+   *
+   * A pool is used by a single thread at a time: no locking is performed.
+   * The allocated memory is released when the pool is destroyed, the nodes
+   * must have been destroyed (but not deallocated) beforehand.
+   */
+  class PavingNodePool
+  {
+    public:
+
+      /**
+       * \brief Creates an empty pool
+       *
+       * \param chunk_size number of nodes allocated at once
+       */
+      PavingNodePool(size_t chunk_size = 512);
+
+      /**
+       * \brief PavingNodePool destructor
+       */
+      ~PavingNodePool();
+
+      /**
+       * \brief Returns raw memory for one Paving node
+       *
+       * \return a pointer to uninitialized storage of `sizeof(Paving)` bytes
+       */
+      void* allocate();
+
+      /**
+       * \brief Returns the number of nodes allocated from this pool
+       *
+       * \return an integer
+       */
+      size_t nb_nodes() const;
+
+    protected:
+
+      PavingNodePool(const PavingNodePool&) = delete;
+      PavingNodePool& operator=(const PavingNodePool&) = delete;
+
+      const size_t m_chunk_size; //!< number of nodes per chunk
+      std::vector<char*> m_v_chunks; //!< allocated memory blocks
+      size_t m_nb_nodes = 0; //!< number of nodes already provided
+  };
+
+  /**
+   * \class PavingEngine
+   * \brief Task-based computation of a Paving
+   *
+   * The engine calls a test function on the leaves of a paving. If the test
+   * requests a bisection, the leaf is bisected and its two subpavings are
+   * tested in turn. Subtrees close to the root are distributed as tasks among
+   * worker threads (work stealing), deeper ones are explored depth-first
+   * by the thread owning the task. The threads are provided by the pool
+   * of the library, see Executor.
+   *
+   * As the test of a node only depends on its box, the resulting tree
+   * does not depend on the number of threads nor on the scheduling.
+   */
+  class PavingEngine
+  {
+    public:
+
+      /**
+       * \brief Test function called on each leaf
+       *
+       * The function sets the value of the leaf and returns `true` if the leaf
+       * has to be bisected. The second argument is the index of the calling thread
+       * (between 0 and nb_threads()-1), to be used for thread-local resources.
+       */
+      typedef std::function<bool(Paving*,int)> LeafTest;
+
+      /**
+       * \brief Creates a paving engine
+       *
+       * \param nb_threads number of threads (0 for the global setting of the Executor, 1 for a sequential run)
+       * \param task_depth depth of the binary tree down to which subpavings are spawned as tasks
+       */
+      PavingEngine(int nb_threads = 0, int task_depth = 10);
+
+      /**
+       * \brief Returns the actual number of threads used by this engine
+       *
+       * \return an integer greater than 0
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Computes the paving from its root
+       *
+       * \note Non-leaf nodes are traversed and their leaves are tested.
+       *
+       * \param root the Paving to be computed
+       * \param f the test function called on the leaves
+       * \param ratio the bisection ratio
+       */
+      void compute(Paving *root, const LeafTest& f, float ratio = 0.49) const;
+
+    protected:
+
+      int m_nb_threads; //!< number of threads
+      int m_task_depth; //!< task-granularity cutoff, as a depth in the binary tree
+  };
+}
+
+#endif
@@ -28,22 +28,43 @@ namespace tubex
     assert(f.nb_var() == box().size());
     assert(f.image_dim() == y.size());
 
-    IntervalVector result = f.eval_vector(box());
+    const PavingEngine paving_engine = engine();
 
-    if(result.is_subset(y))
-      set_value(SetValue::IN);
+    // IBEX functions are not reentrant: one copy per thread
+    vector<Function*> v_f(paving_engine.nb_threads());
+    for(size_t i = 0 ; i < v_f.size() ; i++)
+      v_f[i] = new Function(f, Function::COPY);
 
-    else if(!result.intersects(y))
-      set_value(SetValue::OUT);
+    try
+    {
+      paving_engine.compute(this, [&](Paving *p, int thread_id) -> bool
+      {
+        IntervalVector result = v_f[thread_id]->eval_vector(p->box());
+
+        if(result.is_subset(y))
+          p->set_value(SetValue::IN);
+
+        else if(!result.intersects(y))
+          p->set_value(SetValue::OUT);
+
+        else if(p->box().max_diam() < precision)
+          p->set_value(SetValue::MAYBE);
 
-    else if(box().max_diam() < precision)
-      set_value(SetValue::MAYBE);
+        else
+          return true; // bisection
 
-    else
+        return false;
+      });
+    }
+
+    catch(...)
     {
-      bisect();
-      ((SIVIAPaving*)m_first_subpaving)->compute(f, y, precision);
-      ((SIVIAPaving*)m_second_subpaving)->compute(f, y, precision);
+      for(size_t i = 0 ; i < v_f.size() ; i++)
+        delete v_f[i];
+      throw;
     }
+
+    for(size_t i = 0 ; i < v_f.size() ; i++)
+      delete v_f[i];
   }
 }
\ No newline at end of file
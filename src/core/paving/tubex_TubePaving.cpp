@@ -27,47 +27,53 @@ namespace tubex
     assert(precision > 0.);
     assert(x.size() == size());
 
-    IntervalVector y = box();
-    vector<Interval> v_t_inv;
-    x.invert(y, v_t_inv);
+    // Lazily computed data of the tubes are precomputed before the
+    // parallel computation, so that the tubes are then only read
+    for(int j = 0 ; j < x.size() ; j++)
+      x[j].freeze();
 
-    bool is_out = v_t_inv.empty();
-    bool is_in = false;
-
-    for(size_t i = 0 ; i < v_t_inv.size() && !is_in ; i++)
+    engine().compute(this, [&](Paving *p, int) -> bool
     {
-      const Slice **s = new const Slice*[size()];
-      for(int j = 0 ; j < size() ; j++)
-        s[j] = x[j].slice(v_t_inv[i].lb());
+      IntervalVector y = p->box();
+      vector<Interval> v_t_inv;
+      x.invert(y, v_t_inv);
+
+      bool is_out = v_t_inv.empty();
+      bool is_in = false;
 
-      while(!is_in && s[0] != NULL && s[0]->tdomain().ub() <= v_t_inv[i].ub())
+      vector<const Slice*> v_s(size());
+      for(size_t i = 0 ; i < v_t_inv.size() && !is_in ; i++)
       {
-        bool is_in_i = true;
+        for(int j = 0 ; j < size() ; j++)
+          v_s[j] = x[j].slice(v_t_inv[i].lb());
 
-        for(int j = 0 ; j < size() && is_in_i ; j++)
-          is_in_i &= y[j].is_subset(s[j]->codomain());
+        while(!is_in && v_s[0] != NULL && v_s[0]->tdomain().ub() <= v_t_inv[i].ub())
+        {
+          bool is_in_i = true;
 
-        is_in |= is_in_i;
+          for(int j = 0 ; j < size() && is_in_i ; j++)
+            is_in_i &= y[j].is_subset(v_s[j]->codomain());
 
-        for(int j = 0 ; j < size() ; j++)
-          s[j] = s[j]->next_slice();
+          is_in |= is_in_i;
+
+          for(int j = 0 ; j < size() ; j++)
+            v_s[j] = v_s[j]->next_slice();
+        }
       }
-    }
 
-    if(is_out)
-      set_value(SetValue::OUT);
+      if(is_out)
+        p->set_value(SetValue::OUT);
 
-    else if(is_in)
-      set_value(SetValue::IN);
+      else if(is_in)
+        p->set_value(SetValue::IN);
 
-    else if(box().max_diam() < precision)
-      set_value(SetValue::MAYBE);
+      else if(p->box().max_diam() < precision)
+        p->set_value(SetValue::MAYBE);
 
-    else
-    {
-      bisect();
-      ((TubePaving*)m_first_subpaving)->compute(precision, x);
-      ((TubePaving*)m_second_subpaving)->compute(precision, x);
-    }
+      else
+        return true; // bisection
+
+      return false;
+    });
   }
 }
\ No newline at end of file
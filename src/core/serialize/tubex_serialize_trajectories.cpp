@@ -35,6 +35,7 @@ namespace tubex
         break;
 
       case 2:
+      case 3: // trajectories are not compacted
       {
         // Points number
         int pts_number = traj.sampled_map().size();
@@ -71,6 +72,7 @@ namespace tubex
         break;
 
       case 2:
+      case 3: // trajectories are not compacted
       {
         traj = new Trajectory();
 
@@ -13,6 +13,7 @@
 #include "tubex_Exception.h"
 #include "tubex_Tube.h"
 #include "tubex_TubeVector.h"
+#include "tubex_CompactTube.h"
 #include "tubex_Slice.h"
 
 using namespace std;
@@ -62,6 +63,10 @@ namespace tubex
         break;
       }
 
+      case 3:
+        serialize_CompactTube(bin_file, CompactTube(tube));
+        break;
+
       default:
         throw Exception("serialize_Tube()", "unhandled case");
     }
@@ -153,11 +158,147 @@ namespace tubex
         break;
       }
 
+      case 3:
+      {
+        bin_file.seekg(-(streamoff)sizeof(short int), ios_base::cur); // version number read again
+        CompactTube *compact_tube;
+        deserialize_CompactTube(bin_file, compact_tube);
+        tube = new Tube(compact_tube->tube());
+        delete compact_tube;
+        break;
+      }
+
       default:
         throw Exception("deserialize_Tube()", "deserialization version number not supported");
     }
   }
 
+  // Bounds of uniform slices, computed as in the Tube(tdomain, timestep) constructor.
+  // Returns false if more than max_nb_bounds bounds would be computed.
+  static bool uniform_slicing(double t0, double timestep, double tf, vector<double>& v_t, size_t max_nb_bounds)
+  {
+    assert(timestep > 0.);
+
+    double ub = t0;
+    v_t.clear();
+    v_t.push_back(t0);
+
+    do
+    {
+      if(v_t.size() >= max_nb_bounds)
+        return false;
+
+      ub = min(ub + timestep, tf);
+      v_t.push_back(ub);
+    } while(ub < tf);
+
+    return true;
+  }
+
+  void serialize_CompactTube(ofstream& bin_file, const CompactTube& tube)
+  {
+    if(!bin_file.is_open())
+      throw Exception("serialize_CompactTube()", "ofstream& bin_file not open");
+
+    // Version number for compliance purposes
+    short int version_number = 3;
+    bin_file.write((const char*)&version_number, sizeof(short int));
+
+    // Slices number
+    int slices_number = tube.nb_slices();
+    bin_file.write((const char*)&slices_number, sizeof(int));
+
+    // Domains: a uniform slicing is stored with its timestep only,
+    // provided that the same bounds are computed again at deserialization
+    double t0 = tube.m_v_t.front(), tf = tube.m_v_t.back();
+    double timestep = tube.m_v_t[1] - t0;
+
+    vector<double> v_t;
+    char uniform = uniform_slicing(t0, timestep, tf, v_t, tube.m_v_t.size()) && v_t == tube.m_v_t;
+    bin_file.write((const char*)&uniform, sizeof(char));
+
+    if(uniform)
+    {
+      bin_file.write((const char*)&t0, sizeof(double));
+      bin_file.write((const char*)&timestep, sizeof(double));
+      bin_file.write((const char*)&tf, sizeof(double));
+    }
+
+    else
+      bin_file.write((const char*)tube.m_v_t.data(), tube.m_v_t.size() * sizeof(double));
+
+    // Codomains, then gates
+    bin_file.write((const char*)tube.m_v_codomains.data(), tube.m_v_codomains.size() * sizeof(float));
+    bin_file.write((const char*)tube.m_v_gates.data(), tube.m_v_gates.size() * sizeof(float));
+  }
+
+  void deserialize_CompactTube(ifstream& bin_file, CompactTube *&tube)
+  {
+    if(!bin_file.is_open())
+      throw Exception("deserialize_CompactTube()", "ifstream& bin_file not open");
+
+    // Version number for compliance purposes
+    short int version_number;
+    bin_file.read((char*)&version_number, sizeof(short int));
+
+    switch(version_number)
+    {
+      case 3:
+      {
+        tube = new CompactTube();
+
+        // Slices number
+        int slices_number;
+        bin_file.read((char*)&slices_number, sizeof(int));
+
+        if(slices_number < 1)
+          throw Exception("deserialize_CompactTube()", "wrong slices number");
+
+        // Domains
+        char uniform;
+        bin_file.read((char*)&uniform, sizeof(char));
+
+        if(uniform)
+        {
+          double t0, timestep, tf;
+          bin_file.read((char*)&t0, sizeof(double));
+          bin_file.read((char*)&timestep, sizeof(double));
+          bin_file.read((char*)&tf, sizeof(double));
+
+          if(!(timestep > 0.)) // also rejects NaN values
+            throw Exception("deserialize_CompactTube()", "wrong timestep");
+
+          if(!uniform_slicing(t0, timestep, tf, tube->m_v_t, slices_number + 1)
+            || (int)tube->m_v_t.size() != slices_number + 1)
+            throw Exception("deserialize_CompactTube()", "wrong slices number");
+        }
+
+        else
+        {
+          tube->m_v_t.resize(slices_number + 1);
+          bin_file.read((char*)tube->m_v_t.data(), tube->m_v_t.size() * sizeof(double));
+        }
+
+        // Codomains, then gates
+        tube->m_v_codomains.resize(2 * slices_number);
+        bin_file.read((char*)tube->m_v_codomains.data(), tube->m_v_codomains.size() * sizeof(float));
+        tube->m_v_gates.resize(2 * (slices_number + 1));
+        bin_file.read((char*)tube->m_v_gates.data(), tube->m_v_gates.size() * sizeof(float));
+        break;
+      }
+
+      default:
+      {
+        // Previous versions: the full tube is read, then compacted
+        bin_file.seekg(-(streamoff)sizeof(short int), ios_base::cur);
+        Tube *full_tube;
+        deserialize_Tube(bin_file, full_tube);
+        tube = new CompactTube(*full_tube);
+        delete full_tube;
+      }
+    }
+  }
+
   void serialize_TubeVector(ofstream& bin_file, const TubeVector& tube, int version_number)
   {
     if(!bin_file.is_open())
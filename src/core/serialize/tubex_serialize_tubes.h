@@ -20,14 +20,15 @@ namespace tubex
 
   class Tube;
   class TubeVector;
+  class CompactTube;
 
   /// \name Tube
   /// @{
 
   /**
-   * \brief Writes a Tube object into a binary file (version 2)
+   * \brief Writes a Tube object into a binary file (version 2 or 3)
    * 
-   * Tube binary structure: <br>
+   * Tube binary structure (version 2): <br>
    *   [short_int_version_number] <br>
    *   [int_nb_slices] <br>
    *   [double_t0] <br>
@@ -41,6 +42,10 @@ namespace tubex
    *   [gate_t1] <br>
    *   ...
    *
+   * The version 3 is a compact format, for archiving purposes: the values are
+   * rounded outward to single precision, see serialize_CompactTube().
+   * The deserialized tube encloses the serialized one.
+   *
    * \param bin_file binary file (ofstream object)
    * \param tube Tube object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
@@ -57,6 +62,38 @@ namespace tubex
    */
   void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
 
+  /**
+   * \brief Writes a CompactTube object into a binary file (version 3)
+   * 
+   * CompactTube binary structure: <br>
+   *   [short_int_version_number] <br>
+   *   [int_nb_slices] <br>
+   *   [char_uniform_slicing] <br>
+   *   [double_t0] [double_timestep] [double_tf] // if uniform slicing <br>
+   *   [double_t0] [double_t1] ... [double_tf] // otherwise <br>
+   *   [float_lb_y0] [float_ub_y0] // value of 1rst slice <br>
+   *   ... <br>
+   *   [float_lb_gate_t0] [float_ub_gate_t0] // value of 1rst gate <br>
+   *   ...
+   *
+   * Empty values are stored as pairs of NaN.
+   *
+   * \param bin_file binary file (ofstream object)
+   * \param tube CompactTube object to be serialized
+   */
+  void serialize_CompactTube(std::ofstream& bin_file, const CompactTube& tube);
+
+  /**
+   * \brief Creates a CompactTube object from a binary file.
+   *
+   * The binary file has to be written by the serialize_CompactTube() or
+   * the serialize_Tube() functions.
+   *
+   * \param bin_file binary file (ifstream object)
+   * \param tube CompactTube object to be deserialized
+   */
+  void deserialize_CompactTube(std::ifstream& bin_file, CompactTube *&tube);
+
   /// @}
   /// \name TubeVector
   /// @{
@@ -0,0 +1,567 @@
+/**
+ *  TubeSolver class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <deque>
+#include <queue>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <limits>
+#include <exception>
+#include <algorithm>
+#include "tubex_TubeSolver.h"
+#include "tubex_CtcIntegration.h"
+#include "tubex_TFunction.h"
+#include "tubex_Executor.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Compact storage of the nodes
+  //
+  // The values of a component made of n slices are indexed as follows:
+  // 2k is the input gate of the kth slice, 2k+1 its codomain, 2n the last
+  // output gate. A node only stores the values that differ from its parent,
+  // together with the values of the parent so that the changes can be undone.
+
+  struct ValueDiff
+  {
+    int dim;
+    int id;
+    Interval value;
+    Interval prev_value;
+  };
+
+  struct NodeState
+  {
+    shared_ptr<const NodeState> parent; // NULL for the initial tube
+    vector<ValueDiff> v_diff;
+    int depth; // 0 for the initial tube
+  };
+
+  struct SolverNode
+  {
+    shared_ptr<const NodeState> state; // contracted state of the parent node
+    TubeSolver::Bisection bisection; // gate to be restricted, dim=-1 for the root
+    bool lower_half; // restriction to the lower or upper part of the gate
+    double priority; // volume of the parent node, for best-first exploration
+    size_t id; // creation order, for ties
+  };
+
+  struct SolverNodeOrder
+  {
+    bool operator()(const SolverNode& a, const SolverNode& b) const
+    {
+      // Smallest volumes first, then oldest nodes first
+      return a.priority > b.priority || (a.priority == b.priority && a.id > b.id);
+    }
+  };
+
+  // Per-thread workspace: the tube of the current node and direct access to its values
+
+  struct SolverLane
+  {
+    TubeVector x;
+    vector<vector<Slice*> > v_slices;
+    vector<Interval> v_values; // values of the parent node, before contraction
+    shared_ptr<const NodeState> state; // state held by x, NULL if x has to be reset
+  };
+
+  static void index_slices(SolverLane& w)
+  {
+    w.v_slices.resize(w.x.size());
+    for(int i = 0 ; i < w.x.size() ; i++)
+    {
+      w.v_slices[i].clear();
+      for(Slice *s = w.x[i].first_slice() ; s != NULL ; s = s->next_slice())
+        w.v_slices[i].push_back(s);
+    }
+  }
+
+  static const Interval& get_value(const vector<Slice*>& v_slices, int id)
+  {
+    int k = id / 2;
+    if(k == (int)v_slices.size())
+      return v_slices.back()->output_gate();
+    return id % 2 == 0 ? v_slices[k]->input_gate() : v_slices[k]->codomain();
+  }
+
+  static void set_value(vector<Slice*>& v_slices, int id, const Interval& value)
+  {
+    // Values are restored as they were: no slice consistency
+    int k = id / 2;
+    if(k == (int)v_slices.size())
+      v_slices.back()->set_output_gate(value, false);
+    else if(id % 2 == 0)
+      v_slices[k]->set_input_gate(value, false);
+    else
+      v_slices[k]->set_envelope(value, false);
+  }
+
+  static int gate_id(const SolverLane& w, const TubeSolver::Bisection& b)
+  {
+    const vector<Slice*>& v_slices = w.v_slices[b.dim];
+    if(b.t == v_slices.back()->tdomain().ub())
+      return 2 * v_slices.size();
+
+    auto it = lower_bound(v_slices.begin(), v_slices.end(), b.t,
+      [](const Slice *s, double t) { return s->tdomain().lb() < t; });
+
+    if(it == v_slices.end() || (*it)->tdomain().lb() != b.t)
+      throw Exception("TubeSolver::solve()", "the time of a bisection must be a bound of a slice");
+
+    return 2 * (it - v_slices.begin());
+  }
+
+  static void snapshot(SolverLane& w)
+  {
+    w.v_values.clear();
+    for(const auto& v_slices : w.v_slices)
+      for(int id = 0 ; id <= 2 * (int)v_slices.size() ; id++)
+        w.v_values.push_back(get_value(v_slices, id));
+  }
+
+  static const vector<ValueDiff> diff(const SolverLane& w)
+  {
+    vector<ValueDiff> v_diff;
+    size_t j = 0;
+    for(size_t i = 0 ; i < w.v_slices.size() ; i++)
+      for(int id = 0 ; id <= 2 * (int)w.v_slices[i].size() ; id++, j++)
+      {
+        const Interval& value = get_value(w.v_slices[i], id);
+        if(value != w.v_values[j])
+          v_diff.push_back({ (int)i, id, value, w.v_values[j] });
+      }
+    return v_diff;
+  }
+
+  static void rollback(SolverLane& w)
+  {
+    // Back to the values of the snapshot, only the modified ones are written
+    size_t j = 0;
+    for(size_t i = 0 ; i < w.v_slices.size() ; i++)
+      for(int id = 0 ; id <= 2 * (int)w.v_slices[i].size() ; id++, j++)
+        if(get_value(w.v_slices[i], id) != w.v_values[j])
+          set_value(w.v_slices[i], id, w.v_values[j]);
+  }
+
+  static void materialize(const TubeVector& x0, const shared_ptr<const NodeState>& state, SolverLane& w)
+  {
+    vector<const NodeState*> v_redo;
+    const NodeState *to = state.get();
+
+    if(!w.state) // unknown content: full copy of the initial tube
+    {
+      w.x = x0;
+      index_slices(w);
+      for( ; to != NULL ; to = to->parent.get())
+        v_redo.push_back(to);
+    }
+
+    else
+    {
+      // From the state held by the tube up to the common ancestor of both nodes,
+      // then down to the required state
+
+      const NodeState *from = w.state.get();
+
+      while(from != to)
+      {
+        if(from->depth >= to->depth)
+        {
+          for(auto it = from->v_diff.rbegin() ; it != from->v_diff.rend() ; ++it)
+            set_value(w.v_slices[it->dim], it->id, it->prev_value);
+          from = from->parent.get();
+        }
+
+        else
+        {
+          v_redo.push_back(to);
+          to = to->parent.get();
+        }
+      }
+    }
+
+    for(auto it = v_redo.rbegin() ; it != v_redo.rend() ; ++it)
+      for(const auto& d : (*it)->v_diff)
+        set_value(w.v_slices[d.dim], d.id, d.value);
+
+    w.state = state;
+  }
+
+  // Nodes waiting to be processed
+
+  class SolverNodeQueues
+  {
+    public:
+
+      SolverNodeQueues(Exploration exploration, int nb_lanes)
+        : m_best_first(exploration == Exploration::BEST_FIRST), m_v_deques(nb_lanes), m_v_mtx(nb_lanes)
+      {
+
+      }
+
+      void push(int lane, const SolverNode& node)
+      {
+        if(m_best_first)
+        {
+          lock_guard<mutex> lock(m_pq_mtx);
+          m_pq.push(node);
+        }
+
+        else
+        {
+          lock_guard<mutex> lock(m_v_mtx[lane]);
+          m_v_deques[lane].push_back(node);
+        }
+      }
+
+      bool pop(int lane, SolverNode& node)
+      {
+        if(m_best_first)
+        {
+          lock_guard<mutex> lock(m_pq_mtx);
+          if(m_pq.empty())
+            return false;
+          node = m_pq.top();
+          m_pq.pop();
+          return true;
+        }
+
+        // Own nodes in LIFO order (depth-first), then the oldest ones of the other threads
+
+        for(size_t i = 0 ; i < m_v_deques.size() ; i++)
+        {
+          int victim = (lane + i) % m_v_deques.size();
+          lock_guard<mutex> lock(m_v_mtx[victim]);
+          deque<SolverNode>& nodes = m_v_deques[victim];
+
+          if(!nodes.empty())
+          {
+            if(i == 0)
+            {
+              node = nodes.back();
+              nodes.pop_back();
+            }
+
+            else
+            {
+              node = nodes.front();
+              nodes.pop_front();
+            }
+
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+    protected:
+
+      const bool m_best_first;
+      vector<deque<SolverNode> > m_v_deques;
+      vector<mutex> m_v_mtx;
+      priority_queue<SolverNode,vector<SolverNode>,SolverNodeOrder> m_pq;
+      mutex m_pq_mtx;
+  };
+
+  // TubeSolver
+
+  TubeSolver::TubeSolver(const Vector& max_thickness, int nb_threads)
+    : m_max_thickness(max_thickness), m_nb_nodes(0), m_budget_reached(false)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = Executor::nb_threads(nb_threads);
+  }
+
+  int TubeSolver::nb_threads() const
+  {
+    return m_nb_threads;
+  }
+
+  void TubeSolver::set_contraction(const Contraction& ctc)
+  {
+    m_ctc = ctc;
+  }
+
+  void TubeSolver::set_bisection(const Bisector& bisector)
+  {
+    m_bisector = bisector;
+  }
+
+  void TubeSolver::set_exploration(Exploration exploration)
+  {
+    m_exploration = exploration;
+  }
+
+  void TubeSolver::set_bisection_ratio(float ratio)
+  {
+    assert(Interval(0.,1.).interior_contains(ratio));
+    m_ratio = ratio;
+  }
+
+  void TubeSolver::set_max_nodes(size_t max_nodes)
+  {
+    m_max_nodes = max_nodes;
+  }
+
+  void TubeSolver::set_time_limit(double max_duration)
+  {
+    assert(max_duration >= 0.);
+    m_max_duration = max_duration;
+  }
+
+  const vector<TubeVector>& TubeSolver::solve(const TubeVector& x0)
+  {
+    assert(x0.size() == m_max_thickness.size());
+
+    m_v_solutions.clear();
+    m_v_boundary.clear();
+    m_nb_nodes = 0;
+    m_budget_reached = false;
+
+    const int nb_slices = x0.nb_slices();
+    const chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+
+    auto budget_reached = [&]() -> bool
+    {
+      if((m_max_nodes > 0 && m_nb_nodes.load() >= m_max_nodes)
+        || (m_max_duration > 0.
+          && chrono::duration<double>(chrono::steady_clock::now() - t_start).count() > m_max_duration))
+        m_budget_reached = true;
+      return m_budget_reached.load();
+    };
+
+    auto add_result = [&](vector<TubeVector>& v_results, const TubeVector& x)
+    {
+      lock_guard<mutex> lock(m_results_mtx);
+      v_results.push_back(x);
+    };
+
+    // Search tree, from the initial tube
+
+      vector<SolverLane> v_lanes(m_nb_threads, SolverLane({ x0, {}, {}, NULL }));
+      SolverNodeQueues queues(m_exploration, m_nb_threads);
+      atomic<size_t> next_id(1);
+      atomic<int> nb_pending(1);
+
+      SolverNode root = { make_shared<NodeState>(NodeState({ NULL, {}, 0 })), { -1, 0., 0. }, true, 0., 0 };
+      queues.push(0, root);
+
+      atomic<bool> aborted(false);
+      exception_ptr first_exception;
+      mutex exception_mtx;
+
+    // Processing of the nodes by one thread
+
+      auto worker = [&](int lane)
+      {
+        SolverLane& w = v_lanes[lane];
+
+        while(nb_pending.load() > 0 && !aborted.load())
+        {
+          SolverNode node;
+
+          if(!queues.pop(lane, node))
+          {
+            this_thread::yield();
+            continue;
+          }
+
+          try
+          {
+            materialize(x0, node.state, w);
+
+            while(true)
+            {
+              // Restriction of the bisected gate
+
+                snapshot(w);
+
+                if(node.bisection.dim >= 0)
+                {
+                  int id = gate_id(w, node.bisection);
+                  Interval gate = get_value(w.v_slices[node.bisection.dim], id);
+                  gate &= node.lower_half ? Interval(NEG_INFINITY, node.bisection.value)
+                                          : Interval(node.bisection.value, POS_INFINITY);
+                  set_value(w.v_slices[node.bisection.dim], id, gate);
+                }
+
+                if(budget_reached())
+                {
+                  add_result(m_v_boundary, w.x);
+                  rollback(w);
+                  break;
+                }
+
+              // Contraction
+
+                m_nb_nodes++;
+
+                if(m_ctc)
+                {
+                  m_ctc(w.x, lane);
+
+                  if(w.x.nb_slices() != nb_slices)
+                    throw Exception("TubeSolver::solve()", "the contraction must preserve the slicing");
+                  index_slices(w); // the contraction may have reallocated the slices
+                }
+
+                if(w.x.is_empty())
+                {
+                  rollback(w);
+                  break;
+                }
+
+                if(is_thin(w.x))
+                {
+                  add_result(m_v_solutions, w.x);
+                  rollback(w);
+                  break;
+                }
+
+              // Bisection
+
+                Bisection b = { -1, 0., 0. };
+                if(m_bisector)
+                  b = m_bisector(w.x, lane);
+                if(b.dim < 0)
+                  b = largest_gate(w.x, m_max_thickness, m_ratio);
+
+                if(b.dim < 0 || !get_value(w.v_slices[b.dim], gate_id(w, b)).interior_contains(b.value))
+                {
+                  add_result(m_v_boundary, w.x);
+                  rollback(w);
+                  break;
+                }
+
+                shared_ptr<const NodeState> state =
+                  make_shared<NodeState>(NodeState({ node.state, diff(w), node.state->depth + 1 }));
+                w.state = state; // the tube is now the contracted state
+                double volume = m_exploration == Exploration::BEST_FIRST ? w.x.volume() : 0.;
+                SolverNode first = { state, b, true, volume, next_id++ };
+                SolverNode second = { state, b, false, volume, next_id++ };
+
+                nb_pending++;
+                queues.push(lane, second);
+
+                if(m_exploration == Exploration::DEPTH_FIRST)
+                  node = first; // processed in place: the tube is already the contracted state
+
+                else
+                {
+                  nb_pending++;
+                  queues.push(lane, first);
+                  break;
+                }
+            }
+          }
+
+          catch(...)
+          {
+            w.state = NULL; // the content of the tube is unknown
+            lock_guard<mutex> lock(exception_mtx);
+            if(!first_exception)
+              first_exception = current_exception();
+            aborted = true;
+          }
+
+          nb_pending--;
+        }
+      };
+
+    // Deterministic sequential run, or threads of the pool of the library
+
+      if(m_nb_threads == 1)
+        worker(0);
+      else
+        Executor::global().run(m_nb_threads, worker);
+
+      if(first_exception)
+        rethrow_exception(first_exception);
+
+    return m_v_solutions;
+  }
+
+  const vector<TubeVector>& TubeSolver::solutions() const
+  {
+    return m_v_solutions;
+  }
+
+  const vector<TubeVector>& TubeSolver::boundary() const
+  {
+    return m_v_boundary;
+  }
+
+  size_t TubeSolver::nb_nodes() const
+  {
+    return m_nb_nodes.load();
+  }
+
+  bool TubeSolver::budget_reached() const
+  {
+    return m_budget_reached.load();
+  }
+
+  const TubeSolver::Bisection TubeSolver::largest_gate(const TubeVector& x, const Vector& max_thickness, float ratio)
+  {
+    assert(x.size() == max_thickness.size());
+    assert(Interval(0.,1.).interior_contains(ratio));
+
+    Bisection b = { -1, 0., 0. };
+    double max_ratio = 0.;
+
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      double t = x[i].tdomain().lb(); // not set if the largest gate is the first one
+      double gate_diam = x[i].max_gate_diam(t);
+      double diam_ratio = max_thickness[i] > 0. ? gate_diam / max_thickness[i]
+                                                : (gate_diam > 0. ? numeric_limits<double>::infinity() : 0.);
+
+      if(diam_ratio > max_ratio)
+      {
+        max_ratio = diam_ratio;
+        b.dim = i;
+        b.t = t;
+      }
+    }
+
+    if(b.dim >= 0)
+    {
+      Interval gate = x[b.dim](b.t);
+      b.value = gate.is_unbounded() ? gate.mid() : gate.lb() + ratio * gate.diam();
+    }
+
+    return b;
+  }
+
+  const TubeSolver::Bisection TubeSolver::bisection_guess(TubeVector& x, CtcIntegration& ctc_integration,
+                                                          DynCtc *slice_ctr, TFunction& f, int variant)
+  {
+    assert(variant >= 0 && variant <= 2);
+    TubeVector v = f.eval_vector(x);
+    pair<int,pair<double,double> > guess = ctc_integration.bisection_guess(x, v, slice_ctr, f, variant);
+    Bisection b = { guess.first, guess.second.first, guess.second.second };
+    return b;
+  }
+
+  bool TubeSolver::is_thin(const TubeVector& x) const
+  {
+    Vector max_diam = x.max_diam();
+    for(int i = 0 ; i < x.size() ; i++)
+      if(max_diam[i] > m_max_thickness[i])
+        return false;
+    return true;
+  }
+}
@@ -0,0 +1,254 @@
+/**
+ *  \file
+ *  TubeSolver class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBESOLVER_H__
+#define __TUBEX_TUBESOLVER_H__
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "ibex_Vector.h"
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  class DynCtc;
+  class TFunction;
+  class CtcIntegration;
+
+  /**
+   * \enum Exploration
+   * \brief Order in which the nodes of the search tree are explored
+   */
+  enum class Exploration
+  {
+    DEPTH_FIRST, ///< last created nodes first, with work stealing between threads
+    BEST_FIRST ///< nodes of smallest volume first, from a queue shared by the threads
+  };
+
+  /**
+   * \class TubeSolver
+   * \brief Branch-and-contract solver over bisections of a TubeVector
+   *
+   * Each node of the search tree is contracted by a user-defined pipeline
+   * (for instance CtcIntegration together with CtcDynCid). A node whose
+   * slices are thinner than the required precision is a solution. Otherwise,
+   * one gate \f$[x_i](t)\f$ is bisected and the two resulting nodes are explored.
+   * The nodes that could not be processed (budgets reached) or that cannot
+   * be bisected anymore are collected as boundary tubes.
+   *
+   * The state of a node is stored as the list of the values (slices and gates)
+   * that differ from its parent. When a node is popped, the tube of the thread
+   * is brought from the previously processed node to the new one: the changes
+   * are undone up to their common ancestor, then the stored values are set
+   * again down to the new node. In depth-first mode, the first child is
+   * processed in place.
+   *
+   * The nodes are processed in parallel by the threads of the Executor. The
+   * contraction and bisection functions are called concurrently, with the index
+   * of the calling thread (see nb_threads()) as last argument, so that thread-local
+   * resources can be used (for instance one copy of each IBEX function per thread).
+   *
+   * \note The contraction must preserve the slicing of the tubes.
+   * \note The order of the solutions may depend on the scheduling of the threads.
+   */
+  class TubeSolver
+  {
+    public:
+
+      /**
+       * \struct Bisection
+       * \brief Bisection of a gate \f$[x_i](t)\f$ at some value
+       */
+      struct Bisection
+      {
+        int dim; //!< component \f$i\f$ of the gate, -1 if no bisection is proposed
+        double t; //!< time of the gate, that must be a bound of a slice
+        double value; //!< bisection point, in the interior of the gate
+      };
+
+      /**
+       * \brief Contraction pipeline, called on each node with the index of the calling thread
+       */
+      typedef std::function<void(TubeVector&,int)> Contraction;
+
+      /**
+       * \brief Bisection heuristic, called on each contracted node that is not a solution,
+       *        with the index of the calling thread
+       *
+       * If no bisection is proposed, the largest gate is bisected, see largest_gate().
+       * The tube can be contracted by trials, provided that it is restored before returning.
+       */
+      typedef std::function<Bisection(TubeVector&,int)> Bisector;
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a solver
+       *
+       * \param max_thickness required precision: maximal diameter of the slices of each component
+       * \param nb_threads number of threads (0 for the global setting of the Executor, 1 for a sequential run)
+       */
+      TubeSolver(const ibex::Vector& max_thickness, int nb_threads = 0);
+
+      /**
+       * \brief Returns the actual number of threads used by this solver
+       *
+       * \return an integer greater than 0
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Sets the contraction pipeline applied on each node
+       *
+       * \param ctc the contraction function
+       */
+      void set_contraction(const Contraction& ctc);
+
+      /**
+       * \brief Sets the bisection heuristic (by default, the largest gate is bisected)
+       *
+       * \param bisector the bisection function
+       */
+      void set_bisection(const Bisector& bisector);
+
+      /**
+       * \brief Sets the exploration strategy (depth first by default)
+       *
+       * \param exploration strategy
+       */
+      void set_exploration(Exploration exploration);
+
+      /**
+       * \brief Sets the bisection ratio of the default heuristic
+       *
+       * \param ratio the bisection ratio (default value: 0.49)
+       */
+      void set_bisection_ratio(float ratio);
+
+      /**
+       * \brief Limits the number of contracted nodes
+       *
+       * \param max_nodes maximal number of nodes (0 for no limit)
+       */
+      void set_max_nodes(size_t max_nodes);
+
+      /**
+       * \brief Limits the computation time
+       *
+       * \param max_duration maximal duration in seconds (0 for no limit)
+       */
+      void set_time_limit(double max_duration);
+
+      /// @}
+      /// \name Solving
+      /// @{
+
+      /**
+       * \brief Explores the search tree from an initial tube
+       *
+       * \param x0 the initial tube
+       * \return the solutions, see solutions()
+       */
+      const std::vector<TubeVector>& solve(const TubeVector& x0);
+
+      /**
+       * \brief Returns the solutions of the last call to solve()
+       *
+       * \return the contracted tubes that are thinner than the required precision
+       */
+      const std::vector<TubeVector>& solutions() const;
+
+      /**
+       * \brief Returns the boundary tubes of the last call to solve()
+       *
+       * \return the tubes of the nodes not processed because of a budget,
+       *         and of the nodes that could not be bisected
+       */
+      const std::vector<TubeVector>& boundary() const;
+
+      /**
+       * \brief Returns the number of nodes contracted during the last call to solve()
+       *
+       * \return an integer
+       */
+      size_t nb_nodes() const;
+
+      /**
+       * \brief Tests if a budget (time or nodes) has been reached during the last call to solve()
+       *
+       * \return `true` in case of incomplete exploration
+       */
+      bool budget_reached() const;
+
+      /// @}
+      /// \name Bisection heuristics
+      /// @{
+
+      /**
+       * \brief Default heuristic: bisection of the largest gate, relatively to the required precision
+       *
+       * \param x the contracted tube
+       * \param max_thickness the required precision of each component
+       * \param ratio the bisection ratio
+       * \return the bisection, with `dim=-1` if the tube cannot be bisected
+       */
+      static const Bisection largest_gate(const TubeVector& x, const ibex::Vector& max_thickness, float ratio = 0.49);
+
+      /**
+       * \brief Heuristic of CtcIntegration: bisection of a gate whose half is likely to be removed
+       *
+       * \note See CtcIntegration::bisection_guess(). The objects are not reentrant:
+       *       one set of them is required for each thread.
+       *
+       * \param x the contracted tube, restored after the trial contractions
+       * \param ctc_integration the integration contractor
+       * \param slice_ctr the slice contractor (CtcDynCid, CtcDynCidGuess or CtcDynBasic)
+       * \param f the evolution function, for computing the derivative tube
+       * \param variant 0: first candidate gate, 1: largest candidate gate of the first slice
+       *        providing some, 2: largest candidate gate of the whole tube
+       * \return the bisection, with `dim=-1` if no gate has been found
+       */
+      static const Bisection bisection_guess(TubeVector& x, CtcIntegration& ctc_integration,
+                                             DynCtc *slice_ctr, TFunction& f, int variant);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Tests if the slices of a tube are thinner than the required precision
+       *
+       * \param x the tube
+       * \return `true` in case of solution
+       */
+      bool is_thin(const TubeVector& x) const;
+
+      ibex::Vector m_max_thickness; //!< required precision
+      int m_nb_threads; //!< number of threads
+      Contraction m_ctc; //!< contraction pipeline
+      Bisector m_bisector; //!< bisection heuristic
+      Exploration m_exploration = Exploration::DEPTH_FIRST; //!< exploration strategy
+      float m_ratio = 0.49; //!< bisection ratio of the default heuristic
+      size_t m_max_nodes = 0; //!< budget of nodes (0 for no limit)
+      double m_max_duration = 0.; //!< budget of time in seconds (0 for no limit)
+
+      std::vector<TubeVector> m_v_solutions; //!< solutions of the last solving
+      std::vector<TubeVector> m_v_boundary; //!< boundary tubes of the last solving
+      std::atomic<size_t> m_nb_nodes; //!< number of contracted nodes
+      std::atomic<bool> m_budget_reached; //!< incomplete exploration
+      std::mutex m_results_mtx; //!< lock of the solutions and boundary tubes
+  };
+}
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ *  Executor class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <algorithm>
+#include "tubex_Executor.h"
+
+using namespace std;
+
+namespace tubex
+{
+  // Scoped number of threads of the current thread (0 if not set)
+  static thread_local int tl_nb_threads = 0;
+
+  // Pool and index of the current thread, if it is a worker
+  static thread_local const Executor *tl_executor = NULL;
+  static thread_local int tl_worker_id = -1;
+
+  atomic<int> Executor::s_nb_threads(0);
+
+  // Executor
+
+    // Definition
+
+    Executor::Executor(int nb_workers)
+      : m_v_queues(nb_workers + 1), m_nb_queued(0)
+    {
+      assert(nb_workers >= 0);
+
+      for(int i = 0 ; i < nb_workers ; i++)
+        m_v_threads.push_back(thread(&Executor::worker_loop, this, i));
+    }
+
+    Executor::~Executor()
+    {
+      {
+        lock_guard<mutex> lock(m_sleep_mtx);
+        m_stop = true;
+      }
+
+      m_sleep_cv.notify_all();
+      for(size_t i = 0 ; i < m_v_threads.size() ; i++)
+        m_v_threads[i].join();
+    }
+
+    Executor& Executor::global()
+    {
+      // Created at first use, destroyed at exit
+      static Executor executor(max(1, max((int)thread::hardware_concurrency(), s_nb_threads.load())) - 1);
+      return executor;
+    }
+
+    int Executor::nb_workers() const
+    {
+      return m_v_threads.size();
+    }
+
+    // Number of threads
+
+    void Executor::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0);
+      s_nb_threads = nb_threads;
+    }
+
+    int Executor::nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0);
+
+      if(nb_threads == 0)
+        nb_threads = tl_nb_threads;
+      if(nb_threads == 0)
+        nb_threads = s_nb_threads.load();
+      if(nb_threads == 0)
+        nb_threads = max(1, (int)thread::hardware_concurrency());
+
+      return nb_threads;
+    }
+
+    Executor::ScopedNbThreads::ScopedNbThreads(int nb_threads)
+      : m_prev_nb_threads(tl_nb_threads)
+    {
+      assert(nb_threads >= 0);
+      if(nb_threads != 0)
+        tl_nb_threads = nb_threads;
+    }
+
+    Executor::ScopedNbThreads::~ScopedNbThreads()
+    {
+      tl_nb_threads = m_prev_nb_threads;
+    }
+
+    // Parallel computations
+
+    void Executor::run(int nb_lanes, const function<void(int)>& f)
+    {
+      assert(nb_lanes > 0);
+
+      if(nb_lanes == 1)
+      {
+        f(0);
+        return;
+      }
+
+      vector<exception_ptr> v_exceptions(nb_lanes);
+      auto lane = [&](int i)
+      {
+        try
+        {
+          f(i);
+        }
+
+        catch(...)
+        {
+          v_exceptions[i] = current_exception();
+        }
+      };
+
+      TaskGroup group(*this, nb_lanes);
+      for(int i = 1 ; i < nb_lanes ; i++)
+        group.run([&lane,i]() { lane(i); });
+      lane(0);
+      group.wait();
+
+      for(int i = 0 ; i < nb_lanes ; i++)
+        if(v_exceptions[i])
+          rethrow_exception(v_exceptions[i]);
+    }
+
+    void Executor::parallel_for(size_t begin, size_t end, const function<void(size_t,int)>& f, int nb_threads, size_t grain)
+    {
+      assert(begin <= end);
+      assert(grain > 0);
+
+      int lanes = nb_lanes(end - begin, nb_threads, grain);
+
+      // Deterministic sequential fallback
+      if(lanes == 1)
+      {
+        for(size_t i = begin ; i < end ; i++)
+          f(i, 0);
+        return;
+      }
+
+      // Chunks are dealt dynamically, for balancing the load
+      atomic<size_t> next(begin);
+      run(lanes, [&](int lane)
+      {
+        for(size_t i0 = next.fetch_add(grain) ; i0 < end ; i0 = next.fetch_add(grain))
+          for(size_t i = i0 ; i < min(end, i0 + grain) ; i++)
+            f(i, lane);
+      });
+    }
+
+    int Executor::nb_lanes(size_t n, int nb_threads, size_t grain)
+    {
+      assert(grain > 0);
+      size_t nb_chunks = (n + grain - 1) / grain;
+      return max(1, (int)min((size_t)Executor::nb_threads(nb_threads), nb_chunks));
+    }
+
+  // Protected methods
+
+    void Executor::submit(Task&& task)
+    {
+      int queue_id = tl_executor == this ? tl_worker_id : m_v_queues.size() - 1;
+
+      {
+        lock_guard<mutex> lock(m_v_queues[queue_id].mtx);
+        m_v_queues[queue_id].tasks.push_back(move(task));
+      }
+
+      m_nb_queued++;
+
+      {
+        lock_guard<mutex> lock(m_sleep_mtx); // no wake-up missed by a worker going to sleep
+      }
+      m_sleep_cv.notify_one();
+    }
+
+    bool Executor::pop_task(int worker_id, Task& task)
+    {
+      if(m_nb_queued.load() == 0)
+        return false;
+
+      int nb_queues = m_v_queues.size();
+
+      // Own tasks first, the most recent ones (depth-first)
+      if(worker_id != -1)
+      {
+        lock_guard<mutex> lock(m_v_queues[worker_id].mtx);
+        if(!m_v_queues[worker_id].tasks.empty())
+        {
+          task = move(m_v_queues[worker_id].tasks.back());
+          m_v_queues[worker_id].tasks.pop_back();
+          m_nb_queued--;
+          return true;
+        }
+      }
+
+      // Then, the oldest tasks of the shared queue and of the other workers
+      int first = nb_queues - 1;
+      for(int i = 0 ; i < nb_queues ; i++)
+      {
+        int q = (first + i + (worker_id == -1 ? 0 : worker_id)) % nb_queues;
+        if(q == worker_id)
+          continue;
+
+        lock_guard<mutex> lock(m_v_queues[q].mtx);
+        if(!m_v_queues[q].tasks.empty())
+        {
+          task = move(m_v_queues[q].tasks.front());
+          m_v_queues[q].tasks.pop_front();
+          m_nb_queued--;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void Executor::execute(Task& task)
+    {
+      int prev_nb_threads = tl_nb_threads;
+      tl_nb_threads = task.nb_threads;
+
+      try
+      {
+        task.f();
+      }
+
+      catch(...)
+      {
+        lock_guard<mutex> lock(task.group->m_exception_mtx);
+        if(!task.group->m_exception)
+          task.group->m_exception = current_exception();
+      }
+
+      tl_nb_threads = prev_nb_threads;
+      task.group->m_nb_pending--;
+    }
+
+    void Executor::help_while(const atomic<int>& nb_pending)
+    {
+      int worker_id = tl_executor == this ? tl_worker_id : -1;
+
+      while(nb_pending.load() > 0)
+      {
+        Task task;
+        if(pop_task(worker_id, task))
+          execute(task);
+        else
+          this_thread::yield(); // remaining tasks are being run by other threads
+      }
+    }
+
+    void Executor::worker_loop(int worker_id)
+    {
+      tl_executor = this;
+      tl_worker_id = worker_id;
+
+      while(true)
+      {
+        Task task;
+        if(pop_task(worker_id, task))
+        {
+          execute(task);
+          continue;
+        }
+
+        unique_lock<mutex> lock(m_sleep_mtx);
+        m_sleep_cv.wait(lock, [this]() { return m_stop || m_nb_queued.load() > 0; });
+        if(m_stop && m_nb_queued.load() == 0)
+          return;
+      }
+    }
+
+  // TaskGroup
+
+    TaskGroup::TaskGroup(Executor& executor, int nb_threads)
+      : m_executor(executor), m_sequential(Executor::nb_threads(nb_threads) == 1), m_nb_pending(0)
+    {
+
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+      m_executor.help_while(m_nb_pending);
+    }
+
+    void TaskGroup::run(const function<void()>& f)
+    {
+      Executor::Task task = { f, this, tl_nb_threads };
+      m_nb_pending++;
+
+      if(m_sequential)
+        Executor::execute(task);
+      else
+        m_executor.submit(move(task));
+    }
+
+    void TaskGroup::wait()
+    {
+      m_executor.help_while(m_nb_pending);
+
+      if(m_exception)
+      {
+        exception_ptr e = m_exception;
+        m_exception = nullptr;
+        rethrow_exception(e);
+      }
+    }
+}
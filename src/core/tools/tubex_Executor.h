@@ -0,0 +1,310 @@
+/**
+ *  \file
+ *  Executor class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_EXECUTOR_H__
+#define __TUBEX_EXECUTOR_H__
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace tubex
+{
+  class TaskGroup;
+
+  /**
+   * \class Executor
+   * \brief Persistent pool of worker threads, shared by the parallel
+   *        computations of the library
+   *
+   * Each worker owns a deque of tasks: it pops its own tasks in LIFO order
+   * and steals the oldest tasks of the others (work stealing). Tasks submitted
+   * from a thread that is not a worker of the pool are pushed in a shared queue.
+   * A thread waiting for the completion of tasks executes pending tasks
+   * meanwhile, so that nested parallel calls cannot deadlock.
+   *
+   * The number of threads involved in a computation is resolved from, by
+   * order of priority: the per-call setting, the one of the innermost
+   * ScopedNbThreads object, and the global setting (see set_nb_threads()).
+   * With one thread, computations are run sequentially by the calling
+   * thread, in a deterministic order.
+   */
+  class Executor
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a pool of worker threads
+       *
+       * \param nb_workers number of workers (the calling threads take part in
+       *        the computations, so `nb_workers=n-1` allows `n` concurrent threads)
+       */
+      explicit Executor(int nb_workers);
+
+      /**
+       * \brief Executor destructor
+       *
+       * The workers are joined once the pending tasks have been completed.
+       */
+      ~Executor();
+
+      /**
+       * \brief Returns the executor shared by the library
+       *
+       * The pool is created at the first call, with enough workers for the
+       * hardware concurrency, or for the global setting if larger.
+       *
+       * \return a reference to the global executor
+       */
+      static Executor& global();
+
+      /**
+       * \brief Returns the number of workers of the pool
+       *
+       * \return an integer
+       */
+      int nb_workers() const;
+
+      /// @}
+      /// \name Number of threads
+      /// @{
+
+      /**
+       * \brief Sets the default number of threads of the parallel computations
+       *
+       * \param nb_threads number of threads (0 for the hardware concurrency, 1 for sequential runs)
+       */
+      static void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Resolves the number of threads of a computation
+       *
+       * \param nb_threads per-call setting (0 for the scoped or global setting)
+       * \return an integer greater than 0
+       */
+      static int nb_threads(int nb_threads = 0);
+
+      /**
+       * \class ScopedNbThreads
+       * \brief Overrides the global number of threads for the computations
+       *        launched by the current thread, during the lifetime of the object
+       *
+       * The setting is propagated to the tasks spawned by these computations.
+       */
+      class ScopedNbThreads
+      {
+        public:
+
+          /**
+           * \brief Overrides the number of threads
+           *
+           * \param nb_threads number of threads (0 to keep the current setting)
+           */
+          explicit ScopedNbThreads(int nb_threads);
+
+          /**
+           * \brief Restores the previous setting
+           */
+          ~ScopedNbThreads();
+
+        protected:
+
+          ScopedNbThreads(const ScopedNbThreads&) = delete;
+          ScopedNbThreads& operator=(const ScopedNbThreads&) = delete;
+
+          int m_prev_nb_threads; //!< previous scoped setting
+      };
+
+      /// @}
+      /// \name Parallel computations
+      /// @{
+
+      /**
+       * \brief Runs a function on several lanes concurrently, and waits for their completion
+       *
+       * The lane 0 is run by the calling thread. The index of the lane can be
+       * used for accessing thread-local resources (such as copies of IBEX
+       * functions, that are not reentrant). If a lane throws an exception,
+       * the one of the lowest index is rethrown once all lanes have returned.
+       *
+       * \param nb_lanes number of lanes
+       * \param f function called with the index of the lane
+       */
+      void run(int nb_lanes, const std::function<void(int)>& f);
+
+      /**
+       * \brief Calls a function on each index of a range, in parallel
+       *
+       * Indexes are distributed by chunks of `grain` elements among at most
+       * `nb_threads` lanes. With one thread, or if the range is not larger than
+       * the grain, indexes are processed in increasing order by the calling thread.
+       *
+       * \param begin first index
+       * \param end index after the last one
+       * \param f function called with the index and the lane (in `[0,nb_threads[`)
+       * \param nb_threads per-call number of threads (0 for the scoped or global setting)
+       * \param grain minimal number of consecutive indexes processed by a lane
+       */
+      void parallel_for(size_t begin, size_t end, const std::function<void(size_t,int)>& f,
+                        int nb_threads = 0, size_t grain = 1);
+
+      /**
+       * \brief Returns the number of lanes that parallel_for() would use
+       *
+       * Useful for preparing per-lane resources beforehand.
+       *
+       * \param n number of indexes
+       * \param nb_threads per-call number of threads (0 for the scoped or global setting)
+       * \param grain minimal number of consecutive indexes processed by a lane
+       * \return an integer greater than 0
+       */
+      static int nb_lanes(size_t n, int nb_threads = 0, size_t grain = 1);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Task, related to a group whose pending counter is decreased on completion
+       */
+      struct Task
+      {
+        std::function<void()> f; //!< the job
+        TaskGroup *group; //!< group of the task
+        int nb_threads; //!< scoped number of threads when the task was submitted
+      };
+
+      /**
+       * \brief Queue of tasks, locked by its own mutex
+       */
+      struct TaskQueue
+      {
+        std::mutex mtx; //!< lock of the queue
+        std::deque<Task> tasks; //!< pending tasks
+      };
+
+      /**
+       * \brief Submits a task, to the queue of the calling worker or to the shared queue
+       *
+       * \param task the task
+       */
+      void submit(Task&& task);
+
+      /**
+       * \brief Pops a task, or steals one
+       *
+       * \param worker_id index of the calling worker, -1 for an external thread
+       * \param task the popped task
+       * \return `true` if a task was found
+       */
+      bool pop_task(int worker_id, Task& task);
+
+      /**
+       * \brief Executes a task and notifies its group
+       *
+       * \param task the task
+       */
+      static void execute(Task& task);
+
+      /**
+       * \brief Executes pending tasks until the counter reaches zero
+       *
+       * \param nb_pending counter of pending tasks
+       */
+      void help_while(const std::atomic<int>& nb_pending);
+
+      /**
+       * \brief Main loop of a worker thread
+       *
+       * \param worker_id index of the worker
+       */
+      void worker_loop(int worker_id);
+
+      Executor(const Executor&) = delete;
+      Executor& operator=(const Executor&) = delete;
+
+      std::vector<std::thread> m_v_threads; //!< worker threads
+      std::vector<TaskQueue> m_v_queues; //!< one queue per worker, then the shared one
+      std::atomic<int> m_nb_queued; //!< number of tasks in the queues
+      std::mutex m_sleep_mtx; //!< lock for idle workers
+      std::condition_variable m_sleep_cv; //!< wakes up idle workers
+      bool m_stop = false; //!< set when the pool is destroyed
+
+      static std::atomic<int> s_nb_threads; //!< global setting (0 for the hardware concurrency)
+
+      friend class TaskGroup;
+  };
+
+  /**
+   * \class TaskGroup
+   * \brief Set of tasks run by an Executor, that can be waited for
+   *
+   * With one thread (see Executor::nb_threads()), tasks are run sequentially
+   * as soon as they are submitted.
+   */
+  class TaskGroup
+  {
+    public:
+
+      /**
+       * \brief Creates an empty group of tasks
+       *
+       * \param executor the pool running the tasks
+       * \param nb_threads per-call number of threads (0 for the scoped or global setting)
+       */
+      explicit TaskGroup(Executor& executor = Executor::global(), int nb_threads = 0);
+
+      /**
+       * \brief TaskGroup destructor, that waits for the pending tasks
+       *
+       * Exceptions thrown by the tasks are ignored if wait() has not been called.
+       */
+      ~TaskGroup();
+
+      /**
+       * \brief Submits a task
+       *
+       * \param f the task
+       */
+      void run(const std::function<void()>& f);
+
+      /**
+       * \brief Waits for the completion of the submitted tasks
+       *
+       * The calling thread executes pending tasks meanwhile. The first
+       * exception thrown by a task, if any, is rethrown.
+       */
+      void wait();
+
+    protected:
+
+      TaskGroup(const TaskGroup&) = delete;
+      TaskGroup& operator=(const TaskGroup&) = delete;
+
+      Executor& m_executor; //!< pool running the tasks
+      const bool m_sequential; //!< tasks are run at submission
+      std::atomic<int> m_nb_pending; //!< number of tasks not completed yet
+      std::mutex m_exception_mtx; //!< lock of the first exception
+      std::exception_ptr m_exception; //!< first exception thrown by a task
+
+      friend class Executor;
+  };
+}
+
+#endif
@@ -8,6 +8,11 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <clocale>
 #include <iostream>
 #include <sstream>
 #include "tubex_Tools.h"
@@ -17,6 +22,30 @@ using namespace ibex;
 
 namespace tubex
 {
+  static const char* parse_double_strtod(const char *begin, const char *end, double& x)
+  {
+    // Characters that may belong to a number (digits, signs, exponents, nan, inf)
+    const char *token_end = begin;
+    while(token_end < end && (isalnum(*token_end) || *token_end == '.' || *token_end == '+' || *token_end == '-'))
+      token_end++;
+
+    // strtod depends on the locale: the decimal point of the file
+    // is replaced by the one of the current locale before parsing
+    string token(begin, token_end);
+    const char *locale_point = localeconv()->decimal_point;
+    size_t point_pos = token.find('.');
+    size_t point_len = strlen(locale_point);
+    if(point_pos != string::npos && strcmp(locale_point, ".") != 0)
+      token.replace(point_pos, 1, locale_point);
+
+    char *parsed_end;
+    x = strtod(token.c_str(), &parsed_end);
+    size_t nb_parsed = parsed_end - token.c_str();
+    if(point_pos != string::npos && nb_parsed > point_pos && strcmp(locale_point, ".") != 0)
+      nb_parsed -= point_len - 1; // length of the decimal point in the file
+    return begin + nb_parsed;
+  }
+
   void Tools::replace_all(string& input, const string& search, const string& format)
   {
     size_t index = 0;
@@ -52,4 +81,100 @@ namespace tubex
     // outside this function, on demand.
     return max(itv.lb(),min(itv.ub(),rand()/double(RAND_MAX)*itv.diam()+itv.lb()));
   }
+
+  const char* Tools::parse_double(const char *begin, const char *end, double& x)
+  {
+    // Powers of ten that are exactly representable as doubles
+    static const double pow10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    const char *p = begin;
+    bool neg = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+      neg = *p == '-';
+      p++;
+    }
+
+    uint64_t mantissa = 0;
+    int nb_digits = 0, exp10 = 0;
+    bool any_digit = false, exact = true;
+
+    for( ; p < end && *p >= '0' && *p <= '9' ; p++)
+    {
+      any_digit = true;
+      if(nb_digits < 19)
+      {
+        mantissa = mantissa * 10 + (*p - '0');
+        if(mantissa != 0) nb_digits++;
+      }
+
+      else
+      {
+        exp10++;
+        exact &= *p == '0';
+      }
+    }
+
+    if(p < end && *p == '.')
+    {
+      for(p++ ; p < end && *p >= '0' && *p <= '9' ; p++)
+      {
+        any_digit = true;
+        if(nb_digits < 19)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+          if(mantissa != 0) nb_digits++;
+          exp10--;
+        }
+
+        else
+          exact &= *p == '0';
+      }
+    }
+
+    if(!any_digit) // nan, inf, or not a number
+    {
+      if(p < end && isalpha(*p))
+        return parse_double_strtod(begin, end, x);
+      x = 0.; // as strtod
+      return begin;
+    }
+
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+      const char *q = p + 1;
+      bool exp_neg = false;
+      if(q < end && (*q == '-' || *q == '+'))
+      {
+        exp_neg = *q == '-';
+        q++;
+      }
+
+      if(q < end && *q >= '0' && *q <= '9')
+      {
+        int e = 0;
+        for( ; q < end && *q >= '0' && *q <= '9' ; q++)
+          if(e < 100000) e = e * 10 + (*q - '0');
+        exp10 += exp_neg ? -e : e;
+        p = q;
+      }
+    }
+
+    // Fast path: both the mantissa and the power of ten are exact,
+    // the single floating-point operation is correctly rounded
+
+    if(mantissa == 0)
+      x = 0.;
+
+    else if(exact && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+      x = exp10 < 0 ? (double)mantissa / pow10[-exp10] : (double)mantissa * pow10[exp10];
+
+    else
+      return parse_double_strtod(begin, end, x);
+
+    if(neg) x = -x;
+    return p;
+  }
 }
\ No newline at end of file
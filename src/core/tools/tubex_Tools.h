@@ -64,6 +64,20 @@ namespace tubex
        * \return a random double
        */
       static double rand_in_bounds(const ibex::Interval& intv);
+
+      /**
+       * \brief Parses a decimal floating-point number, independently of the locale
+       *
+       * Most of the values are computed exactly from their digits, other
+       * cases (long mantissas, large exponents) are delegated to `strtod`,
+       * so that the result is always correctly rounded.
+       *
+       * \param begin pointer to the first character of the number
+       * \param end pointer to the end of the buffer
+       * \param x the parsed value (0 if no number has been read)
+       * \return a pointer to the character following the number, or `begin` if no number has been read
+       */
+      static const char* parse_double(const char *begin, const char *end, double& x);
   };
 }
 
@@ -0,0 +1,230 @@
+/**
+ *  Performance counters
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <mutex>
+#include <vector>
+#include <iomanip>
+#include <algorithm>
+#include "tubex_perf.h"
+
+using namespace std;
+
+namespace tubex
+{
+  namespace perf
+  {
+    static const Snapshot zero()
+    {
+      Snapshot s;
+      s.allocations.fill(0);
+      s.calls.fill(0);
+      s.durations.fill(0);
+      return s;
+    }
+
+    /**
+     * \brief Counters of the running threads, and sums of the terminated ones
+     */
+    struct Registry
+    {
+      mutex mtx; //!< lock of the registry
+      vector<Counters*> v_counters; //!< counters of the running threads
+      Snapshot retired = zero(); //!< counters of the terminated threads
+    };
+
+    static Registry& registry()
+    {
+      // Never destructed: the thread_local counters of the workers of a thread
+      // pool created before the registry may be destructed after the end of main()
+      static Registry *r = new Registry;
+      return *r;
+    }
+
+    // Snapshot
+
+    uint64_t Snapshot::nb_allocations(Alloc type) const
+    {
+      return allocations[(size_t)type];
+    }
+
+    uint64_t Snapshot::nb_calls(Kernel kernel) const
+    {
+      return calls[(size_t)kernel];
+    }
+
+    double Snapshot::duration(Kernel kernel) const
+    {
+      return durations[(size_t)kernel] * 1e-9;
+    }
+
+    const Snapshot Snapshot::operator-(const Snapshot& s) const
+    {
+      Snapshot diff;
+      for(size_t i = 0 ; i < allocations.size() ; i++)
+        diff.allocations[i] = allocations[i] - s.allocations[i];
+      for(size_t i = 0 ; i < calls.size() ; i++)
+      {
+        diff.calls[i] = calls[i] - s.calls[i];
+        diff.durations[i] = durations[i] - s.durations[i];
+      }
+      return diff;
+    }
+
+    // Global access
+
+    bool enabled()
+    {
+      #ifdef TUBEX_PERF_COUNTERS
+        return true;
+      #else
+        return false;
+      #endif
+    }
+
+    const Snapshot snapshot()
+    {
+      Registry& r = registry();
+      lock_guard<mutex> lock(r.mtx);
+
+      Snapshot s = r.retired;
+      for(const auto& c : r.v_counters)
+        c->add_to(s);
+      return s;
+    }
+
+    void reset()
+    {
+      Registry& r = registry();
+      lock_guard<mutex> lock(r.mtx);
+
+      r.retired = zero();
+      for(const auto& c : r.v_counters)
+        c->reset();
+    }
+
+    const char* name(Alloc type)
+    {
+      switch(type)
+      {
+        case Alloc::SLICE: return "Slice";
+        case Alloc::GATE: return "gate";
+        case Alloc::CONVEX_POLYGON: return "ConvexPolygon";
+        case Alloc::INTERVAL_VECTOR: return "IntervalVector";
+        case Alloc::SYNTHESIS_NODE: return "TubeTreeSynthesis";
+        default: return "?";
+      }
+    }
+
+    const char* name(Kernel kernel)
+    {
+      switch(kernel)
+      {
+        case Kernel::CTC_DERIV_SLICE: return "CtcDeriv (slice)";
+        case Kernel::POLYGON_BUILD: return "Slice::polygon()";
+        case Kernel::TFUNCTION_EVAL: return "TFunction evaluation";
+        case Kernel::SYNTHESIS_BUILD: return "synthesis tree build";
+        default: return "?";
+      }
+    }
+
+    ostream& operator<<(ostream& str, const Snapshot& s)
+    {
+      str << "Allocations:" << endl;
+      for(size_t i = 0 ; i < s.allocations.size() ; i++)
+        str << "  " << left << setw(24) << name((Alloc)i)
+            << right << setw(12) << s.allocations[i] << endl;
+
+      str << "Kernels:" << endl;
+      for(size_t i = 0 ; i < s.calls.size() ; i++)
+      {
+        Kernel k = (Kernel)i;
+        str << "  " << left << setw(24) << name(k)
+            << right << setw(12) << s.calls[i] << " calls, "
+            << s.duration(k) << "s";
+        if(s.calls[i] != 0)
+          str << " (" << s.durations[i] / s.calls[i] << "ns/call)";
+        str << endl;
+      }
+
+      return str;
+    }
+
+    // Counters of one thread
+
+    Counters::Counters()
+    {
+      reset();
+      Registry& r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      r.v_counters.push_back(this);
+    }
+
+    Counters::~Counters()
+    {
+      Registry& r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      add_to(r.retired); // values are kept after the end of the thread
+      r.v_counters.erase(find(r.v_counters.begin(), r.v_counters.end(), this));
+    }
+
+    void Counters::count_allocations(Alloc type, uint64_t nb)
+    {
+      // Single writer: no atomic read-modify-write required
+      auto& c = m_allocations[(size_t)type];
+      c.store(c.load(memory_order_relaxed) + nb, memory_order_relaxed);
+    }
+
+    void Counters::count_call(Kernel kernel, uint64_t duration)
+    {
+      auto& c = m_calls[(size_t)kernel];
+      c.store(c.load(memory_order_relaxed) + 1, memory_order_relaxed);
+      auto& d = m_durations[(size_t)kernel];
+      d.store(d.load(memory_order_relaxed) + duration, memory_order_relaxed);
+    }
+
+    void Counters::add_to(Snapshot& s) const
+    {
+      for(size_t i = 0 ; i < m_allocations.size() ; i++)
+        s.allocations[i] += m_allocations[i].load(memory_order_relaxed);
+      for(size_t i = 0 ; i < m_calls.size() ; i++)
+      {
+        s.calls[i] += m_calls[i].load(memory_order_relaxed);
+        s.durations[i] += m_durations[i].load(memory_order_relaxed);
+      }
+    }
+
+    void Counters::reset()
+    {
+      for(auto& c : m_allocations) c.store(0, memory_order_relaxed);
+      for(auto& c : m_calls) c.store(0, memory_order_relaxed);
+      for(auto& c : m_durations) c.store(0, memory_order_relaxed);
+    }
+
+    Counters& Counters::local()
+    {
+      static thread_local Counters c;
+      return c;
+    }
+
+    // Timer of a kernel
+
+    KernelTimer::KernelTimer(Kernel kernel)
+      : m_kernel(kernel), m_t0(chrono::steady_clock::now())
+    {
+
+    }
+
+    KernelTimer::~KernelTimer()
+    {
+      auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_t0);
+      Counters::local().count_call(m_kernel, duration.count());
+    }
+  }
+}
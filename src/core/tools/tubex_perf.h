@@ -0,0 +1,213 @@
+/**
+ *  \file
+ *  Performance counters
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_PERF_H__
+#define __TUBEX_PERF_H__
+
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+
+namespace tubex
+{
+  namespace perf
+  {
+    /**
+     * \enum Alloc
+     * \brief Objects whose allocations are counted
+     */
+    enum class Alloc
+    {
+      SLICE = 0, ///< Slice objects
+      GATE, ///< gates (Interval objects) of the slices
+      CONVEX_POLYGON, ///< ConvexPolygon objects
+      INTERVAL_VECTOR, ///< boxes created by the evaluations of tubes and functions
+      SYNTHESIS_NODE, ///< nodes of the synthesis trees
+      NB ///< number of counted types
+    };
+
+    /**
+     * \enum Kernel
+     * \brief Computations whose invocations and durations are counted
+     *
+     * \note Durations are inclusive: a kernel called by another one is also
+     *       part of the duration of the caller.
+     */
+    enum class Kernel
+    {
+      CTC_DERIV_SLICE = 0, ///< contraction of a slice by CtcDeriv
+      POLYGON_BUILD, ///< polygon enclosure of a slice, see Slice::polygon()
+      TFUNCTION_EVAL, ///< evaluation of a TFunction
+      SYNTHESIS_BUILD, ///< creation of the synthesis tree of a tube
+      NB ///< number of counted kernels
+    };
+
+    /**
+     * \struct Snapshot
+     * \brief Values of the counters, summed over all the threads
+     */
+    struct Snapshot
+    {
+      std::array<uint64_t,(size_t)Alloc::NB> allocations; //!< number of allocations of each type
+      std::array<uint64_t,(size_t)Kernel::NB> calls; //!< number of invocations of each kernel
+      std::array<uint64_t,(size_t)Kernel::NB> durations; //!< time spent in each kernel (ns)
+
+      /**
+       * \brief Returns the number of allocations of some type
+       *
+       * \param type type of the allocated objects
+       * \return an integer
+       */
+      uint64_t nb_allocations(Alloc type) const;
+
+      /**
+       * \brief Returns the number of invocations of some kernel
+       *
+       * \param kernel the computation
+       * \return an integer
+       */
+      uint64_t nb_calls(Kernel kernel) const;
+
+      /**
+       * \brief Returns the time spent in some kernel
+       *
+       * \param kernel the computation
+       * \return the duration in seconds
+       */
+      double duration(Kernel kernel) const;
+
+      /**
+       * \brief Returns the counters accumulated since a previous snapshot
+       *
+       * \param s the previous snapshot
+       * \return the differences of the counters
+       */
+      const Snapshot operator-(const Snapshot& s) const;
+    };
+
+    /**
+     * \brief Tests if the counters have been compiled in the library
+     *
+     * \note Counters are enabled by the `WITH_PERF_COUNTERS` CMake option.
+     *       Otherwise, the snapshots are zero and the instrumentation has no cost.
+     *
+     * \return `true` if the counters are enabled
+     */
+    bool enabled();
+
+    /**
+     * \brief Returns the values of the counters, summed over all the threads
+     *        (including the ones that have terminated)
+     *
+     * \note Values being updated concurrently may be missed, see reset()
+     *
+     * \return the snapshot of the counters
+     */
+    const Snapshot snapshot();
+
+    /**
+     * \brief Resets the counters of all the threads
+     *
+     * \note Should not be called during a computation: concurrent updates may be lost
+     */
+    void reset();
+
+    /**
+     * \brief Returns the name of a type of allocated objects
+     *
+     * \param type type of the allocated objects
+     * \return the name
+     */
+    const char* name(Alloc type);
+
+    /**
+     * \brief Returns the name of a kernel
+     *
+     * \param kernel the computation
+     * \return the name
+     */
+    const char* name(Kernel kernel);
+
+    /**
+     * \brief Displays a summary of the counters
+     *
+     * \param str ostream
+     * \param s the snapshot to be displayed
+     * \return ostream
+     */
+    std::ostream& operator<<(std::ostream& str, const Snapshot& s);
+
+    /**
+     * \class Counters
+     * \brief Counters of one thread
+     *
+     * \note Only the owning thread writes its counters: the updates do not
+     *       lock and do not require atomic read-modify-write operations.
+     */
+    class Counters
+    {
+      public:
+
+        Counters();
+        ~Counters();
+
+        void count_allocations(Alloc type, uint64_t nb);
+        void count_call(Kernel kernel, uint64_t duration);
+        void add_to(Snapshot& s) const;
+        void reset();
+
+        static Counters& local();
+
+      protected:
+
+        Counters(const Counters&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        std::array<std::atomic<uint64_t>,(size_t)Alloc::NB> m_allocations;
+        std::array<std::atomic<uint64_t>,(size_t)Kernel::NB> m_calls;
+        std::array<std::atomic<uint64_t>,(size_t)Kernel::NB> m_durations;
+    };
+
+    /**
+     * \class KernelTimer
+     * \brief Counts one invocation of a kernel and its duration, until the end of the scope
+     */
+    class KernelTimer
+    {
+      public:
+
+        explicit KernelTimer(Kernel kernel);
+        ~KernelTimer();
+
+      protected:
+
+        KernelTimer(const KernelTimer&) = delete;
+        KernelTimer& operator=(const KernelTimer&) = delete;
+
+        Kernel m_kernel; //!< counted kernel
+        std::chrono::steady_clock::time_point m_t0; //!< start of the invocation
+    };
+  }
+}
+
+// Instrumentation of the library, without any cost when the counters are disabled
+
+#ifdef TUBEX_PERF_COUNTERS
+  #define TUBEX_PERF_ALLOC(type, nb) tubex::perf::Counters::local().count_allocations(tubex::perf::Alloc::type, nb)
+  #define TUBEX_PERF_KERNEL(kernel) tubex::perf::KernelTimer tubex_perf_timer(tubex::perf::Kernel::kernel)
+#else
+  #define TUBEX_PERF_ALLOC(type, nb) ((void)0)
+  #define TUBEX_PERF_KERNEL(kernel) ((void)0)
+#endif
+
+#endif
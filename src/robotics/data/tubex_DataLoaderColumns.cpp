@@ -0,0 +1,367 @@
+/**
+ *  DataLoaderColumns class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <exception>
+#include <algorithm>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "tubex_DataLoaderColumns.h"
+#include "tubex_Exception.h"
+#include "tubex_Executor.h"
+#include "tubex_Tools.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  static inline bool is_separator(char c)
+  {
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+  }
+
+  DataLoaderColumns::DataLoaderColumns(const string& file_path, int time_col, const vector<int>& v_value_cols)
+    : m_file_path(file_path), m_time_col(time_col), m_v_value_cols(v_value_cols)
+  {
+    assert(time_col >= 0);
+
+    int max_col = time_col;
+    for(size_t i = 0 ; i < v_value_cols.size() ; i++)
+    {
+      assert(v_value_cols[i] >= 0);
+      max_col = std::max(max_col, v_value_cols[i]);
+    }
+
+    m_v_col_ids = vector<int>(max_col + 1, -1);
+    m_v_col_ids[time_col] = 0;
+    for(size_t i = 0 ; i < v_value_cols.size() ; i++)
+    {
+      assert(m_v_col_ids[v_value_cols[i]] == -1 && "columns cannot be loaded twice");
+      m_v_col_ids[v_value_cols[i]] = i + 1;
+    }
+
+    #ifndef _WIN32
+
+      int fd = open(file_path.c_str(), O_RDONLY);
+      if(fd < 0)
+        throw Exception("DataLoaderColumns constructor", "unable to load data file");
+
+      struct stat st;
+      if(fstat(fd, &st) != 0)
+      {
+        close(fd);
+        throw Exception("DataLoaderColumns constructor", "unable to load data file");
+      }
+
+      m_buffer_size = st.st_size;
+      if(m_buffer_size > 0)
+      {
+        void *p = mmap(NULL, m_buffer_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p == MAP_FAILED)
+        {
+          close(fd);
+          throw Exception("DataLoaderColumns constructor", "unable to map data file in memory");
+        }
+
+        madvise(p, m_buffer_size, MADV_SEQUENTIAL);
+        m_buffer = static_cast<const char*>(p);
+      }
+
+      close(fd);
+
+    #else
+
+      ifstream bin_file(file_path.c_str(), ios::in | ios::binary);
+      if(!bin_file.is_open())
+        throw Exception("DataLoaderColumns constructor", "unable to load data file");
+
+      bin_file.seekg(0, ios::end);
+      m_buffer_size = bin_file.tellg();
+      bin_file.seekg(0, ios::beg);
+      m_v_read_buffer.resize(m_buffer_size);
+      if(m_buffer_size > 0)
+      {
+        bin_file.read(m_v_read_buffer.data(), m_buffer_size);
+        m_buffer = m_v_read_buffer.data();
+      }
+
+    #endif
+  }
+
+  DataLoaderColumns::~DataLoaderColumns()
+  {
+    #ifndef _WIN32
+      if(m_buffer != NULL)
+        munmap(const_cast<char*>(m_buffer), m_buffer_size);
+    #endif
+  }
+
+  void DataLoaderColumns::set_header_lines(int nb_lines)
+  {
+    assert(nb_lines >= 0);
+    m_nb_header_lines = nb_lines;
+  }
+
+  void DataLoaderColumns::set_max_lines(int nb_lines)
+  {
+    assert(nb_lines >= -1);
+    m_max_lines = nb_lines;
+  }
+
+  void DataLoaderColumns::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = nb_threads;
+  }
+
+  size_t DataLoaderColumns::load()
+  {
+    m_v_data.clear();
+    if(m_buffer == NULL)
+      return 0;
+
+    const char *buffer_end = m_buffer + m_buffer_size;
+
+    // Skipping header lines, limiting data lines
+
+      const char *begin = m_buffer;
+      for(int i = 0 ; i < m_nb_header_lines && begin < buffer_end ; i++)
+      {
+        const char *eol = static_cast<const char*>(memchr(begin, '\n', buffer_end - begin));
+        begin = (eol == NULL) ? buffer_end : eol + 1;
+      }
+
+      const char *end = buffer_end;
+      if(m_max_lines != -1)
+      {
+        end = begin;
+        for(int i = 0 ; i < m_max_lines && end < buffer_end ; i++)
+        {
+          const char *eol = static_cast<const char*>(memchr(end, '\n', buffer_end - end));
+          end = (eol == NULL) ? buffer_end : eol + 1;
+        }
+      }
+
+      if(begin >= end)
+        return 0;
+
+    // Splitting the data into chunks of lines (at least 1MB each)
+
+      const size_t min_chunk_size = 1 << 20;
+      size_t nb_chunks = Executor::nb_threads(m_nb_threads);
+      nb_chunks = std::max((size_t)1, std::min(nb_chunks, (size_t)(end - begin) / min_chunk_size));
+
+      vector<const char*> v_bounds(1, begin);
+      for(size_t k = 1 ; k < nb_chunks ; k++)
+      {
+        const char *p = std::max(v_bounds.back(), begin + k * (end - begin) / nb_chunks);
+        const char *eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if(eol == NULL)
+          break;
+        v_bounds.push_back(eol + 1);
+      }
+      v_bounds.push_back(end);
+      nb_chunks = v_bounds.size() - 1;
+
+    // Parsing the chunks, preallocating their rows from the size of the first line
+
+      const char *first_eol = static_cast<const char*>(memchr(begin, '\n', end - begin));
+      size_t line_size = std::max((size_t)1, (size_t)((first_eol == NULL ? end : first_eol + 1) - begin));
+      size_t row_size = m_v_value_cols.size() + 1;
+
+      vector<vector<double> > v_chunks_data(nb_chunks);
+      vector<exception_ptr> v_exceptions(nb_chunks);
+
+      auto parse = [&](size_t k)
+      {
+        try
+        {
+          v_chunks_data[k].reserve(((v_bounds[k+1] - v_bounds[k]) / line_size + 1) * row_size);
+          parse_chunk(v_bounds[k], v_bounds[k+1], v_chunks_data[k]);
+        }
+
+        catch(...)
+        {
+          v_exceptions[k] = current_exception();
+        }
+      };
+
+      Executor::global().run(nb_chunks, parse);
+
+      for(size_t k = 0 ; k < nb_chunks ; k++)
+        if(v_exceptions[k])
+          rethrow_exception(v_exceptions[k]);
+
+    // Gathering the rows
+
+      if(nb_chunks == 1)
+        m_v_data.swap(v_chunks_data[0]);
+
+      else
+      {
+        size_t nb_values = 0;
+        for(size_t k = 0 ; k < nb_chunks ; k++)
+          nb_values += v_chunks_data[k].size();
+
+        m_v_data.reserve(nb_values);
+        for(size_t k = 0 ; k < nb_chunks ; k++)
+          m_v_data.insert(m_v_data.end(), v_chunks_data[k].begin(), v_chunks_data[k].end());
+      }
+
+    return nb_rows();
+  }
+
+  void DataLoaderColumns::parse_chunk(const char *begin, const char *end, vector<double>& v_data) const
+  {
+    const int nb_cols = m_v_col_ids.size();
+    const size_t row_size = m_v_value_cols.size() + 1;
+
+    const char *p = begin;
+    while(p < end)
+    {
+      const char *eol = static_cast<const char*>(memchr(p, '\n', end - p));
+      if(eol == NULL)
+        eol = end;
+
+      size_t row_id = v_data.size();
+      v_data.resize(row_id + row_size);
+
+      int col = 0;
+      while(col < nb_cols)
+      {
+        while(p < eol && is_separator(*p))
+          p++;
+
+        if(p == eol)
+          break;
+
+        if(m_v_col_ids[col] == -1) // column not loaded
+          while(p < eol && !is_separator(*p))
+            p++;
+
+        else
+        {
+          double x;
+          const char *q = parse_double(p, eol, x);
+          if(q == p || (q < eol && !is_separator(*q)))
+            throw Exception("DataLoaderColumns::load", "unable to read a value in data file");
+          v_data[row_id + m_v_col_ids[col]] = x;
+          p = q;
+        }
+
+        col++;
+      }
+
+      if(col == 0) // empty line
+        v_data.resize(row_id);
+
+      else if(col < nb_cols)
+        throw Exception("DataLoaderColumns::load", "missing column in data file");
+
+      p = eol + 1;
+    }
+  }
+
+  const char* DataLoaderColumns::parse_double(const char *begin, const char *end, double& x)
+  {
+    return Tools::parse_double(begin, end, x);
+  }
+
+  size_t DataLoaderColumns::nb_rows() const
+  {
+    return m_v_data.size() / (m_v_value_cols.size() + 1);
+  }
+
+  double DataLoaderColumns::time(size_t row) const
+  {
+    assert(row < nb_rows());
+    return m_v_data[row * (m_v_value_cols.size() + 1)];
+  }
+
+  double DataLoaderColumns::value(size_t row, int i) const
+  {
+    assert(row < nb_rows());
+    assert(i >= 0 && i < (int)m_v_value_cols.size());
+    return m_v_data[row * (m_v_value_cols.size() + 1) + i + 1];
+  }
+
+  const Trajectory DataLoaderColumns::trajectory(int i) const
+  {
+    assert(nb_rows() > 0);
+    assert(i >= 0 && i < (int)m_v_value_cols.size());
+
+    // Sorted times are inserted in amortized constant time
+    map<double,double> m_values;
+    for(size_t k = 0 ; k < nb_rows() ; k++)
+      m_values.emplace_hint(m_values.end(), time(k), value(k, i));
+
+    return Trajectory(m_values);
+  }
+
+  const TrajectoryVector DataLoaderColumns::trajectory_vector(const vector<int>& v_ids) const
+  {
+    assert(nb_rows() > 0);
+    assert(!v_ids.empty());
+
+    vector<map<double,double> > v_maps(v_ids.size());
+    for(size_t j = 0 ; j < v_ids.size() ; j++)
+    {
+      assert(v_ids[j] >= 0 && v_ids[j] < (int)m_v_value_cols.size());
+      for(size_t k = 0 ; k < nb_rows() ; k++)
+        v_maps[j].emplace_hint(v_maps[j].end(), time(k), value(k, v_ids[j]));
+    }
+
+    return TrajectoryVector(v_maps);
+  }
+
+  const TubeVector DataLoaderColumns::tube_vector(const vector<int>& v_ids, const vector<int>& v_radius_ids) const
+  {
+    assert(nb_rows() > 1);
+    assert(!v_ids.empty());
+    assert(v_radius_ids.empty() || v_radius_ids.size() == v_ids.size());
+
+    const size_t n = nb_rows() - 1;
+    vector<Interval> v_tdomains;
+    vector<IntervalVector> v_codomains(n, IntervalVector(v_ids.size()));
+    v_tdomains.reserve(n);
+
+    IntervalVector y_prev(v_ids.size()), y(v_ids.size());
+    for(size_t k = 0 ; k <= n ; k++)
+    {
+      for(size_t j = 0 ; j < v_ids.size() ; j++)
+      {
+        y[j] = value(k, v_ids[j]);
+        if(!v_radius_ids.empty())
+          y[j].inflate(value(k, v_radius_ids[j]));
+      }
+
+      if(k > 0)
+      {
+        if(time(k) <= time(k-1))
+          throw Exception("DataLoaderColumns::tube_vector", "times are not strictly increasing");
+
+        v_tdomains.push_back(Interval(time(k-1), time(k)));
+        v_codomains[k-1] = y_prev | y;
+      }
+
+      y_prev = y;
+    }
+
+    return TubeVector(v_tdomains, v_codomains);
+  }
+}
@@ -0,0 +1,176 @@
+/**
+ *  DataLoaderColumns class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_DATALOADERCOLUMNS_H__
+#define __TUBEX_DATALOADERCOLUMNS_H__
+
+#include <string>
+#include <vector>
+#include "tubex_Trajectory.h"
+#include "tubex_TrajectoryVector.h"
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * \class DataLoaderColumns
+   * \brief Fast loader of column-based text data (logs, CSV files)
+   *
+   * The file is mapped in memory and split into chunks of lines that are
+   * parsed in parallel. Columns are separated by spaces, tabulations, commas
+   * or semicolons. Only the time column and the requested value columns
+   * are stored, in a row-major array of doubles.
+   */
+  class DataLoaderColumns
+  {
+    public:
+
+      /**
+       * \brief Creates a loader of a text file
+       *
+       * \param file_path path of the data file
+       * \param time_col index of the time column (starting from 0)
+       * \param v_value_cols indexes of the value columns to be loaded
+       */
+      DataLoaderColumns(const std::string& file_path, int time_col, const std::vector<int>& v_value_cols);
+
+      /**
+       * \brief DataLoaderColumns destructor
+       */
+      ~DataLoaderColumns();
+
+      /**
+       * \brief Sets the number of lines to skip at the beginning of the file
+       *
+       * \param nb_lines number of header lines
+       */
+      void set_header_lines(int nb_lines);
+
+      /**
+       * \brief Limits the number of data lines read after the header
+       *
+       * \param nb_lines maximal number of lines, -1 for reading until the end of the file
+       */
+      void set_max_lines(int nb_lines);
+
+      /**
+       * \brief Sets the number of threads used for parsing
+       *
+       * \param nb_threads number of threads (0 for the global setting of the Executor, 1 for a sequential run)
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Parses the file
+       *
+       * Empty lines are ignored. An exception is thrown if a
+       * requested column is missing or cannot be read.
+       *
+       * \return the number of loaded rows
+       */
+      size_t load();
+
+      /**
+       * \brief Returns the number of loaded rows
+       *
+       * \return the number of rows
+       */
+      size_t nb_rows() const;
+
+      /**
+       * \brief Returns the time value of a row
+       *
+       * \param row index of the row
+       * \return the time
+       */
+      double time(size_t row) const;
+
+      /**
+       * \brief Returns a loaded value
+       *
+       * \param row index of the row
+       * \param i index of the value column, as given in `v_value_cols`
+       * \return the value
+       */
+      double value(size_t row, int i) const;
+
+      /**
+       * \brief Creates a trajectory from one loaded column
+       *
+       * \param i index of the value column, as given in `v_value_cols`
+       * \return the sampled trajectory
+       */
+      const Trajectory trajectory(int i) const;
+
+      /**
+       * \brief Creates a trajectory vector from loaded columns
+       *
+       * \param v_ids indexes of the value columns, as given in `v_value_cols`
+       * \return the sampled trajectory vector
+       */
+      const TrajectoryVector trajectory_vector(const std::vector<int>& v_ids) const;
+
+      /**
+       * \brief Creates a tube vector enclosing the loaded data
+       *
+       * One slice is created between two consecutive rows. Its codomain
+       * is the hull of the two samples, possibly inflated by radius columns.
+       * Times are expected to be strictly increasing.
+       *
+       * \param v_ids indexes of the value columns, as given in `v_value_cols`
+       * \param v_radius_ids indexes of the columns of uncertainties (radius) associated to `v_ids`, or empty
+       * \return the tube vector
+       */
+      const TubeVector tube_vector(const std::vector<int>& v_ids, const std::vector<int>& v_radius_ids = std::vector<int>()) const;
+
+      /**
+       * \brief Parses a decimal floating-point number, independently of the locale
+       *
+       * \note Same as Tools::parse_double, used for each value of the file.
+       *
+       * \param begin pointer to the first character of the number
+       * \param end pointer to the end of the buffer
+       * \param x the parsed value (0 if no number has been read)
+       * \return a pointer to the character following the number, or `begin` if no number has been read
+       */
+      static const char* parse_double(const char *begin, const char *end, double& x);
+
+    protected:
+
+      DataLoaderColumns(const DataLoaderColumns&) = delete;
+      DataLoaderColumns& operator=(const DataLoaderColumns&) = delete;
+
+      /**
+       * \brief Parses the lines of a chunk of the file
+       *
+       * \param begin pointer to the beginning of a line
+       * \param end pointer to the end of the chunk, located after an end of line
+       * \param v_data row-major array of values to be completed
+       */
+      void parse_chunk(const char *begin, const char *end, std::vector<double>& v_data) const;
+
+      std::string m_file_path; //!< path of the data file
+      const char *m_buffer = NULL; //!< file content, mapped in memory
+      size_t m_buffer_size = 0; //!< size of the file
+      std::vector<char> m_v_read_buffer; //!< file content, when memory mapping is not available
+
+      int m_time_col; //!< index of the time column
+      std::vector<int> m_v_value_cols; //!< indexes of the value columns
+      std::vector<int> m_v_col_ids; //!< for each column of the file, its position in a row (-1 if not loaded)
+
+      int m_nb_header_lines = 0; //!< number of lines to skip
+      int m_max_lines = -1; //!< maximal number of data lines
+      int m_nb_threads = 0; //!< number of threads used for parsing
+
+      std::vector<double> m_v_data; //!< loaded rows: time and values
+  };
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <time.h>
 #include "tubex_DataLoaderRedermor.h"
+#include "tubex_DataLoaderColumns.h"
 #include "tubex_TFunction.h"
 #include "tubex_Exception.h"
 #include "tubex_Tube.h"
@@ -36,49 +37,42 @@ namespace tubex
     
     else // loading data from file
     {
-      if(!m_datafile->is_open())
-        throw Exception("DataLoaderRedermor::load_data", "data file not already open");
+      // Columns: t, then (y,dy) for phi, theta, psi, vx, vy, vz, depth, alt, x, y
+      vector<int> v_cols;
+      for(int j = 1 ; j <= 20 ; j++)
+        v_cols.push_back(j);
+
+      DataLoaderColumns loader(m_file_path, 0, v_cols);
+      loader.set_header_lines(45); // accessing data
+      loader.set_max_lines(59954); // end of data
+      if(loader.load() == 0)
+        throw Exception("DataLoaderRedermor::load_data", "fail loading data");
+
+      // Trajectories used for velocities evaluations:
+      vector<int> v_y_ids, v_dy_ids;
+      for(int j = 0 ; j < 10 ; j++)
+      {
+        v_y_ids.push_back(2*j);
+        v_dy_ids.push_back(2*j+1);
+      }
 
-      int i = 0;
-      string line;
-      TrajectoryVector traj_data_x(10), traj_data_dx(10);
-      truth = new TrajectoryVector(6);
+      TrajectoryVector traj_data_x = loader.trajectory_vector(v_y_ids);
+      TrajectoryVector traj_data_dx = loader.trajectory_vector(v_dy_ids);
 
-      while(getline(*m_datafile, line))
+      // Trajectory used as ground truth:
+      vector<map<double,double> > v_truth(6);
+      for(size_t k = 0 ; k < loader.nb_rows() ; k++)
       {
-        i ++;
-        if(i < 46) continue; // accessing data
-        if(i == 60000) break; // end of data
-
-        double t;
-        Vector y(10), dy(10);
-
-        istringstream iss(line);
-        if(!(iss >> t
-                 >> y[0] >> dy[0]   // phi
-                 >> y[1] >> dy[1]   // theta
-                 >> y[2] >> dy[2]   // psi
-                 >> y[3] >> dy[3]   // vx
-                 >> y[4] >> dy[4]   // vy
-                 >> y[5] >> dy[5]   // vz
-                 >> y[6] >> dy[6]   // depth
-                 >> y[7] >> dy[7]   // alt
-                 >> y[8] >> dy[8]   // x
-                 >> y[9] >> dy[9])) // y
-          throw Exception("DataLoaderRedermor::load_data", "fail loading data");
-
-        // Trajectory used for velocities evaluations:
-        traj_data_x.set(y, t);
-        traj_data_dx.set(dy, t);
-
-        // Trajectory used as ground truth:
-        Vector truth_vector(6);
-        truth_vector.put(0, y.subvector(8,9)); // position
-        truth_vector[2] = y[6]; // depth
-        truth_vector.put(3, Vector(3, 0.)); // unknown velocities
-        truth->set(truth_vector, t);
+        double t = loader.time(k);
+        v_truth[0].emplace_hint(v_truth[0].end(), t, loader.value(k, 16)); // position
+        v_truth[1].emplace_hint(v_truth[1].end(), t, loader.value(k, 18));
+        v_truth[2].emplace_hint(v_truth[2].end(), t, loader.value(k, 12)); // depth
+        for(int j = 3 ; j < 6 ; j++) // unknown velocities
+          v_truth[j].emplace_hint(v_truth[j].end(), t, 0.);
       }
 
+      truth = new TrajectoryVector(v_truth);
+
       // Data from sensors with uncertainties:
       x = new TubeVector(traj_data_x, timestep); // state vector
       x->inflate(traj_data_dx);
@@ -35,19 +35,21 @@ namespace tubex
     if(m_box.is_unbounded())
       m_box = IntervalVector(2, p.tdomain()); // initializing
     m_precision = precision;
-    
-    if(value() == SetValue::OUT)
-      return;
 
-    else if(!is_leaf())
+    // Lazily computed data of the tubes are precomputed before the
+    // parallel computation, so that the tubes are then only read
+    for(int j = 0 ; j < p.size() ; j++)
     {
-      ((TPlane*)m_first_subpaving)->compute_detections(precision, p, v, false);
-      ((TPlane*)m_second_subpaving)->compute_detections(precision, p, v, false);
+      p[j].freeze();
+      v[j].freeze();
     }
 
-    else
+    engine().compute(this, [&](Paving *tplane, int) -> bool
     {
-      const Interval t1 = m_box[0], t2 = m_box[1];
+      if(tplane->value() == SetValue::OUT)
+        return false;
+
+      const Interval t1 = tplane->box()[0], t2 = tplane->box()[1];
       const IntervalVector box_neg_reals(2, Interval::NEG_REALS);
       const IntervalVector box_pos_reals(2, Interval::POS_REALS);
 
@@ -87,21 +89,19 @@ namespace tubex
       // Conclusion
 
         if(derivative_out || primitive_out)
-          set_value(SetValue::OUT);
+          tplane->set_value(SetValue::OUT);
 
         else if(derivative_in && primitive_in)
-          set_value(SetValue::IN);
+          tplane->set_value(SetValue::IN);
 
         else if(max(t1.diam(), t2.diam()) < precision)
-          set_value(SetValue::MAYBE);
+          tplane->set_value(SetValue::MAYBE);
 
         else
-        {
-          bisect();
-          ((TPlane*)m_first_subpaving)->compute_detections(precision, p, v, false);
-          ((TPlane*)m_second_subpaving)->compute_detections(precision, p, v, false);
-        }
-    }
+          return true; // bisection
+
+        return false;
+    });
 
     if(extract_subsets)
       m_v_detected_loops = get_connected_subsets();
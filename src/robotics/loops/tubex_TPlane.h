@@ -117,10 +117,11 @@ namespace tubex
     protected:
 
       /**
-       * \brief Recursive computation of the tplane, from the tube of positions \f$[\mathbf{p}](\cdot)\f$
+       * \brief Computation of the tplane, from the tube of positions \f$[\mathbf{p}](\cdot)\f$
        *        and the tube of velocities \f$[\mathbf{v}](\cdot)\f$.
        *
-       * \note This method is used as recursive algorithm.
+       * \note The leaves are computed in parallel by a PavingEngine, see Paving::set_nb_threads().
+       * \note If the tplane has already been computed, only its non-OUT leaves are refined.
        *
        * \param precision precision \f$\epsilon\f$ of the SIVIA approximation
        * \param p 2d TubeVector \f$[\mathbf{p}](\cdot)\f$ for positions
@@ -1,6 +1,9 @@
 #include "catch_interval.hpp"
 #include "tubex_CtcDelay.h"
 #include "tubex_TubeVectorODE.h"
+#include "tubex_TaylorIntegrator.h"
+#include "tubex_TaylorExpr.h"
+#include <clocale>
 
 using namespace std;
 using namespace Catch;
@@ -11,6 +14,7 @@ using namespace tubex;
 
 TEST_CASE("TubeVectorODE_1")
 {
+#ifdef WITH_CAPD
     SECTION("CAPD_MODE")
     {
         Interval domain(0,5);
@@ -28,4 +32,126 @@ TEST_CASE("TubeVectorODE_1")
         REQUIRE(ApproxIntvVector(a1) == expected);
 
     }
-}
\ No newline at end of file
+#endif
+
+    SECTION("TAYLOR_MODE")
+    {
+        Interval domain(0,5);
+        TFunction f("x","y", "(x^3+x*y^2-x+y; y^3+x^2*y-x-y)");
+        IntervalVector x0(2);
+        x0[0]=Interval(0.5,0.5);
+        x0[1]=Interval(0,0);
+        double timestep = 0.001;
+        int mode = TAYLOR_MODE;
+        TubeVector output = TubeVectorODE(domain,f,x0,timestep,mode);
+        CHECK(output.tdomain() == domain);
+        IntervalVector a1 = output(1.0);
+        IntervalVector expected(2);
+        expected[0] = Interval(0.1121125007098844, 0.1123948125529081);
+        expected[1] = Interval(-0.1748521323811479, -0.1747971075720925);
+        CHECK(a1.intersects(expected));
+        CHECK(a1.max_diam() < 1e-3);
+
+        // Adaptive step size
+        TubeVector output_adaptive = TubeVectorODE(domain,f,x0,0.,mode);
+        CHECK(output_adaptive(1.0).intersects(expected));
+        CHECK(output_adaptive(1.0).max_diam() < 1e-3);
+        CHECK(output_adaptive.nb_slices() < output.nb_slices());
+    }
+
+    SECTION("DEFAULT_ODE_MODE")
+    {
+        TFunction f("x", "(-x)");
+        TubeVector output = TubeVectorODE(Interval(0.,1.), f, IntervalVector(1, Interval(1.)), 0.01);
+        CHECK(output(1.)[0].contains(exp(-1.)));
+    }
+}
+
+TEST_CASE("TaylorIntegrator")
+{
+    SECTION("Linear system, known solution")
+    {
+        Interval domain(0,2);
+        TFunction f("x","y", "(y; -x)");
+        IntervalVector x0(2);
+        x0[0]=Interval(1.,1.1);
+        x0[1]=Interval(0.);
+
+        TaylorIntegrator integrator(f);
+        integrator.set_order(8);
+        integrator.set_tolerance(1e-12);
+        TubeVector x = integrator.integrate(domain, x0);
+
+        // x(t)=x0*cos(t), y(t)=-x0*sin(t)
+        for(double t = 0. ; t <= 2. ; t += 0.25)
+        {
+            CHECK(x[0](t).contains(cos(t)));
+            CHECK(x[0](t).contains(1.1*cos(t)));
+            CHECK(x[1](t).contains(-sin(t)));
+            CHECK(x[1](t).contains(-1.1*sin(t)));
+        }
+
+        // The rotation of the initial box does not inflate
+        // the enclosure of the final gate, thanks to the QR method
+        CHECK(x(2.).max_diam() < 0.11);
+    }
+
+    SECTION("Non-autonomous system")
+    {
+        Interval domain(0,3);
+        TFunction f("x", "(cos(t)*x)");
+        TaylorIntegrator integrator(f);
+        TubeVector x = integrator.integrate(domain, IntervalVector(1, Interval(1.)), 0.1);
+
+        // x(t)=exp(sin(t))
+        CHECK(x.nb_slices() == 30);
+        CHECK(x[0](3.).contains(exp(sin(3.))));
+        CHECK(x[0](3.).diam() < 1e-6);
+        CHECK(x[0](Interval(1.,1.1)).contains(exp(sin(1.05))));
+    }
+
+    SECTION("Decimal constants")
+    {
+        vector<vector<Interval> > v_coeffs;
+        vector<Interval> x(1, Interval(1.));
+
+        // 0.1 is not a double: its enclosure is not degenerate
+        TaylorExpr(TFunction("x", "(0.1*x)")).ode_coefficients(Interval(0.), x, 1, v_coeffs);
+        CHECK(v_coeffs[0][1].contains(0.1));
+        CHECK(v_coeffs[0][1].diam() > 0.);
+        CHECK(v_coeffs[0][1].diam() < 1e-15);
+
+        TaylorExpr(TFunction("x", "([0.1,0.3]*x)")).ode_coefficients(Interval(0.), x, 1, v_coeffs);
+        CHECK(v_coeffs[0][1].lb() < 0.1);
+        CHECK(v_coeffs[0][1].ub() > 0.3);
+
+        // Integers are exactly represented
+        TaylorExpr(TFunction("x", "(3.0*x-2)")).ode_coefficients(Interval(0.), x, 1, v_coeffs);
+        CHECK(v_coeffs[0][1] == Interval(1.));
+    }
+
+    SECTION("Decimal constants, locale with a decimal comma")
+    {
+        vector<vector<Interval> > v_coeffs;
+        vector<Interval> x(1, Interval(1.));
+        TFunction f("x", "(2.5*x)");
+
+        string previous_locale = setlocale(LC_NUMERIC, NULL);
+        if(setlocale(LC_NUMERIC, "de_DE.UTF-8") != NULL || setlocale(LC_NUMERIC, "fr_FR.UTF-8") != NULL)
+        {
+            TaylorExpr expr(f);
+            setlocale(LC_NUMERIC, previous_locale.c_str());
+            expr.ode_coefficients(Interval(0.), x, 1, v_coeffs);
+            CHECK(v_coeffs[0][1].contains(2.5));
+            CHECK(v_coeffs[0][1].diam() < 1e-15);
+        }
+
+        setlocale(LC_NUMERIC, previous_locale.c_str());
+    }
+
+    SECTION("Unsupported expression")
+    {
+        TFunction f("x", "(atan(x))");
+        CHECK_THROWS(TaylorIntegrator(f).set_order(5));
+    }
+}
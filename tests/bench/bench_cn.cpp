@@ -0,0 +1,214 @@
+/**
+ *  Benchmarks: building and solving contractor networks
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "bench_suite.h"
+#include "tubex_Tube.h"
+#include "tubex_TubeVector.h"
+#include "tubex_TrajectoryVector.h"
+#include "tubex_RandTrajectory.h"
+#include "tubex_TFunction.h"
+#include "tubex_CtcFunction.h"
+#include "tubex_ContractorNetwork.h"
+#include "tubex_CtcDeriv.h"
+#include "tubex_CtcEval.h"
+#include "tubex_predef_contractors.h"
+#include "tubex_DataLoader.h"
+#include "pyibex_predef_contractors.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+namespace bench
+{
+  void add_cn_benchmarks(Suite& suite)
+  {
+    const Interval tdomain(0.,10.);
+
+    for(int n : suite.nb_slices())
+    {
+      double dt = tdomain.diam() / n;
+
+      for(int nb_obs : { 10, 100 })
+      {
+        // Long tube with observations, with variable sizes
+
+        vector<Interval> v_t, v_z;
+        for(int i = 0 ; i < nb_obs ; i++)
+        {
+          double t = tdomain.lb() + (i + 0.5) * tdomain.diam() / nb_obs;
+          v_t.push_back(Interval(t));
+          v_z.push_back(sin(Interval(t)) + Interval(-0.2,0.2));
+        }
+
+        suite.add("cn/build", { {"slices",n}, {"obs",nb_obs} }, [=]()
+        {
+          Tube x(tdomain, dt), v(tdomain, dt, TFunction("cos(t)+[-0.05,0.05]"));
+          vector<Interval> v_t_(v_t), v_z_(v_z);
+          return time_ms([&]() {
+            ContractorNetwork cn;
+            cn.add(ctc::deriv, {x, v});
+            for(size_t i = 0 ; i < v_t_.size() ; i++)
+              cn.add(ctc::eval, {v_t_[i], v_z_[i], x, v});
+          });
+        });
+
+        for(int nb_windows : { 1, 8 })
+          suite.add("cn/solve", { {"slices",n}, {"obs",nb_obs}, {"windows",nb_windows} }, [=]()
+          {
+            Tube x(tdomain, dt), v(tdomain, dt, TFunction("cos(t)+[-0.05,0.05]"));
+            vector<Interval> v_t_(v_t), v_z_(v_z);
+            ContractorNetwork cn;
+            cn.set_time_windows(nb_windows);
+            cn.add(ctc::deriv, {x, v});
+            for(size_t i = 0 ; i < v_t_.size() ; i++)
+              cn.add(ctc::eval, {v_t_[i], v_z_[i], x, v});
+            return time_ms([&]() { cn.contract(); });
+          });
+
+        for(int policy = 0 ; policy < 3 ; policy++)
+          suite.add("cn/scheduling_long_tube", { {"slices",n}, {"obs",nb_obs}, {"policy",policy} }, [=]()
+          {
+            Tube x(tdomain, dt), v(tdomain, dt, TFunction("cos(t)+[-0.05,0.05]"));
+            vector<Interval> v_t_(v_t), v_z_(v_z);
+            ContractorNetwork cn;
+            cn.set_scheduling((Scheduling)policy);
+            cn.add(ctc::deriv, {x, v});
+            for(size_t i = 0 ; i < v_t_.size() ; i++)
+              cn.add(ctc::eval, {v_t_[i], v_z_[i], x, v});
+            return time_ms([&]() { cn.contract(); });
+          });
+      }
+    }
+
+    // Scheduling policies (STACK, YIELD_PER_COST, DOMAIN_WEIGHT)
+
+    for(int policy = 0 ; policy < 3 ; policy++)
+    {
+      // Dynamic range-only localization of the tutorials
+      suite.add("cn/scheduling_rangeonly", { {"policy",policy} }, [=]()
+      {
+        float dt = 0.01;
+        TrajectoryVector x_truth(Interval(0.,3.), TFunction("( \
+          10*cos(t)+t ; \
+          5*sin(2*t)+t ; \
+          atan2((10*cos(2*t)+1),(-10*sin(t)+1)) ; \
+          sqrt((-10*sin(t)+1)^2+(10*cos(2*t)+1)^2))"));
+        Interval tdomain_ = x_truth.tdomain();
+
+        Trajectory psi = x_truth[2].sample(dt).make_continuous();
+        psi += RandTrajectory(tdomain_, dt, Interval(-0.01,0.01));
+        Trajectory speed = x_truth[3].sample(dt);
+        speed += RandTrajectory(tdomain_, dt, Interval(-0.01,0.01));
+
+        TubeVector x(tdomain_, dt, 4), v(tdomain_, dt, 4), u(tdomain_, dt, 2);
+        x[2] = Tube(psi, dt).inflate(0.01);
+        x[3] = Tube(speed, dt).inflate(0.01);
+
+        CtcFunction ctc_f(
+          Function("v[4]", "x[4]", "u[2]",
+                   "(v[0]-x[3]*cos(x[2]) ; v[1]-x[3]*sin(x[2]) ; v[2]-u[0] ; v[3]-u[1])"));
+
+        Interval e_y(-0.1,0.1);
+        vector<Interval> y = {1.9+e_y, 3.6+e_y, 2.8+e_y};
+        vector<Vector>   b = {{8,3}, {0,5}, {-2,1}};
+        vector<double>   t = {0.3, 1.5, 2.0};
+
+        ContractorNetwork cn;
+        cn.set_scheduling((Scheduling)policy);
+        cn.add(ctc_f, {v, x, u});
+
+        for(int i = 0 ; i < 3 ; i++)
+        {
+          IntervalVector& p = cn.create_dom(IntervalVector(4));
+          cn.add(ctc::dist, {cn.subvector(p,0,1), b[i], y[i]});
+          cn.add(ctc::eval, {t[i], p, x, v});
+        }
+
+        return time_ms([&]() { cn.contract(); });
+      });
+
+      // Dynamic range-bearing localization of the tutorials
+      suite.add("cn/scheduling_rangebearing", { {"policy",policy} }, [=]()
+      {
+        srand(0); // same landmarks and observations for each policy
+
+        float dt = 0.05;
+        TrajectoryVector x_truth(Interval(0.,3.), TFunction("( \
+          10*cos(t)+t ; \
+          5*sin(2*t)+t ; \
+          atan2((10*cos(2*t)+1),(-10*sin(t)+1)) ; \
+          sqrt((-10*sin(t)+1)^2+(10*cos(2*t)+1)^2))"));
+        Interval tdomain_ = x_truth.tdomain();
+
+        Trajectory psi = x_truth[2].sample(dt).make_continuous();
+        psi += RandTrajectory(tdomain_, dt, Interval(-0.01,0.01));
+        Trajectory speed = x_truth[3].sample(dt);
+        speed += RandTrajectory(tdomain_, dt, Interval(-0.01,0.01));
+
+        vector<IntervalVector> v_map = DataLoader::generate_landmarks_boxes(IntervalVector(2, Interval(-8.,8.)), 30);
+        vector<IntervalVector> v_obs = DataLoader::generate_observations_along_traj(x_truth, v_map, 10);
+        for(auto& obs : v_obs)
+        {
+          obs[1].inflate(0.3); // range
+          obs[2].inflate(0.1); // bearing
+        }
+
+        TubeVector x(tdomain_, dt, 4), v(tdomain_, dt, 4), u(tdomain_, dt, 2);
+        x[2] = Tube(psi, dt).inflate(0.01);
+        x[3] = Tube(speed, dt).inflate(0.01);
+
+        CtcFunction ctc_f(
+          Function("v[4]", "x[4]", "u[2]",
+                   "(v[0]-x[3]*cos(x[2]) ; v[1]-x[3]*sin(x[2]) ; v[2]-u[0] ; v[3]-u[1])"));
+        CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+        CtcFunction ctc_minus(Function("a", "b", "c", "a-b-c"));
+
+        ContractorNetwork cn;
+        cn.set_scheduling((Scheduling)policy);
+        cn.add(ctc_f, {v, x, u});
+
+        for(auto& y : v_obs)
+        {
+          Interval& alpha = cn.create_dom(Interval());
+          IntervalVector& d = cn.create_dom(IntervalVector(2));
+          IntervalVector& p = cn.create_dom(IntervalVector(4));
+
+          cn.add(ctc_plus, {y[2], p[2], alpha});
+          cn.add(ctc_minus, {cn.subvector(y,3,4), cn.subvector(p,0,1), d});
+          cn.add(ctc::polar, {d, y[1], alpha});
+          cn.add(ctc::eval, {y[0], p, x, v});
+        }
+
+        return time_ms([&]() { cn.contract(); });
+      });
+
+      // Chain of static constraints, with noisy links
+      for(int n : suite.nb_slices(100000))
+        suite.add("cn/scheduling_static_chain", { {"size",n}, {"policy",policy} }, [=]()
+        {
+          vector<Interval> v_x(n, Interval(-1000.,1000.)), v_d(n-1);
+          for(int i = 0 ; i < n-1 ; i++)
+            v_d[i] = Interval(1.) + Interval(-0.01,0.01) * (1 + i%7);
+          v_x[0] = Interval(0.);
+          v_x[n-1] &= Interval(n-1.) + Interval(-1.,1.);
+
+          CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+
+          ContractorNetwork cn;
+          cn.set_scheduling((Scheduling)policy);
+          for(int i = 0 ; i < n-1 ; i++)
+            cn.add(ctc_add, {v_x[i], v_d[i], v_x[i+1]});
+
+          return time_ms([&]() { cn.contract(); });
+        });
+    }
+  }
+}
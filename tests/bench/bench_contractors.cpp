@@ -0,0 +1,129 @@
+/**
+ *  Benchmarks: dynamic contractors and integration methods
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "bench_suite.h"
+#include "tubex_Tube.h"
+#include "tubex_TubeVector.h"
+#include "tubex_TFunction.h"
+#include "tubex_CtcFunction.h"
+#include "tubex_CtcDeriv.h"
+#include "tubex_CtcEval.h"
+#include "tubex_CtcDelay.h"
+#include "tubex_CtcStatic.h"
+#include "tubex_CtcPicard.h"
+#include "tubex_CtcDynCid.h"
+#include "tubex_CtcDynCidGuess.h"
+#include "tubex_CtcIntegration.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+namespace bench
+{
+  const TFunction vector_function(int dim);
+
+  void add_contractors_benchmarks(Suite& suite)
+  {
+    const Interval tdomain(0.,10.);
+
+    for(int n : suite.nb_slices())
+    {
+      double dt = tdomain.diam() / n;
+
+      for(int d : suite.dims())
+      {
+        if(suite.too_large(n, d))
+          continue;
+
+        suite.add("ctc/deriv", { {"slices",n}, {"dim",d} }, [=]()
+        {
+          TubeVector x(tdomain, dt, d), v(tdomain, dt, d);
+          x.set(IntervalVector(d, Interval(0.)), 0.);
+          v.set(IntervalVector(d, Interval(-1.,1.)));
+          CtcDeriv ctc_deriv;
+          return time_ms([&]() { ctc_deriv.contract(x, v); });
+        });
+      }
+
+      suite.add("ctc/eval", { {"slices",n}, {"obs",100} }, [=]()
+      {
+        Tube x(tdomain, dt), v(tdomain, dt, TFunction("cos(t)+[-0.1,0.1]"));
+        vector<Interval> v_z(100);
+        for(size_t i = 0 ; i < v_z.size() ; i++)
+          v_z[i] = sin(Interval(0.05 + i * 0.1)) + Interval(-0.2,0.2);
+        CtcEval ctc_eval;
+        return time_ms([&]() {
+          for(size_t i = 0 ; i < v_z.size() ; i++)
+            ctc_eval.contract(0.05 + i * 0.1, v_z[i], x, v);
+        });
+      });
+
+      suite.add("ctc/delay", { {"slices",n} }, [=]()
+      {
+        Interval a(1.);
+        Tube x(tdomain, dt, TFunction("cos(t)+[-0.1,0.1]")), y(tdomain, dt);
+        CtcDelay ctc_delay;
+        return time_ms([&]() { ctc_delay.contract(a, x, y); });
+      });
+
+      suite.add("ctc/static", { {"slices",n} }, [=]()
+      {
+        Tube x(tdomain, dt, TFunction("cos(t)+[-0.5,0.5]")), y(tdomain, dt, Interval(-3.,3.));
+        CtcFunction ctc_f(Function("x", "y", "y-2*x"));
+        CtcStatic ctc_static(ctc_f);
+        return time_ms([&]() { ctc_static.contract(x, y); });
+      });
+    }
+
+    // Integration methods are more expensive: smaller sizes
+
+    for(int n : suite.nb_slices(10000))
+    {
+      double dt = tdomain.diam() / n;
+
+      for(int d : suite.dims(4))
+      {
+        suite.add("ctc/picard", { {"slices",n}, {"dim",d} }, [=]()
+        {
+          TubeVector x(tdomain, dt, d);
+          x.set(IntervalVector(d, Interval(0.5,1.)), 0.);
+          TFunction f = vector_function(d);
+          CtcPicard ctc_picard;
+          return time_ms([&]() { ctc_picard.contract(f, x, TimePropag::FORWARD); });
+        });
+      }
+
+      suite.add("ctc/integration_cid", { {"slices",n} }, [=]()
+      {
+        TFunction f("x", "-x");
+        TubeVector x(Interval(0.,1.), 1. / n, 1);
+        x.set(IntervalVector(1, Interval(1.)), 0.);
+        CtcDynCid *ctc_cid = new CtcDynCid(f);
+        CtcIntegration ctc_integration(f, ctc_cid);
+        double t = time_ms([&]() { ctc_integration.contract(x, 0., TimePropag::FORWARD); });
+        delete ctc_cid;
+        return t;
+      });
+
+      suite.add("ctc/integration_cidguess", { {"slices",n} }, [=]()
+      {
+        TFunction f("x", "-x");
+        TubeVector x(Interval(0.,1.), 1. / n, 1);
+        x.set(IntervalVector(1, Interval(1.)), 0.);
+        CtcDynCidGuess *ctc_cidguess = new CtcDynCidGuess(f);
+        CtcIntegration ctc_integration(f, ctc_cidguess);
+        double t = time_ms([&]() { ctc_integration.contract(x, 0., TimePropag::FORWARD); });
+        delete ctc_cidguess;
+        return t;
+      });
+    }
+  }
+}
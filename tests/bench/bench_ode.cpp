@@ -0,0 +1,51 @@
+/**
+ *  Benchmarks: validated integration of ODEs
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "bench_suite.h"
+#include "tubex_TFunction.h"
+#include "tubex_TubeVectorODE.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+namespace bench
+{
+  void add_ode_benchmarks(Suite& suite)
+  {
+    // The CAPD mode is only measured if Tubex has been built with CAPD
+    vector<int> v_modes(1, TAYLOR_MODE);
+    #ifdef WITH_CAPD
+      v_modes.push_back(CAPD_MODE);
+    #endif
+
+    for(int mode : v_modes)
+    {
+      // Fixed timestep (1) or adaptive one (0)
+      for(int fixed : { 1, 0 })
+      {
+        suite.add("ode/polynomial", { {"taylor",mode == TAYLOR_MODE}, {"fixed_timestep",fixed} }, [=]()
+        {
+          IntervalVector x0(2);
+          x0[0] = Interval(0.5);
+          x0[1] = Interval(0.);
+          TFunction f("x", "y", "(x^3+x*y^2-x+y; y^3+x^2*y-x-y)");
+          return time_ms([&]() { TubeVectorODE(Interval(0.,5.), f, x0, fixed ? 0.001 : 0., mode); });
+        });
+
+        suite.add("ode/unicycle", { {"taylor",mode == TAYLOR_MODE}, {"fixed_timestep",fixed} }, [=]()
+        {
+          TFunction f("x1", "x2", "x3", "(cos(x3);sin(x3);sin(0.4*t))");
+          return time_ms([&]() { TubeVectorODE(Interval(0.,17.), f, IntervalVector(3, Interval(0.)), fixed ? 0.1 : 0., mode); });
+        });
+      }
+    }
+  }
+}
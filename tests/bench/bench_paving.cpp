@@ -0,0 +1,39 @@
+/**
+ *  Benchmarks: set inversion and pavings
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "bench_suite.h"
+#include "tubex_SIVIAPaving.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+namespace bench
+{
+  void add_paving_benchmarks(Suite& suite)
+  {
+    // Precision of the paving: 10^-k
+    int k_max = suite.scale() == Scale::SMALL ? 2 : 3;
+
+    for(int k = 1 ; k <= k_max ; k++)
+    {
+      for(int nb_threads : { 1, 0 })
+      {
+        suite.add("paving/sivia", { {"precision",k}, {"threads",nb_threads} }, [=]()
+        {
+          Function f("x", "y", "x^2+y^2");
+          SIVIAPaving p(IntervalVector(2, Interval(-3.,3.)));
+          p.set_nb_threads(nb_threads);
+          return time_ms([&]() { p.compute(f, IntervalVector(1, Interval(1.,2.)), pow(10., -k)); });
+        });
+      }
+    }
+  }
+}
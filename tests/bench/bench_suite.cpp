@@ -0,0 +1,136 @@
+/**
+ *  Benchmark suite of the library (tubex-bench)
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include "bench_suite.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+
+namespace bench
+{
+  Suite::Suite(Scale scale, int nb_runs, const string& filter)
+    : m_scale(scale), m_nb_runs(nb_runs), m_filter(filter)
+  {
+    assert(nb_runs > 0);
+  }
+
+  Scale Suite::scale() const
+  {
+    return m_scale;
+  }
+
+  const vector<int> Suite::nb_slices(int max_nb_slices) const
+  {
+    vector<int> v_n;
+    int n_max = m_scale == Scale::SMALL ? 1000 : m_scale == Scale::MEDIUM ? 100000 : 1000000;
+    for(int n = 1000 ; n <= min(n_max, max_nb_slices) ; n *= 10)
+      v_n.push_back(n);
+    if(v_n.empty())
+      v_n.push_back(max_nb_slices);
+    return v_n;
+  }
+
+  const vector<int> Suite::dims(int max_dim) const
+  {
+    vector<int> v_dims;
+    int d_max = m_scale == Scale::SMALL ? 4 : m_scale == Scale::MEDIUM ? 8 : 16;
+    for(int d = 1 ; d <= min(d_max, max_dim) ; d *= 4)
+      v_dims.push_back(d);
+    if(v_dims.back() != min(d_max, max_dim))
+      v_dims.push_back(min(d_max, max_dim));
+    return v_dims;
+  }
+
+  bool Suite::too_large(int nb_slices, int dim) const
+  {
+    // The largest tube vectors are limited to 4.10^6 slices (about 1 GB)
+    return (double)nb_slices * dim > 4e6;
+  }
+
+  void Suite::add(const string& name, const Params& params, const function<double()>& f)
+  {
+    Benchmark b;
+    b.name = name;
+    b.params = params;
+    b.f = f;
+
+    if(id(b).find(m_filter) != string::npos)
+      m_v_benchmarks.push_back(b);
+  }
+
+  void Suite::list() const
+  {
+    for(const auto& b : m_v_benchmarks)
+      cout << id(b) << endl;
+  }
+
+  void Suite::run()
+  {
+    for(auto& b : m_v_benchmarks)
+    {
+      cout << setw(60) << left << id(b) << flush;
+
+      for(int i = 0 ; i < m_nb_runs ; i++)
+        b.v_times.push_back(b.f());
+
+      vector<double> v_sorted(b.v_times);
+      sort(v_sorted.begin(), v_sorted.end());
+      cout << v_sorted[v_sorted.size() / 2] << " ms" << endl;
+    }
+  }
+
+  void Suite::write_json(const string& file_name) const
+  {
+    ofstream file(file_name.c_str(), ios::out);
+
+    if(!file.is_open())
+      throw tubex::Exception("Suite::write_json()", "error while writing file \"" + file_name + "\"");
+
+    file << "{" << endl;
+    file << "  \"scale\": \"" << (m_scale == Scale::SMALL ? "small" : m_scale == Scale::MEDIUM ? "medium" : "large") << "\"," << endl;
+    file << "  \"nb_runs\": " << m_nb_runs << "," << endl;
+    file << "  \"benchmarks\": [" << endl;
+    file << setprecision(6) << fixed;
+
+    for(size_t i = 0 ; i < m_v_benchmarks.size() ; i++)
+    {
+      const Benchmark& b = m_v_benchmarks[i];
+      assert(!b.v_times.empty() && "the benchmarks have to be run beforehand");
+
+      vector<double> v_sorted(b.v_times);
+      sort(v_sorted.begin(), v_sorted.end());
+
+      file << "    { \"id\": \"" << id(b) << "\", \"name\": \"" << b.name << "\", \"params\": {";
+      for(auto it = b.params.begin() ; it != b.params.end() ; ++it)
+        file << (it == b.params.begin() ? " " : ", ") << "\"" << it->first << "\": " << it->second;
+      file << " }, \"median_ms\": " << v_sorted[v_sorted.size() / 2]
+           << ", \"min_ms\": " << v_sorted.front()
+           << ", \"max_ms\": " << v_sorted.back()
+           << " }" << (i + 1 < m_v_benchmarks.size() ? "," : "") << endl;
+    }
+
+    file << "  ]" << endl;
+    file << "}" << endl;
+    file.close();
+  }
+
+  const string Suite::id(const Benchmark& b)
+  {
+    string id = b.name;
+    for(auto it = b.params.begin() ; it != b.params.end() ; ++it)
+      id += (it == b.params.begin() ? "[" : ",") + it->first + "=" + to_string(it->second);
+    return id + (b.params.empty() ? "" : "]");
+  }
+}
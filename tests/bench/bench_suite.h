@@ -0,0 +1,97 @@
+/**
+ *  Benchmark suite of the library (tubex-bench)
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_BENCH_SUITE_H__
+#define __TUBEX_BENCH_SUITE_H__
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace bench
+{
+  /**
+   * \enum Scale
+   * \brief Range of the problem sizes
+   */
+  enum class Scale
+  {
+    SMALL,  ///< quick runs, for continuous integration (10^3 slices, 4 dimensions)
+    MEDIUM, ///< up to 10^5 slices and 8 dimensions
+    LARGE   ///< reference sizes: up to 10^6 slices and 16 dimensions
+  };
+
+  typedef std::map<std::string,int> Params;
+
+  /**
+   * \brief Measures the execution time of f, in milliseconds
+   */
+  template<typename F>
+  double time_ms(const F& f)
+  {
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - t0).count();
+  }
+
+  /**
+   * \class Suite
+   * \brief Set of parameterized benchmarks, with a JSON report of the timings
+   *
+   * A benchmark is a function that prepares its data and returns the time
+   * (in ms) of the measured part only. It is run several times, the median
+   * time being the reference value for comparisons between releases.
+   */
+  class Suite
+  {
+    public:
+
+      Suite(Scale scale, int nb_runs, const std::string& filter = "");
+
+      Scale scale() const;
+
+      // Problem sizes of the current scale
+      const std::vector<int> nb_slices(int max_nb_slices = 1000000) const;
+      const std::vector<int> dims(int max_dim = 16) const;
+      bool too_large(int nb_slices, int dim) const;
+
+      void add(const std::string& name, const Params& params, const std::function<double()>& f);
+      void list() const;
+      void run();
+      void write_json(const std::string& file_name) const;
+
+    protected:
+
+      struct Benchmark
+      {
+        std::string name;
+        Params params;
+        std::function<double()> f;
+        std::vector<double> v_times;
+      };
+
+      static const std::string id(const Benchmark& b);
+
+      Scale m_scale;
+      int m_nb_runs;
+      std::string m_filter;
+      std::vector<Benchmark> m_v_benchmarks;
+  };
+
+  void add_tubes_benchmarks(Suite& suite);
+  void add_contractors_benchmarks(Suite& suite);
+  void add_cn_benchmarks(Suite& suite);
+  void add_paving_benchmarks(Suite& suite);
+  void add_ode_benchmarks(Suite& suite);
+}
+
+#endif
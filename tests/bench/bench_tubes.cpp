@@ -0,0 +1,172 @@
+/**
+ *  Benchmarks: tubes structure, evaluations, inversions and serialization
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstdio>
+#include <random>
+#include "bench_suite.h"
+#include "tubex_Tube.h"
+#include "tubex_TubeVector.h"
+#include "tubex_TFunction.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+namespace bench
+{
+  // Function of dimension dim: (x1*x0+sin(t) ; x2*x1+sin(t) ; ... )
+  const TFunction vector_function(int dim)
+  {
+    vector<string> v_names(dim);
+    vector<const char*> v_x(dim);
+    string y = dim > 1 ? "(" : "";
+
+    for(int i = 0 ; i < dim ; i++)
+    {
+      v_names[i] = "x" + to_string(i);
+      v_x[i] = v_names[i].c_str();
+      y += (i == 0 ? "" : " ; ") + string("x") + to_string((i+1)%dim) + "*x" + to_string(i) + "+sin(t)";
+    }
+
+    y += dim > 1 ? ")" : "";
+    return TFunction(dim, v_x.data(), y.c_str());
+  }
+
+  void add_tubes_benchmarks(Suite& suite)
+  {
+    const Interval tdomain(0.,10.);
+    const int nb_queries = 100000;
+
+    for(int n : suite.nb_slices())
+    {
+      double dt = tdomain.diam() / n;
+
+      suite.add("tube/construction", { {"slices",n} }, [=]()
+      {
+        return time_ms([&]() { Tube x(tdomain, dt, Interval(-1.,1.)); });
+      });
+
+      suite.add("tube/construction_tfunction", { {"slices",n} }, [=]()
+      {
+        TFunction f("cos(t)+[-0.1,0.1]");
+        return time_ms([&]() { Tube x(tdomain, dt, f); });
+      });
+
+      for(int tree = 0 ; tree < 2 ; tree++)
+      {
+        suite.add("tube/slice_by_index", { {"slices",n}, {"tree",tree} }, [=]()
+        {
+          Tube x(tdomain, dt);
+          if(tree) x.enable_synthesis();
+          mt19937 gen(0);
+          uniform_int_distribution<int> k(0, n-1);
+          double sum = 0.;
+          double t = time_ms([&]() {
+            for(int i = 0 ; i < nb_queries ; i++)
+              sum += x.slice(k(gen))->tdomain().lb();
+          });
+          return t + 0. * sum;
+        });
+
+        suite.add("tube/slice_by_time", { {"slices",n}, {"tree",tree} }, [=]()
+        {
+          Tube x(tdomain, dt);
+          if(tree) x.enable_synthesis();
+          mt19937 gen(0);
+          uniform_real_distribution<double> t_(tdomain.lb(), tdomain.ub());
+          double sum = 0.;
+          double t = time_ms([&]() {
+            for(int i = 0 ; i < nb_queries ; i++)
+              sum += x.slice(t_(gen))->tdomain().lb();
+          });
+          return t + 0. * sum;
+        });
+
+        suite.add("tube/eval_interval", { {"slices",n}, {"tree",tree} }, [=]()
+        {
+          Tube x(tdomain, dt, TFunction("cos(t)+[-0.1,0.1]"));
+          if(tree) x.enable_synthesis();
+          mt19937 gen(0);
+          uniform_real_distribution<double> t_(tdomain.lb(), tdomain.ub() - 1.);
+          Interval y;
+          return time_ms([&]() {
+            for(int i = 0 ; i < nb_queries / 100 ; i++)
+            {
+              double t0 = t_(gen);
+              y |= x(Interval(t0, t0 + 1.));
+            }
+          });
+        });
+      }
+
+      // Inversions of 200 codomains, the former path building a
+      // derivative tube [-oo,oo] for each inversion
+      for(int path = 0 ; path < 5 ; path++)
+      {
+        const char* v_names[] = { "former", "derivative_free", "batch", "components", "components_tree" };
+        suite.add(string("tube/invert_") + v_names[path], { {"slices",n} }, [=]()
+        {
+          Tube x(tdomain, dt, TFunction("cos(t)+0.1*sin(10*t)+[-0.05,0.05]"));
+          if(path == 4) x.enable_synthesis();
+          Interval search(1.,9.);
+          vector<Interval> v_y, v_t;
+          for(int i = 0 ; i < 200 ; i++)
+            v_y.push_back(Interval(-1. + i / 100., -1. + i / 100. + 0.01));
+
+          return time_ms([&]() {
+            if(path == 2)
+              x.invert(v_y, v_t, search);
+
+            else
+              for(const auto& y : v_y)
+              {
+                if(path == 0) v_t.push_back(x.invert(y, Tube(x, Interval::ALL_REALS), search));
+                else if(path == 1) v_t.push_back(x.invert(y, search));
+                else x.invert(y, v_t, search);
+              }
+          });
+        });
+      }
+
+      for(int d : suite.dims())
+      {
+        if(suite.too_large(n, d))
+          continue;
+
+        suite.add("tube/copy", { {"slices",n}, {"dim",d} }, [=]()
+        {
+          TubeVector x(tdomain, dt, d);
+          return time_ms([&]() { TubeVector y(x); });
+        });
+
+        suite.add("tfunction/eval_vector", { {"slices",n}, {"dim",d} }, [=]()
+        {
+          TubeVector x(tdomain, dt, d);
+          x.set(IntervalVector(d, Interval(-1.,1.)));
+          TFunction f = vector_function(d);
+          return time_ms([&]() { TubeVector y = f.eval_vector(x); });
+        });
+
+        suite.add("tube/serialization", { {"slices",n}, {"dim",d} }, [=]()
+        {
+          TubeVector x(tdomain, dt, d);
+          x.set(IntervalVector(d, Interval(-1.,1.)));
+          string file_name = "tubex-bench_" + to_string(n) + "_" + to_string(d) + ".tube";
+          double t = time_ms([&]() {
+            x.serialize(file_name);
+            TubeVector y(file_name);
+          });
+          remove(file_name.c_str());
+          return t;
+        });
+      }
+    }
+  }
+}
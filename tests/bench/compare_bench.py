@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+# ==================================================================
+#  tubex-lib / benchmarks - comparison of two tubex-bench reports
+# ==================================================================
+#
+#  Usage: compare_bench.py baseline.json current.json [--threshold 0.10]
+#
+#  Benchmarks are matched by id. A benchmark is flagged as a regression
+#  when its median time exceeds the baseline by more than the threshold
+#  (relative). The exit status is 1 if at least one regression is found.
+
+import argparse
+import json
+import sys
+
+
+def load(file_name):
+  with open(file_name) as f:
+    report = json.load(f)
+  return {b["id"]: b for b in report["benchmarks"]}
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Compares two tubex-bench reports")
+  parser.add_argument("baseline", help="reference JSON report")
+  parser.add_argument("current", help="new JSON report")
+  parser.add_argument("--threshold", type=float, default=0.10,
+                      help="relative slowdown considered as a regression (default: 0.10)")
+  parser.add_argument("--min-ms", type=float, default=0.5,
+                      help="timings below this value are not compared (default: 0.5 ms)")
+  args = parser.parse_args()
+
+  baseline, current = load(args.baseline), load(args.current)
+  nb_regressions = 0
+
+  print("%-60s %12s %12s %8s" % ("benchmark", "baseline", "current", "ratio"))
+
+  for id in sorted(set(baseline) & set(current)):
+    t0, t1 = baseline[id]["median_ms"], current[id]["median_ms"]
+    ratio = t1 / t0 if t0 > 0. else float("inf")
+    flag = ""
+
+    if max(t0, t1) >= args.min_ms:
+      if ratio > 1. + args.threshold:
+        flag = "  REGRESSION"
+        nb_regressions += 1
+      elif ratio < 1. / (1. + args.threshold):
+        flag = "  improvement"
+
+    print("%-60s %10.3fms %10.3fms %8.2f%s" % (id, t0, t1, ratio, flag))
+
+  for id in sorted(set(baseline) - set(current)):
+    print("%-60s missing in the current report" % id)
+  for id in sorted(set(current) - set(baseline)):
+    print("%-60s new benchmark" % id)
+
+  print("\n%d regression(s) (threshold: %.0f%%)" % (nb_regressions, 100. * args.threshold))
+  return 1 if nb_regressions > 0 else 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
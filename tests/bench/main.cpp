@@ -0,0 +1,78 @@
+/**
+ *  Benchmark suite of the library (tubex-bench)
+ * ----------------------------------------------------------------------------
+ *  \brief      Runs the benchmarks and writes the timings in a JSON file,
+ *              to be compared between releases with compare_bench.py
+ *
+ *              Usage: tubex-bench [--scale small|medium|large] [--runs N]
+ *                                 [--filter substring] [--out file.json] [--list]
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include "bench_suite.h"
+
+using namespace std;
+using namespace bench;
+
+int main(int argc, char** argv)
+{
+  Scale scale = Scale::SMALL;
+  int nb_runs = 5;
+  string filter, out = "tubex-bench.json";
+  bool list_only = false;
+
+  for(int i = 1 ; i < argc ; i++)
+  {
+    if(!strcmp(argv[i], "--scale") && i + 1 < argc)
+    {
+      string s = argv[++i];
+      scale = s == "large" ? Scale::LARGE : s == "medium" ? Scale::MEDIUM : Scale::SMALL;
+    }
+
+    else if(!strcmp(argv[i], "--runs") && i + 1 < argc)
+      nb_runs = max(1, atoi(argv[++i]));
+
+    else if(!strcmp(argv[i], "--filter") && i + 1 < argc)
+      filter = argv[++i];
+
+    else if(!strcmp(argv[i], "--out") && i + 1 < argc)
+      out = argv[++i];
+
+    else if(!strcmp(argv[i], "--list"))
+      list_only = true;
+
+    else
+    {
+      cout << "Usage: " << argv[0] << " [--scale small|medium|large] [--runs N]"
+           << " [--filter substring] [--out file.json] [--list]" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  Suite suite(scale, nb_runs, filter);
+  add_tubes_benchmarks(suite);
+  add_contractors_benchmarks(suite);
+  add_cn_benchmarks(suite);
+  add_paving_benchmarks(suite);
+  add_ode_benchmarks(suite);
+
+  if(list_only)
+    suite.list();
+
+  else
+  {
+    suite.run();
+    suite.write_json(out);
+    cout << "Results written in " << out << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
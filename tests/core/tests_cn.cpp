@@ -4,6 +4,8 @@
 #include "tubex_CtcEval.h"
 #include "tubex_CtcFunction.h"
 #include "vibes.h"
+#include <cstdio>
+#include <fstream>
 
 using namespace Catch;
 using namespace Detail;
@@ -419,6 +421,278 @@ TEST_CASE("CN simple")
     CHECK(v(4) == Interval(-3.,-1.));
   }
 
+  SECTION("Growing tubes")
+  {
+    Tube x(Interval(0.,1.), 0.5), v(x, Interval(1.));
+    x.set(0., 0.);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn;
+    cn.add(ctc_deriv, {x, v});
+    cn.contract();
+
+    CHECK(x(1.) == Interval(1.));
+    CHECK(cn.nb_dom() == 6);
+
+    x.push_back_slice(0.5);
+    v.push_back_slice(0.5, Interval(1.));
+    cn.register_new_slices();
+    CHECK(cn.nb_dom() == 8);
+    CHECK(cn.nb_ctc_in_stack() > 0);
+
+    cn.contract();
+    CHECK(x(1.5) == Interval(1.5));
+    CHECK(x.last_slice()->codomain() == Interval(1.,1.5));
+
+    cn.drop_front_slices(1.);
+    CHECK(x.tdomain() == Interval(1.,1.5));
+    CHECK(v.tdomain() == Interval(1.,1.5));
+    CHECK(cn.nb_dom() == 4);
+    CHECK(cn.nb_ctc() == 3); // tubes/slices components, and one CtcDeriv
+
+    x.push_back_slice(0.5);
+    v.push_back_slice(0.5, Interval(1.));
+    cn.register_new_slices();
+    cn.contract();
+    CHECK(x(2.) == Interval(2.));
+  }
+
+  SECTION("Adaptive slicing")
+  {
+    Tube x(Interval(0.,2.), 2.), v(x, Interval(-1.,1.));
+    x.set(0., 0.);
+    x.set(0., 2.);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn;
+    cn.add(ctc_deriv, {x, v});
+    cn.contract();
+
+    CHECK(x.codomain() == Interval(-1.,1.));
+    CHECK(cn.nb_dom() == 4);
+    CHECK(cn.nb_ctc() == 3);
+
+    SlicingController ctrl(4, 0.5);
+    CHECK(cn.adapt_slicing(ctrl) == 1);
+    CHECK(x.nb_slices() == 2);
+    CHECK(Tube::same_slicing(x, v));
+    CHECK(cn.nb_dom() == 6);
+    CHECK(cn.nb_ctc() == 6); // tubes/slices components, and one CtcDeriv per row of slices
+    CHECK(cn.nb_ctc_in_stack() > 0);
+
+    cn.contract();
+    CHECK(x(1.) == Interval(-1.,1.));
+    CHECK(x(0.) == Interval(0.));
+    CHECK(x(2.) == Interval(0.));
+
+    // Nearly identical slices are merged back
+    CHECK(cn.adapt_slicing(ctrl) == 1);
+    CHECK(x.nb_slices() == 1);
+    CHECK(v.nb_slices() == 1);
+    CHECK(cn.nb_dom() == 4);
+    CHECK(cn.nb_ctc() == 3);
+
+    cn.contract();
+    CHECK(x.codomain() == Interval(-1.,1.));
+    CHECK(x(2.) == Interval(0.));
+  }
+
+  SECTION("Incremental contraction")
+  {
+    Interval tdomain(0.,10.);
+    double dt = 0.5;
+    CtcEval ctc_eval;
+
+    // Observations added one by one, each one followed by a contraction
+    Tube x1(tdomain, dt, Interval(-20.,20.)), v1(tdomain, dt, Interval(-0.5,1.));
+    Interval t1_a(2.), z1_a(1.,1.5), t1_b(7.), z1_b(3.,3.25);
+
+    ContractorNetwork cn1;
+    cn1.set_fixedpoint_ratio(0.);
+    cn1.add(ctc_eval, {t1_a, z1_a, x1, v1});
+    cn1.contract();
+    CHECK(cn1.nb_ctc_in_stack() == 0);
+    int nb_ctc = cn1.nb_ctc();
+
+    cn1.add(ctc_eval, {t1_b, z1_b, x1, v1});
+    CHECK(cn1.nb_ctc() == nb_ctc + 1);
+    CHECK(cn1.nb_ctc_in_stack() == 1); // the new observation is the only seed
+    cn1.contract();
+
+    // Same observations, contracted from scratch
+    Tube x2(tdomain, dt, Interval(-20.,20.)), v2(tdomain, dt, Interval(-0.5,1.));
+    Interval t2_a(2.), z2_a(1.,1.5), t2_b(7.), z2_b(3.,3.25);
+
+    ContractorNetwork cn2;
+    cn2.set_fixedpoint_ratio(0.);
+    cn2.add(ctc_eval, {t2_a, z2_a, x2, v2});
+    cn2.add(ctc_eval, {t2_b, z2_b, x2, v2});
+    cn2.contract();
+
+    CHECK(x1 == x2);
+    CHECK(z1_a == z2_a);
+    CHECK(z1_b == z2_b);
+    CHECK(x1(7.) == Interval(3.,3.25));
+    CHECK(x1(2.).is_subset(Interval(1.,1.5)));
+
+    // External update of a domain
+    x1.set(Interval(3.,3.1), 7.);
+    x2.set(Interval(3.,3.1), 7.);
+    cn1.trigger_contractors(x1);
+    CHECK(cn1.nb_ctc_in_stack() < cn1.nb_ctc());
+    cn1.contract();
+    cn2.trigger_all_contractors();
+    cn2.contract();
+    CHECK(x1 == x2);
+
+    Tube x3(tdomain, dt);
+    CHECK_THROWS(cn1.trigger_contractors(x3));
+  }
+
+  SECTION("Scheduling policies")
+  {
+    Interval tdomain(0.,10.);
+    CtcEval ctc_eval;
+    CtcFunction ctc_f(Function("x", "v", "v-0.1*x"));
+    vector<Tube> v_x;
+
+    for(Scheduling policy : { Scheduling::STACK, Scheduling::YIELD_PER_COST, Scheduling::DOMAIN_WEIGHT })
+    {
+      Tube x(tdomain, 0.5, Interval(-20.,20.)), v(tdomain, 0.5, Interval(-1.,1.));
+      Interval t_a(2.), z_a(1.,1.5), t_b(7.), z_b(3.,3.25);
+
+      ContractorNetwork cn;
+      cn.set_fixedpoint_ratio(0.);
+      cn.set_scheduling(policy);
+      cn.add(ctc_f, {x, v});
+      cn.add(ctc_eval, {t_a, z_a, x, v});
+      cn.add(ctc_eval, {t_b, z_b, x, v});
+      cn.contract();
+
+      CHECK(cn.nb_ctc_in_stack() == 0);
+      v_x.push_back(x);
+    }
+
+    // Same fixed point, whatever the order of the contractions
+    CHECK(v_x[1] == v_x[0]);
+    CHECK(v_x[2] == v_x[0]);
+    CHECK(v_x[0](7.) == Interval(3.,3.25));
+
+    // Contractor triggered only on significant contractions of its domains
+    Tube x(tdomain, 0.5, Interval(-20.,20.)), v(tdomain, 0.5, Interval(-1.,1.));
+    ContractorNetwork cn;
+    cn.add(ctc_f, {x, v});
+    cn.contract();
+    cn.set_fixedpoint_ratio(ctc_f, 0.9);
+
+    x.set(Interval(1.,1.5), 2.);
+    cn.trigger_contractors(x);
+    cn.contract();
+    CHECK(v(2.) == Interval(-1.,1.)); // the slices of x have not been contracted enough
+
+    cn.set_fixedpoint_ratio(ctc_f, 0.);
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(v(2.).is_subset(Interval(0.09,0.16)));
+  }
+
+  SECTION("Contraction by time windows")
+  {
+    Interval tdomain(0.,20.);
+    CtcDeriv ctc_deriv;
+    CtcEval ctc_eval;
+    vector<Tube> v_x;
+
+    for(int nb_windows : { 1, 4, 7 })
+      for(int nb_threads : { 1, 0 })
+      {
+        Tube x(tdomain, 0.05), v(tdomain, 0.05, TFunction("cos(t)+[-0.05,0.05]"));
+        vector<Interval> v_t, v_z;
+        for(int i = 0 ; i < 20 ; i++)
+        {
+          v_t.push_back(Interval(0.5 + i));
+          v_z.push_back(sin(Interval(0.5 + i)) + Interval(-0.2,0.2));
+        }
+
+        ContractorNetwork cn;
+        cn.set_fixedpoint_ratio(0.);
+        cn.set_time_windows(nb_windows);
+        cn.set_nb_threads(nb_threads);
+        cn.add(ctc_deriv, {x, v});
+        for(size_t i = 0 ; i < v_t.size() ; i++)
+          cn.add(ctc_eval, {v_t[i], v_z[i], x, v});
+        cn.contract();
+
+        CHECK(cn.nb_ctc_in_stack() == 0);
+        v_x.push_back(x);
+      }
+
+    // Same fixed point as the monolithic contraction
+    for(size_t i = 1 ; i < v_x.size() ; i++)
+      CHECK(v_x[i] == v_x[0]);
+    CHECK(v_x[0](10.5).is_subset(sin(Interval(10.5)) + Interval(-0.2,0.2)));
+  }
+
+  SECTION("Checkpoints")
+  {
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_f(Function("a", "b", "a-b"));
+
+    Tube x1(Interval(0.,2.), 0.5), v1(x1, Interval(1.));
+    Interval a1(-10.,10.), b1(1.,2.);
+    x1.set(0., 0.);
+
+    ContractorNetwork cn1;
+    cn1.add(ctc_deriv, {x1, v1});
+    cn1.add(ctc_f, {a1, b1});
+    int nb_ctc_in_stack = cn1.nb_ctc_in_stack();
+    cn1.save_checkpoint("cn_checkpoint.bin");
+
+    // Restored into a network of the same shape, before any contraction
+    Tube x2(Interval(0.,2.), 0.5), v2(x2, Interval(1.));
+    Interval a2(-10.,10.), b2(1.,2.);
+
+    ContractorNetwork cn2;
+    cn2.add(ctc_deriv, {x2, v2});
+    cn2.add(ctc_f, {a2, b2});
+    cn2.contract();
+    CHECK(cn2.nb_ctc_in_stack() == 0);
+
+    cn2.restore_checkpoint("cn_checkpoint.bin");
+    CHECK(x2 == x1);
+    CHECK(cn2.nb_ctc_in_stack() == nb_ctc_in_stack);
+
+    cn1.contract();
+    cn2.contract();
+    CHECK(x2 == x1);
+    CHECK(x2(2.) == Interval(2.));
+    CHECK(a2 == a1);
+    CHECK(a2 == Interval(1.,2.));
+
+    // Networks of another shape
+    Tube x3(Interval(0.,2.), 1.), v3(x3, Interval(1.));
+    ContractorNetwork cn3;
+    cn3.add(ctc_deriv, {x3, v3});
+    CHECK_THROWS(cn3.restore_checkpoint("cn_checkpoint.bin"));
+
+    // Truncated file: the network is left unchanged
+    {
+      ifstream file("cn_checkpoint.bin", ios::binary);
+      string content((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+      ofstream truncated_file("cn_checkpoint_truncated.bin", ios::binary);
+      truncated_file.write(content.data(), content.size() - 3);
+    }
+
+    Tube x2_copy(x2);
+    Interval a2_copy(a2);
+    CHECK_THROWS(cn2.restore_checkpoint("cn_checkpoint_truncated.bin"));
+    CHECK(x2 == x2_copy);
+    CHECK(a2 == a2_copy);
+
+    remove("cn_checkpoint.bin");
+    remove("cn_checkpoint_truncated.bin");
+  }
+
   SECTION("create_dom Tube")
   {
     double dt = 0.1;
@@ -0,0 +1,130 @@
+#include <thread>
+#include "catch_interval.hpp"
+#include "tubex_Tube.h"
+#include "tubex_TFunction.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+// These tests are meant to be run with the thread sanitizer
+// (CMake option WITH_TSAN), that reports any data race
+
+#define NB_QUERIES 400
+#define NB_THREADS 4
+
+Tube make_tube()
+{
+  return Tube(Interval(0.,10.), 0.01, TFunction("sin(t)+[-0.1,0.1]"));
+}
+
+vector<Interval> queries(const Tube& x, int i)
+{
+  Interval t = Interval(0.,0.5) + 9.5 * (i % 97) / 97.;
+
+  vector<Interval> v;
+  v.push_back(x(t));
+  v.push_back(x(t.mid()));
+  v.push_back(x.invert(Interval(0.5,0.6), t));
+  v.push_back(x.integral(t));
+  v.push_back(x.integral(t.lb(), t.ub()));
+  v.push_back(x.codomain());
+  v.push_back(Interval(x.nb_slices()));
+  v.push_back(x.last_slice()->codomain());
+  return v;
+}
+
+vector<vector<Interval> > sequential_queries(const Tube& x)
+{
+  vector<vector<Interval> > v_results(NB_QUERIES);
+  for(int i = 0 ; i < NB_QUERIES ; i++)
+    v_results[i] = queries(x, i);
+  return v_results;
+}
+
+vector<vector<Interval> > concurrent_queries(const Tube& x)
+{
+  vector<vector<Interval> > v_results(NB_QUERIES);
+  vector<thread> v_threads;
+
+  for(int k = 0 ; k < NB_THREADS ; k++)
+    v_threads.push_back(thread([&x,&v_results,k]()
+    {
+      for(int i = k ; i < NB_QUERIES ; i += NB_THREADS)
+        v_results[i] = queries(x, i);
+    }));
+
+  for(auto& th : v_threads)
+    th.join();
+  return v_results;
+}
+
+TEST_CASE("Concurrent queries on tubes")
+{
+  SECTION("Lazy updates, without synthesis tree")
+  {
+    Tube x1 = make_tube(), x2 = make_tube();
+    CHECK(!x1.is_frozen());
+    CHECK(concurrent_queries(x1) == sequential_queries(x2));
+  }
+
+  SECTION("Lazy updates, with synthesis tree")
+  {
+    Tube x1 = make_tube(), x2 = make_tube();
+    x1.enable_synthesis();
+    x2.enable_synthesis();
+    CHECK(!x1.is_frozen());
+    CHECK(concurrent_queries(x1) == sequential_queries(x2));
+  }
+
+  SECTION("Updates after modifications")
+  {
+    Tube x1 = make_tube(), x2 = make_tube();
+    x1.enable_synthesis();
+    x2.enable_synthesis();
+    concurrent_queries(x1);
+
+    x1.set(Interval(-0.2,0.3), Interval(4.,5.));
+    x2.set(Interval(-0.2,0.3), Interval(4.,5.));
+    CHECK(concurrent_queries(x1) == sequential_queries(x2));
+  }
+
+  SECTION("Frozen tubes")
+  {
+    Tube x1 = make_tube(), x2 = make_tube();
+    x1.freeze();
+    CHECK(x1.is_frozen());
+    CHECK(concurrent_queries(x1) == sequential_queries(x2));
+    CHECK(x1.is_frozen());
+
+    x1.enable_synthesis();
+    x2.enable_synthesis();
+    x1.freeze();
+    CHECK(x1.is_frozen());
+    CHECK(concurrent_queries(x1) == sequential_queries(x2));
+
+    x1.set(Interval(0.), 5.);
+    CHECK(!x1.is_frozen()); // the modification requires new updates
+  }
+
+  SECTION("Synthesis tree enabled during queries")
+  {
+    Tube x1 = make_tube(), x2 = make_tube();
+    vector<vector<Interval> > v_results;
+
+    thread th([&x1,&v_results]() { v_results = concurrent_queries(x1); });
+    x1.enable_synthesis();
+    th.join();
+
+    // Evaluations over slices do not depend on the tree
+    vector<vector<Interval> > v_ref = sequential_queries(x2);
+    for(int i = 0 ; i < NB_QUERIES ; i++)
+    {
+      CHECK(v_results[i][1] == v_ref[i][1]);
+      CHECK(v_results[i][6] == v_ref[i][6]);
+      CHECK(v_results[i][7] == v_ref[i][7]);
+    }
+  }
+}
@@ -0,0 +1,171 @@
+#include "catch_interval.hpp"
+#include "tubex_CtcDynCidGuess.h"
+#include "tubex_TFunction.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+// Access to the trials of the corners strategy
+class CtcDynCidGuessTrials : public CtcDynCidGuess
+{
+  public:
+
+    CtcDynCidGuessTrials(const TFnc& f) : CtcDynCidGuess(f), m_f(f)
+    {
+
+    }
+
+    // Former enumeration: cartesian product of the bounds of the gates
+    void contract_cart_product(vector<Slice>& x_slice, vector<Slice>& v_slice)
+    {
+      vector<vector<double> > v_corners = {{}};
+      for(const auto& s : x_slice)
+      {
+        vector<vector<double> > r;
+        for(const auto& c : v_corners)
+          for(double b : { s.input_gate().lb(), s.input_gate().ub() })
+          {
+            r.push_back(c);
+            r.back().push_back(b);
+          }
+        v_corners = r;
+      }
+
+      int n = x_slice.size();
+      vector<Interval> hull_x(3*n, Interval::EMPTY_SET), hull_v(3*n, Interval::EMPTY_SET);
+
+      for(const auto& c : v_corners)
+      {
+        vector<Slice> aux_x(x_slice), aux_v(v_slice);
+        vector<bool> is_present(n, false);
+        for(int j = 0 ; j < n ; j++)
+          aux_x[j].set_input_gate(Interval(c[j]));
+
+        CtcDeriv ctc_deriv;
+        propagate_trial(m_f, ctc_deriv, aux_x, aux_v, is_present, 0, TimePropag::FORWARD);
+
+        for(int j = 0 ; j < n ; j++)
+        {
+          hull_x[j] |= aux_x[j].codomain(); hull_v[j] |= aux_v[j].codomain();
+          hull_x[n+j] |= aux_x[j].input_gate(); hull_v[n+j] |= aux_v[j].input_gate();
+          hull_x[2*n+j] |= aux_x[j].output_gate(); hull_v[2*n+j] |= aux_v[j].output_gate();
+        }
+      }
+
+      for(int j = 0 ; j < n ; j++)
+      {
+        x_slice[j].set_envelope(x_slice[j].codomain() & hull_x[j]); v_slice[j].set_envelope(v_slice[j].codomain() & hull_v[j]);
+        x_slice[j].set_input_gate(x_slice[j].input_gate() & hull_x[n+j]); v_slice[j].set_input_gate(v_slice[j].input_gate() & hull_v[n+j]);
+        x_slice[j].set_output_gate(x_slice[j].output_gate() & hull_x[2*n+j]); v_slice[j].set_output_gate(v_slice[j].output_gate() & hull_v[2*n+j]);
+      }
+    }
+
+    void sampled_corner(uint64_t k, vector<bool>& c)
+    {
+      corner(k, c, { 2, 3, 5, 7 });
+    }
+
+  protected:
+
+    const TFnc& m_f;
+};
+
+void init_slices(int n, vector<Slice>& x_slice, vector<Slice>& v_slice)
+{
+  x_slice.clear(); v_slice.clear();
+  for(int j = 0 ; j < n ; j++)
+  {
+    x_slice.push_back(Slice(Interval(0.,0.1), Interval(-10.,10.)));
+    x_slice.back().set_input_gate(Interval(0.9,1.1) + 0.1*j);
+    v_slice.push_back(Slice(Interval(0.,0.1), Interval(-20.,20.)));
+  }
+}
+
+void check_same_slices(const vector<Slice>& v_s1, const vector<Slice>& v_s2)
+{
+  REQUIRE(v_s1.size() == v_s2.size());
+  for(size_t j = 0 ; j < v_s1.size() ; j++)
+  {
+    CHECK(v_s1[j].codomain() == v_s2[j].codomain());
+    CHECK(v_s1[j].input_gate() == v_s2[j].input_gate());
+    CHECK(v_s1[j].output_gate() == v_s2[j].output_gate());
+  }
+}
+
+TEST_CASE("CtcDynCidGuess corners")
+{
+  TFunction f("x1", "x2", "x3", "(-x1+x2 ; -x2*x3 ; -x3+sin(x1))");
+  vector<Slice> x_slice, v_slice;
+
+  SECTION("Exhaustive enumeration, same corners as the cartesian product")
+  {
+    CtcDynCidGuessTrials ctc(f);
+    ctc.set_s_corn(1);
+    REQUIRE((1 << 3) <= ctc.get_max_corners());
+
+    init_slices(3, x_slice, v_slice);
+    vector<Slice> x_ref(x_slice), v_ref(v_slice);
+
+    ctc.FullPropagationEngine(x_slice, v_slice, TimePropag::FORWARD);
+    ctc.contract_cart_product(x_ref, v_ref);
+
+    CHECK(x_slice[0].output_gate().diam() < 20.); // contracted
+    check_same_slices(x_slice, x_ref);
+    check_same_slices(v_slice, v_ref);
+  }
+
+  SECTION("Reproducible sampled corners")
+  {
+    CtcDynCidGuessTrials ctc(f);
+    ctc.set_s_corn(1);
+    ctc.set_max_corners(4); // less than the 2^3 corners
+
+    for(int sampling : { 0, 1 })
+    {
+      ctc.set_corners_sampling(sampling);
+
+      vector<bool> c1(4), c2(4);
+      ctc.sampled_corner(0, c1);
+      CHECK(c1 == vector<bool>(4, false)); // lower corner
+      ctc.sampled_corner(1, c1);
+      CHECK(c1 == vector<bool>(4, true)); // upper corner
+
+      for(uint64_t k = 2 ; k < 100 ; k++)
+      {
+        ctc.sampled_corner(k, c1);
+        ctc.sampled_corner(k, c2);
+        CHECK(c1 == c2);
+      }
+
+      vector<Slice> x_slice2, v_slice2;
+      init_slices(3, x_slice, v_slice);
+      init_slices(3, x_slice2, v_slice2);
+      ctc.FullPropagationEngine(x_slice, v_slice, TimePropag::FORWARD);
+      ctc.FullPropagationEngine(x_slice2, v_slice2, TimePropag::FORWARD);
+      check_same_slices(x_slice, x_slice2);
+      check_same_slices(v_slice, v_slice2);
+    }
+  }
+
+  SECTION("1 thread vs 4 threads")
+  {
+    for(int max_corners : { 1024, 4 }) // exhaustive, sampled
+    {
+      CtcDynCidGuess ctc1(f), ctc4(f);
+      ctc1.set_s_corn(1); ctc4.set_s_corn(1);
+      ctc1.set_max_corners(max_corners); ctc4.set_max_corners(max_corners);
+      ctc4.set_nb_threads(4);
+
+      vector<Slice> x_slice4, v_slice4;
+      init_slices(3, x_slice, v_slice);
+      init_slices(3, x_slice4, v_slice4);
+      ctc1.FullPropagationEngine(x_slice, v_slice, TimePropag::FORWARD);
+      ctc4.FullPropagationEngine(x_slice4, v_slice4, TimePropag::FORWARD);
+      check_same_slices(x_slice, x_slice4);
+      check_same_slices(v_slice, v_slice4);
+    }
+  }
+}
@@ -0,0 +1,99 @@
+#include "catch_interval.hpp"
+#include "tubex_CtcLieSymmetry.h"
+#include "tubex_ReferenceTubeCache.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+TEST_CASE("CtcLieSymmetry")
+{
+  // Dynamics x' = cos(t), invariant by translation: x(t) = a(t) + x0,
+  // with the reference a(t) = sin(t), a(0) = 0
+
+  Interval tdomain(0.,10.);
+  TubeVector a(tdomain, 0.125, TFunction("sin(t)"));
+  Function phi("a", "x0", "a+x0");
+
+  SECTION("Transport of the reference tube")
+  {
+    CtcLieSymmetry ctc_lie(phi);
+    TubeVector x = ctc_lie.transport(a, IntervalVector(1, Interval(1.,2.)));
+
+    CHECK(TubeVector::same_slicing(x, a));
+    CHECK(x[0](0.) == ApproxIntv(Interval(1.,2.)));
+    CHECK(x[0](5.) == ApproxIntv(a[0](5.) + Interval(1.,2.)));
+    CHECK(x[0](Interval(2.,3.)) == ApproxIntv(a[0](Interval(2.,3.)) + Interval(1.,2.)));
+    CHECK(a[0](0.) == ApproxIntv(Interval(0.))); // the reference is not modified
+  }
+
+  SECTION("Contraction of the initial condition from an observation")
+  {
+    CtcLieSymmetry ctc_lie(phi);
+    TubeVector x(tdomain, 0.125, 1);
+    IntervalVector x0(1, Interval(-10.,10.));
+    x.set(IntervalVector(1, sin(Interval(5.)) + Interval(0.9,1.1)), 5.);
+
+    ctc_lie.contract(x, x0, a);
+    CHECK(x0[0].contains(1.));
+    CHECK(x0[0].is_subset(Interval(0.8,1.2)));
+
+    // The contraction of [x0] is propagated to the tube by a second pass
+    ctc_lie.contract(x, x0, a);
+    CHECK(x[0](8.).contains(sin(8.)+1.));
+    CHECK(x[0](8.).is_subset(a[0](8.) + Interval(0.8,1.2)));
+  }
+
+  SECTION("Inconsistent observation")
+  {
+    CtcLieSymmetry ctc_lie(phi);
+    TubeVector x(tdomain, 0.125, 1);
+    IntervalVector x0(1, Interval(0.,1.));
+    x.set(IntervalVector(1, Interval(5.,6.)), 5.);
+
+    ctc_lie.contract(x, x0, a);
+    CHECK(x0.is_empty());
+    CHECK(x.is_empty());
+  }
+
+  SECTION("Cache of reference tubes")
+  {
+    ReferenceTubeCache cache;
+    TFunction f("a", "cos(t)");
+    IntervalVector a0(1, Interval(0.));
+    int nb_integrations = 0;
+    auto integrate = [&]() { nb_integrations++; return TubeVector(tdomain, 0.125, TFunction("sin(t)")); };
+
+    CHECK(!cache.contains(f, a0, tdomain, 0.125, "exact"));
+    shared_ptr<const TubeVector> a1 = cache.reference(f, a0, tdomain, 0.125, "exact", integrate);
+    shared_ptr<const TubeVector> a2 = cache.reference(f, a0, tdomain, 0.125, "exact", integrate);
+    CHECK(nb_integrations == 1);
+    CHECK(a1 == a2);
+    CHECK(cache.contains(f, a0, tdomain, 0.125, "exact"));
+
+    cache.reference(f, a0, tdomain, 0.01, "exact", integrate); // other time grid
+    cache.reference(TFunction("a", "cos(2*t)"), a0, tdomain, 0.125, "exact", integrate); // other dynamics
+    cache.reference(f, a0, tdomain, 0.125, "taylor,order=20", integrate); // other integrator
+    CHECK(nb_integrations == 4);
+    CHECK(cache.size() == 4);
+
+    // Least recently used tubes are evicted, shared tubes remain valid
+    cache.reference(f, a0, tdomain, 0.125, "exact", integrate);
+    cache.set_max_size(2);
+    CHECK(cache.size() == 2);
+    CHECK(cache.contains(f, a0, tdomain, 0.125, "exact"));
+    CHECK(cache.contains(f, a0, tdomain, 0.125, "taylor,order=20"));
+    CHECK(!cache.contains(f, a0, tdomain, 0.01, "exact"));
+    cache.reference(f, a0, tdomain, 0.01, "exact", integrate);
+    CHECK(nb_integrations == 5);
+    CHECK(cache.size() == 2);
+    CHECK(!cache.contains(f, a0, tdomain, 0.125, "taylor,order=20"));
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(a1->tdomain() == tdomain);
+    CHECK(a1.use_count() == 2);
+  }
+}
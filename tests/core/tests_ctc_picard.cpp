@@ -209,4 +209,36 @@ TEST_CASE("CtcPicard")
       //vibes::endDrawing();
     }
   }
-}
\ No newline at end of file
+
+  SECTION("Test CtcPicard / TubeVector - preserved slicing, several slices")
+  {
+    Interval domain(0.,1.);
+    TubeVector x_preserve_sampling(domain, 0.01, 1);
+    x_preserve_sampling.set(IntervalVector(1, Interval(1.)), 0.);
+    TubeVector x_auto_sampling(x_preserve_sampling);
+    int nb_slices = x_preserve_sampling.nb_slices();
+
+    TFunction f("x", "-x");
+    CtcPicard ctc_picard_preserve(1.1);
+    ctc_picard_preserve.preserve_slicing(true);
+    CtcPicard ctc_picard_auto(1.1);
+    ctc_picard_auto.preserve_slicing(false);
+
+    ctc_picard_preserve.contract(f, x_preserve_sampling, TimePropag::FORWARD);
+    ctc_picard_auto.contract(f, x_auto_sampling, TimePropag::FORWARD);
+
+    CHECK(x_preserve_sampling.nb_slices() == nb_slices);
+    CHECK_FALSE(x_preserve_sampling.codomain().is_unbounded());
+    CHECK(x_preserve_sampling(1.).is_superset(Interval(exp(-1.))));
+    CHECK(x_auto_sampling.codomain() == x_preserve_sampling.codomain());
+    CHECK(x_auto_sampling(1.) == x_preserve_sampling(1.));
+
+    x_preserve_sampling.set(IntervalVector(1, Interval::ALL_REALS));
+    x_preserve_sampling.set(IntervalVector(1, Interval(exp(-1.))), 1.);
+    ctc_picard_preserve.contract(f, x_preserve_sampling, TimePropag::BACKWARD);
+
+    CHECK(x_preserve_sampling.nb_slices() == nb_slices);
+    CHECK_FALSE(x_preserve_sampling.codomain().is_unbounded());
+    CHECK(x_preserve_sampling(0.).is_superset(Interval(1.)));
+  }
+}
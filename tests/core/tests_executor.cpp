@@ -0,0 +1,274 @@
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include "catch_interval.hpp"
+#include "tubex_Executor.h"
+#include "tubex_Exception.h"
+#include "tubex_TFunction.h"
+#include "tubex_CtcFunction.h"
+#include "tubex_CtcStatic.h"
+#include "tubex_CtcDeriv.h"
+#include "tubex_perf.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+TEST_CASE("Executor")
+{
+  SECTION("Number of threads")
+  {
+    Executor::set_nb_threads(3);
+    CHECK(Executor::nb_threads() == 3);
+    CHECK(Executor::nb_threads(2) == 2);
+
+    {
+      Executor::ScopedNbThreads scope(5);
+      CHECK(Executor::nb_threads() == 5);
+      CHECK(Executor::nb_threads(2) == 2);
+
+      {
+        Executor::ScopedNbThreads scope_default(0); // keeps the current setting
+        CHECK(Executor::nb_threads() == 5);
+      }
+    }
+
+    CHECK(Executor::nb_threads() == 3);
+    Executor::set_nb_threads(0);
+    CHECK(Executor::nb_threads() >= 1);
+
+    CHECK(Executor::nb_lanes(10, 4) == 4);
+    CHECK(Executor::nb_lanes(10, 4, 5) == 2);
+    CHECK(Executor::nb_lanes(0, 4) == 1);
+  }
+
+  SECTION("Parallel for")
+  {
+    Executor executor(3);
+    CHECK(executor.nb_workers() == 3);
+
+    vector<int> v_count(1000, 0);
+    atomic<int> max_lane(0);
+
+    executor.parallel_for(0, v_count.size(),
+      [&](size_t i, int lane)
+      {
+        v_count[i]++;
+        if(lane > max_lane)
+          max_lane = lane;
+      }, 4, 10);
+
+    for(size_t i = 0 ; i < v_count.size() ; i++)
+      CHECK(v_count[i] == 1);
+    CHECK(max_lane < 4);
+  }
+
+  SECTION("Sequential fallback")
+  {
+    Executor executor(3);
+    thread::id caller = this_thread::get_id();
+    vector<size_t> v_order;
+    bool same_thread = true;
+
+    executor.parallel_for(0, 100,
+      [&](size_t i, int lane)
+      {
+        v_order.push_back(i);
+        same_thread &= (this_thread::get_id() == caller && lane == 0);
+      }, 1);
+
+    CHECK(same_thread);
+    CHECK(v_order.size() == 100);
+    for(size_t i = 0 ; i < v_order.size() ; i++)
+      CHECK(v_order[i] == i);
+  }
+
+  SECTION("Task groups")
+  {
+    Executor executor(2);
+    atomic<int> sum(0);
+
+    {
+      TaskGroup group(executor, 3);
+      for(int i = 1 ; i <= 100 ; i++)
+        group.run([&sum,i]() { sum += i; });
+      group.wait();
+      CHECK(sum == 5050);
+    }
+
+    // Nested parallel computations, run by the same pool
+    vector<int> v_count(800, 0);
+    TaskGroup group(executor, 3);
+    for(int k = 0 ; k < 8 ; k++)
+      group.run([&,k]()
+      {
+        executor.parallel_for(k*100, (k+1)*100, [&](size_t i, int) { v_count[i]++; }, 3, 10);
+      });
+    group.wait();
+
+    for(size_t i = 0 ; i < v_count.size() ; i++)
+      CHECK(v_count[i] == 1);
+  }
+
+  SECTION("Exceptions")
+  {
+    Executor executor(2);
+
+    TaskGroup group(executor, 3);
+    group.run([]() { throw tubex::Exception("test", "task"); });
+    group.run([]() { });
+    CHECK_THROWS(group.wait());
+
+    CHECK_THROWS(executor.parallel_for(0, 100,
+      [](size_t i, int) { if(i == 50) throw tubex::Exception("test", "index"); }, 3));
+  }
+}
+
+// Reference: propagation of a static contractor through the slices of two
+// tubes, row by row (envelope and input gate of a row, then the next one)
+
+static void contract_row_by_row(Ctc& ctc, Tube& x, Tube& y)
+{
+  Slice *sx = x.first_slice(), *sy = y.first_slice();
+  IntervalVector envelope(2), ingate(2);
+
+  while(sx != NULL)
+  {
+    envelope[0] = sx->codomain(); envelope[1] = sy->codomain();
+    ingate[0] = sx->input_gate(); ingate[1] = sy->input_gate();
+    ctc.contract(envelope);
+    ctc.contract(ingate);
+    sx->set_envelope(envelope[0]); sy->set_envelope(envelope[1]);
+    sx->set_input_gate(ingate[0]); sy->set_input_gate(ingate[1]);
+
+    if(sx->next_slice() == NULL)
+    {
+      IntervalVector outgate(2);
+      outgate[0] = sx->output_gate(); outgate[1] = sy->output_gate();
+      ctc.contract(outgate);
+      sx->set_output_gate(outgate[0]); sy->set_output_gate(outgate[1]);
+    }
+
+    sx = sx->next_slice(); sy = sy->next_slice();
+  }
+}
+
+TEST_CASE("Parallel contractors")
+{
+  SECTION("CtcFunction")
+  {
+    Interval tdomain(0.,10.);
+    TubeVector x1(tdomain, 0.01, TFunction("(sin(t)+[-0.1,0.1] ; cos(t)+[-0.2,0.2])"));
+    x1[0] |= Interval(-2.,2.);
+    TubeVector x2(x1), x3(x1);
+
+    CtcFunction ctc1(Function("x", "y", "sqr(x)+sqr(y)-1"));
+    ctc1.set_nb_threads(1);
+    ctc1.contract(x1);
+
+    CtcFunction ctc2(Function("x", "y", "sqr(x)+sqr(y)-1"));
+    ctc2.set_nb_threads(4);
+    ctc2.contract(x2);
+
+    CHECK(x1 == x2); // same result with several threads
+
+    Function f("x", "y", "sqr(x)+sqr(y)-1");
+    CtcFwdBwd ctc_ref(f);
+    contract_row_by_row(ctc_ref, x3[0], x3[1]);
+    CHECK(x1 == x3); // same result as a propagation through the slices
+    CHECK(x1.volume() < TubeVector(tdomain, 0.01, 2).volume());
+  }
+
+  SECTION("CtcStatic")
+  {
+    Interval tdomain(0.,10.);
+    Tube x1(tdomain, 0.01, TFunction("cos(t)+[-0.5,0.5]")), y1(x1);
+    y1 |= Interval(-3.,3.);
+    Tube x2(x1), y2(y1), x3(x1), y3(y1);
+
+    CtcFunction ctc_f(Function("x", "y", "y-2*x"));
+    CtcStatic ctc1(ctc_f), ctc2(ctc_f);
+    ctc1.set_nb_threads(1);
+    ctc1.contract(x1, y1);
+    ctc2.set_nb_threads(4);
+    ctc2.contract(x2, y2);
+
+    CHECK(x1 == x2);
+    CHECK(y1 == y2);
+
+    Function f("x", "y", "y-2*x");
+    CtcFwdBwd ctc_ref(f);
+    contract_row_by_row(ctc_ref, x3, y3);
+    CHECK(x1 == x3);
+    CHECK(y1 == y3);
+    CHECK(y1.codomain().is_subset(Interval(-3.,3.)));
+  }
+
+  SECTION("CtcDeriv and TFunction")
+  {
+    Interval tdomain(0.,10.);
+    TubeVector v(tdomain, 0.01, TFunction("(cos(t)+[-0.1,0.1] ; -sin(t)+[-0.1,0.1])"));
+    TubeVector x1(tdomain, 0.01, 2), x2(x1);
+    x1.set(IntervalVector(2, Interval(0.)), 0.);
+    x2.set(IntervalVector(2, Interval(0.)), 0.);
+
+    CtcDeriv ctc_deriv;
+    ctc_deriv.set_nb_threads(1);
+    ctc_deriv.contract(x1, v);
+    ctc_deriv.set_nb_threads(2);
+    ctc_deriv.contract(x2, v);
+    CHECK(x1 == x2);
+
+    TFunction f("x", "y", "(x+y ; x*y ; sin(x))");
+    auto eval = [&](int nb_threads)
+    {
+      Executor::ScopedNbThreads scope(nb_threads);
+      return f.eval_vector(x1);
+    };
+
+    TubeVector y1 = eval(1), y2 = eval(4);
+
+    CHECK(y1.size() == 3);
+    CHECK(y1 == y2);
+  }
+}
+
+TEST_CASE("Performance counters")
+{
+  SECTION("Counts")
+  {
+    perf::reset();
+    perf::Snapshot s0 = perf::snapshot();
+    CHECK(s0.nb_allocations(perf::Alloc::SLICE) == 0);
+    CHECK(s0.nb_calls(perf::Kernel::CTC_DERIV_SLICE) == 0);
+
+    Tube x(Interval(0.,1.), 0.1, Interval(-1.,1.));
+    Tube v(x, Interval(-0.5,0.5));
+    x.set(Interval(0.), 0.);
+
+    CtcDeriv ctc_deriv;
+    ctc_deriv.contract(x, v);
+
+    perf::Snapshot s = perf::snapshot() - s0;
+
+    if(perf::enabled())
+    {
+      CHECK(s.nb_allocations(perf::Alloc::SLICE) >= 20);
+      CHECK(s.nb_allocations(perf::Alloc::GATE) >= 40);
+      CHECK(s.nb_calls(perf::Kernel::CTC_DERIV_SLICE) >= 10);
+      CHECK(s.duration(perf::Kernel::CTC_DERIV_SLICE) >= 0.);
+    }
+
+    else
+    {
+      CHECK(s.nb_allocations(perf::Alloc::SLICE) == 0);
+      CHECK(s.nb_calls(perf::Kernel::CTC_DERIV_SLICE) == 0);
+    }
+
+    ostringstream os;
+    os << s;
+    CHECK(os.str().find("CtcDeriv") != string::npos);
+  }
+}
@@ -813,4 +813,95 @@ TEST_CASE("Computing partial integration, two interval bounds", "[core]")
 
     if(TEST_COMPUTATION_TIMES) CHECK(COEFF_COMPUTATION_TIME*t[0] < t[1]);
   }
+}
+
+// Former evaluation of the partial integral, slice by slice,
+// used as a reference independent of the synthesis tree and of the prefix sums
+pair<Interval,Interval> slice_by_slice_partial_integral(const Tube& tube, const Interval& t)
+{
+  Interval intv_t;
+  const Slice *slice = tube.first_slice();
+  pair<Interval,Interval> p_integ
+    = make_pair(0., 0.), p_integ_uncertain(p_integ);
+
+  while(slice != NULL && slice->tdomain().lb() < t.ub())
+  {
+    if(slice->codomain().is_empty())
+      return make_pair(Interval::EMPTY_SET, Interval::EMPTY_SET);
+
+    if(slice->codomain().is_unbounded())
+      return make_pair(Interval::ALL_REALS, Interval::ALL_REALS);
+
+    // From t0 to tlb
+
+      intv_t = slice->tdomain() & Interval(tube.tdomain().lb(), t.lb());
+      if(!intv_t.is_empty())
+      {
+        p_integ.first += intv_t.diam() * slice->codomain().lb();
+        p_integ.second += intv_t.diam() * slice->codomain().ub();
+        p_integ_uncertain = p_integ;
+
+        if(intv_t.ub() == t.ub())
+          return p_integ; // end of the integral evaluation
+      }
+
+    // From tlb to tub
+
+      intv_t = slice->tdomain() & t;
+      if(!intv_t.is_empty())
+      {
+        pair<Interval,Interval> p_integ_temp(p_integ_uncertain);
+        p_integ_uncertain.first += Interval(0., intv_t.diam()) * slice->codomain().lb();
+        p_integ_uncertain.second += Interval(0., intv_t.diam()) * slice->codomain().ub();
+
+        p_integ.first |= p_integ_uncertain.first;
+        p_integ.second |= p_integ_uncertain.second;
+
+        p_integ_uncertain.first = p_integ_temp.first + intv_t.diam() * slice->codomain().lb();
+        p_integ_uncertain.second = p_integ_temp.second + intv_t.diam() * slice->codomain().ub();
+      }
+
+    slice = slice->next_slice();
+  }
+
+  return p_integ;
+}
+
+void check_partial_integral(const Tube& tube, const Interval& t)
+{
+  pair<Interval,Interval> p_integ = tube.partial_integral(t);
+  pair<Interval,Interval> p_integ_ref = slice_by_slice_partial_integral(tube, t);
+  CHECK(ApproxIntv(p_integ.first) == p_integ_ref.first);
+  CHECK(ApproxIntv(p_integ.second) == p_integ_ref.second);
+}
+
+TEST_CASE("Computing integration from prefix sums", "[core]")
+{
+  SECTION("Invalidation of the sums")
+  {
+    Tube tube(Interval(0.,10.), 0.1, TFunction("sin(t)+[-0.1,0.1]"));
+    tube.enable_synthesis(false);
+
+    Interval t1(2.05), t2(3.,7.55);
+    check_partial_integral(tube, t1);
+    check_partial_integral(tube, t2);
+
+    tube.slice(45)->set_envelope(Interval(-5.,5.));
+    check_partial_integral(tube, t2);
+    check_partial_integral(tube, t1); // sums before the slice are still valid
+
+    tube.slice(10)->set(Interval::ALL_REALS);
+    CHECK(tube.integral(t1) == Interval::ALL_REALS);
+    check_partial_integral(tube, Interval(0.5));
+
+    tube.slice(10)->set_empty();
+    CHECK(tube.integral(t2) == Interval::EMPTY_SET);
+    tube.slice(10)->set(Interval(0.));
+    check_partial_integral(tube, t2);
+
+    tube.sample(5.123); // structural change
+    check_partial_integral(tube, t1);
+    check_partial_integral(tube, t2);
+    check_partial_integral(tube, Interval(5.,5.2));
+  }
 }
\ No newline at end of file
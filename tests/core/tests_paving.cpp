@@ -0,0 +1,110 @@
+#include "catch_interval.hpp"
+#include "tubex_TubeVector.h"
+#include "tubex_TFunction.h"
+#include "tubex_TubePaving.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+void check_same_leaves(const Paving& p1, const Paving& p2, SetValue val)
+{
+  vector<const Paving*> v_leaves1, v_leaves2;
+  p1.get_leaves(val, v_leaves1);
+  p2.get_leaves(val, v_leaves2);
+
+  REQUIRE(v_leaves1.size() == v_leaves2.size());
+  for(size_t i = 0 ; i < v_leaves1.size() ; i++)
+    CHECK(v_leaves1[i]->box() == v_leaves2[i]->box());
+}
+
+// Regular grid of leaves of width w, the leaves of v_in and v_maybe
+// being respectively set to IN and MAYBE, the other ones to OUT
+void set_grid(Paving *p, double w, const vector<IntervalVector>& v_in, const vector<IntervalVector>& v_maybe)
+{
+  if(p->box().max_diam() > w)
+  {
+    if(p->is_leaf())
+      p->bisect(0.5);
+    set_grid(p->get_first_subpaving(), w, v_in, v_maybe);
+    set_grid(p->get_second_subpaving(), w, v_in, v_maybe);
+    return;
+  }
+
+  p->set_value(SetValue::OUT);
+  for(const auto& b : v_in)
+    if(p->box() == b)
+      p->set_value(SetValue::IN);
+  for(const auto& b : v_maybe)
+    if(p->box() == b)
+      p->set_value(SetValue::MAYBE);
+}
+
+IntervalVector cell(int i, int j)
+{
+  IntervalVector b(2);
+  b[0] = Interval(i,i+1); b[1] = Interval(j,j+1);
+  return b;
+}
+
+TEST_CASE("Connected subsets")
+{
+  SECTION("Three components on a 4x4 grid")
+  {
+    // A: L-shape over three cells, B: two cells (one MAYBE), C: isolated cell
+    Paving p(IntervalVector(2, Interval(0.,4.)));
+    set_grid(&p, 1., { cell(0,0), cell(0,1), cell(1,1), cell(3,0), cell(3,3) }, { cell(3,1) });
+
+    vector<const Paving*> v_leaves;
+    p.get_leaves(SetValue::IN | SetValue::OUT | SetValue::MAYBE, v_leaves);
+    REQUIRE(v_leaves.size() == 16);
+
+    vector<ConnectedSubset> v_subsets = p.get_connected_subsets(true);
+    REQUIRE(v_subsets.size() == 3);
+
+    IntervalVector hull_a(2, Interval(0.,2.)), hull_b(cell(3,0) | cell(3,1));
+    CHECK(v_subsets[0].get_items().size() == 3);
+    CHECK(v_subsets[0].box() == hull_a);
+    CHECK(v_subsets[1].get_items().size() == 2);
+    CHECK(v_subsets[1].box() == hull_b);
+    CHECK(v_subsets[2].get_items().size() == 1);
+    CHECK(v_subsets[2].box() == cell(3,3));
+
+    // Joining A and B by a cell
+    set_grid(&p, 1., { cell(0,0), cell(0,1), cell(1,1), cell(2,1), cell(3,0), cell(3,3) }, { cell(3,1) });
+    v_subsets = p.get_connected_subsets(true);
+    REQUIRE(v_subsets.size() == 2);
+    CHECK(v_subsets[0].get_items().size() == 6);
+    CHECK(v_subsets[0].box() == (hull_a | hull_b));
+    CHECK(v_subsets[1].box() == cell(3,3));
+  }
+}
+
+TEST_CASE("Parallel pavings")
+{
+  SECTION("TubePaving, 1 thread vs 4 threads")
+  {
+    TubeVector x(Interval(0.,10.), 0.01, TFunction("(cos(t)+[-0.1,0.1] ; sin(t)+[-0.1,0.1])"));
+    x.enable_synthesis();
+    IntervalVector init_box(2, Interval(-2.,2.));
+
+    TubePaving p1(init_box);
+    p1.set_nb_threads(1);
+    p1.compute(0.05, x);
+
+    TubePaving p4(init_box);
+    p4.set_nb_threads(4);
+    p4.set_task_depth(4);
+    p4.compute(0.05, x);
+
+    vector<const Paving*> v_in;
+    p1.get_leaves(SetValue::IN, v_in);
+    CHECK(!v_in.empty());
+
+    check_same_leaves(p1, p4, SetValue::IN);
+    check_same_leaves(p1, p4, SetValue::OUT);
+    check_same_leaves(p1, p4, SetValue::MAYBE);
+  }
+}
@@ -893,6 +893,30 @@ TEST_CASE("Polygons")
     CHECK(p_truth.is_subset(p_inter) != NO);
   }
 
+  SECTION("Polygons intersections, test 11 (crossing boundaries)")
+  {
+    ConvexPolygon p1(IntervalVector(2, Interval(0.,2.)));
+    ConvexPolygon p2(vector<Vector>({{1.,-0.5}, {2.5,1.}, {1.,2.5}, {-0.5,1.}}));
+
+    ConvexPolygon p_truth(vector<Vector>({{0.5,0.}, {1.5,0.}, {2.,0.5}, {2.,1.5},
+                                          {1.5,2.}, {0.5,2.}, {0.,1.5}, {0.,0.5}}));
+    CHECK(ApproxConvexPolygon(p1 & p2) == p_truth);
+    CHECK(ApproxConvexPolygon(p2 & p1) == p_truth);
+  }
+
+  SECTION("Polygons intersections, test 12 (no crossing)")
+  {
+    ConvexPolygon p1(IntervalVector(2, Interval(0.,4.)));
+    ConvexPolygon p2(vector<Vector>({{1.,1.}, {3.,1.5}, {2.,3.}}));
+    ConvexPolygon p3(vector<Vector>({{5.,1.}, {7.,1.5}, {6.,3.}}));
+
+    CHECK((p1 & p2) == p2); // p2 inside p1
+    CHECK((p2 & p1) == p2);
+    CHECK((p1 & p3).is_empty()); // disjoint polygons
+    CHECK((p3 & p1).is_empty());
+    CHECK((p1 & p1) == p1); // degenerated configuration
+  }
+
   SECTION("Polygons, orientations")
   {
     IntervalVector p1({0.,0.});
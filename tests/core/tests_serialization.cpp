@@ -1,4 +1,6 @@
 #include <cstdio>
+#include <cfloat>
+#include <limits>
 #include "tubex_serialize_trajectories.h"
 #include "tubex_serialize_tubes.h"
 #include "catch_interval.hpp"
@@ -8,6 +10,7 @@
 // of the class for tests purposes
 #define protected public
 #include "tubex_TrajectoryVector.h"
+#include "tubex_CompactTubeVector.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -277,4 +280,117 @@ TEST_CASE("(de)serializations on unbounded tubes", "[core]")
     tube.set(Interval::EMPTY_SET);
     CHECK(test_serialization(tube));
   }
-}
\ No newline at end of file
+}
+
+bool test_compact_serialization(const Tube& tube1)
+{
+  string filename = "test_compact_serialization.tube";
+  tube1.serialize(filename, 3); // compact serialization
+  Tube tube2(filename);
+  remove(filename.c_str());
+
+  return tube1.is_subset(tube2)
+    && Tube::same_slicing(tube1, tube2)
+    && tube1.is_subset(CompactTube(tube1).tube());
+}
+
+TEST_CASE("compact (de)serializations of tubes", "[core]")
+{
+  SECTION("Enclosure of bounded tubes")
+  {
+    CHECK(test_compact_serialization(tube_test_1()));
+    CHECK(test_compact_serialization(tube_test_1_01()));
+    CHECK(test_compact_serialization(tube_test2()));
+    CHECK(test_compact_serialization(tube_test3()));
+    CHECK(test_compact_serialization(tube_test4()));
+    CHECK(test_compact_serialization(tube_test4_05()));
+  }
+
+  SECTION("Enclosure of unbounded or empty tubes")
+  {
+    Tube tube = tube_test_1();
+    tube.set(Interval::POS_REALS, tube.nb_slices() / 2);
+    tube.set(Interval::NEG_REALS, 1);
+    tube.set(Interval(1e300,DBL_MAX), 2);
+    tube.set(Interval::EMPTY_SET, 0);
+    CHECK(test_compact_serialization(tube));
+
+    CompactTube compact_tube(tube);
+    CHECK(compact_tube(0) == Interval::EMPTY_SET);
+    CHECK(compact_tube(1) == Interval::NEG_REALS);
+    CHECK(compact_tube(2) == Interval(FLT_MAX,POS_INFINITY));
+    CHECK(compact_tube(tube.nb_slices() / 2) == Interval::POS_REALS);
+  }
+
+  SECTION("Outward rounding")
+  {
+    Tube tube(Interval(0.,1.), 0.1, Interval(0.1,1./3.));
+    CompactTube compact_tube(tube);
+    CHECK(compact_tube(0).is_superset(Interval(0.1,1./3.)));
+    CHECK(compact_tube(0).diam() < 1e-6 + Interval(0.1,1./3.).diam());
+    CHECK(compact_tube(0.05).is_superset(Interval(0.1,1./3.)));
+    CHECK(compact_tube.nb_slices() == tube.nb_slices());
+    CHECK(compact_tube.slice_tdomain(3) == tube.slice(3)->tdomain());
+  }
+
+  SECTION("Size of files")
+  {
+    Tube tube(Interval(0.,10.), 0.01, Interval(-1.,1.));
+    tube.serialize("test_v2.tube", 2);
+    tube.serialize("test_v3.tube", 3);
+
+    ifstream file_v2("test_v2.tube", ios::binary | ios::ate), file_v3("test_v3.tube", ios::binary | ios::ate);
+    CHECK(2 * file_v3.tellg() < file_v2.tellg());
+    file_v2.close(); file_v3.close();
+
+    CompactTube compact_tube("test_v2.tube"); // from a previous version
+    CHECK(tube.is_subset(compact_tube.tube()));
+    remove("test_v2.tube");
+    remove("test_v3.tube");
+  }
+
+  SECTION("Vector case")
+  {
+    TubeVector tube1(Interval(0.,5.), 0.1, IntervalVector(2, Interval(-1./3.,2./3.)));
+    tube1[1].set(Interval(-0.1,0.5), 2.);
+
+    CompactTubeVector compact_tube(tube1);
+    CHECK(compact_tube.size() == 2);
+    CHECK(compact_tube.memory_size() == 2 * (3 * tube1.nb_slices() + 2) * 8); // 24 bytes per slice
+    CHECK(tube1.is_subset(compact_tube.tube_vector()));
+
+    string filename = "test_compact_vector.tube";
+    compact_tube.serialize(filename);
+    TubeVector tube2(filename);
+    remove(filename.c_str());
+    CHECK(tube1.is_subset(tube2));
+    CHECK(tube2 == compact_tube.tube_vector());
+  }
+  SECTION("Corrupted uniform slicing")
+  {
+    string filename = "test_corrupted.tube";
+    auto write_header = [&](int slices_number, double timestep)
+    {
+      ofstream bin_file(filename.c_str(), ios::out | ios::binary);
+      short int version_number = 3; char uniform = 1;
+      double t0 = 0., tf = 1.;
+      bin_file.write((const char*)&version_number, sizeof(short int));
+      bin_file.write((const char*)&slices_number, sizeof(int));
+      bin_file.write((const char*)&uniform, sizeof(char));
+      bin_file.write((const char*)&t0, sizeof(double));
+      bin_file.write((const char*)&timestep, sizeof(double));
+      bin_file.write((const char*)&tf, sizeof(double));
+      bin_file.close();
+    };
+
+    write_header(10, 0.);
+    CHECK_THROWS(Tube{filename});
+    write_header(10, -0.1);
+    CHECK_THROWS(Tube{filename});
+    write_header(10, std::numeric_limits<double>::quiet_NaN());
+    CHECK_THROWS(Tube{filename});
+    write_header(10, 1e-300); // would require too many bounds
+    CHECK_THROWS(Tube{filename});
+    remove(filename.c_str());
+  }
+}
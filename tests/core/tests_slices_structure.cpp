@@ -1,5 +1,6 @@
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
+#include "tubex_SlicingController.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -353,4 +354,171 @@ TEST_CASE("Tube slices structure")
     CHECK(x.nb_slices() == xold.nb_slices());
     CHECK(x == xold);
   }
+
+  SECTION("Growing tube")
+  {
+    Tube x(Interval(0.,1.), 0.5, Interval(-1.,1.));
+    CHECK(x.last_slice()->tdomain() == Interval(0.5,1.));
+
+    x.push_back_slice(0.5, Interval(0.,2.));
+    CHECK(x.nb_slices() == 3);
+    CHECK(x.tdomain() == Interval(0.,1.5));
+    CHECK(x.last_slice()->tdomain() == Interval(1.,1.5));
+    CHECK(x.last_slice()->codomain() == Interval(0.,2.));
+    CHECK(x.last_slice()->input_gate() == Interval(0.,1.));
+    CHECK(x.last_slice()->input_gate() == x.slice(1)->output_gate());
+
+    x.push_back_slice(0.5);
+    CHECK(x.nb_slices() == 4);
+    CHECK(x.tdomain() == Interval(0.,2.));
+    CHECK(x.last_slice()->prev_slice() == x.slice(2));
+    CHECK(x(1.75) == Interval::ALL_REALS);
+
+    x.sample(1.8);
+    CHECK(x.last_slice()->tdomain() == Interval(1.8,2.));
+
+    CHECK(x.drop_front_slices(0.2) == 0);
+    CHECK(x.drop_front_slices(1.) == 2);
+    CHECK(x.nb_slices() == 3);
+    CHECK(x.tdomain() == Interval(1.,2.));
+    CHECK(x.first_slice()->tdomain() == Interval(1.,1.5));
+    CHECK(x.first_slice()->prev_slice() == NULL);
+    CHECK(x(1.) == Interval(0.,1.));
+
+    TubeVector y(Interval(0.,1.), 0.5, 2);
+    y.push_back_slice(0.5, IntervalVector(2, Interval(-1.,1.)));
+    CHECK(y.nb_slices() == 3);
+    CHECK(y.tdomain() == Interval(0.,1.5));
+    CHECK(y.drop_front_slices(0.5) == 1);
+    CHECK(y.tdomain() == Interval(0.5,1.5));
+    CHECK(y(1.2) == IntervalVector(2, Interval(-1.,1.)));
+  }
+}
+
+TEST_CASE("Adaptive slicing")
+{
+  SECTION("Splits, within the budget")
+  {
+    Tube x(Interval(0.,4.), 1., Interval(-1.,1.));
+    for(int i = 0 ; i <= 4 ; i++)
+      x.set(Interval(0.), i);
+
+    SlicingController ctrl(6, 1.);
+    CHECK(ctrl.adapt(x) == 2);
+    CHECK(x.nb_slices() == 6);
+    CHECK(x.slice(0)->tdomain() == Interval(0.,1.));
+    CHECK(x.slice(2)->tdomain() == Interval(2.,2.5));
+    CHECK(x(2.5) == Interval(-1.,1.));
+    CHECK(x.codomain() == Interval(-1.,1.));
+  }
+
+  SECTION("Merges")
+  {
+    Tube x(Interval(0.,4.), 1., Interval(-1.,1.));
+
+    SlicingController ctrl(10, 1.);
+    CHECK(ctrl.adapt(x) == 2);
+    CHECK(x.nb_slices() == 2);
+    CHECK(x.first_slice()->tdomain() == Interval(0.,2.));
+    CHECK(x.codomain() == Interval(-1.,1.));
+
+    Tube y(Interval(0.,4.), 1., Interval(-1.,1.));
+    SlicingController ctrl_budget(1, 1.);
+    CHECK(ctrl_budget.adapt(y) == 3);
+    CHECK(y.nb_slices() == 1);
+  }
+
+  SECTION("With derivative")
+  {
+    Tube x(Interval(0.,2.), 1., Interval(-1.,1.)), v(x, Interval(0.1));
+    for(int i = 0 ; i <= 2 ; i++)
+      x.set(Interval(0.), i);
+    Tube x_copy(x);
+
+    SlicingController ctrl(10, 0.5);
+    CHECK(ctrl.adapt(x, v) == 0); // variations bounded by the derivative
+    CHECK(ctrl.adapt(x_copy) == 2);
+  }
+
+  SECTION("Tube vector")
+  {
+    TubeVector x(Interval(0.,4.), 1., IntervalVector(2, Interval(-1.,1.)));
+    x[1].set(Interval(0.), 1.);
+    x[1].set(Interval(0.), 2.);
+
+    SlicingController ctrl(10, 1.);
+    CHECK(ctrl.adapt(x) == 2);
+    CHECK(x.nb_slices() == 4);
+    CHECK(Tube::same_slicing(x[0], x[1]));
+    CHECK(x[0].slice(1)->tdomain() == Interval(1.,1.5));
+    CHECK(x[0].slice(3)->tdomain() == Interval(2.,4.));
+  }
+}
+
+TEST_CASE("Shared time grid")
+{
+  SECTION("Values of the slices")
+  {
+    TubeVector x(Interval(0.,4.), 1., IntervalVector(2, Interval(-1.,1.)));
+    CHECK(x.shared_grid() == NULL);
+    x.enable_shared_grid();
+    REQUIRE(x.shared_grid() != NULL);
+    CHECK(x.shared_grid()->nb_slices() == 4);
+    CHECK(x.shared_grid()->slice_tdomain(2) == Interval(2.,3.));
+    CHECK(x.shared_grid()->time_to_index(2.) == 2);
+    CHECK(x.shared_grid()->time_to_index(4.) == 3);
+
+    x[1].set(Interval(0.,0.5), 2);
+    CHECK(x(2)[0] == Interval(-1.,1.));
+    CHECK(x(2)[1] == Interval(0.,0.5));
+    CHECK(x.shared_grid()->input_gate(2)[1] == Interval(0.,0.5));
+    CHECK(x.shared_grid()->output_gate(1)[1] == Interval(0.,0.5)); // shared gate
+    CHECK(x.shared_grid()->output_gate(2)[1] == Interval(0.,0.5));
+    CHECK(x.shared_grid()->input_gate(3)[1] == Interval(0.,0.5));
+    CHECK(x(1) == IntervalVector(2, Interval(-1.,1.)));
+
+    TubeVector y(x);
+    CHECK(y.shared_grid() == NULL); // not transmitted to copies
+    CHECK(TubeVector::same_slicing(x, y));
+    y.enable_shared_grid();
+    CHECK(TubeVector::same_slicing(x, y));
+    x = y;
+    CHECK(x.shared_grid() != NULL);
+    CHECK(x(2) == y(2));
+  }
+
+  SECTION("Structural changes")
+  {
+    TubeVector x(Interval(0.,4.), 1., IntervalVector(2, Interval(-1.,1.)));
+    x.enable_shared_grid();
+    TubeVector y(x);
+    y.enable_shared_grid();
+
+    x.sample(2.5);
+    CHECK(x.nb_slices() == 5);
+    CHECK(x.shared_grid()->nb_slices() == 5);
+    CHECK(x.shared_grid()->slice_tdomain(2) == Interval(2.,2.5));
+    CHECK(x.shared_grid()->slice_tdomain(3) == Interval(2.5,3.));
+    CHECK(!TubeVector::same_slicing(x, y));
+    x.sample(2.5); // no effect
+    CHECK(x.nb_slices() == 5);
+
+    x[0].sample(0.5);
+    CHECK(x.shared_grid() == NULL); // components do not share the same slicing
+    CHECK(x(3) == IntervalVector(2, Interval(-1.,1.)));
+    x[1].sample(0.5);
+    REQUIRE(x.shared_grid() != NULL);
+    CHECK(x.shared_grid()->nb_slices() == 6);
+
+    x.resize(3);
+    REQUIRE(x.shared_grid() != NULL);
+    x[2].set(Interval(2.), 5);
+    CHECK(x(5).subvector(0,1) == IntervalVector(2, Interval(-1.,1.)));
+    CHECK(x(5)[2] == Interval(2.));
+
+    x.enable_shared_grid(false);
+    CHECK(x.shared_grid() == NULL);
+    CHECK(x(5).subvector(0,1) == IntervalVector(2, Interval(-1.,1.)));
+    CHECK(x(5)[2] == Interval(2.));
+  }
 }
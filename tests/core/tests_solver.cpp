@@ -0,0 +1,94 @@
+#include "catch_interval.hpp"
+#include "tubex_TubeSolver.h"
+#include "tubex_CtcDeriv.h"
+#include "tubex_Exception.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+TEST_CASE("TubeSolver")
+{
+  // Constant trajectories x(·) such that x(0)=±0.5
+
+  TubeVector x0(Interval(0.,1.), 0.1, IntervalVector(1, Interval(-1.,1.)));
+  const TubeVector v(Interval(0.,1.), 0.1, IntervalVector(1, Interval(0.)));
+
+  auto ctc = [&v](TubeVector& x, int)
+  {
+    Interval g = x[0](0.);
+    x[0].set((g & Interval(-0.5)) | (g & Interval(0.5)), 0.);
+
+    CtcDeriv ctc_deriv;
+    ctc_deriv.contract(x, v);
+  };
+
+  SECTION("Solutions")
+  {
+    for(int nb_threads : { 1, 0 })
+      for(Exploration exploration : { Exploration::DEPTH_FIRST, Exploration::BEST_FIRST })
+      {
+        TubeSolver solver(Vector(1, 0.1), nb_threads);
+        solver.set_contraction(ctc);
+        solver.set_exploration(exploration);
+
+        const vector<TubeVector>& v_sols = solver.solve(x0);
+        CHECK(v_sols.size() == 2);
+        CHECK(solver.boundary().empty());
+        CHECK(solver.nb_nodes() == 3);
+        CHECK(!solver.budget_reached());
+
+        Interval sols_x0 = Interval::EMPTY_SET;
+        for(const auto& x : v_sols)
+        {
+          CHECK(x.nb_slices() == x0.nb_slices());
+          CHECK(x.max_diam()[0] == 0.);
+          CHECK(x(0.5)[0] == x(0.)[0]);
+          sols_x0 |= x(0.)[0];
+        }
+
+        CHECK(sols_x0 == Interval(-0.5,0.5));
+      }
+  }
+
+  SECTION("Budget of nodes")
+  {
+    TubeSolver solver(Vector(1, 0.1), 1);
+    solver.set_contraction(ctc);
+    solver.set_max_nodes(1);
+    solver.solve(x0);
+
+    CHECK(solver.solutions().empty());
+    CHECK(solver.boundary().size() == 2);
+    CHECK(solver.budget_reached());
+    CHECK(solver.boundary()[0].nb_slices() == x0.nb_slices());
+    CHECK(ApproxIntv(solver.boundary()[0](0.)[0]) == Interval(-0.5,-0.01));
+    CHECK(ApproxIntv(solver.boundary()[1](0.)[0]) == Interval(-0.01,0.5));
+  }
+
+  SECTION("Bisection heuristics")
+  {
+    TubeVector x(x0);
+    ctc(x, 0);
+
+    TubeSolver::Bisection b = TubeSolver::largest_gate(x, Vector(1, 0.1));
+    CHECK(b.dim == 0);
+    CHECK(b.t == 0.);
+    CHECK(b.value == Approx(-0.01));
+
+    TubeVector x_thin(Interval(0.,1.), 0.1, IntervalVector(1, Interval(0.5)));
+    b = TubeSolver::largest_gate(x_thin, Vector(1, 0.1));
+    CHECK(b.dim == -1);
+
+    TubeSolver solver(Vector(1, 0.1), 1);
+    solver.set_contraction(ctc);
+    solver.set_bisection([](const TubeVector&, int) -> TubeSolver::Bisection { return { 0, 0.05, 0. }; });
+    CHECK_THROWS(solver.solve(x0););
+
+    // Bisection of the last gate, the initial one being deduced by CtcDeriv
+    solver.set_bisection([](const TubeVector& x, int) -> TubeSolver::Bisection { return { 0, 1., x[0](1.).mid() }; });
+    CHECK(solver.solve(x0).size() == 2);
+  }
+}
@@ -2,6 +2,7 @@
 #include "tubex_CtcEval.h"
 #include "tubex_VIBesFigTube.h"
 #include "tubex_VIBesFigTubeVector.h"
+#include "tubex_TubeSnapshot.h"
 #include "tests_predefined_tubes.h"
 #include "vibes.h"
 
@@ -425,6 +426,35 @@ TEST_CASE("Testing set inversion")
     Tube x(domain, dt, TFunction("[-1,1]*(t^2+1)"));
     CHECK(x.invert(0.) == domain);
   }
+
+  SECTION("Batch inversion and synthesis tree")
+  {
+    Tube x = tube_test_1();
+    x.set(Interval(-4,2), 14);
+
+    vector<Interval> v_y, v_inv;
+    v_y.push_back(Interval(0.));
+    v_y.push_back(Interval(-12.0,-7.0));
+    v_y.push_back(Interval(-20,-18));
+    v_y.push_back(Interval(6.0,7.0));
+    v_y.push_back(Interval::EMPTY_SET);
+    v_y.push_back(Interval(-1.0,1.0));
+
+    Interval search(3.8,42.5);
+    x.invert(v_y, v_inv, search);
+    CHECK(v_inv.size() == v_y.size());
+    for(size_t i = 0 ; i < v_y.size() ; i++)
+    {
+      CHECK(v_inv[i] == x.invert(v_y[i], search));
+      CHECK(v_inv[i] == x.invert(v_y[i], Tube(x, Interval::ALL_REALS), search)); // former path
+    }
+
+    vector<Interval> v_t, v_t_tree;
+    x.invert(Interval(-1.0,1.0), v_t, search);
+    x.enable_synthesis();
+    x.invert(Interval(-1.0,1.0), v_t_tree, search);
+    CHECK(v_t_tree == v_t);
+  }
 }
 
 TEST_CASE("Testing set inversion in vector case")
@@ -1253,4 +1283,65 @@ TEST_CASE("Interpol")
     TubeVector x2(Interval(0.,10.), 0.001, 4);
     CHECK(!x2.is_empty());
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Snapshots")
+{
+  SECTION("Restoring a tube after a trial contraction")
+  {
+    Tube x = tube_test_1();
+    Tube x_copy(x);
+    Tube v(x, Interval(-1.,1.));
+
+    {
+      TubeSnapshot snapshot(x);
+      CHECK(snapshot.nb_records() == 0);
+
+      x.set(Interval(-2.,3.), 5);
+      x.set(Interval(0.5), x.slice(10)->tdomain().lb());
+      CtcDeriv ctc_deriv;
+      ctc_deriv.contract(x, v);
+      CHECK(x != x_copy);
+      CHECK(snapshot.nb_records() > 0);
+
+      snapshot.restore();
+      CHECK(snapshot.nb_records() == 0);
+      CHECK(x == x_copy);
+      CHECK(x.volume() == x_copy.volume());
+
+      // The snapshot can be restored several times
+      x.set_empty();
+      snapshot.restore();
+      CHECK(x == x_copy);
+
+      // Only the first modification of a slice is recorded
+      for(int i = 0 ; i < 100 ; i++)
+        x.slice(3)->set_envelope(Interval(-1.,1.) + 0.01*i);
+      x.slice(4)->set(Interval(1.));
+      CHECK(snapshot.nb_records() == 2);
+      snapshot.restore();
+      CHECK(x == x_copy);
+    }
+
+    // Once the snapshot is destroyed, modifications are not recorded anymore
+    x.set(Interval(0.), 2);
+    TubeSnapshot snapshot(x);
+    CHECK(snapshot.nb_records() == 0);
+    CHECK_THROWS(TubeSnapshot snapshot2(x););
+  }
+
+  SECTION("Vector case")
+  {
+    TubeVector x(Interval(0.,10.), 1., IntervalVector(2, Interval(-1.,1.)));
+    TubeVector x_copy(x);
+
+    TubeSnapshot snapshot(x);
+    x[1].set(Interval(0.,0.5), 3.);
+    x[0].set(Interval(2.), 4);
+    snapshot.restore();
+    CHECK(x == x_copy);
+
+    x[0].sample(5.5);
+    CHECK_THROWS(snapshot.restore(););
+  }
+}
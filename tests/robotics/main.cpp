@@ -0,0 +1,3 @@
+#define CATCH_CONFIG_MAIN
+
+#include "catch_interval.hpp"
\ No newline at end of file
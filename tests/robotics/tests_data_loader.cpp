@@ -0,0 +1,160 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <random>
+#include <fstream>
+#include "catch_interval.hpp"
+#include "tubex_DataLoaderColumns.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+// Parses str with DataLoaderColumns::parse_double and with strtod:
+// same values (bitwise) and same numbers of read characters are expected
+bool same_as_strtod(const string& str)
+{
+  const char *begin = str.c_str(), *end = begin + str.size();
+
+  double x;
+  const char *p = DataLoaderColumns::parse_double(begin, end, x);
+
+  char *p_ref;
+  double x_ref = strtod(begin, &p_ref);
+
+  if(p != p_ref)
+    return false;
+
+  if(std::isnan(x_ref))
+    return std::isnan(x);
+
+  return memcmp(&x, &x_ref, sizeof(double)) == 0; // also distinguishes -0 and 0
+}
+
+TEST_CASE("DataLoaderColumns::parse_double")
+{
+  SECTION("Round-trip of random doubles")
+  {
+    mt19937_64 gen(0);
+    uniform_real_distribution<double> mantissa(-1.,1.);
+    uniform_int_distribution<int> exponent(-300,300);
+    char buffer[64];
+
+    for(int i = 0 ; i < 10000 ; i++)
+    {
+      double x_ref = ldexp(mantissa(gen), exponent(gen));
+      for(int precision : { 6, 15, 17 })
+      {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, x_ref);
+        CHECK(same_as_strtod(buffer));
+      }
+
+      snprintf(buffer, sizeof(buffer), "%.17g", x_ref);
+      double x;
+      DataLoaderColumns::parse_double(buffer, buffer + strlen(buffer), x);
+      CHECK(x == x_ref);
+    }
+
+    for(const char *str : { "0", "1", "0.1", "0.3", "12.5", "3.14159", "123456789", "9007199254740993" })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("More than 19 digits")
+  {
+    for(const char *str : {
+        "3.14159265358979323846264338327950288",
+        "123456789012345678901234567890",
+        "12345678901234567890.5",
+        "1234567890123456789",
+        "0.000000000000000000000123456789012345678901",
+        "2.2250738585072011e-308",
+        "9007199254740993.000000000000000000001",
+        "0.10000000000000000555111512312578270211815834045410156250001" })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("Exponents")
+  {
+    for(const char *str : {
+        "1e22", "1e23", "1e-22", "1e-23", "2.5E+10", "2.5e-0", "7e",
+        "1e308", "1.7976931348623157e308", "1e309", "1e400",
+        "4.9e-324", "1e-320", "1e-400", "123.456e-7" })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("nan and inf")
+  {
+    for(const char *str : { "nan", "NaN", "-nan", "inf", "-inf", "+inf", "Infinity", "-INF" })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("Signs")
+  {
+    for(const char *str : { "+1.5", "-1.5", "-0", "-0.0", "+0", "-1e-5", "-", "+", "-.5", ".5", "." })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("Separators and CRLF line endings")
+  {
+    string line = "1.25\r\n";
+    double x;
+    const char *p = DataLoaderColumns::parse_double(line.c_str(), line.c_str() + line.size(), x);
+    CHECK(x == 1.25);
+    CHECK(*p == '\r');
+
+    line = "3.14159265358979323846264338327950288\r\n"; // fallback on strtod
+    p = DataLoaderColumns::parse_double(line.c_str(), line.c_str() + line.size(), x);
+    CHECK(x == strtod(line.c_str(), NULL));
+    CHECK(*p == '\r');
+
+    for(const char *str : { "1.5;2", "1.5,2", "-2.5\t3", "1e3 4" })
+      CHECK(same_as_strtod(str));
+  }
+
+  SECTION("Locale with a decimal comma")
+  {
+    string previous_locale = setlocale(LC_NUMERIC, NULL);
+    if(setlocale(LC_NUMERIC, "de_DE.UTF-8") != NULL || setlocale(LC_NUMERIC, "fr_FR.UTF-8") != NULL)
+    {
+      string line = "3.14159265358979323846264338327950288;2"; // fallback on strtod
+      double x;
+      const char *p = DataLoaderColumns::parse_double(line.c_str(), line.c_str() + line.size(), x);
+      setlocale(LC_NUMERIC, previous_locale.c_str());
+      CHECK(x == strtod(line.c_str(), NULL));
+      CHECK(*p == ';');
+    }
+
+    setlocale(LC_NUMERIC, previous_locale.c_str());
+  }
+}
+
+TEST_CASE("DataLoaderColumns::load")
+{
+  SECTION("CRLF data file")
+  {
+    string file_name = "tubex_data_loader_test.txt";
+    ofstream file(file_name, ios::binary);
+    file << "t x y\r\n";
+    file << "0 1.5 -2\r\n";
+    file << "0.5 1.25e1 3.14159265358979323846264338327950288\r\n";
+    file << "\r\n";
+    file << "1 -0.1 +7\r\n";
+    file.close();
+
+    DataLoaderColumns loader(file_name, 0, { 2, 1 });
+    loader.set_header_lines(1);
+    CHECK(loader.load() == 3);
+    CHECK(loader.time(1) == 0.5);
+    CHECK(loader.value(0, 0) == -2.);
+    CHECK(loader.value(0, 1) == 1.5);
+    CHECK(loader.value(1, 0) == strtod("3.14159265358979323846264338327950288", NULL));
+    CHECK(loader.value(1, 1) == 12.5);
+    CHECK(loader.value(2, 0) == 7.);
+    CHECK(loader.value(2, 1) == strtod("-0.1", NULL));
+    remove(file_name.c_str());
+  }
+}